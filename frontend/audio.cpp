@@ -16,8 +16,9 @@ void update(void* userdata, SDL_AudioStream* stream, int additional_amount, int
 
     iris->audio_buf.resize(additional_amount);
 
+    ps2_spu2_get_samples(iris->ps2->spu2, iris->audio_buf.data(), additional_amount, !iris->mute_adma);
+
     for (int i = 0; i < additional_amount; i++) {
-        iris->audio_buf[i] = ps2_spu2_get_sample(iris->ps2->spu2, !iris->mute_adma);
         iris->audio_buf[i].s16[0] *= iris->mute ? 0.0f : iris->volume;
         iris->audio_buf[i].s16[1] *= iris->mute ? 0.0f : iris->volume;
     }
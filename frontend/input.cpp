@@ -427,7 +427,19 @@ bool save_screenshot(iris::instance* iris, std::string path) {
     void* ptr = nullptr;
     int width = 0, height = 0, offset = 0;
 
-    if (iris->screenshot_mode == IRIS_SCREENSHOT_MODE_INTERNAL) {
+    // The software renderer keeps its frame in host memory, take it
+    // from there instead of reading the image back from the GPU
+    const uint32_t* frame = nullptr;
+
+    if (iris->screenshot_mode == IRIS_SCREENSHOT_MODE_INTERNAL && !iris->screenshot_shader_processing) {
+        frame = renderer_get_buffer(iris->renderer, &width, &height);
+    }
+
+    if (frame) {
+        ptr = malloc((width * 4) * height);
+
+        memcpy(ptr, frame, (width * 4) * height);
+    } else if (iris->screenshot_mode == IRIS_SCREENSHOT_MODE_INTERNAL) {
         renderer_image* image = iris->screenshot_shader_processing ? &iris->output_image : &iris->image;
 
         ptr = vulkan::read_image(iris,
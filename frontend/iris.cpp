@@ -139,6 +139,78 @@ void sleep_limiter(iris::instance* iris) {
     // }
 }
 
+static inline bool same_breakpoint(const iris::breakpoint& a, const iris::breakpoint& b) {
+    return a.addr == b.addr && a.cpu == b.cpu;
+}
+
+static inline bool has_breakpoint(const std::vector <iris::breakpoint>& v, const iris::breakpoint& b) {
+    for (const iris::breakpoint& e : v) {
+        if (same_breakpoint(e, b)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Breakpoints are checked by the core when caching blocks, so we only
+// need to push the enabled set whenever the UI changes it
+static void sync_breakpoints(iris::instance* iris) {
+    std::vector <iris::breakpoint> enabled;
+
+    for (const iris::breakpoint& b : iris->breakpoints) {
+        if (b.enabled) {
+            enabled.push_back(b);
+        }
+    }
+
+    // Step over is implemented as a temporary EE breakpoint
+    if (iris->step_over) {
+        iris::breakpoint b = {};
+
+        b.addr = iris->step_over_addr;
+        b.cpu = iris::BKPT_CPU_EE;
+
+        enabled.push_back(b);
+    }
+
+    bool changed = enabled.size() != iris->core_breakpoints.size();
+
+    for (size_t i = 0; !changed && i < enabled.size(); i++) {
+        changed = !same_breakpoint(enabled[i], iris->core_breakpoints[i]);
+    }
+
+    if (!changed)
+        return;
+
+    // Only push the difference, clearing everything would drop the
+    // core's pending resume from the breakpoint we're stopped on, and
+    // flush the whole EE block cache
+    for (const iris::breakpoint& b : iris->core_breakpoints) {
+        if (has_breakpoint(enabled, b))
+            continue;
+
+        if (b.cpu == iris::BKPT_CPU_EE) {
+            ee_remove_breakpoint(iris->ps2->ee, b.addr);
+        } else {
+            iop_remove_breakpoint(iris->ps2->iop, b.addr);
+        }
+    }
+
+    for (const iris::breakpoint& b : enabled) {
+        if (has_breakpoint(iris->core_breakpoints, b))
+            continue;
+
+        if (b.cpu == iris::BKPT_CPU_EE) {
+            ee_set_breakpoint(iris->ps2->ee, b.addr);
+        } else {
+            iop_set_breakpoint(iris->ps2->iop, b.addr);
+        }
+    }
+
+    iris->core_breakpoints = enabled;
+}
+
 static inline void do_cycle(iris::instance* iris) {
     ps2_cycle(iris->ps2);
 
@@ -153,22 +225,14 @@ static inline void do_cycle(iris::instance* iris) {
         }
     }
 
-    if (iris->step_over) {
-        if (iris->ps2->ee->pc == iris->step_over_addr) {
-            iris->step_over = false;
-            iris->pause = true;
-        }
-    }
+    int ee_hit = ee_poll_breakpoint(iris->ps2->ee);
+    int iop_hit = iop_poll_breakpoint(iris->ps2->iop);
 
-    for (const iris::breakpoint& b : iris->breakpoints) {
-        if (b.cpu == iris::BKPT_CPU_EE) {
-            if (iris->ps2->ee->pc == b.addr) {
-                iris->pause = true;
-            }
-        } else {
-            if (iris->ps2->iop->pc == b.addr) {
-                iris->pause = true;
-            }
+    if (ee_hit || iop_hit) {
+        iris->pause = true;
+
+        if (iris->step_over && ee_hit && iris->ps2->ee->pc == iris->step_over_addr) {
+            iris->step_over = false;
         }
     }
 }
@@ -472,6 +536,8 @@ SDL_AppResult update(iris::instance* iris) {
         iris->double_click_counter--;
     }
 
+    sync_breakpoints(iris);
+
     if (iris->pause) {
         iris->step_out = false;
         iris->step_over = false;
@@ -463,6 +463,8 @@ struct instance {
     std::string mcd1_path = "";
     std::string snap_path = "";
     std::string flash_path = "";
+    std::string hdd_path = "";
+    std::string hdd_overlay_path = "";
     std::string ini_path = "";
     std::string gcdb_path = "";
 
@@ -561,6 +563,7 @@ struct instance {
     bool prev_mute = false;
     float volume = 1.0f;
     int timescale = 8;
+    int cdvd_speed = 1;
     bool mute_adma = true;
     bool vsync = true;
     float ui_scale = 1.0f;
@@ -588,6 +591,10 @@ struct instance {
     std::vector <std::string> sysmem_log = { "" };
 
     std::vector <iris::breakpoint> breakpoints = {};
+
+    // Breakpoints currently registered with the core, used to
+    // detect changes made through the UI
+    std::vector <iris::breakpoint> core_breakpoints = {};
     std::deque <iris::notification> notifications = {};
 
     struct ds_state* ds[2] = { nullptr };
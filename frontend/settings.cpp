@@ -112,6 +112,8 @@ bool parse_toml_settings(iris::instance* iris) {
     iris->mcd1_path = paths["mcd1_path"].value_or("");
     iris->snap_path = paths["snap_path"].value_or("snap");
     iris->flash_path = paths["flash_path"].value_or("");
+    iris->hdd_path = paths["hdd_path"].value_or("");
+    iris->hdd_overlay_path = paths["hdd_overlay_path"].value_or("");
     iris->gcdb_path = paths["gcdb_path"].value_or("");
 
     auto window = tbl["window"];
@@ -166,6 +168,7 @@ bool parse_toml_settings(iris::instance* iris) {
     iris->show_imgui_demo = debugger["show_imgui_demo"].value_or(false);
     iris->skip_fmv = debugger["skip_fmv"].value_or(false);
     iris->timescale = debugger["timescale"].value_or(8);
+    iris->cdvd_speed = debugger["cdvd_speed"].value_or(1);
 
     auto system = tbl["system"];
     iris->system = system["model"].value_or(PS2_SYSTEM_AUTO);
@@ -425,9 +428,11 @@ bool init(iris::instance* iris, int argc, const char* argv[]) {
     ps2_set_timescale(iris->ps2, iris->timescale);
 
     ee_set_fmv_skip(iris->ps2->ee, iris->skip_fmv);
+    ps2_cdvd_set_fast_read(iris->ps2->cdvd, iris->cdvd_speed > 1 ? CDVD_FAST_READ_SECTORS : 0, iris->cdvd_speed);
 
     ps2_set_system(iris->ps2, iris->system);
     ps2_speed_load_flash(iris->ps2->speed, iris->flash_path.c_str());
+    ps2_speed_load_hdd(iris->ps2->speed, iris->hdd_path.c_str(), iris->hdd_overlay_path.c_str());
     ps2_speed_set_mac_address(iris->ps2->speed, iris->mac_address);
 
     return true;
@@ -513,7 +518,8 @@ void close(iris::instance* iris) {
             { "show_imgui_demo", iris->show_imgui_demo },
             { "show_overlay", iris->show_overlay },
             { "skip_fmv", iris->skip_fmv },
-            { "timescale", iris->timescale }
+            { "timescale", iris->timescale },
+            { "cdvd_speed", iris->cdvd_speed }
         } },
         { "display", toml::table {
             { "scale", iris->scale },
@@ -562,6 +568,8 @@ void close(iris::instance* iris) {
             { "mcd1_path", iris->mcd1_path },
             { "snap_path", iris->snap_path },
             { "flash_path", iris->flash_path },
+            { "hdd_path", iris->hdd_path },
+            { "hdd_overlay_path", iris->hdd_overlay_path },
             { "gcdb_path", iris->gcdb_path },
         } },
         { "recents", toml::table {
@@ -1,10 +1,13 @@
+#include <algorithm>
 #include <sstream>
 #include <fstream>
+#include <cstring>
 #include <vector>
 #include <string>
 #include <cctype>
 
 #include "iris.hpp"
+#include "ps2_search.h"
 #include "ee/ee_def.hpp"
 #include "ee/vu_def.hpp"
 
@@ -88,221 +91,69 @@ struct match {
     int type;
 };
 
-std::vector <match> search_matches;
 std::vector <match> address_list;
 
+struct ps2_search* search = nullptr;
+
 int search_type = SEARCH_TYPE_U32;
 int search_cmp = SEARCH_CMP_EQUAL;
 int search_cpu = SEARCH_CPU_EE;
+bool search_against_prev = false;
 bool display_hex = false;
 bool search_aligned = true;
 
-template <typename T> bool compare_values(int cmp, T a, T b) {
-    switch (cmp) {
-        case SEARCH_CMP_EQUAL:
-            return a == b;
-        case SEARCH_CMP_NOT_EQUAL:
-            return a != b;
-        case SEARCH_CMP_LESS_THAN:
-            return a < b;
-        case SEARCH_CMP_GREATER_THAN:
-            return a > b;
-        case SEARCH_CMP_LESS_EQUAL:
-            return a <= b;
-        case SEARCH_CMP_GREATER_EQUAL:
-            return a >= b;
-    }
-
-    return false;
-}
-
-void search_memory(struct ps2_state* ps2, int cpu, int type, int cmp, const char* value_str, bool aligned) {
-    search_matches.clear();
+// Type and CPU of the current search results
+int search_result_type = SEARCH_TYPE_U32;
+int search_result_cpu = SEARCH_CPU_EE;
 
-    struct ps2_ram* mem = cpu == SEARCH_CPU_EE ? ps2->ee_ram : ps2->iop_ram;
+uint64_t parse_search_value(int type, const char* value_str) {
+    value v;
 
-    int size = 0;
+    v.u64 = 0;
 
     switch (type) {
-        case SEARCH_TYPE_U8:
-        case SEARCH_TYPE_S8:
-            size = 1;
-            break;
-        case SEARCH_TYPE_U16:
-        case SEARCH_TYPE_S16:
-            size = 2;
-            break;
-        case SEARCH_TYPE_U32:
-        case SEARCH_TYPE_S32:
-        case SEARCH_TYPE_F32:
-            size = 4;
-            break;
-        case SEARCH_TYPE_U64:
-        case SEARCH_TYPE_S64:
-        case SEARCH_TYPE_F64:
-            size = 8;
-            break;
+        case SEARCH_TYPE_U8: v.u8[0] = (uint8_t)std::strtoul(value_str, nullptr, 0); break;
+        case SEARCH_TYPE_U16: v.u16[0] = (uint16_t)std::strtoul(value_str, nullptr, 0); break;
+        case SEARCH_TYPE_U32: v.u32[0] = (uint32_t)std::strtoul(value_str, nullptr, 0); break;
+        case SEARCH_TYPE_U64: v.u64 = (uint64_t)std::strtoull(value_str, nullptr, 0); break;
+        case SEARCH_TYPE_S8: v.s8[0] = (int8_t)std::strtol(value_str, nullptr, 0); break;
+        case SEARCH_TYPE_S16: v.s16[0] = (int16_t)std::strtol(value_str, nullptr, 0); break;
+        case SEARCH_TYPE_S32: v.s32[0] = (int32_t)std::strtol(value_str, nullptr, 0); break;
+        case SEARCH_TYPE_S64: v.s64 = (int64_t)std::strtoll(value_str, nullptr, 0); break;
+        case SEARCH_TYPE_F32: v.f32[0] = std::strtof(value_str, nullptr); break;
+        case SEARCH_TYPE_F64: v.f64 = std::strtod(value_str, nullptr); break;
     }
 
-    for (int addr = 0; addr < mem->size - size; addr += (aligned ? size : 1)) {
-        match m;
-    
-        m.address = addr;
-        m.curr_value.u64 = *(uint64_t*)&mem->buf[addr];
-        m.prev_value = m.curr_value;
-        m.cpu = cpu;
-        m.type = type;
-
-        switch (type) {
-            case SEARCH_TYPE_U8: {
-                uint8_t val = (uint8_t)std::strtoul(value_str, nullptr, 0);
-                if (compare_values<uint8_t>(cmp, m.curr_value.u8[0], val)) {
-                    search_matches.push_back(m);
-                }
-            } break;
-            case SEARCH_TYPE_U16: {
-                uint16_t val = (uint16_t)std::strtoul(value_str, nullptr, 0);
-                if (compare_values<uint16_t>(cmp, m.curr_value.u16[0], val)) {
-                    search_matches.push_back(m);
-                }
-            } break;
-            case SEARCH_TYPE_U32: {
-                uint32_t val = (uint32_t)std::strtoul(value_str, nullptr, 0);
-                if (compare_values<uint32_t>(cmp, m.curr_value.u32[0], val)) {
-                    search_matches.push_back(m);
-                }
-            } break;
-            case SEARCH_TYPE_U64: {
-                uint64_t val = (uint64_t)std::strtoull(value_str, nullptr, 0);
-                if (compare_values<uint64_t>(cmp, m.curr_value.u64, val)) {
-                    search_matches.push_back(m);
-                }
-            } break;
-            case SEARCH_TYPE_S8: {
-                int8_t val = (int8_t)std::strtol(value_str, nullptr, 0);
-                if (compare_values<int8_t>(cmp, m.curr_value.s8[0], val)) {
-                    search_matches.push_back(m);
-                }
-            } break;
-            case SEARCH_TYPE_S16: {
-                int16_t val = (int16_t)std::strtol(value_str, nullptr, 0);
-                if (compare_values<int16_t>(cmp, m.curr_value.s16[0], val)) {
-                    search_matches.push_back(m);
-                }
-            } break;
-            case SEARCH_TYPE_S32: {
-                int32_t val = (int32_t)std::strtol(value_str, nullptr, 0);
-                if (compare_values<int32_t>(cmp, m.curr_value.s32[0], val)) {
-                    search_matches.push_back(m);
-                }
-            } break;
-            case SEARCH_TYPE_S64: {
-                int64_t val = (int64_t)std::strtoll(value_str, nullptr, 0);
-                if (compare_values<int64_t>(cmp, m.curr_value.s64, val)) {
-                    search_matches.push_back(m);
-                }
-            } break;
-            case SEARCH_TYPE_F32: {
-                float val = std::strtof(value_str, nullptr);
-                if (compare_values<float>(cmp, m.curr_value.f32[0], val)) {
-                    search_matches.push_back(m);
-                }
-            } break;
-            case SEARCH_TYPE_F64: {
-                double val = std::strtod(value_str, nullptr);
-                if (compare_values<double>(cmp, m.curr_value.f64, val)) {
-                    search_matches.push_back(m);
-                }
-            } break;
-        }
-    }
+    return v.u64;
 }
 
-void filter_results(int type, int cmp, const char* value_str) {
-    // TODO
-    switch (type) {
-        case SEARCH_TYPE_U8: {
-            uint8_t val = (uint8_t)std::strtoul(value_str, nullptr, 0);
-
-            std::erase_if(search_matches, [cmp, val](const match& m) {
-                return !compare_values<uint8_t>(cmp, m.curr_value.u8[0], val);
-            });
-        } break;
-
-        case SEARCH_TYPE_U16: {
-            uint16_t val = (uint16_t)std::strtoul(value_str, nullptr, 0);
-
-            std::erase_if(search_matches, [cmp, val](const match& m) {
-                return !compare_values<uint16_t>(cmp, m.curr_value.u16[0], val);
-            });
-        } break;
-
-        case SEARCH_TYPE_U32: {
-            uint32_t val = (uint32_t)std::strtoul(value_str, nullptr, 0);
-
-            std::erase_if(search_matches, [cmp, val](const match& m) {
-                return !compare_values<uint32_t>(cmp, m.curr_value.u32[0], val);
-            });
-        } break;
-
-        case SEARCH_TYPE_U64: {
-            uint64_t val = (uint64_t)std::strtoull(value_str, nullptr, 0);
-
-            std::erase_if(search_matches, [cmp, val](const match& m) {
-                return !compare_values<uint64_t>(cmp, m.curr_value.u64, val);
-            });
-        } break;
-
-        case SEARCH_TYPE_S8: {
-            int8_t val = (int8_t)std::strtol(value_str, nullptr, 0);
-
-            std::erase_if(search_matches, [cmp, val](const match& m) {
-                return !compare_values<int8_t>(cmp, m.curr_value.s8[0], val);
-            });
-        } break;
-
-        case SEARCH_TYPE_S16: {
-            int16_t val = (int16_t)std::strtol(value_str, nullptr, 0);
-
-            std::erase_if(search_matches, [cmp, val](const match& m) {
-                return !compare_values<int16_t>(cmp, m.curr_value.s16[0], val);
-            });
-        } break;
-
-        case SEARCH_TYPE_S32: {
-            int32_t val = (int32_t)std::strtol(value_str, nullptr, 0);
-
-            std::erase_if(search_matches, [cmp, val](const match& m) {
-                return !compare_values<int32_t>(cmp, m.curr_value.s32[0], val);
-            });
-        } break;
-
-        case SEARCH_TYPE_S64: {
-            int64_t val = (int64_t)std::strtoll(value_str, nullptr, 0);
+// Search and comparison enums match the core's PS2_SEARCH_* values
+void search_memory(struct ps2_state* ps2, int cpu, int type, int cmp, const char* value_str, bool aligned) {
+    struct ps2_ram* mem = cpu == SEARCH_CPU_EE ? ps2->ee_ram : ps2->iop_ram;
 
-            std::erase_if(search_matches, [cmp, val](const match& m) {
-                return !compare_values<int64_t>(cmp, m.curr_value.s64, val);
-            });
-        } break;
+    if (!search)
+        search = ps2_search_create();
 
-        case SEARCH_TYPE_F32: {
-            float val = std::strtof(value_str, nullptr);
+    search_result_type = type;
+    search_result_cpu = cpu;
 
-            std::erase_if(search_matches, [cmp, val](const match& m) {
-                return !compare_values<float>(cmp, m.curr_value.f32[0], val);
-            });
-        } break;
+    ps2_search_scan(search, mem->buf, mem->size, type, cmp, parse_search_value(type, value_str), aligned);
+}
 
-        case SEARCH_TYPE_F64: {
-            double val = std::strtod(value_str, nullptr);
+void filter_results(struct ps2_state* ps2, int cmp, const char* value_str, bool against_prev) {
+    struct ps2_ram* mem = search_result_cpu == SEARCH_CPU_EE ? ps2->ee_ram : ps2->iop_ram;
 
-            std::erase_if(search_matches, [cmp, val](const match& m) {
-                return !compare_values<double>(cmp, m.curr_value.f64, val);
-            });
-        } break;
+    if (against_prev) {
+        ps2_search_filter_prev(search, mem->buf, cmp);
+    } else {
+        ps2_search_filter(search, mem->buf, cmp, parse_search_value(search_result_type, value_str));
     }
 }
 
+size_t search_match_count() {
+    return search ? ps2_search_count(search) : 0;
+}
+
 void write_match_value(struct ps2_state* ps2, int cpu, match& m, int type) {
     struct ps2_ram* mem = cpu == SEARCH_CPU_EE ? ps2->ee_ram : ps2->iop_ram;
 
@@ -494,27 +345,41 @@ void show_search_table(iris::instance* iris, struct ps2_state* ps2, int type, in
 
     static uint32_t selected_address = 0;
 
-    if (search_matches.empty()) {
+    size_t count = search_match_count();
+
+    if (!count) {
         SeparatorText("Search results");
     } else {
         char buf[256];
 
-        if (search_matches.size() > 9999) {
-            snprintf(buf, sizeof(buf), "Search results (9999+ matches)");
-        } else {
-            snprintf(buf, sizeof(buf), "Search results (%zu matches)", search_matches.size());
-        }
+        snprintf(buf, sizeof(buf), "Search results (%zu matches)", count);
 
         SeparatorText(buf);
     }
 
+    struct ps2_ram* mem = cpu == SEARCH_CPU_EE ? ps2->ee_ram : ps2->iop_ram;
+
     if (BeginTable("Matches", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingStretchProp)) {
         TableSetupColumn("Address");
         TableSetupColumn("Previous Value");
         TableSetupColumn("Current Value");
         TableHeadersRow();
 
-        for (match& m : search_matches) {
+        // Only visible rows are fetched from the search results
+        ImGuiListClipper clipper;
+
+        clipper.Begin(count);
+
+        while (clipper.Step()) for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            match m;
+
+            if (!ps2_search_get(search, row, &m.address, &m.prev_value.u64))
+                break;
+
+            m.curr_value.u64 = 0;
+
+            memcpy(&m.curr_value, &mem->buf[m.address], std::min<size_t>(8, mem->size - m.address));
+
             TableNextRow();
 
             TableSetColumnIndex(0);
@@ -800,6 +665,10 @@ void show_search_options(iris::instance* iris) {
         EndCombo();
     }
 
+    PushStyleVarY(ImGuiStyleVar_FramePadding, 2.0f);
+    Checkbox("Filter against previous value", &search_against_prev);
+    PopStyleVar();
+
     static char buf[64];
 
     Text("Value");
@@ -815,9 +684,9 @@ void show_search_options(iris::instance* iris) {
     } SameLine();
     EndDisabled();
 
-    BeginDisabled(buf[0] == '\0' || search_matches.empty());
+    BeginDisabled((buf[0] == '\0' && !search_against_prev) || !search_match_count());
     if (Button("Filter")) {
-        filter_results(search_type, search_cmp, buf);
+        filter_results(ps2, search_cmp, buf, search_against_prev);
     }
     EndDisabled();
 }
@@ -829,19 +698,12 @@ void update_search_matches(struct ps2_state* ps2, int cpu) {
         return;
     }
 
-    for (match& m : search_matches) {
-        struct ps2_ram* mem = m.cpu == SEARCH_CPU_EE ? ps2->ee_ram : ps2->iop_ram;
-
-        m.curr_value.u64 = *(uint64_t*)&mem->buf[m.address];
-    }
-
     for (match& m : address_list) {
         struct ps2_ram* mem = m.cpu == SEARCH_CPU_EE ? ps2->ee_ram : ps2->iop_ram;
 
         m.curr_value.u64 = *(uint64_t*)&mem->buf[m.address];
     }
 
-
     frame = 0;
 }
 
@@ -974,7 +836,7 @@ void show_memory_search(iris::instance* iris) {
         }
 
         if (BeginChild("##search_table", ImVec2(GetContentRegionAvail().x - 225, GetContentRegionAvail().y - 220))) {
-            show_search_table(iris, ps2, search_type, search_cpu);
+            show_search_table(iris, ps2, search_result_type, search_result_cpu);
         } EndChild(); SameLine();
 
         if (BeginChild("##search_options", ImVec2(0, GetContentRegionAvail().y - 220))) {
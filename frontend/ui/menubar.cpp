@@ -274,13 +274,9 @@ void show_main_menubar(iris::instance* iris) {
             if (BeginMenu(ICON_MS_MONITOR " Display")) {
                 if (BeginMenu(ICON_MS_BRUSH " Renderer")) {
                     for (int i = 0; i < 3; i++) {
-                        BeginDisabled(i == RENDERER_BACKEND_SOFTWARE);
-
                         if (MenuItem(renderer_names[i], nullptr, i == iris->renderer_backend)) {
                             render::switch_backend(iris, i);
                         }
-
-                        EndDisabled();
                     }
 
                     ImGui::EndMenu();
@@ -524,6 +520,20 @@ void show_main_menubar(iris::instance* iris) {
                 ImGui::EndMenu();
             }
 
+            if (BeginMenu(ICON_MS_SPEED " CDVD speed")) {
+                for (int i = 0; i < 5; i++) {
+                    char buf[16]; snprintf(buf, 16, "%dx", 1 << i);
+
+                    if (MenuItem(buf, nullptr, iris->cdvd_speed == (1 << i))) {
+                        iris->cdvd_speed = (1 << i);
+
+                        ps2_cdvd_set_fast_read(iris->ps2->cdvd, iris->cdvd_speed > 1 ? CDVD_FAST_READ_SECTORS : 0, iris->cdvd_speed);
+                    }
+                }
+
+                ImGui::EndMenu();
+            }
+
             if (MenuItem(ICON_MS_SKIP_NEXT " Skip FMVs", NULL, &iris->skip_fmv)) {
                 printf("Skip FMVs: %d\n", iris->skip_fmv);
                 ee_set_fmv_skip(iris->ps2->ee, iris->skip_fmv);
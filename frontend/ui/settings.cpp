@@ -366,13 +366,9 @@ void show_graphics_settings(iris::instance* iris) {
 
     if (BeginCombo("##renderer", settings_renderer_names[iris->renderer_backend], ImGuiComboFlags_HeightSmall)) {
         for (int i = 0; i < 3; i++) {
-            BeginDisabled(i == RENDERER_BACKEND_SOFTWARE);
-
             if (Selectable(settings_renderer_names[i], i == iris->renderer_backend)) {
                 render::switch_backend(iris, i);
             }
-
-            EndDisabled();
         }
 
         EndCombo();
@@ -909,6 +905,8 @@ void show_paths_settings(iris::instance* iris) {
     static char rom2_buf[512];
     static char nvram_buf[512];
     static char flash_buf[512];
+    static char hdd_buf[512];
+    static char hdd_overlay_buf[512];
 
     Text("BIOS (rom0)");
 
@@ -923,6 +921,8 @@ void show_paths_settings(iris::instance* iris) {
     const char* rom2_hint = iris->rom2_path.size() ? iris->rom2_path.c_str() : "Not configured";
     const char* nvram_hint = iris->nvram_path.size() ? iris->nvram_path.c_str() : "Not configured";
     const char* flash_hint = iris->flash_path.size() ? iris->flash_path.c_str() : "Not configured";
+    const char* hdd_hint = iris->hdd_path.size() ? iris->hdd_path.c_str() : "Not configured";
+    const char* hdd_overlay_hint = iris->hdd_overlay_path.size() ? iris->hdd_overlay_path.c_str() : "Not configured";
 
     SetNextItemWidth(300);
 
@@ -1126,18 +1126,94 @@ void show_paths_settings(iris::instance* iris) {
         memset(flash_buf, 0, 512);
     } 
 
+    Text("Hard disk image");
+
+    if (IsItemHovered()) {
+        hovered = true;
+
+        tooltip = ICON_MS_INFO " Raw or sparse HDD image, used as a read-only base when an overlay is configured";
+    }
+
+    SetNextItemWidth(300);
+
+    InputTextWithHint("##hdd", hdd_hint, hdd_buf, 512, ImGuiInputTextFlags_EscapeClearsAll);
+    SameLine();
+
+    if (Button(ICON_MS_FOLDER "##hdd")) {
+        audio::mute(iris);
+
+        auto f = pfd::open_file("Select HDD image", "", {
+            "HDD images (*.img; *.raw)", "*.img *.raw",
+            "All Files (*.*)", "*"
+        });
+
+        while (!f.ready());
+
+        audio::unmute(iris);
+
+        if (f.result().size()) {
+            strncpy(hdd_buf, f.result().at(0).c_str(), 512);
+        }
+    } SameLine();
+
+    if (Button(ICON_MS_CLEAR "##hdd")) {
+        iris->hdd_path = "";
+
+        memset(hdd_buf, 0, 512);
+    } 
+
+    Text("Hard disk overlay");
+
+    if (IsItemHovered()) {
+        hovered = true;
+
+        tooltip = ICON_MS_INFO " Writes go to this sparse image instead of the hard disk image, it will be created if it doesn't exist";
+    }
+
+    SetNextItemWidth(300);
+
+    InputTextWithHint("##hddovl", hdd_overlay_hint, hdd_overlay_buf, 512, ImGuiInputTextFlags_EscapeClearsAll);
+    SameLine();
+
+    if (Button(ICON_MS_FOLDER "##hddovl")) {
+        audio::mute(iris);
+
+        auto f = pfd::save_file("Select HDD overlay", "", {
+            "HDD images (*.img)", "*.img",
+            "All Files (*.*)", "*"
+        }, pfd::opt::force_overwrite);
+
+        while (!f.ready());
+
+        audio::unmute(iris);
+
+        if (f.result().size()) {
+            strncpy(hdd_overlay_buf, f.result().c_str(), 512);
+        }
+    } SameLine();
+
+    if (Button(ICON_MS_CLEAR "##hddovl")) {
+        iris->hdd_overlay_path = "";
+
+        memset(hdd_overlay_buf, 0, 512);
+    } 
+
     if (Button(ICON_MS_SAVE " Save")) {
         std::string bios_path = buf;
         std::string rom1_path = dvd_buf;
         std::string rom2_path = rom2_buf;
         std::string flash_path = flash_buf;
         std::string nvram_path = nvram_buf;
+        std::string hdd_path = hdd_buf;
+        std::string hdd_overlay_path = hdd_overlay_buf;
 
         if (bios_path.size()) iris->bios_path = bios_path;
         if (rom1_path.size()) iris->rom1_path = rom1_path;
         if (rom2_path.size()) iris->rom2_path = rom2_path;
         if (flash_path.size()) iris->flash_path = flash_path;
         if (nvram_path.size()) iris->nvram_path = nvram_path;
+        if (hdd_path.size()) iris->hdd_path = hdd_path;
+        if (hdd_overlay_path.size()) iris->hdd_overlay_path = hdd_overlay_path;
 
         saved = 1;
     } SameLine();
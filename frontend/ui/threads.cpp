@@ -3,6 +3,7 @@
 #include <cctype>
 #include <algorithm>
 #include <regex>
+#include <cstring>
 
 #include "iris.hpp"
 #include "ee/ee_def.hpp"
@@ -37,6 +38,17 @@ static const char* get_entry_symbol(iris::instance* iris, uint32_t addr) {
     return nullptr;
 }
 
+static const char* get_guest_string(iris::instance* iris, uint32_t addr) {
+    uint32_t size = 256;
+
+    const char* str = (const char*)ee_bus_get_span(iris->ps2->ee_bus, addr & 0x1fffffff, &size, 0);
+
+    if (!str || !memchr(str, 0, size))
+        return "<invalid>";
+
+    return str;
+}
+
 void show_thread_list(iris::instance* iris) {
     using namespace ImGui;
 
@@ -55,10 +67,15 @@ void show_thread_list(iris::instance* iris) {
         TableHeadersRow();
         PopFont();
 
-        struct ee_thread* thr = (struct ee_thread*)&iris->ps2->ee_ram->buf[ee->thread_list_base & 0x1fffffff];
+        uint32_t addr = ee->thread_list_base & 0x1fffffff;
+
+        struct ee_thread t;
+        struct ee_thread* thr = &t;
 
         int id = 0;
 
+        ee_bus_read_block(iris->ps2->ee_bus, addr, &t, sizeof(t));
+
         while (thr->status) {
             TableNextRow();
             TableSetColumnIndex(0);
@@ -75,18 +92,22 @@ void show_thread_list(iris::instance* iris) {
                 Text("0x%08X", thr->func);
             }
 
-            uint32_t argv = *(uint32_t*)&iris->ps2->ee_ram->buf[(thr->argv + 4) & 0x1fffffff];
+            uint32_t argv = 0;
+
+            ee_bus_read_block(iris->ps2->ee_bus, (thr->argv + 4) & 0x1fffffff, &argv, sizeof(argv));
 
             // if (thr->argc) {
             //     printf("argv=%08x *argv=%08x\n", thr->argv, argv);
             // }
 
             TableSetColumnIndex(3);
-            Text("%s", thr->argc ? (char*)&iris->ps2->ee_ram->buf[argv & 0x1fffffff] : "NULL");
+            Text("%s", thr->argc ? get_guest_string(iris, argv) : "NULL");
             TableSetColumnIndex(4);
             Text("%s", get_status_string(thr->status));
 
-            thr++;
+            addr += sizeof(struct ee_thread);
+
+            ee_bus_read_block(iris->ps2->ee_bus, addr, &t, sizeof(t));
         }
 
         EndTable();
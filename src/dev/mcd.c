@@ -1,4 +1,5 @@
 #include "mcd.h"
+#include "mcd_cache.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -6,11 +7,6 @@
 
 #define printf(fmt,...)(0)
 
-void mcd_flush_block(struct mcd_state* mcd, int addr, int size) {
-    fseek(mcd->file, addr, SEEK_SET);
-    fwrite(&mcd->buf[addr], 1, size, mcd->file);
-}
-
 void mcd_cmd_probe(struct ps2_sio2* sio2, struct mcd_state* mcd) {
     printf("mcd: mcd_cmd_probe\n");
 
@@ -142,15 +138,17 @@ void mcd_cmd_write_data(struct ps2_sio2* sio2, struct mcd_state* mcd) {
     queue_push(sio2->out, 0x2b);
     queue_push(sio2->out, mcd->term);
 
-    uint32_t addr = mcd->addr;
+    uint8_t data[256];
 
     for (int i = 0; i < size; i++) {
-        mcd->buf[mcd->addr++] = queue_at(sio2->in, 3 + i);
+        data[i] = queue_at(sio2->in, 3 + i);
 
         queue_push(sio2->out, 0);
     }
 
-    mcd_flush_block(mcd, addr, size);
+    mcd_cache_write(mcd->cache, mcd->addr, data, size);
+
+    mcd->addr += size;
 
     queue_push(sio2->out, 0);
     queue_push(sio2->out, mcd->term);
@@ -195,13 +193,13 @@ void mcd_cmd_erase_block(struct ps2_sio2* sio2, struct mcd_state* mcd) {
     queue_push(sio2->out, 0x2b);
     queue_push(sio2->out, mcd->term);
 
-    uint32_t addr = mcd->addr;
+    uint8_t data[MCD_SECTOR_SIZE * 16];
 
-    for (int i = 0; i < MCD_SECTOR_SIZE * 16; i++) {
-        mcd->buf[mcd->addr++] = 0xff;
-    }
+    memset(data, 0xff, sizeof(data));
+
+    mcd_cache_write(mcd->cache, mcd->addr, data, sizeof(data));
 
-    mcd_flush_block(mcd, addr, MCD_SECTOR_SIZE * 16);
+    mcd->addr += sizeof(data);
 }
 void mcd_cmd_auth_f0(struct ps2_sio2* sio2, struct mcd_state* mcd) {
     printf("mcd: mcd_cmd_auth_f0\n");
@@ -340,6 +338,9 @@ void mcd_handle_command(struct ps2_sio2* sio2, void* udata, int cmd) {
 }
 
 struct mcd_state* mcd_attach(struct ps2_sio2* sio2, int port, const char* path) {
+    // Finish any flush that was interrupted last time
+    mcd_cache_recover(path);
+
     FILE* file = fopen(path, "r+b");
 
     if (!file)
@@ -363,7 +364,7 @@ struct mcd_state* mcd_attach(struct ps2_sio2* sio2, int port, const char* path)
 
     // Init card state
     mcd->term = 0x55;
-    mcd->file = file;
+    mcd->cache = mcd_cache_create(file, path, mcd->buf, mcd->buf_size, MCD_SECTOR_SIZE, MCD_CACHE_FLUSH_INTERVAL);
     mcd->size = (1 << (31 - __builtin_clz(mcd->buf_size))) >> 9;
 
     mcd->checksum = 0x02 ^ 0x10;
@@ -389,11 +390,9 @@ struct mcd_state* mcd_attach(struct ps2_sio2* sio2, int port, const char* path)
 void mcd_detach(void* udata) {
     struct mcd_state* mcd = (struct mcd_state*)udata;
 
-    // Flush buffer back to file
-    fseek(mcd->file, 0, SEEK_SET);
-    fwrite(mcd->buf, 1, mcd->buf_size, mcd->file);
+    // Flushes pending writes and closes the file
+    mcd_cache_destroy(mcd->cache);
 
-    fclose(mcd->file);
     free(mcd->buf);
     free(mcd);
 }
\ No newline at end of file
@@ -35,7 +35,7 @@ struct mcd_state {
     uint32_t buf_size;
     uint8_t* buf;
 
-    FILE* file;
+    struct mcd_cache* cache;
 };
 
 struct mcd_state* mcd_attach(struct ps2_sio2* sio2, int port, const char* path);
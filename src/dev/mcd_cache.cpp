@@ -0,0 +1,317 @@
+#include <condition_variable>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <mutex>
+
+#ifdef _WIN32
+#include <io.h>
+#define fsync _commit
+#else
+#include <unistd.h>
+#endif
+
+#include "mcd_cache.h"
+
+// Flushes go through a small journal next to the card image. Dirty pages
+// are first written to the journal and committed with a trailer, only then
+// they're patched into the card image and the journal is removed. If we
+// crash before the trailer hits the disk the image is still untouched, if
+// we crash after it the journal gets replayed on the next attach.
+#define MCD_JOURNAL_RECORD 0x4443524d // "MRCD"
+#define MCD_JOURNAL_COMMIT 0x4d4d434d // "MCMM"
+
+struct mcd_cache_run {
+    uint32_t offset;
+    uint32_t size;
+};
+
+struct mcd_cache {
+    FILE* file;
+    std::string journal_path;
+
+    uint8_t* buf;
+    uint32_t size;
+    uint32_t page_size;
+
+    std::vector <uint64_t> dirty;
+    bool pending = false;
+    bool end = false;
+
+    std::mutex mtx;
+    std::mutex flush_mtx;
+    std::condition_variable cv;
+    std::chrono::milliseconds interval;
+    std::thread flush_thr;
+};
+
+static inline uint32_t mcd_cache_hash(uint32_t hash, const void* data, size_t size) {
+    const uint8_t* p = (const uint8_t*)data;
+
+    // FNV-1a
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= 0x01000193;
+    }
+
+    return hash;
+}
+
+static inline void mcd_cache_sync(FILE* file) {
+    fflush(file);
+    fsync(fileno(file));
+}
+
+static bool mcd_cache_write_journal(struct mcd_cache* cache, const std::vector <mcd_cache_run>& runs, const std::vector <uint8_t>& data) {
+    FILE* file = fopen(cache->journal_path.c_str(), "wb");
+
+    if (!file)
+        return false;
+
+    uint32_t hash = 0x811c9dc5;
+    const uint8_t* p = data.data();
+    bool ok = true;
+
+    for (const mcd_cache_run& run : runs) {
+        uint32_t hdr[3] = { MCD_JOURNAL_RECORD, run.offset, run.size };
+
+        hash = mcd_cache_hash(hash, hdr, sizeof(hdr));
+        hash = mcd_cache_hash(hash, p, run.size);
+
+        ok = ok && fwrite(hdr, sizeof(hdr), 1, file) == 1;
+        ok = ok && fwrite(p, 1, run.size, file) == run.size;
+
+        p += run.size;
+    }
+
+    // Make sure every record is on disk before committing
+    mcd_cache_sync(file);
+
+    uint32_t trailer[3] = { MCD_JOURNAL_COMMIT, (uint32_t)runs.size(), hash };
+
+    ok = ok && fwrite(trailer, sizeof(trailer), 1, file) == 1;
+
+    mcd_cache_sync(file);
+    fclose(file);
+
+    return ok;
+}
+
+static void mcd_cache_do_flush(struct mcd_cache* cache) {
+    std::lock_guard <std::mutex> flush_lock(cache->flush_mtx);
+
+    std::vector <mcd_cache_run> runs;
+    std::vector <uint8_t> data;
+
+    // Snapshot dirty pages, adjacent pages are coalesced into a single run
+    {
+        std::lock_guard <std::mutex> lock(cache->mtx);
+
+        if (!cache->pending)
+            return;
+
+        uint32_t pages = (cache->size + cache->page_size - 1) / cache->page_size;
+        uint32_t page = 0;
+
+        while (page < pages) {
+            if (!(cache->dirty[page >> 6] & (1ull << (page & 63)))) {
+                page++;
+
+                continue;
+            }
+
+            uint32_t first = page;
+
+            while (page < pages && (cache->dirty[page >> 6] & (1ull << (page & 63)))) {
+                cache->dirty[page >> 6] &= ~(1ull << (page & 63));
+
+                page++;
+            }
+
+            uint32_t offset = first * cache->page_size;
+            uint32_t end = page * cache->page_size;
+
+            if (end > cache->size)
+                end = cache->size;
+
+            runs.push_back({ offset, end - offset });
+            data.insert(data.end(), cache->buf + offset, cache->buf + end);
+        }
+
+        cache->pending = false;
+    }
+
+    if (!mcd_cache_write_journal(cache, runs, data)) {
+        fprintf(stderr, "mcd: Couldn't write journal \'%s\', writing card image directly\n", cache->journal_path.c_str());
+    }
+
+    const uint8_t* p = data.data();
+
+    for (const mcd_cache_run& run : runs) {
+        fseek(cache->file, run.offset, SEEK_SET);
+        fwrite(p, 1, run.size, cache->file);
+
+        p += run.size;
+    }
+
+    mcd_cache_sync(cache->file);
+
+    remove(cache->journal_path.c_str());
+}
+
+static void mcd_cache_flush_thread(struct mcd_cache* cache) {
+    while (true) {
+        bool end;
+
+        {
+            std::unique_lock <std::mutex> lock(cache->mtx);
+
+            cache->cv.wait_for(lock, cache->interval, [cache] { return cache->end; });
+
+            end = cache->end;
+        }
+
+        mcd_cache_do_flush(cache);
+
+        if (end)
+            return;
+    }
+}
+
+extern "C" void mcd_cache_recover(const char* path) {
+    std::string journal_path = std::string(path) + ".journal";
+
+    FILE* file = fopen(journal_path.c_str(), "rb");
+
+    if (!file)
+        return;
+
+    std::vector <uint8_t> journal;
+
+    fseek(file, 0, SEEK_END);
+
+    journal.resize(ftell(file));
+
+    fseek(file, 0, SEEK_SET);
+
+    size_t journal_size = fread(journal.data(), 1, journal.size(), file);
+
+    fclose(file);
+
+    // Validate the whole journal before touching the image, a journal
+    // without a matching trailer was never committed and is discarded
+    std::vector <mcd_cache_run> runs;
+    std::vector <size_t> offsets;
+
+    uint32_t hash = 0x811c9dc5;
+    size_t pos = 0;
+    bool committed = false;
+
+    while (pos + 12 <= journal_size) {
+        uint32_t hdr[3];
+
+        memcpy(hdr, &journal[pos], sizeof(hdr));
+
+        if (hdr[0] == MCD_JOURNAL_COMMIT) {
+            committed = hdr[1] == runs.size() && hdr[2] == hash;
+
+            break;
+        }
+
+        if (hdr[0] != MCD_JOURNAL_RECORD || pos + 12 + hdr[2] > journal_size)
+            break;
+
+        hash = mcd_cache_hash(hash, hdr, sizeof(hdr));
+        hash = mcd_cache_hash(hash, &journal[pos + 12], hdr[2]);
+
+        runs.push_back({ hdr[1], hdr[2] });
+        offsets.push_back(pos + 12);
+
+        pos += 12 + hdr[2];
+    }
+
+    if (committed) {
+        FILE* image = fopen(path, "r+b");
+
+        if (!image) {
+            fprintf(stderr, "mcd: Couldn't open \'%s\' to replay journal\n", path);
+
+            return;
+        }
+
+        for (size_t i = 0; i < runs.size(); i++) {
+            fseek(image, runs[i].offset, SEEK_SET);
+            fwrite(&journal[offsets[i]], 1, runs[i].size, image);
+        }
+
+        mcd_cache_sync(image);
+        fclose(image);
+    }
+
+    remove(journal_path.c_str());
+}
+
+extern "C" struct mcd_cache* mcd_cache_create(FILE* file, const char* path, uint8_t* buf, uint32_t size, uint32_t page_size, int interval) {
+    struct mcd_cache* cache = new mcd_cache;
+
+    uint32_t pages = (size + page_size - 1) / page_size;
+
+    cache->file = file;
+    cache->journal_path = std::string(path) + ".journal";
+    cache->buf = buf;
+    cache->size = size;
+    cache->page_size = page_size;
+    cache->dirty.resize((pages + 63) / 64);
+    cache->interval = std::chrono::milliseconds(interval);
+    cache->flush_thr = std::thread(mcd_cache_flush_thread, cache);
+
+    return cache;
+}
+
+extern "C" void mcd_cache_write(struct mcd_cache* cache, uint32_t addr, const uint8_t* data, uint32_t size) {
+    if (addr >= cache->size)
+        return;
+
+    if (size > cache->size - addr)
+        size = cache->size - addr;
+
+    if (!size)
+        return;
+
+    std::lock_guard <std::mutex> lock(cache->mtx);
+
+    memcpy(cache->buf + addr, data, size);
+
+    uint32_t first = addr / cache->page_size;
+    uint32_t last = (addr + size - 1) / cache->page_size;
+
+    for (uint32_t page = first; page <= last; page++)
+        cache->dirty[page >> 6] |= 1ull << (page & 63);
+
+    cache->pending = true;
+}
+
+extern "C" void mcd_cache_flush(struct mcd_cache* cache) {
+    mcd_cache_do_flush(cache);
+}
+
+extern "C" void mcd_cache_destroy(struct mcd_cache* cache) {
+    {
+        std::lock_guard <std::mutex> lock(cache->mtx);
+
+        cache->end = true;
+    }
+
+    cache->cv.notify_one();
+
+    // The flush thread does a final flush before exiting
+    cache->flush_thr.join();
+
+    fclose(cache->file);
+
+    delete cache;
+}
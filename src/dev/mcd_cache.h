@@ -0,0 +1,31 @@
+#ifndef MCD_CACHE_H
+#define MCD_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Default delay between background flushes
+#define MCD_CACHE_FLUSH_INTERVAL 1000
+
+struct mcd_cache;
+
+// Replays a committed journal left behind by an interrupted flush, must
+// be called before the card image is read
+void mcd_cache_recover(const char* path);
+
+// Takes ownership of the card file, buf stays owned by the caller and
+// must only be modified through mcd_cache_write
+struct mcd_cache* mcd_cache_create(FILE* file, const char* path, uint8_t* buf, uint32_t size, uint32_t page_size, int interval);
+void mcd_cache_write(struct mcd_cache* cache, uint32_t addr, const uint8_t* data, uint32_t size);
+void mcd_cache_flush(struct mcd_cache* cache);
+void mcd_cache_destroy(struct mcd_cache* cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
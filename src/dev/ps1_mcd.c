@@ -1,4 +1,5 @@
 #include "ps1_mcd.h"
+#include "mcd_cache.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -6,11 +7,6 @@
 
 #define printf(fmt,...)(0)
 
-void ps1_mcd_flush_block(struct ps1_mcd_state* mcd, int addr) {
-    fseek(mcd->file, addr, SEEK_SET);
-    fwrite(&mcd->buf[addr], 1, 128, mcd->file);
-}
-
 /*
   Send Reply Comment
   81h  N/A   Memory card address
@@ -87,13 +83,15 @@ void ps1_mcd_cmd_write(struct ps2_sio2* sio2, struct ps1_mcd_state* mcd) {
     queue_push(sio2->out, 0x00);
     queue_push(sio2->out, msb); // (pre)
 
+    uint8_t data[PS1_MCD_SECTOR_SIZE];
+
     for (int i = 0; i < 128; i++) {
-        mcd->buf[addr+i] = queue_at(sio2->in, 6+i);
+        data[i] = queue_at(sio2->in, 6+i);
 
         queue_push(sio2->out, queue_at(sio2->in, 5+i)); // (pre)
     }
 
-    ps1_mcd_flush_block(mcd, addr);
+    mcd_cache_write(mcd->cache, addr, data, PS1_MCD_SECTOR_SIZE);
 
     queue_push(sio2->out, queue_at(sio2->in, 133)); // (pre)
     queue_push(sio2->out, 0x5c);
@@ -153,6 +151,9 @@ void ps1_mcd_set_type(struct ps1_mcd_state* mcd, int type) {
 }
 
 struct ps1_mcd_state* ps1_mcd_attach(struct ps2_sio2* sio2, int port, const char* path) {
+    // Finish any flush that was interrupted last time
+    mcd_cache_recover(path);
+
     FILE* file = fopen(path, "r+b");
 
     if (!file)
@@ -163,11 +164,12 @@ struct ps1_mcd_state* ps1_mcd_attach(struct ps2_sio2* sio2, int port, const char
 
     memset(mcd, 0, sizeof(struct ps1_mcd_state));
 
-    mcd->file = file;
     mcd->flag = 0x08;
 
     fread(mcd->buf, 1, PS1_MCD_SIZE, file);
 
+    mcd->cache = mcd_cache_create(file, path, mcd->buf, PS1_MCD_SIZE, PS1_MCD_SECTOR_SIZE, MCD_CACHE_FLUSH_INTERVAL);
+
     printf("ps1_mcd: Memory card at \'%s\' initialized.\n",
         path
     );
@@ -184,10 +186,8 @@ struct ps1_mcd_state* ps1_mcd_attach(struct ps2_sio2* sio2, int port, const char
 void ps1_mcd_detach(void* udata) {
     struct ps1_mcd_state* mcd = (struct ps1_mcd_state*)udata;
 
-    // Flush buffer back to file
-    fseek(mcd->file, 0, SEEK_SET);
-    fwrite(mcd->buf, 1, PS1_MCD_SIZE, mcd->file);
+    // Flushes pending writes and closes the file
+    mcd_cache_destroy(mcd->cache);
 
-    fclose(mcd->file);
     free(mcd);
 }
\ No newline at end of file
@@ -20,7 +20,7 @@ struct ps1_mcd_state {
     uint8_t flag;
     int type;
 
-    FILE* file;
+    struct mcd_cache* cache;
 };
 
 struct ps1_mcd_state* ps1_mcd_attach(struct ps2_sio2* sio2, int port, const char* path);
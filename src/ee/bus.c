@@ -43,6 +43,84 @@ void ee_bus_init_fastmem(struct ee_bus* bus, int ee_ram_size, int iop_ram_size)
     }
 }
 
+// Get a host pointer to the memory backing a physical address range.
+// On return *size is clamped to the part of the range that is contiguous
+// in host memory. If addr isn't backed by RAM or ROM, NULL is returned
+// and *size is clamped to the end of the current fastmem block, so the
+// caller can go through the regular bus functions for that part
+void* ee_bus_get_span(void* udata, uint32_t addr, uint32_t* size, int write) {
+    struct ee_bus* bus = (struct ee_bus*)udata;
+
+    void** table = write ? bus->fastmem_w_table : bus->fastmem_r_table;
+
+    addr &= 0x1fffffff;
+
+    uint32_t block = addr >> 13;
+    uint32_t offset = addr & 0x1fff;
+    uint32_t len = 0x2000 - offset;
+    uint8_t* base = (uint8_t*)table[block];
+
+    if (!base) {
+        if (*size > len)
+            *size = len;
+
+        return NULL;
+    }
+
+    // Merge following blocks while they're contiguous on the host side
+    for (uint32_t i = 1; (len < *size) && ((block + i) < 0x10000); i++) {
+        if (table[block + i] != (base + (i * 0x2000)))
+            break;
+
+        len += 0x2000;
+    }
+
+    if (*size > len)
+        *size = len;
+
+    return base + offset;
+}
+
+void ee_bus_read_block(void* udata, uint32_t addr, void* buf, uint32_t size) {
+    uint8_t* dst = (uint8_t*)buf;
+
+    while (size) {
+        uint32_t len = size;
+        uint8_t* ptr = (uint8_t*)ee_bus_get_span(udata, addr, &len, 0);
+
+        if (ptr) {
+            memcpy(dst, ptr, len);
+        } else {
+            for (uint32_t i = 0; i < len; i++)
+                dst[i] = ee_bus_read8(udata, addr + i);
+        }
+
+        addr += len;
+        dst += len;
+        size -= len;
+    }
+}
+
+void ee_bus_write_block(void* udata, uint32_t addr, const void* buf, uint32_t size) {
+    const uint8_t* src = (const uint8_t*)buf;
+
+    while (size) {
+        uint32_t len = size;
+        uint8_t* ptr = (uint8_t*)ee_bus_get_span(udata, addr, &len, 1);
+
+        if (ptr) {
+            memcpy(ptr, src, len);
+        } else {
+            for (uint32_t i = 0; i < len; i++)
+                ee_bus_write8(udata, addr + i, src[i]);
+        }
+
+        addr += len;
+        src += len;
+        size -= len;
+    }
+}
+
 void ee_bus_init_bios(struct ee_bus* bus, struct ps2_bios* bios) {
     bus->bios = bios;
 }
@@ -24,6 +24,11 @@ void ee_bus_write32(void* udata, uint32_t addr, uint64_t data);
 void ee_bus_write64(void* udata, uint32_t addr, uint64_t data);
 void ee_bus_write128(void* udata, uint32_t addr, uint128_t data);
 
+// Bulk access for host-side copies (HLE, loaders, debugger)
+void* ee_bus_get_span(void* udata, uint32_t addr, uint32_t* size, int write);
+void ee_bus_read_block(void* udata, uint32_t addr, void* buf, uint32_t size);
+void ee_bus_write_block(void* udata, uint32_t addr, const void* buf, uint32_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,6 +28,138 @@ static inline void dmac_write_qword(struct ps2_dmac* dmac, uint32_t addr, int me
     ps2_ram_write128(dmac->spr, addr & 0x3ff0, value);
 }
 
+// Resolve up to *qwc qwords at addr to a host pointer. *qwc is clamped
+// to the part of the range that's contiguous in host memory, SPR spans
+// stop at the end of SPR. If the range isn't backed by memory (MMIO),
+// NULL is returned and the caller has to go through dmac_read_qword or
+// dmac_write_qword for those *qwc qwords instead
+static inline uint128_t* dmac_get_span(struct ps2_dmac* dmac, uint32_t addr, int mem, uint32_t* qwc, int write) {
+    if (mem || (addr & 0x80000000)) {
+        uint32_t offset = addr & 0x3ff0;
+        uint32_t len = (0x4000 - offset) >> 4;
+
+        if (*qwc > len)
+            *qwc = len;
+
+        return (uint128_t*)(dmac->spr->buf + offset);
+    }
+
+    uint32_t size = *qwc << 4;
+
+    uint128_t* ptr = ee_bus_get_span(dmac->bus, addr & 0xfffffff0, &size, write);
+
+    *qwc = size >> 4;
+
+    return ptr;
+}
+
+// Send qwc qwords starting at addr to a FIFO. Memory is handed to the
+// FIFO a span at a time, MMIO sources are read one qword at a time.
+// Returns the address following the last qword sent
+static inline uint32_t dmac_send_qwords(struct ps2_dmac* dmac, uint32_t addr, uint32_t qwc, void (*send)(struct ps2_dmac*, const uint128_t*, uint32_t)) {
+    while (qwc) {
+        uint32_t len = qwc;
+
+        const uint128_t* ptr = dmac_get_span(dmac, addr, 0, &len, 0);
+
+        if (ptr) {
+            send(dmac, ptr, len);
+        } else {
+            for (uint32_t i = 0; i < len; i++) {
+                uint128_t q = dmac_read_qword(dmac, addr + (i << 4));
+
+                send(dmac, &q, 1);
+            }
+        }
+
+        addr += len << 4;
+        qwc -= len;
+    }
+
+    return addr;
+}
+
+static void dmac_send_vif0(struct ps2_dmac* dmac, const uint128_t* data, uint32_t qwc) {
+    ps2_vif_fifo_write_block(dmac->bus->vif0, data, qwc);
+}
+
+static void dmac_send_vif1(struct ps2_dmac* dmac, const uint128_t* data, uint32_t qwc) {
+    ps2_vif_fifo_write_block(dmac->bus->vif1, data, qwc);
+}
+
+static void dmac_send_gif(struct ps2_dmac* dmac, const uint128_t* data, uint32_t qwc) {
+    ps2_gif_fifo_write_block(dmac->bus->gif, data, qwc, GIF_PATH3);
+}
+
+static void dmac_send_sif1(struct ps2_dmac* dmac, const uint128_t* data, uint32_t qwc) {
+    ps2_sif1_write_block(dmac->sif, data, qwc);
+}
+
+// Write qwc qwords to memory starting at addr, a span at a time.
+// Returns the address following the last qword written
+static inline uint32_t dmac_write_qwords(struct ps2_dmac* dmac, uint32_t addr, const void* data, uint32_t qwc) {
+    const uint8_t* src = (const uint8_t*)data;
+
+    while (qwc) {
+        uint32_t len = qwc;
+
+        uint128_t* ptr = dmac_get_span(dmac, addr, 0, &len, 1);
+
+        if (ptr) {
+            memcpy(ptr, src, len << 4);
+        } else {
+            for (uint32_t i = 0; i < len; i++) {
+                uint128_t q;
+
+                memcpy(&q, src + (i << 4), sizeof(uint128_t));
+
+                dmac_write_qword(dmac, addr + (i << 4), 0, q);
+            }
+        }
+
+        addr += len << 4;
+        src += len << 4;
+        qwc -= len;
+    }
+
+    return addr;
+}
+
+// Copy qwc qwords between memory at *madr and SPR at *sadr, the SPR
+// address wraps around at 16 KiB. Both addresses are advanced past the
+// copied data
+static inline void dmac_copy_spr(struct ps2_dmac* dmac, uint32_t* madr, uint32_t* sadr, uint32_t qwc, int to_spr) {
+    while (qwc) {
+        uint32_t len = (0x4000 - (*sadr & 0x3ff0)) >> 4;
+
+        if (len > qwc)
+            len = qwc;
+
+        uint128_t* spr = (uint128_t*)(dmac->spr->buf + (*sadr & 0x3ff0));
+        uint128_t* mem = dmac_get_span(dmac, *madr, 0, &len, !to_spr);
+
+        if (mem) {
+            if (to_spr) {
+                memmove(spr, mem, len << 4);
+            } else {
+                memmove(mem, spr, len << 4);
+            }
+        } else {
+            for (uint32_t i = 0; i < len; i++) {
+                if (to_spr) {
+                    spr[i] = dmac_read_qword(dmac, *madr + (i << 4));
+                } else {
+                    dmac_write_qword(dmac, *madr + (i << 4), 0, spr[i]);
+                }
+            }
+        }
+
+        *madr += len << 4;
+        *sadr = (*sadr + (len << 4)) & 0x3ff0;
+        qwc -= len;
+    }
+}
+
 struct ps2_dmac* ps2_dmac_create(void) {
     return malloc(sizeof(struct ps2_dmac));
 }
@@ -275,14 +407,7 @@ void dmac_handle_vif0_transfer(struct ps2_dmac* dmac) {
 
     int mode = (dmac->vif0.chcr >> 2) & 3;
 
-    for (int i = 0; i < dmac->vif0.qwc; i++) {
-        uint128_t q = dmac_read_qword(dmac, dmac->vif0.madr);
-
-        // VIF0 FIFO address
-        ee_bus_write128(dmac->bus, 0x10004000, q);
-
-        dmac->vif0.madr += 16;
-    }
+    dmac->vif0.madr = dmac_send_qwords(dmac, dmac->vif0.madr, dmac->vif0.qwc, dmac_send_vif0);
 
     if (mode == 0) {
         dmac->vif0.chcr &= ~0x100;
@@ -313,18 +438,7 @@ void dmac_handle_vif0_transfer(struct ps2_dmac* dmac) {
             ee_bus_write32(dmac->bus, 0x10004000, dmac->vif0.tag.data >> 32);
         }
 
-        for (int i = 0; i < dmac->vif0.qwc; i++) {
-            uint128_t q = dmac_read_qword(dmac, dmac->vif0.madr);
-
-            // printf("ee: Sending %016lx%016lx from %08x to VIF0 FIFO\n",
-            //     q.u64[1], q.u64[0],
-            //     dmac->vif0.madr
-            // );
-
-            ee_bus_write128(dmac->bus, 0x10004000, q);
-
-            dmac->vif0.madr += 16;
-        }
+        dmac->vif0.madr = dmac_send_qwords(dmac, dmac->vif0.madr, dmac->vif0.qwc, dmac_send_vif0);
 
         if (dmac->vif0.tag.id == 1) {
             dmac->vif0.tadr = dmac->vif0.madr;
@@ -351,20 +465,8 @@ void dmac_send_vif1_irq(void* udata, int overshoot) {
 void mfifo_handle_ref_tag(struct ps2_dmac* dmac) {
     struct dmac_channel* c = dmac->mfifo_drain;
 
-    while (c->qwc) {
-        uint128_t q = dmac_read_qword(dmac, c->madr);
-
-        if (c == &dmac->vif1) {
-            // VIF1 FIFO
-            ee_bus_write128(dmac->bus, 0x10005000, q);
-        } else {
-            // GIF FIFO
-            ps2_gif_fifo_write(dmac->bus->gif, q, GIF_PATH3);
-        }
-
-        c->madr += 16;
-        c->qwc--;
-    }
+    c->madr = dmac_send_qwords(dmac, c->madr, c->qwc, c == &dmac->vif1 ? dmac_send_vif1 : dmac_send_gif);
+    c->qwc = 0;
 
     if (channel_is_done(c)) {
         // fprintf(stdout, "dmac: mfifo channel done end=%d tte-irq=%d\n", c->tag.end, c->tag.irq && (c->chcr & 0x80));
@@ -514,17 +616,7 @@ void dmac_handle_vif1_transfer(struct ps2_dmac* dmac) {
         return;
     }
 
-    for (int i = 0; i < dmac->vif1.qwc; i++) {
-        uint128_t q = dmac_read_qword(dmac, dmac->vif1.madr);
-
-        // VIF1 FIFO address
-        ee_bus_write32(dmac->bus, 0x10005000, q.u32[0]);
-        ee_bus_write32(dmac->bus, 0x10005000, q.u32[1]);
-        ee_bus_write32(dmac->bus, 0x10005000, q.u32[2]);
-        ee_bus_write32(dmac->bus, 0x10005000, q.u32[3]);
-
-        dmac->vif1.madr += 16;
-    }
+    dmac->vif1.madr = dmac_send_qwords(dmac, dmac->vif1.madr, dmac->vif1.qwc, dmac_send_vif1);
 
     dmac->vif1.qwc = 0;
 
@@ -558,16 +650,7 @@ void dmac_handle_vif1_transfer(struct ps2_dmac* dmac) {
             ee_bus_write32(dmac->bus, 0x10005000, dmac->vif1.tag.data >> 32);
         }
 
-        for (int i = 0; i < dmac->vif1.qwc; i++) {
-            uint128_t q = dmac_read_qword(dmac, dmac->vif1.madr);
-
-            ee_bus_write32(dmac->bus, 0x10005000, q.u32[0]);
-            ee_bus_write32(dmac->bus, 0x10005000, q.u32[1]);
-            ee_bus_write32(dmac->bus, 0x10005000, q.u32[2]);
-            ee_bus_write32(dmac->bus, 0x10005000, q.u32[3]);
-
-            dmac->vif1.madr += 16;
-        }
+        dmac->vif1.madr = dmac_send_qwords(dmac, dmac->vif1.madr, dmac->vif1.qwc, dmac_send_vif1);
 
         if (dmac->vif1.tag.id == 1) {
             dmac->vif1.tadr = dmac->vif1.madr;
@@ -628,19 +711,7 @@ void dmac_handle_gif_transfer(struct ps2_dmac* dmac) {
     //     dmac->gif.tadr
     // );
 
-    for (int i = 0; i < dmac->gif.qwc; i++) {
-        uint128_t q = dmac_read_qword(dmac, dmac->gif.madr);
-
-        // fprintf(file, "ee: Sending %016lx%016lx from %08x to GIF FIFO (burst)\n",
-        //     q.u64[1], q.u64[0],
-        //     dmac->gif.madr
-        // );
-
-        // GIF FIFO address
-        ps2_gif_fifo_write(dmac->bus->gif, q, GIF_PATH3);
-
-        dmac->gif.madr += 16;
-    }
+    dmac->gif.madr = dmac_send_qwords(dmac, dmac->gif.madr, dmac->gif.qwc, dmac_send_gif);
 
     if (dmac->gif.tag.end) {
         return;
@@ -660,18 +731,7 @@ void dmac_handle_gif_transfer(struct ps2_dmac* dmac) {
 
         // printf("ee: gif tag qwc=%08x madr=%08x tadr=%08x mem=%d\n", dmac->gif.qwc, dmac->gif.madr, dmac->gif.tadr, dmac->gif.tag.mem);
 
-        for (int i = 0; i < dmac->gif.qwc; i++) {
-            uint128_t q = dmac_read_qword(dmac, dmac->gif.madr);
-
-            // fprintf(file, "ee: Sending %016lx%016lx from %08x to GIF FIFO (chain)\n",
-            //     q.u64[1], q.u64[0],
-            //     dmac->gif.madr
-            // );
-
-            ps2_gif_fifo_write(dmac->bus->gif, q, GIF_PATH3);
-
-            dmac->gif.madr += 16;
-        }
+        dmac->gif.madr = dmac_send_qwords(dmac, dmac->gif.madr, dmac->gif.qwc, dmac_send_gif);
 
         if (dmac->gif.tag.id == 1) {
             dmac->gif.tadr = dmac->gif.madr;
@@ -802,6 +862,34 @@ void dmac_handle_ipu_to_transfer(struct ps2_dmac* dmac) {
         // Keep transferring until we run out of QWC or DREQ is cleared
     }
 }
+int dmac_sif0_direct(struct ps2_dmac* dmac, uint128_t tag, const void* data, uint32_t qwc) {
+    if (!(dmac->sif0.chcr & 0x100) || !ps2_sif0_is_empty(dmac->sif))
+        return 0;
+
+    if (TAG_QWC(tag) != qwc)
+        return 0;
+
+    dmac_process_dest_tag(dmac, &dmac->sif0, tag);
+
+    dmac->sif0.madr = dmac_write_qwords(dmac, dmac->sif0.madr, data, qwc);
+
+    // Keep what the FIFO returns on underflow consistent
+    if (qwc) {
+        memcpy(&dmac->sif->sif0.last, (const uint8_t*)data + ((qwc - 1) << 4), sizeof(uint128_t));
+    } else {
+        dmac->sif->sif0.last = tag;
+    }
+
+    if (channel_is_done(&dmac->sif0)) {
+        dmac->sif0.chcr &= ~0x100;
+        dmac->sif0.qwc = 0;
+
+        dmac_set_irq(dmac, DMAC_SIF0);
+    }
+
+    return 1;
+}
+
 void dmac_handle_sif0_transfer(struct ps2_dmac* dmac) {
     // SIF FIFO is empty, keep waiting
     if (ps2_sif0_is_empty(dmac->sif)) {
@@ -838,8 +926,12 @@ void dmac_handle_sif0_transfer(struct ps2_dmac* dmac) {
         //     dmac->sif0.chcr
         // );
 
-        for (int i = 0; i < dmac->sif0.qwc; i++) {
-            if (ps2_sif0_is_empty(dmac->sif)) {
+        uint32_t qwc = dmac->sif0.qwc;
+
+        while (qwc) {
+            uint32_t size = ps2_sif0_size(dmac->sif);
+
+            if (!size) {
                 printf("dmac: qwc != 0 FIFO empty\n");
 
                 if (channel_is_done(&dmac->sif0)) {
@@ -854,27 +946,21 @@ void dmac_handle_sif0_transfer(struct ps2_dmac* dmac) {
                 }
             }
 
-            uint128_t q = ps2_sif0_read(dmac->sif);
-
-            // printf("%08x: ", dmac->sif0.madr);
+            // Read straight into EE memory, stopping where the FIFO runs
+            // out so the check above happens at the same point
+            uint32_t len = (size && (size < qwc)) ? size : qwc;
 
-            // for (int i = 0; i < 16; i++) {
-            //     printf("%02x ", q.u8[i]);
-            // }
+            uint128_t* ptr = dmac_get_span(dmac, dmac->sif0.madr, 0, &len, 1);
 
-            // putchar('|');
-
-            // for (int i = 0; i < 16; i++) {
-            //     printf("%c", isprint(q.u8[i]) ? q.u8[i] : '.');
-            // }
-
-            // puts("|");
-
-            // printf("ee: Writing %016lx %016lx to %08x\n", q.u64[1], q.u64[0], dmac->sif0.madr);
-
-            dmac_write_qword(dmac, dmac->sif0.madr, 0, q);
+            if (ptr) {
+                ps2_sif0_read_block(dmac->sif, ptr, len);
+            } else {
+                for (uint32_t i = 0; i < len; i++)
+                    dmac_write_qword(dmac, dmac->sif0.madr + (i << 4), 0, ps2_sif0_read(dmac->sif));
+            }
 
-            dmac->sif0.madr += 16;
+            dmac->sif0.madr += len << 4;
+            qwc -= len;
         }
 
         if (channel_is_done(&dmac->sif0)) {
@@ -924,26 +1010,16 @@ void dmac_handle_sif1_transfer(struct ps2_dmac* dmac) {
         // );
         // printf("ee: SIF1 tag madr=%08x\n", dmac->sif1.madr);
 
-        for (int i = 0; i < dmac->sif1.qwc; i++) {
-            uint128_t q = dmac_read_qword(dmac, dmac->sif1.madr);
-
-            // printf("%08x: ", dmac->sif1.madr);
-
-            // for (int i = 0; i < 16; i++) {
-            //     printf("%02x ", q.u8[i]);
-            // }
-
-            // putchar('|');
+        uint32_t qwc = dmac->sif1.qwc;
 
-            // for (int i = 0; i < 16; i++) {
-            //     printf("%c", isprint(q.u8[i]) ? q.u8[i] : '.');
-            // }
-
-            // puts("|");
-
-            ps2_sif1_write(dmac->sif, q);
+        const void* ptr = dmac_get_span(dmac, dmac->sif1.madr, 0, &qwc, 0);
 
-            dmac->sif1.madr += 16;
+        // Hand the packet straight to the IOP if it's waiting for it,
+        // otherwise queue it up in the FIFO
+        if (ptr && (qwc == dmac->sif1.qwc) && iop_dma_sif1_direct(dmac->iop_dma, ptr, qwc)) {
+            dmac->sif1.madr += qwc << 4;
+        } else {
+            dmac->sif1.madr = dmac_send_qwords(dmac, dmac->sif1.madr, dmac->sif1.qwc, dmac_send_sif1);
         }
 
         if (dmac->sif1.tag.id == 1) {
@@ -975,17 +1051,11 @@ void dmac_spr_from_interleave(struct ps2_dmac* dmac) {
         tqwc = dmac->spr_from.qwc;
 
     while (dmac->spr_from.qwc) {
-        for (int i = 0; i < tqwc && dmac->spr_from.qwc; i++) {
-            uint128_t q = ps2_ram_read128(dmac->spr, dmac->spr_from.sadr);
+        uint32_t len = tqwc < dmac->spr_from.qwc ? tqwc : dmac->spr_from.qwc;
 
-            ee_bus_write128(dmac->bus, dmac->spr_from.madr, q);
-
-            dmac->spr_from.madr += 0x10;
-            dmac->spr_from.sadr += 0x10;
-            dmac->spr_from.sadr &= 0x3ff0;
-            dmac->spr_from.qwc--;
-        }
+        dmac_copy_spr(dmac, &dmac->spr_from.madr, &dmac->spr_from.sadr, len, 0);
 
+        dmac->spr_from.qwc -= len;
         dmac->spr_from.madr += sqwc * 16;
     }
 }
@@ -1039,15 +1109,7 @@ void dmac_handle_spr_from_transfer(struct ps2_dmac* dmac) {
         return;
     }
 
-    for (int i = 0; i < dmac->spr_from.qwc; i++) {
-        uint128_t q = ps2_ram_read128(dmac->spr, dmac->spr_from.sadr & 0x3ff0);
-
-        ee_bus_write128(dmac->bus, dmac->spr_from.madr, q);
-
-        dmac->spr_from.madr += 0x10;
-        dmac->spr_from.sadr += 0x10;
-        dmac->spr_from.sadr &= 0x3ff0;
-    }
+    dmac_copy_spr(dmac, &dmac->spr_from.madr, &dmac->spr_from.sadr, dmac->spr_from.qwc, 0);
 
     dmac->spr_from.qwc = 0;
 
@@ -1082,15 +1144,7 @@ void dmac_handle_spr_from_transfer(struct ps2_dmac* dmac) {
         //     (dmac->spr_from.chcr >> 7) & 1
         // );
 
-        for (int i = 0; i < dmac->spr_from.qwc; i++) {
-            uint128_t q = ps2_ram_read128(dmac->spr, dmac->spr_from.sadr & 0x3ff0);
-
-            ee_bus_write128(dmac->bus, dmac->spr_from.madr, q);
-
-            dmac->spr_from.madr += 0x10;
-            dmac->spr_from.sadr += 0x10;
-            dmac->spr_from.sadr &= 0x3ff0;
-        }
+        dmac_copy_spr(dmac, &dmac->spr_from.madr, &dmac->spr_from.sadr, dmac->spr_from.qwc, 0);
     } while (!channel_is_done(&dmac->spr_from));
 }
 
@@ -1103,17 +1157,11 @@ void dmac_spr_to_interleave(struct ps2_dmac* dmac) {
         tqwc = dmac->spr_to.qwc;
 
     while (dmac->spr_to.qwc) {
-        for (int i = 0; i < tqwc && dmac->spr_to.qwc; i++) {
-            uint128_t q = dmac_read_qword(dmac, dmac->spr_to.madr);
-
-            ps2_ram_write128(dmac->spr, dmac->spr_to.sadr, q);
+        uint32_t len = tqwc < dmac->spr_to.qwc ? tqwc : dmac->spr_to.qwc;
 
-            dmac->spr_to.madr += 0x10;
-            dmac->spr_to.sadr += 0x10;
-            dmac->spr_to.sadr &= 0x3ff0;
-            dmac->spr_to.qwc--;
-        }
+        dmac_copy_spr(dmac, &dmac->spr_to.madr, &dmac->spr_to.sadr, len, 1);
 
+        dmac->spr_to.qwc -= len;
         dmac->spr_to.madr += sqwc * 16;
     }
 }
@@ -1141,15 +1189,7 @@ void dmac_handle_spr_to_transfer(struct ps2_dmac* dmac) {
         return;
     }
 
-    for (int i = 0; i < dmac->spr_to.qwc; i++) {
-        uint128_t q = dmac_read_qword(dmac, dmac->spr_to.madr);
-
-        ps2_ram_write128(dmac->spr, dmac->spr_to.sadr, q);
-
-        dmac->spr_to.madr += 0x10;
-        dmac->spr_to.sadr += 0x10;
-        dmac->spr_to.sadr &= 0x3ff0;
-    }
+    dmac_copy_spr(dmac, &dmac->spr_to.madr, &dmac->spr_to.sadr, dmac->spr_to.qwc, 1);
 
     dmac->spr_to.qwc = 0;
 
@@ -1180,15 +1220,7 @@ void dmac_handle_spr_to_transfer(struct ps2_dmac* dmac) {
         //     tag.u32[1], tag.u32[0]
         // );
 
-        for (int i = 0; i < dmac->spr_to.qwc; i++) {
-            uint128_t q = dmac_read_qword(dmac, dmac->spr_to.madr);
-
-            ps2_ram_write128(dmac->spr, dmac->spr_to.sadr, q);
-
-            dmac->spr_to.madr += 0x10;
-            dmac->spr_to.sadr += 0x10;
-            dmac->spr_to.sadr &= 0x3ff0;
-        }
+        dmac_copy_spr(dmac, &dmac->spr_to.madr, &dmac->spr_to.sadr, dmac->spr_to.qwc, 1);
 
         if (dmac->spr_to.tag.id == 1) {
             dmac->spr_to.tadr = dmac->spr_to.madr;
@@ -107,6 +107,7 @@ void dmac_handle_gif_transfer(struct ps2_dmac* dmac);
 void dmac_handle_ipu_from_transfer(struct ps2_dmac* dmac);
 void dmac_handle_ipu_to_transfer(struct ps2_dmac* dmac);
 void dmac_handle_sif0_transfer(struct ps2_dmac* dmac);
+int dmac_sif0_direct(struct ps2_dmac* dmac, uint128_t tag, const void* data, uint32_t qwc);
 void dmac_handle_sif1_transfer(struct ps2_dmac* dmac);
 void dmac_handle_sif2_transfer(struct ps2_dmac* dmac);
 void dmac_handle_spr_from_transfer(struct ps2_dmac* dmac);
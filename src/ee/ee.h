@@ -25,6 +25,7 @@ struct ee_bus_s {
     void (*write32)(void* udata, uint32_t addr, uint64_t data);
     void (*write64)(void* udata, uint32_t addr, uint64_t data);
     void (*write128)(void* udata, uint32_t addr, uint128_t data);
+    void* (*get_span)(void* udata, uint32_t addr, uint32_t* size, int write);
 };
 
 #define EE_SR_CU  0xf0000000
@@ -166,6 +167,7 @@ uint32_t ee_get_pc(struct ee_state* ee);
 struct ps2_ram* ee_get_spr(struct ee_state* ee);
 int ee_run_block(struct ee_state* ee, int cycles);
 int ee_step(struct ee_state* ee);
+int ee_skip_idle(struct ee_state* ee, int cycles);
 void ee_set_fmv_skip(struct ee_state* ee, int v);
 void ee_reset_intc_reads(struct ee_state* ee);
 void ee_reset_csr_reads(struct ee_state* ee);
@@ -173,6 +175,10 @@ void ee_flush_cache(struct ee_state* ee);
 void ee_set_ram_size(struct ee_state* ee, int ram_size);
 void ee_set_osd_config(struct ee_state* ee, struct ee_osd_config config);
 struct ee_osd_config ee_get_osd_config(struct ee_state* ee);
+void ee_set_breakpoint(struct ee_state* ee, uint32_t addr);
+void ee_remove_breakpoint(struct ee_state* ee, uint32_t addr);
+void ee_clear_breakpoints(struct ee_state* ee);
+int ee_poll_breakpoint(struct ee_state* ee);
 
 #undef EE_ALIGNED16
 
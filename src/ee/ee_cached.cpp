@@ -41,51 +41,13 @@
 #define VU_D_Z (0x00400000)
 #define VU_D_W (0x00200000)
 
-// file = fopen("vu.dump", "a"); fprintf(file, #ins "\n"); fclose(file);
-#define VU_LOWER(ins) { ps2_vu_decode_lower(ee->vu0, i.opcode); vu_i_ ## ins(ee->vu0, &ee->vu0->lower); }
-#define VU_UPPER(ins) { ps2_vu_decode_upper(ee->vu0, i.opcode); vu_i_ ## ins(ee->vu0, &ee->vu0->upper); }
-#define VU_LOWER_TEMPLATE(ins) { \
-    ps2_vu_decode_lower(ee->vu0, i.opcode); \
-    switch ((i.opcode >> 21) & 0xf) { \
-        case 0: vu_i_ ## ins <0>(ee->vu0, &ee->vu0->lower); break; \
-        case 1: vu_i_ ## ins <VU_D_W>(ee->vu0, &ee->vu0->lower); break; \
-        case 2: vu_i_ ## ins <VU_D_Z>(ee->vu0, &ee->vu0->lower); break; \
-        case 3: vu_i_ ## ins <VU_D_Z | VU_D_W>(ee->vu0, &ee->vu0->lower); break; \
-        case 4: vu_i_ ## ins <VU_D_Y>(ee->vu0, &ee->vu0->lower); break; \
-        case 5: vu_i_ ## ins <VU_D_Y | VU_D_W>(ee->vu0, &ee->vu0->lower); break; \
-        case 6: vu_i_ ## ins <VU_D_Y | VU_D_Z>(ee->vu0, &ee->vu0->lower); break; \
-        case 7: vu_i_ ## ins <VU_D_Y | VU_D_Z | VU_D_W>(ee->vu0, &ee->vu0->lower); break; \
-        case 8: vu_i_ ## ins <VU_D_X>(ee->vu0, &ee->vu0->lower); break; \
-        case 9: vu_i_ ## ins <VU_D_X | VU_D_W>(ee->vu0, &ee->vu0->lower); break; \
-        case 10: vu_i_ ## ins <VU_D_X | VU_D_Z>(ee->vu0, &ee->vu0->lower); break; \
-        case 11: vu_i_ ## ins <VU_D_X | VU_D_Z | VU_D_W>(ee->vu0, &ee->vu0->lower); break; \
-        case 12: vu_i_ ## ins <VU_D_X | VU_D_Y>(ee->vu0, &ee->vu0->lower); break; \
-        case 13: vu_i_ ## ins <VU_D_X | VU_D_Y | VU_D_W>(ee->vu0, &ee->vu0->lower); break; \
-        case 14: vu_i_ ## ins <VU_D_X | VU_D_Y | VU_D_Z>(ee->vu0, &ee->vu0->lower); break; \
-        case 15: vu_i_ ## ins <VU_D_X | VU_D_Y | VU_D_Z | VU_D_W>(ee->vu0, &ee->vu0->lower); break; \
-        default: __builtin_unreachable(); \
-    } }
-#define VU_UPPER_TEMPLATE(ins) { \
-    ps2_vu_decode_upper(ee->vu0, i.opcode); \
-    switch ((i.opcode >> 21) & 0xf) { \
-        case 0: vu_i_ ## ins <0>(ee->vu0, &ee->vu0->upper); break; \
-        case 1: vu_i_ ## ins <VU_D_W>(ee->vu0, &ee->vu0->upper); break; \
-        case 2: vu_i_ ## ins <VU_D_Z>(ee->vu0, &ee->vu0->upper); break; \
-        case 3: vu_i_ ## ins <VU_D_Z | VU_D_W>(ee->vu0, &ee->vu0->upper); break; \
-        case 4: vu_i_ ## ins <VU_D_Y>(ee->vu0, &ee->vu0->upper); break; \
-        case 5: vu_i_ ## ins <VU_D_Y | VU_D_W>(ee->vu0, &ee->vu0->upper); break; \
-        case 6: vu_i_ ## ins <VU_D_Y | VU_D_Z>(ee->vu0, &ee->vu0->upper); break; \
-        case 7: vu_i_ ## ins <VU_D_Y | VU_D_Z | VU_D_W>(ee->vu0, &ee->vu0->upper); break; \
-        case 8: vu_i_ ## ins <VU_D_X>(ee->vu0, &ee->vu0->upper); break; \
-        case 9: vu_i_ ## ins <VU_D_X | VU_D_W>(ee->vu0, &ee->vu0->upper); break; \
-        case 10: vu_i_ ## ins <VU_D_X | VU_D_Z>(ee->vu0, &ee->vu0->upper); break; \
-        case 11: vu_i_ ## ins <VU_D_X | VU_D_Z | VU_D_W>(ee->vu0, &ee->vu0->upper); break; \
-        case 12: vu_i_ ## ins <VU_D_X | VU_D_Y>(ee->vu0, &ee->vu0->upper); break; \
-        case 13: vu_i_ ## ins <VU_D_X | VU_D_Y | VU_D_W>(ee->vu0, &ee->vu0->upper); break; \
-        case 14: vu_i_ ## ins <VU_D_X | VU_D_Y | VU_D_Z>(ee->vu0, &ee->vu0->upper); break; \
-        case 15: vu_i_ ## ins <VU_D_X | VU_D_Y | VU_D_Z | VU_D_W>(ee->vu0, &ee->vu0->upper); break; \
-        default: __builtin_unreachable(); \
-    } }
+// COP2 macro instructions run straight off the VU instruction decoded
+// when the block was cached, templated ops get the dest mask from the
+// handler instantiation ee_decode picked
+#define VU_LOWER(ins) { vu_i_ ## ins(ee->vu0, &ee->block_vu[i.vu]); }
+#define VU_UPPER(ins) { vu_i_ ## ins(ee->vu0, &ee->block_vu[i.vu]); }
+#define VU_LOWER_TEMPLATE(ins) { vu_i_ ## ins <di>(ee->vu0, &ee->block_vu[i.vu]); }
+#define VU_UPPER_TEMPLATE(ins) { vu_i_ ## ins <di>(ee->vu0, &ee->block_vu[i.vu]); }
 
 static inline int fast_abs32(int a) {
     uint32_t m = a >> 31;
@@ -102,7 +64,7 @@ static inline int16_t fast_abs16(int16_t a) {
 static inline int16_t saturate16(int32_t word) {
     if (word > (int32_t)0x00007FFF) {
         return 0x7FFF;
-    } else if (word < (int32_t)0xFFFF80000) {
+    } else if (word < (int32_t)0xFFFF8000) {
         return 0x8000;
     } else {
         return (int16_t)word;
@@ -142,6 +104,29 @@ static inline __m128i _mm_adds_epu32(__m128i a, __m128i b) {
 
     return _mm_add_epi32(a, c);
 }
+
+static inline __m128i _mm_subs_epi32(__m128i a, __m128i b) {
+    const __m128i m = _mm_set1_epi32(0x7fffffff);
+    __m128i r = _mm_sub_epi32(a, b);
+    __m128i sb = _mm_srli_epi32(a, 31);
+    __m128i sat = _mm_add_epi32(m, sb);
+    __m128i o = _mm_and_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, r));
+
+    return _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(r),
+                                          _mm_castsi128_ps(sat),
+                                          _mm_castsi128_ps(o)));
+}
+
+static inline __m128i _mm_subs_epu32(__m128i a, __m128i b) {
+    return _mm_sub_epi32(_mm_max_epu32(a, b), b);
+}
+
+// Sign-extends words 0 and 2 into both doublewords
+static inline __m128i _mm_sext_epi32_epi64(__m128i a) {
+    __m128i r = _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 2, 0, 0));
+
+    return _mm_blend_epi16(r, _mm_srai_epi32(r, 31), 0xcc);
+}
 #endif
 
 static inline uint32_t unpack_5551_8888(uint32_t v) {
@@ -172,9 +157,9 @@ static inline uint32_t unpack_5551_8888(uint32_t v) {
 #define EE_D_RD (i.rd)
 #define EE_D_FD (i.sa)
 #define EE_D_SA (i.sa)
-#define EE_D_I15 (i.i15)
+#define EE_D_I15 ((i.rt << 10) | (i.rd << 5) | i.sa)
 #define EE_D_I16 (i.i16)
-#define EE_D_I26 (i.i26)
+#define EE_D_I26 ((i.rs << 21) | (i.rt << 16) | i.i16)
 #define EE_D_SI26 ((int32_t)(EE_D_I26 << 6) >> 4)
 #define EE_D_SI16 ((int32_t)(EE_D_I16 << 16) >> 14)
 
@@ -210,7 +195,7 @@ static inline uint32_t unpack_5551_8888(uint32_t v) {
 #define SE648(v) ((int64_t)((int8_t)(v)))
 #define SE3216(v) ((int32_t)((int16_t)(v)))
 
-static inline void ee_print_disassembly(struct ee_state* ee, const ee_instruction& i) {
+static inline void ee_print_disassembly(struct ee_state* ee) {
     char buf[128];
     struct ee_dis_state ds;
 
@@ -218,7 +203,7 @@ static inline void ee_print_disassembly(struct ee_state* ee, const ee_instructio
     ds.print_opcode = 1;
     ds.pc = ee->pc;
 
-    puts(ee_disassemble(buf, i.opcode, &ds));
+    puts(ee_disassemble(buf, ee->opcode, &ds));
 }
 
 static inline int ee_get_segment(uint32_t virt) {
@@ -1717,7 +1702,7 @@ static inline void ee_i_padsbh(struct ee_state* ee, const ee_instruction& i) {
     __m128i b = _mm_load_si128((__m128i*)t);
     __m128i x = _mm_sub_epi16(a, b);
     __m128i y = _mm_add_epi16(a, b);
-    __m128i r = _mm_blend_epi16(x, y, 15);
+    __m128i r = _mm_blend_epi16(x, y, 0xf0);
 
     _mm_store_si128((__m128i*)d, r);
 #endif
@@ -1885,12 +1870,20 @@ static inline void ee_i_pcpyld(struct ee_state* ee, const ee_instruction& i) {
 #endif
 }
 static inline void ee_i_pcpyud(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     uint128_t rs = ee->r[EE_D_RS];
     int d = EE_D_RD;
 
     ee->r[d].u64[0] = rs.u64[1];
     ee->r[d].u64[1] = rt.u64[1];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_unpackhi_epi64(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pdivbw(struct ee_state* ee, const ee_instruction& i) {
     int s = EE_D_RS;
@@ -1965,6 +1958,7 @@ static inline void ee_i_pdivw(struct ee_state* ee, const ee_instruction& i) {
     // ee->lo.u64[1] = SE6432(ee->r[s].s32[2] / ee->r[t].s32[2]);
 }
 static inline void ee_i_pexch(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     int d = EE_D_RD;
 
@@ -1976,8 +1970,15 @@ static inline void ee_i_pexch(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[5] = rt.u16[6];
     ee->r[d].u16[6] = rt.u16[5];
     ee->r[d].u16[7] = rt.u16[7];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_shufflehi_epi16(_mm_shufflelo_epi16(a, _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pexcw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     int d = EE_D_RD;
 
@@ -1985,8 +1986,15 @@ static inline void ee_i_pexcw(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u32[1] = rt.u32[2];
     ee->r[d].u32[2] = rt.u32[1];
     ee->r[d].u32[3] = rt.u32[3];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_shuffle_epi32(a, _MM_SHUFFLE(3, 1, 2, 0));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pexeh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     int d = EE_D_RD;
 
@@ -1998,8 +2006,15 @@ static inline void ee_i_pexeh(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[5] = rt.u16[5];
     ee->r[d].u16[6] = rt.u16[4];
     ee->r[d].u16[7] = rt.u16[7];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_shufflehi_epi16(_mm_shufflelo_epi16(a, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pexew(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     int d = EE_D_RD;
 
@@ -2007,8 +2022,15 @@ static inline void ee_i_pexew(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u32[1] = rt.u32[1];
     ee->r[d].u32[2] = rt.u32[0];
     ee->r[d].u32[3] = rt.u32[3];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_shuffle_epi32(a, _MM_SHUFFLE(3, 0, 1, 2));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pext5(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     int d = EE_D_RD;
 
@@ -2016,8 +2038,19 @@ static inline void ee_i_pext5(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u32[1] = unpack_5551_8888(rt.u32[1]);
     ee->r[d].u32[2] = unpack_5551_8888(rt.u32[2]);
     ee->r[d].u32[3] = unpack_5551_8888(rt.u32[3]);
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_slli_epi32(_mm_and_si128(a, _mm_set1_epi32(0x001f)), 3);
+
+    r = _mm_or_si128(r, _mm_slli_epi32(_mm_and_si128(a, _mm_set1_epi32(0x03e0)), 6));
+    r = _mm_or_si128(r, _mm_slli_epi32(_mm_and_si128(a, _mm_set1_epi32(0x7c00)), 9));
+    r = _mm_or_si128(r, _mm_slli_epi32(_mm_and_si128(a, _mm_set1_epi32(0x8000)), 16));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pextlb(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     uint128_t rs = ee->r[EE_D_RS];
     int d = EE_D_RD;
@@ -2038,8 +2071,16 @@ static inline void ee_i_pextlb(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u8[13] = rs.u8[6];
     ee->r[d].u8[14] = rt.u8[7];
     ee->r[d].u8[15] = rs.u8[7];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i r = _mm_unpacklo_epi8(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pextlh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     uint128_t rs = ee->r[EE_D_RS];
     int d = EE_D_RD;
@@ -2052,8 +2093,16 @@ static inline void ee_i_pextlh(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[5] = rs.u16[2];
     ee->r[d].u16[6] = rt.u16[3];
     ee->r[d].u16[7] = rs.u16[3];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i r = _mm_unpacklo_epi16(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pextlw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     uint128_t rs = ee->r[EE_D_RS];
     int d = EE_D_RD;
@@ -2062,8 +2111,16 @@ static inline void ee_i_pextlw(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u32[1] = rs.u32[0];
     ee->r[d].u32[2] = rt.u32[1];
     ee->r[d].u32[3] = rs.u32[1];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i r = _mm_unpacklo_epi32(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pextub(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     uint128_t rs = ee->r[EE_D_RS];
     int d = EE_D_RD;
@@ -2084,8 +2141,16 @@ static inline void ee_i_pextub(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u8[13] = rs.u8[14];
     ee->r[d].u8[14] = rt.u8[15];
     ee->r[d].u8[15] = rs.u8[15];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i r = _mm_unpackhi_epi8(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pextuh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     uint128_t rs = ee->r[EE_D_RS];
     int d = EE_D_RD;
@@ -2098,8 +2163,16 @@ static inline void ee_i_pextuh(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[5] = rs.u16[6];
     ee->r[d].u16[6] = rt.u16[7];
     ee->r[d].u16[7] = rs.u16[7];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i r = _mm_unpackhi_epi16(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pextuw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     uint128_t rs = ee->r[EE_D_RS];
     int d = EE_D_RD;
@@ -2108,8 +2181,16 @@ static inline void ee_i_pextuw(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u32[1] = rs.u32[2];
     ee->r[d].u32[2] = rt.u32[3];
     ee->r[d].u32[3] = rs.u32[3];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i r = _mm_unpackhi_epi32(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_phmadh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     uint128_t rs = ee->r[EE_D_RS];
     int d = EE_D_RD;
@@ -2131,8 +2212,21 @@ static inline void ee_i_phmadh(struct ee_state* ee, const ee_instruction& i) {
     ee->lo.u32[3] = r2;
     ee->hi.u32[2] = ee->r[d].u32[3];
     ee->hi.u32[3] = r3;
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+
+    // Odd products alone go to LO1/LO3/HI1/HI3
+    __m128i r = _mm_madd_epi16(a, b);
+    __m128i o = _mm_madd_epi16(a, _mm_and_si128(b, _mm_set1_epi32(0xffff0000)));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+    _mm_store_si128((__m128i*)&ee->lo, _mm_blend_epi16(r, _mm_slli_epi64(o, 32), 0xcc));
+    _mm_store_si128((__m128i*)&ee->hi, _mm_blend_epi16(_mm_srli_epi64(r, 32), o, 0xcc));
+#endif
 }
 static inline void ee_i_phmsbh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
@@ -2154,8 +2248,24 @@ static inline void ee_i_phmsbh(struct ee_state* ee, const ee_instruction& i) {
     ee->lo.u32[3] = ~r5;
     ee->hi.u32[2] = ee->r[d].u32[3];
     ee->hi.u32[3] = ~r7;
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i m = _mm_set1_epi32(0xffff0000);
+    __m128i o = _mm_madd_epi16(a, _mm_and_si128(b, m));
+    __m128i e = _mm_madd_epi16(a, _mm_andnot_si128(m, b));
+    __m128i r = _mm_sub_epi32(o, e);
+
+    // LO1/LO3/HI1/HI3 get the inverted odd products
+    o = _mm_xor_si128(o, _mm_set1_epi32(0xffffffff));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+    _mm_store_si128((__m128i*)&ee->lo, _mm_blend_epi16(r, _mm_slli_epi64(o, 32), 0xcc));
+    _mm_store_si128((__m128i*)&ee->hi, _mm_blend_epi16(_mm_srli_epi64(r, 32), o, 0xcc));
+#endif
 }
 static inline void ee_i_pinteh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     uint128_t rs = ee->r[EE_D_RS];
     int d = EE_D_RD;
@@ -2168,8 +2278,16 @@ static inline void ee_i_pinteh(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[5] = rs.u16[4];
     ee->r[d].u16[6] = rt.u16[6];
     ee->r[d].u16[7] = rs.u16[6];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i r = _mm_blend_epi16(a, _mm_slli_epi32(b, 16), 0xaa);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pinth(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     uint128_t rs = ee->r[EE_D_RS];
     int d = EE_D_RD;
@@ -2182,6 +2300,13 @@ static inline void ee_i_pinth(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[5] = rs.u16[6];
     ee->r[d].u16[6] = rt.u16[3];
     ee->r[d].u16[7] = rs.u16[7];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i r = _mm_unpacklo_epi16(a, _mm_srli_si128(b, 8));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_plzcw(struct ee_state* ee, const ee_instruction& i) { 
     for (int j = 0; j < 2; j++) {
@@ -2195,6 +2320,7 @@ static inline void ee_i_plzcw(struct ee_state* ee, const ee_instruction& i) {
     }
 }
 static inline void ee_i_pmaddh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
@@ -2229,8 +2355,28 @@ static inline void ee_i_pmaddh(struct ee_state* ee, const ee_instruction& i) {
     ee->hi.u32[0] = ee->r[d].u32[1];
     ee->lo.u32[2] = ee->r[d].u32[2];
     ee->hi.u32[2] = ee->r[d].u32[3];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i lo = _mm_load_si128((__m128i*)&ee->lo);
+    __m128i hi = _mm_load_si128((__m128i*)&ee->hi);
+    __m128i pl = _mm_mullo_epi16(a, b);
+    __m128i ph = _mm_mulhi_epi16(a, b);
+
+    // Products 0-3 and 4-7 line up with LO0 LO1 HI0 HI1 and
+    // LO2 LO3 HI2 HI3 respectively
+    __m128i x = _mm_add_epi32(_mm_unpacklo_epi64(lo, hi), _mm_unpacklo_epi16(pl, ph));
+    __m128i y = _mm_add_epi32(_mm_unpackhi_epi64(lo, hi), _mm_unpackhi_epi16(pl, ph));
+
+    _mm_store_si128((__m128i*)&ee->lo, _mm_unpacklo_epi64(x, y));
+    _mm_store_si128((__m128i*)&ee->hi, _mm_unpackhi_epi64(x, y));
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], _mm_castps_si128(
+        _mm_shuffle_ps(_mm_castsi128_ps(x), _mm_castsi128_ps(y), _MM_SHUFFLE(2, 0, 2, 0))
+    ));
+#endif
 }
 static inline void ee_i_pmadduw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
@@ -2244,8 +2390,24 @@ static inline void ee_i_pmadduw(struct ee_state* ee, const ee_instruction& i) {
     ee->hi.u64[0] = SE6432(ee->r[d].u32[1]);
     ee->lo.u64[1] = SE6432(ee->r[d].u32[2]);
     ee->hi.u64[1] = SE6432(ee->r[d].u32[3]);
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_mul_epu32(a, b);
+
+    // Accumulate onto HI0:LO0 and HI2:LO2
+    __m128i lo = _mm_load_si128((__m128i*)&ee->lo);
+    __m128i hi = _mm_load_si128((__m128i*)&ee->hi);
+
+    r = _mm_add_epi64(r, _mm_blend_epi16(lo, _mm_slli_epi64(hi, 32), 0xcc));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+    _mm_store_si128((__m128i*)&ee->lo, _mm_sext_epi32_epi64(r));
+    _mm_store_si128((__m128i*)&ee->hi, _mm_sext_epi32_epi64(_mm_srli_epi64(r, 32)));
+#endif
 }
 static inline void ee_i_pmaddw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
@@ -2259,8 +2421,24 @@ static inline void ee_i_pmaddw(struct ee_state* ee, const ee_instruction& i) {
     ee->hi.u64[0] = SE6432(ee->r[d].u32[1]);
     ee->lo.u64[1] = SE6432(ee->r[d].u32[2]);
     ee->hi.u64[1] = SE6432(ee->r[d].u32[3]);
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_mul_epi32(a, b);
+
+    // Accumulate onto HI0:LO0 and HI2:LO2
+    __m128i lo = _mm_load_si128((__m128i*)&ee->lo);
+    __m128i hi = _mm_load_si128((__m128i*)&ee->hi);
+
+    r = _mm_add_epi64(r, _mm_blend_epi16(lo, _mm_slli_epi64(hi, 32), 0xcc));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+    _mm_store_si128((__m128i*)&ee->lo, _mm_sext_epi32_epi64(r));
+    _mm_store_si128((__m128i*)&ee->hi, _mm_sext_epi32_epi64(_mm_srli_epi64(r, 32)));
+#endif
 }
 static inline void ee_i_pmaxh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
@@ -2273,8 +2451,16 @@ static inline void ee_i_pmaxh(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[5] = ((int16_t)ee->r[s].u16[5] > (int16_t)ee->r[t].u16[5]) ? ee->r[s].u16[5] : ee->r[t].u16[5];
     ee->r[d].u16[6] = ((int16_t)ee->r[s].u16[6] > (int16_t)ee->r[t].u16[6]) ? ee->r[s].u16[6] : ee->r[t].u16[6];
     ee->r[d].u16[7] = ((int16_t)ee->r[s].u16[7] > (int16_t)ee->r[t].u16[7]) ? ee->r[s].u16[7] : ee->r[t].u16[7];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_max_epi16(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pmaxw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
@@ -2283,33 +2469,71 @@ static inline void ee_i_pmaxw(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u32[1] = ((int32_t)ee->r[s].u32[1] > (int32_t)ee->r[t].u32[1]) ? ee->r[s].u32[1] : ee->r[t].u32[1];
     ee->r[d].u32[2] = ((int32_t)ee->r[s].u32[2] > (int32_t)ee->r[t].u32[2]) ? ee->r[s].u32[2] : ee->r[t].u32[2];
     ee->r[d].u32[3] = ((int32_t)ee->r[s].u32[3] > (int32_t)ee->r[t].u32[3]) ? ee->r[s].u32[3] : ee->r[t].u32[3];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_max_epi32(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pmfhi(struct ee_state* ee, const ee_instruction& i) {
     ee->r[EE_D_RD] = ee->hi;
 }
 static inline void ee_i_pmfhllw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
 
     ee->r[d].u32[0] = ee->lo.u32[0];
     ee->r[d].u32[1] = ee->hi.u32[0];
     ee->r[d].u32[2] = ee->lo.u32[2];
     ee->r[d].u32[3] = ee->hi.u32[2];
+#else
+    __m128i lo = _mm_load_si128((__m128i*)&ee->lo);
+    __m128i hi = _mm_load_si128((__m128i*)&ee->hi);
+    __m128i r = _mm_blend_epi16(lo, _mm_slli_epi64(hi, 32), 0xcc);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pmfhluw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
 
     ee->r[d].u32[0] = ee->lo.u32[1];
     ee->r[d].u32[1] = ee->hi.u32[1];
     ee->r[d].u32[2] = ee->lo.u32[3];
     ee->r[d].u32[3] = ee->hi.u32[3];
+#else
+    __m128i lo = _mm_load_si128((__m128i*)&ee->lo);
+    __m128i hi = _mm_load_si128((__m128i*)&ee->hi);
+    __m128i r = _mm_blend_epi16(_mm_srli_epi64(lo, 32), hi, 0xcc);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pmfhlslw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
 
     ee->r[d].u64[0] = SE6432(saturate32(((uint64_t)ee->lo.u32[0]) | (ee->hi.u64[0] << 32)));
     ee->r[d].u64[1] = SE6432(saturate32(((uint64_t)ee->lo.u32[2]) | (ee->hi.u64[1] << 32)));
+#else
+    __m128i lo = _mm_load_si128((__m128i*)&ee->lo);
+    __m128i hi = _mm_load_si128((__m128i*)&ee->hi);
+
+    // HI:LO fits in 32 bits only if HI is just LO's sign extension
+    __m128i f = _mm_cmpeq_epi32(hi, _mm_srai_epi32(lo, 31));
+    __m128i sat = _mm_add_epi32(_mm_set1_epi32(0x7fffffff), _mm_srli_epi32(hi, 31));
+    __m128i r = _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(sat),
+                                               _mm_castsi128_ps(lo),
+                                               _mm_castsi128_ps(f)));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], _mm_sext_epi32_epi64(r));
+#endif
 }
 static inline void ee_i_pmfhllh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
 
     ee->r[d].u16[0] = ee->lo.u16[0];
@@ -2321,8 +2545,17 @@ static inline void ee_i_pmfhllh(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[6] = ee->hi.u16[4];
     ee->r[d].u16[7] = ee->hi.u16[6];
     
+#else
+    __m128i m = _mm_set1_epi32(0xffff);
+    __m128i lo = _mm_and_si128(_mm_load_si128((__m128i*)&ee->lo), m);
+    __m128i hi = _mm_and_si128(_mm_load_si128((__m128i*)&ee->hi), m);
+    __m128i r = _mm_shuffle_epi32(_mm_packus_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pmfhlsh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
 
     ee->r[d].u16[0] = saturate16(ee->lo.u32[0]);
@@ -2333,11 +2566,19 @@ static inline void ee_i_pmfhlsh(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[5] = saturate16(ee->lo.u32[3]);
     ee->r[d].u16[6] = saturate16(ee->hi.u32[2]);
     ee->r[d].u16[7] = saturate16(ee->hi.u32[3]);
+#else
+    __m128i lo = _mm_load_si128((__m128i*)&ee->lo);
+    __m128i hi = _mm_load_si128((__m128i*)&ee->hi);
+    __m128i r = _mm_shuffle_epi32(_mm_packs_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pmflo(struct ee_state* ee, const ee_instruction& i) {
     ee->r[EE_D_RD] = ee->lo;
 }
 static inline void ee_i_pminh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
@@ -2350,8 +2591,16 @@ static inline void ee_i_pminh(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[5] = ((int16_t)ee->r[s].u16[5] < (int16_t)ee->r[t].u16[5]) ? ee->r[s].u16[5] : ee->r[t].u16[5];
     ee->r[d].u16[6] = ((int16_t)ee->r[s].u16[6] < (int16_t)ee->r[t].u16[6]) ? ee->r[s].u16[6] : ee->r[t].u16[6];
     ee->r[d].u16[7] = ((int16_t)ee->r[s].u16[7] < (int16_t)ee->r[t].u16[7]) ? ee->r[s].u16[7] : ee->r[t].u16[7];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_min_epi16(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pminw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
@@ -2360,8 +2609,16 @@ static inline void ee_i_pminw(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u32[1] = (ee->r[s].s32[1] < ee->r[t].s32[1]) ? ee->r[s].u32[1] : ee->r[t].u32[1];
     ee->r[d].u32[2] = (ee->r[s].s32[2] < ee->r[t].s32[2]) ? ee->r[s].u32[2] : ee->r[t].u32[2];
     ee->r[d].u32[3] = (ee->r[s].s32[3] < ee->r[t].s32[3]) ? ee->r[s].u32[3] : ee->r[t].u32[3];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_min_epi32(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pmsubh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int s = EE_D_RS;
     int t = EE_D_RT;
     int d = EE_D_RD;
@@ -2388,6 +2645,25 @@ static inline void ee_i_pmsubh(struct ee_state* ee, const ee_instruction& i) {
     ee->lo.u32[3] = ee->lo.u32[3] - r5;
     ee->hi.u32[1] = ee->hi.u32[1] - r3;
     ee->hi.u32[3] = ee->hi.u32[3] - r7;
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i lo = _mm_load_si128((__m128i*)&ee->lo);
+    __m128i hi = _mm_load_si128((__m128i*)&ee->hi);
+    __m128i pl = _mm_mullo_epi16(a, b);
+    __m128i ph = _mm_mulhi_epi16(a, b);
+
+    // Products 0-3 and 4-7 line up with LO0 LO1 HI0 HI1 and
+    // LO2 LO3 HI2 HI3 respectively
+    __m128i x = _mm_sub_epi32(_mm_unpacklo_epi64(lo, hi), _mm_unpacklo_epi16(pl, ph));
+    __m128i y = _mm_sub_epi32(_mm_unpackhi_epi64(lo, hi), _mm_unpackhi_epi16(pl, ph));
+
+    _mm_store_si128((__m128i*)&ee->lo, _mm_unpacklo_epi64(x, y));
+    _mm_store_si128((__m128i*)&ee->hi, _mm_unpackhi_epi64(x, y));
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], _mm_castps_si128(
+        _mm_shuffle_ps(_mm_castsi128_ps(x), _mm_castsi128_ps(y), _MM_SHUFFLE(2, 0, 2, 0))
+    ));
+#endif
 }
 static inline void ee_i_pmsubw(struct ee_state* ee, const ee_instruction& i) {
     int s = EE_D_RS;
@@ -2434,17 +2710,27 @@ static inline void ee_i_pmthi(struct ee_state* ee, const ee_instruction& i) {
     ee->hi = ee->r[EE_D_RS];
 }
 static inline void ee_i_pmthl(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int s = EE_D_RS;
 
     ee->lo.u32[0] = ee->r[s].u32[0];
     ee->lo.u32[2] = ee->r[s].u32[2];
     ee->hi.u32[0] = ee->r[s].u32[1];
     ee->hi.u32[2] = ee->r[s].u32[3];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i lo = _mm_load_si128((__m128i*)&ee->lo);
+    __m128i hi = _mm_load_si128((__m128i*)&ee->hi);
+
+    _mm_store_si128((__m128i*)&ee->lo, _mm_blend_epi16(lo, a, 0x33));
+    _mm_store_si128((__m128i*)&ee->hi, _mm_blend_epi16(hi, _mm_srli_epi64(a, 32), 0x33));
+#endif
 }
 static inline void ee_i_pmtlo(struct ee_state* ee, const ee_instruction& i) {
     ee->lo = ee->r[EE_D_RS];
 }
 static inline void ee_i_pmulth(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
@@ -2461,8 +2747,25 @@ static inline void ee_i_pmulth(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u32[1] = ee->hi.u32[0];
     ee->r[d].u32[2] = ee->lo.u32[2];
     ee->r[d].u32[3] = ee->hi.u32[2];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i pl = _mm_mullo_epi16(a, b);
+    __m128i ph = _mm_mulhi_epi16(a, b);
+
+    // Products 0-3 and 4-7
+    __m128i x = _mm_unpacklo_epi16(pl, ph);
+    __m128i y = _mm_unpackhi_epi16(pl, ph);
+
+    _mm_store_si128((__m128i*)&ee->lo, _mm_unpacklo_epi64(x, y));
+    _mm_store_si128((__m128i*)&ee->hi, _mm_unpackhi_epi64(x, y));
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], _mm_castps_si128(
+        _mm_shuffle_ps(_mm_castsi128_ps(x), _mm_castsi128_ps(y), _MM_SHUFFLE(2, 0, 2, 0))
+    ));
+#endif
 }
 static inline void ee_i_pmultuw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
@@ -2474,8 +2777,18 @@ static inline void ee_i_pmultuw(struct ee_state* ee, const ee_instruction& i) {
     ee->lo.u64[1] = SE6432(ee->r[d].u32[2]);
     ee->hi.u64[0] = SE6432(ee->r[d].u32[1]);
     ee->hi.u64[1] = SE6432(ee->r[d].u32[3]);
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_mul_epu32(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+    _mm_store_si128((__m128i*)&ee->lo, _mm_sext_epi32_epi64(r));
+    _mm_store_si128((__m128i*)&ee->hi, _mm_sext_epi32_epi64(_mm_srli_epi64(r, 32)));
+#endif
 }
 static inline void ee_i_pmultw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int s = EE_D_RS;
     int t = EE_D_RT;
     int d = EE_D_RD;
@@ -2487,24 +2800,50 @@ static inline void ee_i_pmultw(struct ee_state* ee, const ee_instruction& i) {
     ee->lo.u64[1] = SE6432(ee->r[d].u32[2]);
     ee->hi.u64[0] = SE6432(ee->r[d].u32[1]);
     ee->hi.u64[1] = SE6432(ee->r[d].u32[3]);
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_mul_epi32(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+    _mm_store_si128((__m128i*)&ee->lo, _mm_sext_epi32_epi64(r));
+    _mm_store_si128((__m128i*)&ee->hi, _mm_sext_epi32_epi64(_mm_srli_epi64(r, 32)));
+#endif
 }
 static inline void ee_i_pnor(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rs = ee->r[EE_D_RS];
     uint128_t rt = ee->r[EE_D_RT];
     int d = EE_D_RD;
 
     ee->r[d].u64[0] = ~(rs.u64[0] | rt.u64[0]);
     ee->r[d].u64[1] = ~(rs.u64[1] | rt.u64[1]);
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_xor_si128(_mm_or_si128(a, b), _mm_set1_epi32(0xffffffff));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_por(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rs = ee->r[EE_D_RS];
     uint128_t rt = ee->r[EE_D_RT];
     int d = EE_D_RD;
 
     ee->r[d].u64[0] = rs.u64[0] | rt.u64[0];
     ee->r[d].u64[1] = rs.u64[1] | rt.u64[1];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_or_si128(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_ppac5(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     int d = EE_D_RD;
 
@@ -2524,8 +2863,19 @@ static inline void ee_i_ppac5(struct ee_state* ee, const ee_instruction& i) {
                       ((rt.u32[3] & 0x0000f800) >> 6) |
                       ((rt.u32[3] & 0x00f80000) >> 9) |
                       ((rt.u32[3] & 0x80000000) >> 16);
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_srli_epi32(_mm_and_si128(a, _mm_set1_epi32(0x000000f8)), 3);
+
+    r = _mm_or_si128(r, _mm_srli_epi32(_mm_and_si128(a, _mm_set1_epi32(0x0000f800)), 6));
+    r = _mm_or_si128(r, _mm_srli_epi32(_mm_and_si128(a, _mm_set1_epi32(0x00f80000)), 9));
+    r = _mm_or_si128(r, _mm_srli_epi32(_mm_and_si128(a, _mm_set1_epi32(0x80000000)), 16));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_ppacb(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rs = ee->r[EE_D_RS];
     uint128_t rt = ee->r[EE_D_RT];
     int d = EE_D_RD;
@@ -2546,8 +2896,16 @@ static inline void ee_i_ppacb(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u8[13] = rs.u8[10];
     ee->r[d].u8[14] = rs.u8[12];
     ee->r[d].u8[15] = rs.u8[14];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i r = _mm_packus_epi16(_mm_and_si128(a, _mm_set1_epi16(0xff)), _mm_and_si128(b, _mm_set1_epi16(0xff)));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_ppach(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rs = ee->r[EE_D_RS];
     uint128_t rt = ee->r[EE_D_RT];
     int d = EE_D_RD;
@@ -2560,8 +2918,16 @@ static inline void ee_i_ppach(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[5] = rs.u16[2];
     ee->r[d].u16[6] = rs.u16[4];
     ee->r[d].u16[7] = rs.u16[6];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i r = _mm_packus_epi32(_mm_and_si128(a, _mm_set1_epi32(0xffff)), _mm_and_si128(b, _mm_set1_epi32(0xffff)));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_ppacw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rs = ee->r[EE_D_RS];
     uint128_t rt = ee->r[EE_D_RT];
     int d = EE_D_RD;
@@ -2570,11 +2936,19 @@ static inline void ee_i_ppacw(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u32[1] = rt.u32[2];
     ee->r[d].u32[2] = rs.u32[0];
     ee->r[d].u32[3] = rs.u32[2];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i r = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(2, 0, 2, 0)));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pref(struct ee_state* ee, const ee_instruction& i) {
     // Does nothing
 }
 static inline void ee_i_prevh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     int d = EE_D_RD;
 
@@ -2586,8 +2960,15 @@ static inline void ee_i_prevh(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[5] = rt.u16[6];
     ee->r[d].u16[6] = rt.u16[5];
     ee->r[d].u16[7] = rt.u16[4];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_shufflehi_epi16(_mm_shufflelo_epi16(a, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_prot3w(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rt = ee->r[EE_D_RT];
     int d = EE_D_RD;
 
@@ -2595,8 +2976,15 @@ static inline void ee_i_prot3w(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u32[1] = rt.u32[2];
     ee->r[d].u32[2] = rt.u32[0];
     ee->r[d].u32[3] = rt.u32[3];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_shuffle_epi32(a, _MM_SHUFFLE(3, 0, 2, 1));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psllh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int sa = EE_D_SA & 0xf;
     int t = EE_D_RT;
     int d = EE_D_RD;
@@ -2609,16 +2997,37 @@ static inline void ee_i_psllh(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[5] = ee->r[t].u16[5] << sa;
     ee->r[d].u16[6] = ee->r[t].u16[6] << sa;
     ee->r[d].u16[7] = ee->r[t].u16[7] << sa;
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_sll_epi16(a, _mm_cvtsi32_si128(EE_D_SA & 0xf));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psllvw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int t = EE_D_RT;
     int d = EE_D_RD;
     int s = EE_D_RS;
 
     ee->r[d].u64[0] = SE6432(ee->r[t].u32[0] << (ee->r[s].u32[0] & 31));
     ee->r[d].u64[1] = SE6432(ee->r[t].u32[2] << (ee->r[s].u32[2] & 31));
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+
+    // Only words 0 and 2 are shifted, each by its own amount
+    b = _mm_and_si128(b, _mm_set_epi32(0, 31, 0, 31));
+
+    __m128i x = _mm_sll_epi32(a, b);
+    __m128i y = _mm_sll_epi32(a, _mm_srli_si128(b, 8));
+    __m128i r = _mm_sext_epi32_epi64(_mm_blend_epi16(x, y, 0xf0));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psllw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int sa = EE_D_SA;
     int t = EE_D_RT;
     int d = EE_D_RD;
@@ -2627,8 +3036,15 @@ static inline void ee_i_psllw(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u32[1] = ee->r[t].u32[1] << sa;
     ee->r[d].u32[2] = ee->r[t].u32[2] << sa;
     ee->r[d].u32[3] = ee->r[t].u32[3] << sa;
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_sll_epi32(a, _mm_cvtsi32_si128(EE_D_SA));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psrah(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int sa = EE_D_SA & 0xf;
     int t = EE_D_RT;
     int d = EE_D_RD;
@@ -2641,16 +3057,37 @@ static inline void ee_i_psrah(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[5] = ((int16_t)ee->r[t].u16[5]) >> sa;
     ee->r[d].u16[6] = ((int16_t)ee->r[t].u16[6]) >> sa;
     ee->r[d].u16[7] = ((int16_t)ee->r[t].u16[7]) >> sa;
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_sra_epi16(a, _mm_cvtsi32_si128(EE_D_SA & 0xf));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psravw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int s = EE_D_RS;
     int t = EE_D_RT;
     int d = EE_D_RD;
 
     ee->r[d].u64[0] = SE6432((int32_t)ee->r[t].u32[0] >> (ee->r[s].u32[0] & 31));
     ee->r[d].u64[1] = SE6432((int32_t)ee->r[t].u32[2] >> (ee->r[s].u32[2] & 31));
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+
+    // Only words 0 and 2 are shifted, each by its own amount
+    b = _mm_and_si128(b, _mm_set_epi32(0, 31, 0, 31));
+
+    __m128i x = _mm_sra_epi32(a, b);
+    __m128i y = _mm_sra_epi32(a, _mm_srli_si128(b, 8));
+    __m128i r = _mm_sext_epi32_epi64(_mm_blend_epi16(x, y, 0xf0));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psraw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int sa = EE_D_SA;
     int t = EE_D_RT;
     int d = EE_D_RD;
@@ -2659,8 +3096,15 @@ static inline void ee_i_psraw(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u32[1] = ((int32_t)ee->r[t].u32[1]) >> sa;
     ee->r[d].u32[2] = ((int32_t)ee->r[t].u32[2]) >> sa;
     ee->r[d].u32[3] = ((int32_t)ee->r[t].u32[3]) >> sa;
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_sra_epi32(a, _mm_cvtsi32_si128(EE_D_SA));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psrlh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int sa = EE_D_SA & 0xf;
     int t = EE_D_RT;
     int d = EE_D_RD;
@@ -2673,16 +3117,37 @@ static inline void ee_i_psrlh(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[5] = ee->r[t].u16[5] >> sa;
     ee->r[d].u16[6] = ee->r[t].u16[6] >> sa;
     ee->r[d].u16[7] = ee->r[t].u16[7] >> sa;
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_srl_epi16(a, _mm_cvtsi32_si128(EE_D_SA & 0xf));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psrlvw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
 
     ee->r[d].u64[0] = SE6432(ee->r[t].u32[0] >> (ee->r[s].u32[0] & 31));
     ee->r[d].u64[1] = SE6432(ee->r[t].u32[2] >> (ee->r[s].u32[2] & 31));
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+
+    // Only words 0 and 2 are shifted, each by its own amount
+    b = _mm_and_si128(b, _mm_set_epi32(0, 31, 0, 31));
+
+    __m128i x = _mm_srl_epi32(a, b);
+    __m128i y = _mm_srl_epi32(a, _mm_srli_si128(b, 8));
+    __m128i r = _mm_sext_epi32_epi64(_mm_blend_epi16(x, y, 0xf0));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psrlw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int sa = EE_D_SA;
     int t = EE_D_RT;
     int d = EE_D_RD;
@@ -2691,8 +3156,15 @@ static inline void ee_i_psrlw(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u32[1] = ee->r[t].u32[1] >> sa;
     ee->r[d].u32[2] = ee->r[t].u32[2] >> sa;
     ee->r[d].u32[3] = ee->r[t].u32[3] >> sa;
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_srl_epi32(a, _mm_cvtsi32_si128(EE_D_SA));
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psubb(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int t = EE_D_RT;
     int s = EE_D_RS;
     int d = EE_D_RD;
@@ -2713,8 +3185,16 @@ static inline void ee_i_psubb(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u8[13] = ee->r[s].u8[13] - ee->r[t].u8[13];
     ee->r[d].u8[14] = ee->r[s].u8[14] - ee->r[t].u8[14];
     ee->r[d].u8[15] = ee->r[s].u8[15] - ee->r[t].u8[15];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_sub_epi8(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psubh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int t = EE_D_RT;
     int s = EE_D_RS;
     int d = EE_D_RD;
@@ -2727,8 +3207,16 @@ static inline void ee_i_psubh(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[5] = ee->r[s].u16[5] - ee->r[t].u16[5];
     ee->r[d].u16[6] = ee->r[s].u16[6] - ee->r[t].u16[6];
     ee->r[d].u16[7] = ee->r[s].u16[7] - ee->r[t].u16[7];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_sub_epi16(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psubsb(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
@@ -2766,8 +3254,16 @@ static inline void ee_i_psubsb(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u8[13] = (r13 >= 0x7f) ? 0x7f : ((r13 < -0x80) ? 0x80 : r13);
     ee->r[d].u8[14] = (r14 >= 0x7f) ? 0x7f : ((r14 < -0x80) ? 0x80 : r14);
     ee->r[d].u8[15] = (r15 >= 0x7f) ? 0x7f : ((r15 < -0x80) ? 0x80 : r15);
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_subs_epi8(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psubsh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
@@ -2789,8 +3285,16 @@ static inline void ee_i_psubsh(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[5] = (r5 >= 0x7fff) ? 0x7fff : ((r5 < -0x8000) ? 0x8000 : r5);
     ee->r[d].u16[6] = (r6 >= 0x7fff) ? 0x7fff : ((r6 < -0x8000) ? 0x8000 : r6);
     ee->r[d].u16[7] = (r7 >= 0x7fff) ? 0x7fff : ((r7 < -0x8000) ? 0x8000 : r7);
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_subs_epi16(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psubsw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
@@ -2804,8 +3308,16 @@ static inline void ee_i_psubsw(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u32[1] = (r1 >= 0x7fffffff) ? 0x7fffffff : ((r1 < (int32_t)0x80000000) ? 0x80000000 : r1);
     ee->r[d].u32[2] = (r2 >= 0x7fffffff) ? 0x7fffffff : ((r2 < (int32_t)0x80000000) ? 0x80000000 : r2);
     ee->r[d].u32[3] = (r3 >= 0x7fffffff) ? 0x7fffffff : ((r3 < (int32_t)0x80000000) ? 0x80000000 : r3);
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_subs_epi32(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psubub(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
@@ -2843,8 +3355,16 @@ static inline void ee_i_psubub(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u8[13] = (r13 < 0) ? 0 : r13;
     ee->r[d].u8[14] = (r14 < 0) ? 0 : r14;
     ee->r[d].u8[15] = (r15 < 0) ? 0 : r15;
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_subs_epu8(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psubuh(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
@@ -2866,8 +3386,16 @@ static inline void ee_i_psubuh(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u16[5] = (r5 < 0) ? 0 : r5;
     ee->r[d].u16[6] = (r6 < 0) ? 0 : r6;
     ee->r[d].u16[7] = (r7 < 0) ? 0 : r7;
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_subs_epu16(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psubuw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
@@ -2881,8 +3409,16 @@ static inline void ee_i_psubuw(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u32[1] = (r1 < 0) ? 0 : r1;
     ee->r[d].u32[2] = (r2 < 0) ? 0 : r2;
     ee->r[d].u32[3] = (r3 < 0) ? 0 : r3;
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_subs_epu32(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_psubw(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     int d = EE_D_RD;
     int s = EE_D_RS;
     int t = EE_D_RT;
@@ -2891,16 +3427,32 @@ static inline void ee_i_psubw(struct ee_state* ee, const ee_instruction& i) {
     ee->r[d].u32[1] = ee->r[s].u32[1] - ee->r[t].u32[1];
     ee->r[d].u32[2] = ee->r[s].u32[2] - ee->r[t].u32[2];
     ee->r[d].u32[3] = ee->r[s].u32[3] - ee->r[t].u32[3];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_sub_epi32(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_pxor(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rs = ee->r[EE_D_RS];
     uint128_t rt = ee->r[EE_D_RT];
     int d = EE_D_RD;
 
     ee->r[d].u64[0] = rs.u64[0] ^ rt.u64[0];
     ee->r[d].u64[1] = rs.u64[1] ^ rt.u64[1];
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i r = _mm_xor_si128(a, b);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_qfsrv(struct ee_state* ee, const ee_instruction& i) {
+#ifndef _EE_USE_INTRINSICS
     uint128_t rs = ee->r[EE_D_RS];
     uint128_t rt = ee->r[EE_D_RT];
     int d = EE_D_RD;
@@ -2929,6 +3481,24 @@ static inline void ee_i_qfsrv(struct ee_state* ee, const ee_instruction& i) {
     }
 
     ee->r[d] = v;
+#else
+    __m128i a = _mm_load_si128((__m128i*)&ee->r[EE_D_RT]);
+    __m128i b = _mm_load_si128((__m128i*)&ee->r[EE_D_RS]);
+
+    // Funnel shift rs:rt right by SA bytes. Indices that run past rt
+    // end up with bit 7 set after the bias, which makes PSHUFB zero
+    // them, and rs indices below 0 wrap around to the same effect
+    __m128i n = _mm_add_epi8(
+        _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+        _mm_set1_epi8(ee->sa)
+    );
+
+    __m128i x = _mm_shuffle_epi8(a, _mm_add_epi8(n, _mm_set1_epi8(0x70)));
+    __m128i y = _mm_shuffle_epi8(b, _mm_sub_epi8(n, _mm_set1_epi8(16)));
+    __m128i r = _mm_or_si128(x, y);
+
+    _mm_store_si128((__m128i*)&ee->r[EE_D_RD], r);
+#endif
 }
 static inline void ee_i_qmfc2(struct ee_state* ee, const ee_instruction& i) {
     int t = EE_D_RT;
@@ -3286,21 +3856,21 @@ static inline void ee_i_tne(struct ee_state* ee, const ee_instruction& i) {
     if (EE_RS != EE_RT) ee_exception_level1(ee, CAUSE_EXC1_TR);
 }
 static inline void ee_i_tnei(struct ee_state* ee, const ee_instruction& i) { fprintf(stderr, "ee: tnei unimplemented\n"); exit(1); }
-static inline void ee_i_vabs(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(abs) }
-static inline void ee_i_vadd(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(add) }
-static inline void ee_i_vadda(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(adda) }
-static inline void ee_i_vaddai(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addai) }
-static inline void ee_i_vaddaq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addaq) }
-static inline void ee_i_vaddaw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addaw) }
-static inline void ee_i_vaddax(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addax) }
-static inline void ee_i_vadday(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(adday) }
-static inline void ee_i_vaddaz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addaz) }
-static inline void ee_i_vaddi(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addi) }
-static inline void ee_i_vaddq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addq) }
-static inline void ee_i_vaddw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addw) }
-static inline void ee_i_vaddx(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addx) }
-static inline void ee_i_vaddy(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addy) }
-static inline void ee_i_vaddz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addz) }
+template <int di> static inline void ee_i_vabs(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(abs) }
+template <int di> static inline void ee_i_vadd(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(add) }
+template <int di> static inline void ee_i_vadda(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(adda) }
+template <int di> static inline void ee_i_vaddai(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addai) }
+template <int di> static inline void ee_i_vaddaq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addaq) }
+template <int di> static inline void ee_i_vaddaw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addaw) }
+template <int di> static inline void ee_i_vaddax(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addax) }
+template <int di> static inline void ee_i_vadday(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(adday) }
+template <int di> static inline void ee_i_vaddaz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addaz) }
+template <int di> static inline void ee_i_vaddi(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addi) }
+template <int di> static inline void ee_i_vaddq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addq) }
+template <int di> static inline void ee_i_vaddw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addw) }
+template <int di> static inline void ee_i_vaddx(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addx) }
+template <int di> static inline void ee_i_vaddy(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addy) }
+template <int di> static inline void ee_i_vaddz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(addz) }
 static inline void ee_i_vcallms(struct ee_state* ee, const ee_instruction& i) {
     vu_execute_program(ee->vu0, EE_D_I15);
 }
@@ -3309,106 +3879,106 @@ static inline void ee_i_vcallmsr(struct ee_state* ee, const ee_instruction& i) {
 }
 static inline void ee_i_vclipw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER(clip) }
 static inline void ee_i_vdiv(struct ee_state* ee, const ee_instruction& i) { VU_LOWER(div) }
-static inline void ee_i_vftoi0(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(ftoi0) }
-static inline void ee_i_vftoi12(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(ftoi12) }
-static inline void ee_i_vftoi15(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(ftoi15) }
-static inline void ee_i_vftoi4(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(ftoi4) }
+template <int di> static inline void ee_i_vftoi0(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(ftoi0) }
+template <int di> static inline void ee_i_vftoi12(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(ftoi12) }
+template <int di> static inline void ee_i_vftoi15(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(ftoi15) }
+template <int di> static inline void ee_i_vftoi4(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(ftoi4) }
 static inline void ee_i_viadd(struct ee_state* ee, const ee_instruction& i) { VU_LOWER(iadd) }
 static inline void ee_i_viaddi(struct ee_state* ee, const ee_instruction& i) { VU_LOWER(iaddi) }
 static inline void ee_i_viand(struct ee_state* ee, const ee_instruction& i) { VU_LOWER(iand) }
-static inline void ee_i_vilwr(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(ilwr) }
+template <int di> static inline void ee_i_vilwr(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(ilwr) }
 static inline void ee_i_vior(struct ee_state* ee, const ee_instruction& i) { VU_LOWER(ior) }
 static inline void ee_i_visub(struct ee_state* ee, const ee_instruction& i) { VU_LOWER(isub) }
-static inline void ee_i_viswr(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(iswr) }
-static inline void ee_i_vitof0(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(itof0) }
-static inline void ee_i_vitof12(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(itof12) }
-static inline void ee_i_vitof15(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(itof15) }
-static inline void ee_i_vitof4(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(itof4) }
-static inline void ee_i_vlqd(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(lqd) }
-static inline void ee_i_vlqi(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(lqi) }
-static inline void ee_i_vmadd(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(madd) }
-static inline void ee_i_vmadda(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(madda) }
-static inline void ee_i_vmaddai(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddai) }
-static inline void ee_i_vmaddaq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddaq) }
-static inline void ee_i_vmaddaw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddaw) }
-static inline void ee_i_vmaddax(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddax) }
-static inline void ee_i_vmadday(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(madday) }
-static inline void ee_i_vmaddaz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddaz) }
-static inline void ee_i_vmaddi(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddi) }
-static inline void ee_i_vmaddq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddq) }
-static inline void ee_i_vmaddw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddw) }
-static inline void ee_i_vmaddx(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddx) }
-static inline void ee_i_vmaddy(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddy) }
-static inline void ee_i_vmaddz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddz) }
-static inline void ee_i_vmax(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(max) }
-static inline void ee_i_vmaxi(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maxi) }
-static inline void ee_i_vmaxw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maxw) }
-static inline void ee_i_vmaxx(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maxx) }
-static inline void ee_i_vmaxy(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maxy) }
-static inline void ee_i_vmaxz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maxz) }
-static inline void ee_i_vmfir(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mfir) }
-static inline void ee_i_vmini(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mini) }
-static inline void ee_i_vminii(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(minii) }
-static inline void ee_i_vminiw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(miniw) }
-static inline void ee_i_vminix(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(minix) }
-static inline void ee_i_vminiy(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(miniy) }
-static inline void ee_i_vminiz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(miniz) }
-static inline void ee_i_vmove(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(move) }
-static inline void ee_i_vmr32(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(mr32) }
-static inline void ee_i_vmsub(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msub) }
-static inline void ee_i_vmsuba(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msuba) }
-static inline void ee_i_vmsubai(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubai) }
-static inline void ee_i_vmsubaq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubaq) }
-static inline void ee_i_vmsubaw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubaw) }
-static inline void ee_i_vmsubax(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubax) }
-static inline void ee_i_vmsubay(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubay) }
-static inline void ee_i_vmsubaz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubaz) }
-static inline void ee_i_vmsubi(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubi) }
-static inline void ee_i_vmsubq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubq) }
-static inline void ee_i_vmsubw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubw) }
-static inline void ee_i_vmsubx(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubx) }
-static inline void ee_i_vmsuby(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msuby) }
-static inline void ee_i_vmsubz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubz) }
+template <int di> static inline void ee_i_viswr(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(iswr) }
+template <int di> static inline void ee_i_vitof0(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(itof0) }
+template <int di> static inline void ee_i_vitof12(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(itof12) }
+template <int di> static inline void ee_i_vitof15(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(itof15) }
+template <int di> static inline void ee_i_vitof4(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(itof4) }
+template <int di> static inline void ee_i_vlqd(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(lqd) }
+template <int di> static inline void ee_i_vlqi(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(lqi) }
+template <int di> static inline void ee_i_vmadd(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(madd) }
+template <int di> static inline void ee_i_vmadda(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(madda) }
+template <int di> static inline void ee_i_vmaddai(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddai) }
+template <int di> static inline void ee_i_vmaddaq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddaq) }
+template <int di> static inline void ee_i_vmaddaw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddaw) }
+template <int di> static inline void ee_i_vmaddax(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddax) }
+template <int di> static inline void ee_i_vmadday(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(madday) }
+template <int di> static inline void ee_i_vmaddaz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddaz) }
+template <int di> static inline void ee_i_vmaddi(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddi) }
+template <int di> static inline void ee_i_vmaddq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddq) }
+template <int di> static inline void ee_i_vmaddw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddw) }
+template <int di> static inline void ee_i_vmaddx(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddx) }
+template <int di> static inline void ee_i_vmaddy(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddy) }
+template <int di> static inline void ee_i_vmaddz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maddz) }
+template <int di> static inline void ee_i_vmax(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(max) }
+template <int di> static inline void ee_i_vmaxi(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maxi) }
+template <int di> static inline void ee_i_vmaxw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maxw) }
+template <int di> static inline void ee_i_vmaxx(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maxx) }
+template <int di> static inline void ee_i_vmaxy(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maxy) }
+template <int di> static inline void ee_i_vmaxz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(maxz) }
+template <int di> static inline void ee_i_vmfir(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mfir) }
+template <int di> static inline void ee_i_vmini(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mini) }
+template <int di> static inline void ee_i_vminii(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(minii) }
+template <int di> static inline void ee_i_vminiw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(miniw) }
+template <int di> static inline void ee_i_vminix(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(minix) }
+template <int di> static inline void ee_i_vminiy(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(miniy) }
+template <int di> static inline void ee_i_vminiz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(miniz) }
+template <int di> static inline void ee_i_vmove(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(move) }
+template <int di> static inline void ee_i_vmr32(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(mr32) }
+template <int di> static inline void ee_i_vmsub(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msub) }
+template <int di> static inline void ee_i_vmsuba(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msuba) }
+template <int di> static inline void ee_i_vmsubai(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubai) }
+template <int di> static inline void ee_i_vmsubaq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubaq) }
+template <int di> static inline void ee_i_vmsubaw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubaw) }
+template <int di> static inline void ee_i_vmsubax(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubax) }
+template <int di> static inline void ee_i_vmsubay(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubay) }
+template <int di> static inline void ee_i_vmsubaz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubaz) }
+template <int di> static inline void ee_i_vmsubi(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubi) }
+template <int di> static inline void ee_i_vmsubq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubq) }
+template <int di> static inline void ee_i_vmsubw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubw) }
+template <int di> static inline void ee_i_vmsubx(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubx) }
+template <int di> static inline void ee_i_vmsuby(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msuby) }
+template <int di> static inline void ee_i_vmsubz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(msubz) }
 static inline void ee_i_vmtir(struct ee_state* ee, const ee_instruction& i) { VU_LOWER(mtir) }
-static inline void ee_i_vmul(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mul) }
-static inline void ee_i_vmula(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mula) }
-static inline void ee_i_vmulai(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulai) }
-static inline void ee_i_vmulaq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulaq) }
-static inline void ee_i_vmulaw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulaw) }
-static inline void ee_i_vmulax(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulax) }
-static inline void ee_i_vmulay(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulay) }
-static inline void ee_i_vmulaz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulaz) }
-static inline void ee_i_vmuli(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(muli) }
-static inline void ee_i_vmulq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulq) }
-static inline void ee_i_vmulw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulw) }
-static inline void ee_i_vmulx(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulx) }
-static inline void ee_i_vmuly(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(muly) }
-static inline void ee_i_vmulz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulz) }
+template <int di> static inline void ee_i_vmul(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mul) }
+template <int di> static inline void ee_i_vmula(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mula) }
+template <int di> static inline void ee_i_vmulai(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulai) }
+template <int di> static inline void ee_i_vmulaq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulaq) }
+template <int di> static inline void ee_i_vmulaw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulaw) }
+template <int di> static inline void ee_i_vmulax(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulax) }
+template <int di> static inline void ee_i_vmulay(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulay) }
+template <int di> static inline void ee_i_vmulaz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulaz) }
+template <int di> static inline void ee_i_vmuli(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(muli) }
+template <int di> static inline void ee_i_vmulq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulq) }
+template <int di> static inline void ee_i_vmulw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulw) }
+template <int di> static inline void ee_i_vmulx(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulx) }
+template <int di> static inline void ee_i_vmuly(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(muly) }
+template <int di> static inline void ee_i_vmulz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(mulz) }
 static inline void ee_i_vnop(struct ee_state* ee, const ee_instruction& i) { VU_UPPER(nop) }
 static inline void ee_i_vopmsub(struct ee_state* ee, const ee_instruction& i) { VU_UPPER(opmsub) }
 static inline void ee_i_vopmula(struct ee_state* ee, const ee_instruction& i) { VU_UPPER(opmula) }
-static inline void ee_i_vrget(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(rget) }
+template <int di> static inline void ee_i_vrget(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(rget) }
 static inline void ee_i_vrinit(struct ee_state* ee, const ee_instruction& i) { VU_LOWER(rinit) }
-static inline void ee_i_vrnext(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(rnext) }
+template <int di> static inline void ee_i_vrnext(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(rnext) }
 static inline void ee_i_vrsqrt(struct ee_state* ee, const ee_instruction& i) { VU_LOWER(rsqrt) }
 static inline void ee_i_vrxor(struct ee_state* ee, const ee_instruction& i) { VU_LOWER(rxor) }
-static inline void ee_i_vsqd(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(sqd) }
-static inline void ee_i_vsqi(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(sqi) }
+template <int di> static inline void ee_i_vsqd(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(sqd) }
+template <int di> static inline void ee_i_vsqi(struct ee_state* ee, const ee_instruction& i) { VU_LOWER_TEMPLATE(sqi) }
 static inline void ee_i_vsqrt(struct ee_state* ee, const ee_instruction& i) { VU_LOWER(sqrt) }
-static inline void ee_i_vsub(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(sub) }
-static inline void ee_i_vsuba(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(suba) }
-static inline void ee_i_vsubai(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subai) }
-static inline void ee_i_vsubaq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subaq) }
-static inline void ee_i_vsubaw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subaw) }
-static inline void ee_i_vsubax(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subax) }
-static inline void ee_i_vsubay(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subay) }
-static inline void ee_i_vsubaz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subaz) }
-static inline void ee_i_vsubi(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subi) }
-static inline void ee_i_vsubq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subq) }
-static inline void ee_i_vsubw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subw) }
-static inline void ee_i_vsubx(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subx) }
-static inline void ee_i_vsuby(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(suby) }
-static inline void ee_i_vsubz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subz) }
+template <int di> static inline void ee_i_vsub(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(sub) }
+template <int di> static inline void ee_i_vsuba(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(suba) }
+template <int di> static inline void ee_i_vsubai(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subai) }
+template <int di> static inline void ee_i_vsubaq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subaq) }
+template <int di> static inline void ee_i_vsubaw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subaw) }
+template <int di> static inline void ee_i_vsubax(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subax) }
+template <int di> static inline void ee_i_vsubay(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subay) }
+template <int di> static inline void ee_i_vsubaz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subaz) }
+template <int di> static inline void ee_i_vsubi(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subi) }
+template <int di> static inline void ee_i_vsubq(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subq) }
+template <int di> static inline void ee_i_vsubw(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subw) }
+template <int di> static inline void ee_i_vsubx(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subx) }
+template <int di> static inline void ee_i_vsuby(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(suby) }
+template <int di> static inline void ee_i_vsubz(struct ee_state* ee, const ee_instruction& i) { VU_UPPER_TEMPLATE(subz) }
 static inline void ee_i_vwaitq(struct ee_state* ee, const ee_instruction& i) { VU_LOWER(waitq) }
 static inline void ee_i_xor(struct ee_state* ee, const ee_instruction& i) {
     EE_RD = EE_RS ^ EE_RT;
@@ -3417,7 +3987,11 @@ static inline void ee_i_xori(struct ee_state* ee, const ee_instruction& i) {
     EE_RT = EE_RS ^ EE_D_I16;
 }
 static inline void ee_i_invalid(struct ee_state* ee, const ee_instruction& i) {
-    fprintf(stderr, "ee: Invalid instruction %08x at PC=%08x\n", i.opcode, ee->pc);
+    // ee_decode stashes the primary opcode in sa for invalid encodings,
+    // the rest of the word is still held by rs, rt and i16
+    uint32_t opcode = (i.sa << 26) | (i.rs << 21) | (i.rt << 16) | i.i16;
+
+    fprintf(stderr, "ee: Invalid instruction %08x at PC=%08x\n", opcode, ee->pc - 4);
 
     exit(1);
 }
@@ -3490,6 +4064,10 @@ void ee_reset(struct ee_state* ee) {
     ee->next_pc = ee->pc + 4;
     ee->intc_reads = 0;
     ee->csr_reads = 0;
+    ee->breakpoint_hit = 0;
+    ee->breakpoint_skip = 0;
+    ee->breakpoint_delay = 0;
+    ee->idle = 0;
 
     ee->block_cache.clear();
     ee->block_cache.resize(EE_CACHE_PAGECOUNT);
@@ -3516,20 +4094,43 @@ void ee_destroy(struct ee_state* ee) {
 #define EE_BRANCH_LIKELY 3
 #define EE_BRANCH_COND 4
 
+// Picks the instantiation of a templated COP2 macro handler for the
+// instruction's dest mask
+#define EE_VU_TEMPLATE_FN(f) \
+    [](uint32_t opcode) -> void (*)(struct ee_state*, const ee_instruction&) { \
+        switch ((opcode >> 21) & 0xf) { \
+            case 0: return &f<0>; \
+            case 1: return &f<VU_D_W>; \
+            case 2: return &f<VU_D_Z>; \
+            case 3: return &f<VU_D_Z | VU_D_W>; \
+            case 4: return &f<VU_D_Y>; \
+            case 5: return &f<VU_D_Y | VU_D_W>; \
+            case 6: return &f<VU_D_Y | VU_D_Z>; \
+            case 7: return &f<VU_D_Y | VU_D_Z | VU_D_W>; \
+            case 8: return &f<VU_D_X>; \
+            case 9: return &f<VU_D_X | VU_D_W>; \
+            case 10: return &f<VU_D_X | VU_D_Z>; \
+            case 11: return &f<VU_D_X | VU_D_Z | VU_D_W>; \
+            case 12: return &f<VU_D_X | VU_D_Y>; \
+            case 13: return &f<VU_D_X | VU_D_Y | VU_D_W>; \
+            case 14: return &f<VU_D_X | VU_D_Y | VU_D_Z>; \
+            case 15: return &f<VU_D_X | VU_D_Y | VU_D_Z | VU_D_W>; \
+            default: __builtin_unreachable(); \
+        } \
+    }(opcode)
+
 ee_instruction ee_decode(uint32_t opcode) {
     ee_instruction i;
 
-    i.opcode = opcode;
     i.rs = (opcode >> 21) & 0x1f;
     i.rt = (opcode >> 16) & 0x1f;
     i.rd = (opcode >> 11) & 0x1f;
     i.sa = (opcode >> 6) & 0x1f;
-    i.i15 = (opcode >> 6) & 0x7fff;
     i.i16 = opcode & 0xffff;
-    i.i26 = opcode & 0x3ffffff;
 
     i.branch = 0;
     i.cycles = 0;
+    i.vu_op = EE_VU_NONE;
 
     switch ((opcode & 0xFC000000) >> 26) {
         case 0x00000000 >> 26: { // special
@@ -3726,59 +4327,59 @@ ee_instruction ee_decode(uint32_t opcode) {
                 case 0x03C00000 >> 21:
                 case 0x03E00000 >> 21: {
                     switch (opcode & 0x0000003F) {
-                        case 0x00000000: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vaddx; return i;
-                        case 0x00000001: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vaddy; return i;
-                        case 0x00000002: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vaddz; return i;
-                        case 0x00000003: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vaddw; return i;
-                        case 0x00000004: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vsubx; return i;
-                        case 0x00000005: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vsuby; return i;
-                        case 0x00000006: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vsubz; return i;
-                        case 0x00000007: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vsubw; return i;
-                        case 0x00000008: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmaddx; return i;
-                        case 0x00000009: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmaddy; return i;
-                        case 0x0000000A: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmaddz; return i;
-                        case 0x0000000B: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmaddw; return i;
-                        case 0x0000000C: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmsubx; return i;
-                        case 0x0000000D: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmsuby; return i;
-                        case 0x0000000E: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmsubz; return i;
-                        case 0x0000000F: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmsubw; return i;
-                        case 0x00000010: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmaxx; return i;
-                        case 0x00000011: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmaxy; return i;
-                        case 0x00000012: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmaxz; return i;
-                        case 0x00000013: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmaxw; return i;
-                        case 0x00000014: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vminix; return i;
-                        case 0x00000015: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vminiy; return i;
-                        case 0x00000016: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vminiz; return i;
-                        case 0x00000017: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vminiw; return i;
-                        case 0x00000018: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmulx; return i;
-                        case 0x00000019: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmuly; return i;
-                        case 0x0000001A: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmulz; return i;
-                        case 0x0000001B: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmulw; return i;
-                        case 0x0000001C: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmulq; return i;
-                        case 0x0000001D: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmaxi; return i;
-                        case 0x0000001E: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmuli; return i;
-                        case 0x0000001F: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vminii; return i;
-                        case 0x00000020: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vaddq; return i;
-                        case 0x00000021: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmaddq; return i;
-                        case 0x00000022: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vaddi; return i;
-                        case 0x00000023: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmaddi; return i;
-                        case 0x00000024: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vsubq; return i;
-                        case 0x00000025: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmsubq; return i;
-                        case 0x00000026: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vsubi; return i;
-                        case 0x00000027: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmsubi; return i;
-                        case 0x00000028: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vadd; return i;
-                        case 0x00000029: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmadd; return i;
-                        case 0x0000002A: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmul; return i;
-                        case 0x0000002B: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmax; return i;
-                        case 0x0000002C: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vsub; return i;
-                        case 0x0000002D: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmsub; return i;
-                        case 0x0000002E: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vopmsub; return i;
-                        case 0x0000002F: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmini; return i;
-                        case 0x00000030: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_viadd; return i;
-                        case 0x00000031: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_visub; return i;
-                        case 0x00000032: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_viaddi; return i;
-                        case 0x00000034: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_viand; return i;
-                        case 0x00000035: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vior; return i;
+                        case 0x00000000: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vaddx); return i;
+                        case 0x00000001: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vaddy); return i;
+                        case 0x00000002: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vaddz); return i;
+                        case 0x00000003: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vaddw); return i;
+                        case 0x00000004: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vsubx); return i;
+                        case 0x00000005: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vsuby); return i;
+                        case 0x00000006: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vsubz); return i;
+                        case 0x00000007: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vsubw); return i;
+                        case 0x00000008: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmaddx); return i;
+                        case 0x00000009: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmaddy); return i;
+                        case 0x0000000A: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmaddz); return i;
+                        case 0x0000000B: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmaddw); return i;
+                        case 0x0000000C: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmsubx); return i;
+                        case 0x0000000D: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmsuby); return i;
+                        case 0x0000000E: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmsubz); return i;
+                        case 0x0000000F: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmsubw); return i;
+                        case 0x00000010: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmaxx); return i;
+                        case 0x00000011: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmaxy); return i;
+                        case 0x00000012: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmaxz); return i;
+                        case 0x00000013: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmaxw); return i;
+                        case 0x00000014: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vminix); return i;
+                        case 0x00000015: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vminiy); return i;
+                        case 0x00000016: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vminiz); return i;
+                        case 0x00000017: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vminiw); return i;
+                        case 0x00000018: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmulx); return i;
+                        case 0x00000019: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmuly); return i;
+                        case 0x0000001A: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmulz); return i;
+                        case 0x0000001B: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmulw); return i;
+                        case 0x0000001C: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmulq); return i;
+                        case 0x0000001D: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmaxi); return i;
+                        case 0x0000001E: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmuli); return i;
+                        case 0x0000001F: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vminii); return i;
+                        case 0x00000020: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vaddq); return i;
+                        case 0x00000021: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmaddq); return i;
+                        case 0x00000022: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vaddi); return i;
+                        case 0x00000023: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmaddi); return i;
+                        case 0x00000024: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vsubq); return i;
+                        case 0x00000025: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmsubq); return i;
+                        case 0x00000026: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vsubi); return i;
+                        case 0x00000027: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmsubi); return i;
+                        case 0x00000028: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vadd); return i;
+                        case 0x00000029: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmadd); return i;
+                        case 0x0000002A: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmul); return i;
+                        case 0x0000002B: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmax); return i;
+                        case 0x0000002C: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vsub); return i;
+                        case 0x0000002D: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmsub); return i;
+                        case 0x0000002E: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = ee_i_vopmsub; return i;
+                        case 0x0000002F: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmini); return i;
+                        case 0x00000030: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = ee_i_viadd; return i;
+                        case 0x00000031: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = ee_i_visub; return i;
+                        case 0x00000032: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = ee_i_viaddi; return i;
+                        case 0x00000034: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = ee_i_viand; return i;
+                        case 0x00000035: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = ee_i_vior; return i;
                         case 0x00000038: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vcallms; return i;
                         case 0x00000039: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vcallmsr; return i;
                         case 0x0000003C:
@@ -3788,71 +4389,71 @@ ee_instruction ee_decode(uint32_t opcode) {
                             uint32_t func = (opcode & 3) | ((opcode & 0x7c0) >> 4);
 
                             switch (func) {
-                                case 0x00000000: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vaddax; return i;
-                                case 0x00000001: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vadday; return i;
-                                case 0x00000002: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vaddaz; return i;
-                                case 0x00000003: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vaddaw; return i;
-                                case 0x00000004: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vsubax; return i;
-                                case 0x00000005: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vsubay; return i;
-                                case 0x00000006: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vsubaz; return i;
-                                case 0x00000007: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vsubaw; return i;
-                                case 0x00000008: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmaddax; return i;
-                                case 0x00000009: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmadday; return i;
-                                case 0x0000000A: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmaddaz; return i;
-                                case 0x0000000B: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmaddaw; return i;
-                                case 0x0000000C: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmsubax; return i;
-                                case 0x0000000D: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmsubay; return i;
-                                case 0x0000000E: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmsubaz; return i;
-                                case 0x0000000F: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmsubaw; return i;
-                                case 0x00000010: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vitof0; return i;
-                                case 0x00000011: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vitof4; return i;
-                                case 0x00000012: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vitof12; return i;
-                                case 0x00000013: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vitof15; return i;
-                                case 0x00000014: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vftoi0; return i;
-                                case 0x00000015: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vftoi4; return i;
-                                case 0x00000016: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vftoi12; return i;
-                                case 0x00000017: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vftoi15; return i;
-                                case 0x00000018: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmulax; return i;
-                                case 0x00000019: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmulay; return i;
-                                case 0x0000001A: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmulaz; return i;
-                                case 0x0000001B: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmulaw; return i;
-                                case 0x0000001C: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmulaq; return i;
-                                case 0x0000001D: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vabs; return i;
-                                case 0x0000001E: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmulai; return i;
-                                case 0x0000001F: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vclipw; return i;
-                                case 0x00000020: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vaddaq; return i;
-                                case 0x00000021: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmaddaq; return i;
-                                case 0x00000022: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vaddai; return i;
-                                case 0x00000023: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmaddai; return i;
-                                case 0x00000024: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vsubaq; return i;
-                                case 0x00000025: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmsubaq; return i;
-                                case 0x00000026: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vsubai; return i;
-                                case 0x00000027: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmsubai; return i;
-                                case 0x00000028: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vadda; return i;
-                                case 0x00000029: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmadda; return i;
-                                case 0x0000002A: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmula; return i;
-                                case 0x0000002C: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vsuba; return i;
-                                case 0x0000002D: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmsuba; return i;
-                                case 0x0000002E: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vopmula; return i;
-                                case 0x0000002F: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vnop; return i;
-                                case 0x00000030: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmove; return i;
-                                case 0x00000031: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmr32; return i;
-                                case 0x00000034: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vlqi; return i;
-                                case 0x00000035: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vsqi; return i;
-                                case 0x00000036: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vlqd; return i;
-                                case 0x00000037: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vsqd; return i;
-                                case 0x00000038: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vdiv; return i;
-                                case 0x00000039: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vsqrt; return i;
-                                case 0x0000003A: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vrsqrt; return i;
-                                case 0x0000003B: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vwaitq; return i;
-                                case 0x0000003C: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmtir; return i;
-                                case 0x0000003D: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vmfir; return i;
-                                case 0x0000003E: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vilwr; return i;
-                                case 0x0000003F: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_viswr; return i;
-                                case 0x00000040: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vrnext; return i;
-                                case 0x00000041: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vrget; return i;
-                                case 0x00000042: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vrinit; return i;
-                                case 0x00000043: i.cycles = EE_CYC_COP_DEFAULT; i.func = ee_i_vrxor; return i;
+                                case 0x00000000: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vaddax); return i;
+                                case 0x00000001: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vadday); return i;
+                                case 0x00000002: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vaddaz); return i;
+                                case 0x00000003: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vaddaw); return i;
+                                case 0x00000004: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vsubax); return i;
+                                case 0x00000005: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vsubay); return i;
+                                case 0x00000006: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vsubaz); return i;
+                                case 0x00000007: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vsubaw); return i;
+                                case 0x00000008: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmaddax); return i;
+                                case 0x00000009: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmadday); return i;
+                                case 0x0000000A: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmaddaz); return i;
+                                case 0x0000000B: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmaddaw); return i;
+                                case 0x0000000C: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmsubax); return i;
+                                case 0x0000000D: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmsubay); return i;
+                                case 0x0000000E: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmsubaz); return i;
+                                case 0x0000000F: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmsubaw); return i;
+                                case 0x00000010: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vitof0); return i;
+                                case 0x00000011: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vitof4); return i;
+                                case 0x00000012: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vitof12); return i;
+                                case 0x00000013: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vitof15); return i;
+                                case 0x00000014: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vftoi0); return i;
+                                case 0x00000015: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vftoi4); return i;
+                                case 0x00000016: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vftoi12); return i;
+                                case 0x00000017: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vftoi15); return i;
+                                case 0x00000018: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmulax); return i;
+                                case 0x00000019: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmulay); return i;
+                                case 0x0000001A: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmulaz); return i;
+                                case 0x0000001B: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmulaw); return i;
+                                case 0x0000001C: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmulaq); return i;
+                                case 0x0000001D: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vabs); return i;
+                                case 0x0000001E: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmulai); return i;
+                                case 0x0000001F: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = ee_i_vclipw; return i;
+                                case 0x00000020: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vaddaq); return i;
+                                case 0x00000021: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmaddaq); return i;
+                                case 0x00000022: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vaddai); return i;
+                                case 0x00000023: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmaddai); return i;
+                                case 0x00000024: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vsubaq); return i;
+                                case 0x00000025: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmsubaq); return i;
+                                case 0x00000026: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vsubai); return i;
+                                case 0x00000027: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmsubai); return i;
+                                case 0x00000028: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vadda); return i;
+                                case 0x00000029: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmadda); return i;
+                                case 0x0000002A: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmula); return i;
+                                case 0x0000002C: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vsuba); return i;
+                                case 0x0000002D: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmsuba); return i;
+                                case 0x0000002E: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = ee_i_vopmula; return i;
+                                case 0x0000002F: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = ee_i_vnop; return i;
+                                case 0x00000030: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmove); return i;
+                                case 0x00000031: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmr32); return i;
+                                case 0x00000034: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = EE_VU_TEMPLATE_FN(ee_i_vlqi); return i;
+                                case 0x00000035: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = EE_VU_TEMPLATE_FN(ee_i_vsqi); return i;
+                                case 0x00000036: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = EE_VU_TEMPLATE_FN(ee_i_vlqd); return i;
+                                case 0x00000037: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = EE_VU_TEMPLATE_FN(ee_i_vsqd); return i;
+                                case 0x00000038: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = ee_i_vdiv; return i;
+                                case 0x00000039: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = ee_i_vsqrt; return i;
+                                case 0x0000003A: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = ee_i_vrsqrt; return i;
+                                case 0x0000003B: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = ee_i_vwaitq; return i;
+                                case 0x0000003C: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = ee_i_vmtir; return i;
+                                case 0x0000003D: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_UPPER; i.func = EE_VU_TEMPLATE_FN(ee_i_vmfir); return i;
+                                case 0x0000003E: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = EE_VU_TEMPLATE_FN(ee_i_vilwr); return i;
+                                case 0x0000003F: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = EE_VU_TEMPLATE_FN(ee_i_viswr); return i;
+                                case 0x00000040: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = EE_VU_TEMPLATE_FN(ee_i_vrnext); return i;
+                                case 0x00000041: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = EE_VU_TEMPLATE_FN(ee_i_vrget); return i;
+                                case 0x00000042: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = ee_i_vrinit; return i;
+                                case 0x00000043: i.cycles = EE_CYC_COP_DEFAULT; i.vu_op = EE_VU_LOWER; i.func = ee_i_vrxor; return i;
                             }
                         } break;
                     }
@@ -4021,11 +4622,215 @@ ee_instruction ee_decode(uint32_t opcode) {
         case 0xFC000000 >> 26: i.cycles = EE_CYC_STORE; i.func = ee_i_sd; return i;
     }
 
+    // rd and sa are redundant with i16 here, keep the primary opcode
+    // so ee_i_invalid can report the full word
+    i.sa = opcode >> 26;
     i.func = ee_i_invalid;
 
     return i;
 }
 
+#define EE_IDLE_MAX_INSTRUCTIONS 16
+
+static inline bool ee_is_idle_load(const ee_instruction& i) {
+    return i.func == ee_i_lb || i.func == ee_i_lbu || i.func == ee_i_lh ||
+           i.func == ee_i_lhu || i.func == ee_i_lw || i.func == ee_i_lwu ||
+           i.func == ee_i_ld || i.func == ee_i_lq;
+}
+
+// Get the GPRs read and written by instructions that are allowed
+// inside an idle loop. Anything that can write memory, raise an
+// exception or touch coprocessor state disqualifies the loop
+static inline int ee_get_idle_regs(const ee_instruction& i, uint32_t* r, uint32_t* w) {
+    *r = 0;
+    *w = 0;
+
+    if (i.func == ee_i_nop)
+        return 1;
+
+    if (ee_is_idle_load(i) || i.func == ee_i_addiu ||
+        i.func == ee_i_daddiu || i.func == ee_i_andi || i.func == ee_i_ori ||
+        i.func == ee_i_xori || i.func == ee_i_slti || i.func == ee_i_sltiu) {
+        *r = 1u << i.rs;
+        *w = 1u << i.rt;
+    } else if (i.func == ee_i_lui) {
+        *w = 1u << i.rt;
+    } else if (i.func == ee_i_addu || i.func == ee_i_daddu || i.func == ee_i_subu ||
+        i.func == ee_i_dsubu || i.func == ee_i_and || i.func == ee_i_or ||
+        i.func == ee_i_xor || i.func == ee_i_nor || i.func == ee_i_slt ||
+        i.func == ee_i_sltu) {
+        *r = (1u << i.rs) | (1u << i.rt);
+        *w = 1u << i.rd;
+    } else if (i.func == ee_i_sll || i.func == ee_i_srl || i.func == ee_i_sra ||
+        i.func == ee_i_dsll || i.func == ee_i_dsrl || i.func == ee_i_dsra ||
+        i.func == ee_i_dsll32 || i.func == ee_i_dsrl32 || i.func == ee_i_dsra32) {
+        *r = 1u << i.rt;
+        *w = 1u << i.rd;
+    } else if (i.func == ee_i_beq || i.func == ee_i_bne ||
+        i.func == ee_i_beql || i.func == ee_i_bnel) {
+        *r = (1u << i.rs) | (1u << i.rt);
+    } else if (i.func == ee_i_blez || i.func == ee_i_bgtz || i.func == ee_i_bltz ||
+        i.func == ee_i_bgez || i.func == ee_i_blezl || i.func == ee_i_bgtzl ||
+        i.func == ee_i_bltzl || i.func == ee_i_bgezl) {
+        *r = 1u << i.rs;
+    } else if (i.func != ee_i_j) {
+        return 0;
+    }
+
+    // $zero is never carried across iterations
+    *r &= ~1u;
+    *w &= ~1u;
+
+    return 1;
+}
+
+// A block is an idle loop if it ends with a branch back to its own
+// start and every iteration computes the same state from memory alone,
+// i.e. no register is read before it's written within the loop. Such a
+// loop can only make progress when something external changes memory
+static inline bool ee_is_idle_block(const struct ee_block& block, uint32_t block_pc) {
+    size_t n = block.instructions.size();
+
+    if (n < 2 || n > EE_IDLE_MAX_INSTRUCTIONS)
+        return false;
+
+    const ee_instruction& b = block.instructions[n - 2];
+    uint32_t branch_pc = block_pc + ((n - 2) << 2);
+    uint32_t target;
+
+    if (b.branch != 1 && b.branch != 3)
+        return false;
+
+    if (b.func == ee_i_j) {
+        target = ((branch_pc + 4) & 0xf0000000) | (((b.rs << 21) | (b.rt << 16) | b.i16) << 2);
+    } else {
+        target = branch_pc + 4 + ((int32_t)(b.i16 << 16) >> 14);
+    }
+
+    if (target != block_pc)
+        return false;
+
+    uint32_t r[EE_IDLE_MAX_INSTRUCTIONS];
+    uint32_t w[EE_IDLE_MAX_INSTRUCTIONS];
+    uint32_t written = 0;
+
+    for (size_t j = 0; j < n; j++) {
+        const ee_instruction& i = block.instructions[j];
+
+        if (!ee_get_idle_regs(i, &r[j], &w[j]))
+            return false;
+
+        // Only the loop branch is allowed
+        if (i.branch && j != n - 2)
+            return false;
+
+        written |= w[j];
+    }
+
+    uint32_t defined = 0;
+
+    for (size_t j = 0; j < n; j++) {
+        if (r[j] & written & ~defined)
+            return false;
+
+        defined |= w[j];
+    }
+
+    return true;
+}
+
+// Only plain memory can be polled without side effects, reading an I/O
+// register could pop a FIFO or ack an interrupt
+static inline bool ee_is_idle_address(struct ee_state* ee, uint32_t addr) {
+    uint32_t phys;
+
+#ifdef _EE_USE_MMU
+    // Don't walk the TLB here, a miss would raise an exception
+    int seg = ee_get_segment(addr);
+
+    if (seg != EE_KSEG0 && seg != EE_KSEG1)
+        return false;
+
+    phys = addr & 0x1fffffff;
+#else
+    if ((addr & 0xf0000000) == 0x70000000)
+        return true;
+
+    ee_translate_virt(ee, addr, &phys);
+#endif
+
+    uint32_t size = 16;
+
+    return ee->bus.get_span && ee->bus.get_span(ee->bus.udata, phys, &size, 0);
+}
+
+// Check that every load in an idle loop reads RAM, scratchpad or ROM.
+// Addresses depend on register values so this runs when the loop is
+// about to be skipped, not when it's cached. Bases can be registers the
+// loop doesn't write or constants built with lui/addiu/ori inside it,
+// anything else is unknown and disqualifies the loop
+static inline bool ee_idle_loads_ok(struct ee_state* ee, const struct ee_block& block) {
+    uint64_t val[32];
+    uint32_t written = 0;
+    uint32_t r, w;
+
+    for (const auto& i : block.instructions) {
+        ee_get_idle_regs(i, &r, &w);
+
+        written |= w;
+    }
+
+    for (int n = 0; n < 32; n++)
+        val[n] = ee->r[n].ul64;
+
+    uint32_t known = ~written;
+
+    for (const auto& i : block.instructions) {
+        ee_get_idle_regs(i, &r, &w);
+
+        if (ee_is_idle_load(i)) {
+            if (!(known & (1u << i.rs)))
+                return false;
+
+            if (!ee_is_idle_address(ee, (uint32_t)val[i.rs] + (int16_t)i.i16))
+                return false;
+        }
+
+        if (!w)
+            continue;
+
+        if (i.func == ee_i_lui) {
+            val[i.rt] = (int64_t)(int32_t)(i.i16 << 16);
+        } else if (i.func == ee_i_addiu && (known & (1u << i.rs))) {
+            val[i.rt] = (int64_t)(int32_t)((uint32_t)val[i.rs] + (int16_t)i.i16);
+        } else if (i.func == ee_i_daddiu && (known & (1u << i.rs))) {
+            val[i.rt] = val[i.rs] + (int16_t)i.i16;
+        } else if (i.func == ee_i_ori && (known & (1u << i.rs))) {
+            val[i.rt] = val[i.rs] | i.i16;
+        } else {
+            known &= ~w;
+
+            continue;
+        }
+
+        known |= w;
+    }
+
+    return true;
+}
+
+static inline void ee_decode_vu(struct ee_state* ee, const ee_instruction& i, uint32_t opcode, struct vu_instruction* vu) {
+    if (i.vu_op == EE_VU_UPPER) {
+        ps2_vu_decode_upper(ee->vu0, opcode);
+
+        *vu = ee->vu0->upper;
+    } else {
+        ps2_vu_decode_lower(ee->vu0, opcode);
+
+        *vu = ee->vu0->lower;
+    }
+}
+
 static inline struct ee_block* ee_cache_block(struct ee_state* ee, int max_cycles) {
     uint32_t page = ee->pc / _EE_CACHE_PAGESIZE;
     uint32_t offset = (ee->pc & (_EE_CACHE_PAGESIZE - 1)) >> 2;
@@ -4041,8 +4846,11 @@ static inline struct ee_block* ee_cache_block(struct ee_state* ee, int max_cycle
     ee_instruction i;
 
     block.cycles = 0;
+    block.breakpoint = false;
     block.instructions.reserve(max_cycles);
 
+    bool check_breakpoints = !ee->breakpoints.empty();
+
     while (max_cycles) {
         ee->opcode = bus_read32(ee, pc);
 
@@ -4051,6 +4859,8 @@ static inline struct ee_block* ee_cache_block(struct ee_state* ee, int max_cycle
             // Stop caching the block here
             ee->exception = 0;
 
+            block.instructions.shrink_to_fit();
+
             // Cache at the new location (handler)
             return ee_cache_block(ee, max_cycles);
         }
@@ -4058,16 +4868,28 @@ static inline struct ee_block* ee_cache_block(struct ee_state* ee, int max_cycle
         if (ee->opcode != 0) {
             i = ee_decode(ee->opcode);
 
+            if (i.vu_op) {
+                i.vu = block.vu_instructions.size();
+
+                block.vu_instructions.emplace_back();
+
+                ee_decode_vu(ee, i, ee->opcode, &block.vu_instructions.back());
+            }
+
             block.instructions.push_back(i);
         } else {
             i.func = ee_i_nop;
             i.branch = 0;
+            i.vu_op = EE_VU_NONE;
 
             block.instructions.push_back(i);
         }
 
         block.cycles += i.cycles;
 
+        if (check_breakpoints && ee->breakpoints.count(pc))
+            block.breakpoint = true;
+
         if (i.branch == 1 || i.branch == 3) {
             max_cycles = 2;
         } else if (i.branch != 0) {
@@ -4079,6 +4901,14 @@ static inline struct ee_block* ee_cache_block(struct ee_state* ee, int max_cycle
         pc += 4;
     }
 
+    // Drop the capacity reserved for max_cycles instructions
+    block.instructions.shrink_to_fit();
+
+    block.idle = ee_is_idle_block(block, block_pc);
+
+    if (block.idle)
+        ee->idle_blocks++;
+
     return &block;
 }
 
@@ -4109,7 +4939,89 @@ static inline struct ee_block* ee_find_block(struct ee_state* ee, uint32_t pc) {
     return &block;
 }
 
+static inline int ee_run_block_step(struct ee_state* ee, struct ee_block* block) {
+    int cycles = 0;
+
+    for (const auto& i : block->instructions) {
+        // ee->pc always holds the address of the instruction we're
+        // about to execute, check it before running the instruction
+        if (ee->breakpoint_skip) {
+            ee->breakpoint_skip = 0;
+        } else if (ee->breakpoints.count(ee->pc)) {
+            ee->breakpoint_hit = 1;
+            ee->breakpoint_skip = 1;
+
+            // The branch already pointed next_pc to its target, the
+            // delay slot has to run on its own when we resume
+            ee->breakpoint_delay = ee->branch;
+
+            break;
+        }
+
+        ee->delay_slot = ee->branch;
+        ee->branch = 0;
+
+        ee->pc = ee->next_pc;
+        ee->next_pc += 4;
+
+        i.func(ee, i);
+
+        ee->count++;
+        ee->r[0] = { 0 };
+
+        cycles++;
+
+        if (ee->exception) {
+            ee->exception = 0;
+
+            break;
+        }
+    }
+
+    return cycles;
+}
+
+static inline int ee_run_delay_slot(struct ee_state* ee, int max_cycles) {
+    struct ee_block* block = ee_find_block(ee, ee->pc);
+
+    if (!block) {
+        ee->cache_misses++;
+
+        block = ee_cache_block(ee, max_cycles);
+    }
+
+    // The block at the delay slot starts with the delay slot itself,
+    // anything after it isn't reached since next_pc holds the target
+    const ee_instruction& i = block->instructions[0];
+
+    ee->breakpoint_delay = 0;
+    ee->breakpoint_skip = 0;
+
+    ee->block_pc = ee->pc;
+    ee->block_vu = block->vu_instructions.data();
+
+    ee->delay_slot = 1;
+    ee->branch = 0;
+
+    ee->pc = ee->next_pc;
+    ee->next_pc += 4;
+
+    i.func(ee, i);
+
+    ee->count++;
+    ee->r[0] = { 0 };
+
+    ee->exception = 0;
+
+    return 1;
+}
+
 int ee_run_block(struct ee_state* ee, int max_cycles) {
+    // Resuming from a breakpoint on a delay slot, this has to happen
+    // before interrupts are checked
+    if (ee->breakpoint_delay)
+        return ee_run_delay_slot(ee, max_cycles);
+
     // This is the entrypoint to the EENULL thread.
     // If we hit this address, the program is basically idling
     // so we "fast-forward" 1024 cycles
@@ -4120,12 +5032,16 @@ int ee_run_block(struct ee_state* ee, int max_cycles) {
     if (ee_check_irq(ee))
         return 0;
 
-    if (ee->pc == 0x81fc0 || ee->intc_reads >= 10000) { // ee->csr_reads >= 1000
+    // Skipping ahead would jump over any breakpoint in the idle loop
+    bool idle = ee->pc == 0x81fc0 || ee->intc_reads >= 10000; // ee->csr_reads >= 1000
+
+    if (idle && ee->breakpoints.empty()) {
         ee->total_cycles += 2048;
         ee->count += 2048;
         // ee->eenull_counter += 8 * 64;
 
         ee->idle_skips++;
+        ee->idle_cycles += 2048;
 
         return 2048;
     }
@@ -4139,6 +5055,10 @@ int ee_run_block(struct ee_state* ee, int max_cycles) {
     }
 
     ee->block_pc = ee->pc;
+    ee->block_vu = block->vu_instructions.data();
+
+    if (block->breakpoint)
+        return ee_run_block_step(ee, block);
 
     int cycles = 0;
 
@@ -4169,16 +5089,42 @@ int ee_run_block(struct ee_state* ee, int max_cycles) {
         }
     }
 
+    // We made it back to the start of an idle loop, nothing will
+    // change until the next event so let the caller fast-forward
+    if (block->idle && ee->pc == ee->block_pc && ee_idle_loads_ok(ee, *block))
+        ee->idle = 1;
+
     // printf("ee: Block executed with %d cycles pc=%08x\n", cycles, ee->pc);
 
     return cycles;
 }
 
+int ee_skip_idle(struct ee_state* ee, int cycles) {
+    if (!ee->idle)
+        return 0;
+
+    ee->idle = 0;
+
+    if (cycles <= 0)
+        return 0;
+
+    ee->total_cycles += cycles;
+    ee->count += cycles;
+
+    ee->idle_skips++;
+    ee->idle_cycles += cycles;
+
+    return cycles;
+}
+
 int ee_step(struct ee_state* ee) {
-    static ee_instruction i;
+    ee_instruction i;
+    vu_instruction vu;
 
     ee->delay_slot = ee->branch;
     ee->branch = 0;
+    ee->breakpoint_skip = 0;
+    ee->breakpoint_delay = 0;
 
     // Would check for interrupts here, but we do this outside of the core
     // to reduce overhead
@@ -4191,8 +5137,19 @@ int ee_step(struct ee_state* ee) {
 
     i = ee_decode(ee->opcode);
 
+    if (i.vu_op) {
+        ee_decode_vu(ee, i, ee->opcode, &vu);
+
+        i.vu = 0;
+
+        ee->block_vu = &vu;
+    }
+
     i.func(ee, i);
 
+    // vu lives on this stack frame, don't leave it reachable
+    ee->block_vu = nullptr;
+
     ++ee->total_cycles;
     ++ee->count;
 
@@ -4243,4 +5200,50 @@ void ee_set_osd_config(struct ee_state* ee, struct ee_osd_config config) {
 
 struct ee_osd_config ee_get_osd_config(struct ee_state* ee) {
     return ee->osd_config;
-}
\ No newline at end of file
+}
+
+static inline void ee_invalidate_breakpoint(struct ee_state* ee, uint32_t addr) {
+    // Blocks are at most one page long, so any block containing
+    // addr must start either in its page or in the previous one
+    INVALIDATE_CACHE_PAGE(addr);
+    INVALIDATE_CACHE_PAGE(addr - _EE_CACHE_PAGESIZE);
+
+    ee->last_block_lookup_pc = ~0u;
+    ee->last_block_ptr = nullptr;
+}
+
+void ee_set_breakpoint(struct ee_state* ee, uint32_t addr) {
+    if (!ee->breakpoints.insert(addr).second)
+        return;
+
+    ee_invalidate_breakpoint(ee, addr);
+}
+
+void ee_remove_breakpoint(struct ee_state* ee, uint32_t addr) {
+    if (!ee->breakpoints.erase(addr))
+        return;
+
+    ee_invalidate_breakpoint(ee, addr);
+
+    // Only forget the pending resume if it was for this breakpoint
+    if (addr == ee->pc)
+        ee->breakpoint_skip = 0;
+}
+
+void ee_clear_breakpoints(struct ee_state* ee) {
+    if (ee->breakpoints.empty())
+        return;
+
+    ee->breakpoints.clear();
+    ee->breakpoint_skip = 0;
+
+    ee_flush_cache(ee);
+}
+
+int ee_poll_breakpoint(struct ee_state* ee) {
+    int hit = ee->breakpoint_hit;
+
+    ee->breakpoint_hit = 0;
+
+    return hit;
+}
@@ -10,6 +10,7 @@
 #include "vu_def.hpp"
 
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #ifdef _EE_USE_INTRINSICS
@@ -35,30 +36,58 @@
 #define EE_CYC_STORE 14
 #define EE_CYC_LOAD 14
 
+// Which half of the VU decoder a COP2 macro instruction goes through
+#define EE_VU_NONE 0
+#define EE_VU_UPPER 1
+#define EE_VU_LOWER 2
+
+// Decoded instructions are packed into 16 bytes so a whole block fits
+// in a few cache lines. Handlers only read the fields their encoding
+// uses, the 15 and 26-bit immediates are rebuilt from the register
+// fields (see EE_D_I15/EE_D_I26)
 struct ee_instruction {
-    uint32_t opcode;
-    int32_t rs;
-    int32_t rt;
-    int32_t rd;
-    int32_t sa;
-    int32_t i15;
-    int32_t i16;
-    int32_t i26;
+    void (*func)(struct ee_state*, const ee_instruction&);
+
+    uint8_t rs;
+    uint8_t rt;
+    uint8_t rd;
+    uint8_t sa;
+
+    // COP2 macro instructions are decoded into a VU instruction when
+    // the block is cached, they have no immediate so vu holds the
+    // index of it in the block's vu_instructions
+    union {
+        uint16_t i16;
+        uint16_t vu;
+    };
 
     // 0 - no branch
     // 1 - delayed branch
     // 2 - immediate branch
     // 3 - likely branch
     // 4 - conditional exception
-    int branch;
-    int cycles;
-
-    void (*func)(struct ee_state*, const ee_instruction&); 
+    uint8_t branch : 4;
+    uint8_t vu_op : 4;
+    uint8_t cycles;
 };
 
+static_assert(sizeof(ee_instruction) <= 16);
+
 struct ee_block {
     std::vector <ee_instruction> instructions;
+
+    // Decoded COP2 macro instructions, in the same order as the
+    // instructions that use them
+    std::vector <vu_instruction> vu_instructions;
     uint32_t cycles = 0;
+
+    // Set when the block contains a breakpoint, these blocks are
+    // executed one instruction at a time so breakpoints fire exactly
+    bool breakpoint = false;
+
+    // Set when the block is a side-effect free loop polling memory,
+    // once it branches back to itself we can skip to the next event
+    bool idle = false;
 };
 
 struct ee_state {
@@ -66,6 +95,9 @@ struct ee_state {
 
     uint32_t block_pc;
 
+    // Decoded COP2 macro instructions of the block being executed
+    const struct vu_instruction* block_vu;
+
     std::vector <ee_block*> block_cache;
     
     // Single-entry block cache for fast lookup (avoid hash computation)
@@ -146,6 +178,16 @@ struct ee_state {
     struct ee_vtlb_entry vtlb[48];
     struct ee_osd_config osd_config;
 
+    // Breakpoints are only looked up while caching blocks
+    std::unordered_set <uint32_t> breakpoints;
+    int breakpoint_hit;
+    int breakpoint_skip;
+
+    // Set when we stopped on the delay slot of a taken branch
+    int breakpoint_delay;
+
+    int idle;
+
     int eenull_counter;
     int csr_reads;
     int intc_reads;
@@ -155,6 +197,8 @@ struct ee_state {
     uint64_t cache_misses;
     uint64_t cache_hits;
     uint64_t idle_skips;
+    uint64_t idle_blocks;
+    uint64_t idle_cycles;
 };
 
 #define THS_RUN 0x01
@@ -338,6 +338,17 @@ void ps2_gif_write128(struct ps2_gif* gif, uint32_t addr, uint128_t data) {
     ps2_gif_fifo_write(gif, data, GIF_PATH3);
 }
 
+static inline void gif_end_packet(struct ps2_gif* gif, int path) {
+    struct queue_state* queue = gif->queue[path];
+
+    gif->state = GIF_STATE_RECV_TAG;
+
+    if (gif->transfer)
+        gif->transfer(gif->udata, path, queue->buf, queue->size * sizeof(uint32_t));
+
+    queue_clear(queue);
+}
+
 void ps2_gif_fifo_write(struct ps2_gif* gif, uint128_t data, int path) {
     // Set FQC when getting GIF FIFO writes
     gif->stat |= 0x1f000000;
@@ -359,14 +370,36 @@ void ps2_gif_fifo_write(struct ps2_gif* gif, uint128_t data, int path) {
 
         gif->tag.qwc--;
 
-        if (!gif->tag.qwc) {
-            gif->state = GIF_STATE_RECV_TAG;
+        if (!gif->tag.qwc)
+            gif_end_packet(gif, path);
+    }
+}
+
+void ps2_gif_fifo_write_block(struct ps2_gif* gif, const uint128_t* data, uint32_t qwc, int path) {
+    while (qwc) {
+        if (gif->state == GIF_STATE_RECV_TAG || !gif->tag.qwc) {
+            ps2_gif_fifo_write(gif, *data, path);
 
-            if (gif->transfer)
-                gif->transfer(gif->udata, path, queue->buf, queue->size * sizeof(uint32_t));
+            data++;
+            qwc--;
 
-            queue_clear(queue);
+            continue;
         }
+
+        // Append as much of the packet's data as we have in one go
+        uint32_t len = qwc < gif->tag.qwc ? qwc : gif->tag.qwc;
+
+        gif->stat |= 0x1f000000;
+
+        queue_push_block(gif->queue[path], (const uint32_t*)data, len * 4);
+
+        gif->tag.qwc -= len;
+
+        if (!gif->tag.qwc)
+            gif_end_packet(gif, path);
+
+        data += len;
+        qwc -= len;
     }
 }
 
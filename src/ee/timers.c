@@ -368,6 +368,25 @@ static inline void ee_timers_write_mode(struct ps2_ee_timers* timers, int t, uin
     ee_timers_schedule_next_irq_event(timers);
 }
 
+// EE cycles until the next compare or overflow that has to be handled,
+// 0xffffffff if no running timer can raise one
+uint32_t ps2_ee_timers_cycles_until_check(struct ps2_ee_timers* timers) {
+    uint32_t min_cycles = 0xffffffffu;
+
+    for (int i = 0; i < 4; i++) {
+        if (timers->timer[i].cue) {
+            ee_timers_sync_timer(timers, &timers->timer[i], i);
+
+            uint32_t wait = ee_timers_cycles_until_check(&timers->timer[i]);
+
+            if (wait < min_cycles)
+                min_cycles = wait;
+        }
+    }
+
+    return min_cycles;
+}
+
 void ps2_ee_timers_tick(struct ps2_ee_timers* timers) {
     ps2_ee_timers_tick_cycles(timers, 1);
 }
@@ -63,6 +63,7 @@ void ps2_ee_timers_write32(struct ps2_ee_timers* timers, uint32_t addr, uint64_t
 void ps2_ee_timers_write16(struct ps2_ee_timers* timers, uint32_t addr, uint64_t data);
 void ps2_ee_timers_tick(struct ps2_ee_timers* timers);
 void ps2_ee_timers_tick_cycles(struct ps2_ee_timers* timers, uint32_t cycles);
+uint32_t ps2_ee_timers_cycles_until_check(struct ps2_ee_timers* timers);
 void ps2_ee_timers_handle_hblank(struct ps2_ee_timers* timers);
 void ps2_ee_timers_handle_vblank_in(struct ps2_ee_timers* timers);
 void ps2_ee_timers_handle_vblank_out(struct ps2_ee_timers* timers);
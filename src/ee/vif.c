@@ -945,4 +945,11 @@ void ps2_vif_write128(struct ps2_vif* vif, uint32_t addr, uint128_t data) {
     }
 }
 
+void ps2_vif_fifo_write_block(struct ps2_vif* vif, const uint128_t* data, uint32_t qwc) {
+    const uint32_t* words = (const uint32_t*)data;
+
+    for (uint32_t i = 0; i < qwc * 4; i++)
+        vif_handle_fifo_write(vif, words[i]);
+}
+
 #undef printf
\ No newline at end of file
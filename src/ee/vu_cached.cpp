@@ -5,6 +5,11 @@
 #include <fenv.h>
 #include <utility>
 
+#ifdef _EE_USE_INTRINSICS
+#include <immintrin.h>
+#include <smmintrin.h>
+#endif
+
 #include "vu.h"
 #include "vu_def.hpp"
 #include "vu_dis.h"
@@ -463,6 +468,93 @@ void template_seq(F f) {
     seq(f, std::make_index_sequence<N>{});
 }
 
+#ifdef _EE_USE_INTRINSICS
+// 4-wide versions of the FMAC helpers, lanes are x, y, z, w
+
+// Maps a dest mask to a blend immediate (x in bit 0)
+template <uint32_t di>
+constexpr int vu_blend_mask() {
+    return ((di & VU_D_X) ? 1 : 0) | ((di & VU_D_Y) ? 2 : 0) |
+           ((di & VU_D_Z) ? 4 : 0) | ((di & VU_D_W) ? 8 : 0);
+}
+
+// Gets a 4-bit lane mask in MAC flag order (x in bit 3)
+static inline uint32_t vu_flag_mask4(__m128i v) {
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3))));
+}
+
+// Vector vu_cvtf, denormals become signed zero and Inf/NaN the
+// largest normal with the same sign
+static inline __m128 vu_cvtf4(__m128i v) {
+    const __m128i exp = _mm_and_si128(v, _mm_set1_epi32(0x7f800000));
+    const __m128i sign = _mm_and_si128(v, _mm_set1_epi32(0x80000000));
+    const __m128i denormal = _mm_cmpeq_epi32(exp, _mm_setzero_si128());
+    const __m128i overflow = _mm_cmpeq_epi32(exp, _mm_set1_epi32(0x7f800000));
+
+    v = _mm_blendv_epi8(v, sign, denormal);
+    v = _mm_blendv_epi8(v, _mm_or_si128(sign, _mm_set1_epi32(0x7f7fffff)), overflow);
+
+    return _mm_castsi128_ps(v);
+}
+
+static inline __m128 vu_vf4(struct vu_state* vu, int r) {
+    return vu_cvtf4(_mm_loadu_si128((const __m128i*)&vu->vf[r]));
+}
+
+static inline __m128 vu_acc4(struct vu_state* vu) {
+    return vu_cvtf4(_mm_loadu_si128((const __m128i*)&vu->acc));
+}
+
+// Vector vu_update_flags, computes the MAC flags for the lanes in the
+// dest mask (clearing the rest) and clamps the result
+template <uint32_t di>
+static inline __m128 vu_update_flags4(struct vu_state* vu, __m128 result) {
+    __m128i v = _mm_castps_si128(result);
+
+    const __m128i exp = _mm_and_si128(v, _mm_set1_epi32(0x7f800000));
+    const __m128i sign = _mm_and_si128(v, _mm_set1_epi32(0x80000000));
+    const __m128i zero = _mm_cmpeq_epi32(_mm_and_si128(v, _mm_set1_epi32(0x7fffffff)), _mm_setzero_si128());
+    const __m128i underflow = _mm_andnot_si128(zero, _mm_cmpeq_epi32(exp, _mm_setzero_si128()));
+    const __m128i overflow = _mm_cmpeq_epi32(exp, _mm_set1_epi32(0x7f800000));
+
+    uint32_t z = vu_flag_mask4(_mm_or_si128(zero, underflow));
+    uint32_t s = vu_flag_mask4(v);
+    uint32_t u = vu_flag_mask4(underflow);
+    uint32_t o = vu_flag_mask4(overflow);
+
+    constexpr uint32_t mask = ((di >> 21) & 0xf) * 0x1111;
+
+    vu->mac &= ~0xffff;
+    vu->mac |= (z | (s << 4) | (u << 8) | (o << 12)) & mask;
+
+    v = _mm_blendv_epi8(v, sign, underflow);
+    v = _mm_blendv_epi8(v, _mm_or_si128(sign, _mm_set1_epi32(0x7f7fffff)), overflow);
+
+    return _mm_castsi128_ps(v);
+}
+
+template <uint32_t di>
+static inline void vu_set_vf4(struct vu_state* vu, int r, __m128 v) {
+    if (!r)
+        return;
+
+    constexpr int mask = vu_blend_mask <di>();
+
+    __m128 old = _mm_loadu_ps(vu->vf[r].f);
+
+    _mm_storeu_ps(vu->vf[r].f, _mm_blend_ps(old, v, mask));
+}
+
+template <uint32_t di>
+static inline void vu_set_acc4(struct vu_state* vu, __m128 v) {
+    constexpr int mask = vu_blend_mask <di>();
+
+    __m128 old = _mm_loadu_ps(vu->acc.f);
+
+    _mm_storeu_ps(vu->acc.f, _mm_blend_ps(old, v, mask));
+}
+#endif
+
 // Upper pipeline
 template <uint32_t di>
 void vu_i_abs(struct vu_state* vu, const struct vu_instruction* ins) {
@@ -481,6 +573,9 @@ void vu_i_add(struct vu_state* vu, const struct vu_instruction* ins) {
     int d = VU_UD_D;
     int t = VU_UD_T;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_add_ps(vu_vf4(vu, s), vu_vf4(vu, t))));
+#else
     template_seq<4>([&](auto i) {
          if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) + vu_vf_i(vu, t, i);
@@ -490,6 +585,7 @@ void vu_i_add(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -498,6 +594,9 @@ void vu_i_addi(struct vu_state* vu, const struct vu_instruction* ins) {
     int d = VU_UD_D;
     int s = VU_UD_S;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_add_ps(vu_vf4(vu, s), _mm_set1_ps(vu->i.f))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) + vu->i.f;
@@ -507,6 +606,7 @@ void vu_i_addi(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -516,6 +616,9 @@ void vu_i_addq(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
     float q = vu_get_q(vu).f;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_add_ps(vu_vf4(vu, s), _mm_set1_ps(q))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) + q;
@@ -525,6 +628,7 @@ void vu_i_addq(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -536,6 +640,9 @@ void vu_i_addx(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_x(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_add_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) + bc;
@@ -545,6 +652,7 @@ void vu_i_addx(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -556,6 +664,9 @@ void vu_i_addy(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_y(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_add_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) + bc;
@@ -565,6 +676,7 @@ void vu_i_addy(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -576,6 +688,9 @@ void vu_i_addz(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_z(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_add_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) + bc;
@@ -585,6 +700,7 @@ void vu_i_addz(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -596,6 +712,9 @@ void vu_i_addw(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_w(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_add_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) + bc;
@@ -605,6 +724,7 @@ void vu_i_addw(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -613,6 +733,9 @@ void vu_i_adda(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
     int t = VU_UD_T;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_add_ps(vu_vf4(vu, s), vu_vf4(vu, t))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) + vu_vf_i(vu, t, i);
@@ -622,6 +745,7 @@ void vu_i_adda(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -629,6 +753,9 @@ template <uint32_t di>
 void vu_i_addai(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_add_ps(vu_vf4(vu, s), _mm_set1_ps(vu->i.f))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) + vu->i.f;
@@ -638,6 +765,7 @@ void vu_i_addai(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -646,6 +774,9 @@ void vu_i_addaq(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
     float q = vu_get_q(vu).f;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_add_ps(vu_vf4(vu, s), _mm_set1_ps(q))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) + q;
@@ -655,6 +786,7 @@ void vu_i_addaq(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -665,6 +797,9 @@ void vu_i_addax(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_x(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_add_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) + bc;
@@ -674,6 +809,7 @@ void vu_i_addax(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -684,6 +820,9 @@ void vu_i_adday(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_y(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_add_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) + bc;
@@ -693,6 +832,7 @@ void vu_i_adday(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -703,6 +843,9 @@ void vu_i_addaz(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_z(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_add_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) + bc;
@@ -712,6 +855,7 @@ void vu_i_addaz(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -722,6 +866,9 @@ void vu_i_addaw(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_w(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_add_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) + bc;
@@ -731,6 +878,7 @@ void vu_i_addaw(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -740,6 +888,9 @@ void vu_i_sub(struct vu_state* vu, const struct vu_instruction* ins) {
     int d = VU_UD_D;
     int t = VU_UD_T;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_vf4(vu, s), vu_vf4(vu, t))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) - vu_vf_i(vu, t, i);
@@ -749,6 +900,7 @@ void vu_i_sub(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -757,6 +909,9 @@ void vu_i_subi(struct vu_state* vu, const struct vu_instruction* ins) {
     int d = VU_UD_D;
     int s = VU_UD_S;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_vf4(vu, s), _mm_set1_ps(vu->i.f))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) - vu->i.f;
@@ -766,6 +921,7 @@ void vu_i_subi(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -775,6 +931,9 @@ void vu_i_subq(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
     float q = vu_get_q(vu).f;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_vf4(vu, s), _mm_set1_ps(q))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) - q;
@@ -784,6 +943,7 @@ void vu_i_subq(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -795,6 +955,9 @@ void vu_i_subx(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_x(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) - bc;
@@ -804,6 +967,7 @@ void vu_i_subx(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -815,6 +979,9 @@ void vu_i_suby(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_y(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) - bc;
@@ -824,6 +991,7 @@ void vu_i_suby(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -835,6 +1003,9 @@ void vu_i_subz(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_z(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) - bc;
@@ -844,6 +1015,7 @@ void vu_i_subz(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -855,6 +1027,9 @@ void vu_i_subw(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_w(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) - bc;
@@ -864,6 +1039,7 @@ void vu_i_subw(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -872,6 +1048,9 @@ void vu_i_suba(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
     int t = VU_UD_T;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_vf4(vu, s), vu_vf4(vu, t))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) - vu_vf_i(vu, t, i);
@@ -881,6 +1060,7 @@ void vu_i_suba(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -888,6 +1068,9 @@ template <uint32_t di>
 void vu_i_subai(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_vf4(vu, s), _mm_set1_ps(vu->i.f))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) - vu->i.f;
@@ -897,6 +1080,7 @@ void vu_i_subai(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -905,6 +1089,9 @@ void vu_i_subaq(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
     float q = vu_get_q(vu).f;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_vf4(vu, s), _mm_set1_ps(q))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) - q;
@@ -914,6 +1101,7 @@ void vu_i_subaq(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -924,6 +1112,9 @@ void vu_i_subax(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_x(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) - bc;
@@ -933,6 +1124,7 @@ void vu_i_subax(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -943,6 +1135,9 @@ void vu_i_subay(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_y(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) - bc;
@@ -952,6 +1147,7 @@ void vu_i_subay(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -962,6 +1158,9 @@ void vu_i_subaz(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_z(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) - bc;
@@ -971,6 +1170,7 @@ void vu_i_subaz(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -981,6 +1181,9 @@ void vu_i_subaw(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_w(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) - bc;
@@ -990,6 +1193,7 @@ void vu_i_subaw(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -999,6 +1203,9 @@ void vu_i_mul(struct vu_state* vu, const struct vu_instruction* ins) {
     int d = VU_UD_D;
     int t = VU_UD_T;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_mul_ps(vu_vf4(vu, s), vu_vf4(vu, t))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) * vu_vf_i(vu, t, i);
@@ -1008,6 +1215,7 @@ void vu_i_mul(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1016,6 +1224,9 @@ void vu_i_muli(struct vu_state* vu, const struct vu_instruction* ins) {
     int d = VU_UD_D;
     int s = VU_UD_S;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(vu->i.f))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) * vu->i.f;
@@ -1025,6 +1236,7 @@ void vu_i_muli(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1034,6 +1246,9 @@ void vu_i_mulq(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
     float q = vu_get_q(vu).f;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(q))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) * q;
@@ -1043,6 +1258,7 @@ void vu_i_mulq(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1054,6 +1270,9 @@ void vu_i_mulx(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_x(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) * bc;
@@ -1063,6 +1282,7 @@ void vu_i_mulx(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1074,6 +1294,9 @@ void vu_i_muly(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_y(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) * bc;
@@ -1083,6 +1306,7 @@ void vu_i_muly(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1094,6 +1318,9 @@ void vu_i_mulz(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_z(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) * bc;
@@ -1103,6 +1330,7 @@ void vu_i_mulz(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1114,6 +1342,9 @@ void vu_i_mulw(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_w(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) * bc;
@@ -1123,6 +1354,7 @@ void vu_i_mulw(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1131,6 +1363,9 @@ void vu_i_mula(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
     int t = VU_UD_T;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_mul_ps(vu_vf4(vu, s), vu_vf4(vu, t))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) * vu_vf_i(vu, t, i);
@@ -1140,6 +1375,7 @@ void vu_i_mula(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1147,6 +1383,9 @@ template <uint32_t di>
 void vu_i_mulai(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(vu->i.f))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) * vu->i.f;
@@ -1156,6 +1395,7 @@ void vu_i_mulai(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1164,6 +1404,9 @@ void vu_i_mulaq(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
     float q = vu_get_q(vu).f;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(q))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) * q;
@@ -1173,6 +1416,7 @@ void vu_i_mulaq(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1183,6 +1427,9 @@ void vu_i_mulax(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_x(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) * bc;
@@ -1192,6 +1439,7 @@ void vu_i_mulax(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1202,6 +1450,9 @@ void vu_i_mulay(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_y(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) * bc;
@@ -1211,6 +1462,7 @@ void vu_i_mulay(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1221,6 +1473,9 @@ void vu_i_mulaz(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_z(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) * bc;
@@ -1230,6 +1485,7 @@ void vu_i_mulaz(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1240,6 +1496,9 @@ void vu_i_mulaw(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_w(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_vf_i(vu, s, i) * bc;
@@ -1249,6 +1508,7 @@ void vu_i_mulaw(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1258,6 +1518,9 @@ void vu_i_madd(struct vu_state* vu, const struct vu_instruction* ins) {
     int t = VU_UD_T;
     int d = VU_UD_D;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_add_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), vu_vf4(vu, t)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) + vu_vf_i(vu, s, i) * vu_vf_i(vu, t, i);
@@ -1267,6 +1530,7 @@ void vu_i_madd(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1275,6 +1539,9 @@ void vu_i_maddi(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
     int d = VU_UD_D;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_add_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(vu->i.f)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) + vu_vf_i(vu, s, i) * vu->i.f;
@@ -1284,6 +1551,7 @@ void vu_i_maddi(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1293,6 +1561,9 @@ void vu_i_maddq(struct vu_state* vu, const struct vu_instruction* ins) {
     int d = VU_UD_D;
     float q = vu_get_q(vu).f;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_add_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(q)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) + vu_vf_i(vu, s, i) * q;
@@ -1302,6 +1573,7 @@ void vu_i_maddq(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1313,6 +1585,9 @@ void vu_i_maddx(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_x(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_add_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) + vu_vf_i(vu, s, i) * bc;
@@ -1322,6 +1597,7 @@ void vu_i_maddx(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1333,6 +1609,9 @@ void vu_i_maddy(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_y(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_add_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) + vu_vf_i(vu, s, i) * bc;
@@ -1342,6 +1621,7 @@ void vu_i_maddy(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1353,6 +1633,9 @@ void vu_i_maddz(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_z(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_add_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) + vu_vf_i(vu, s, i) * bc;
@@ -1362,6 +1645,7 @@ void vu_i_maddz(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1373,6 +1657,9 @@ void vu_i_maddw(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_w(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_add_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) + vu_vf_i(vu, s, i) * bc;
@@ -1382,6 +1669,7 @@ void vu_i_maddw(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1390,6 +1678,9 @@ void vu_i_madda(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
     int t = VU_UD_T;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_add_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), vu_vf4(vu, t)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) + vu_vf_i(vu, s, i) * vu_vf_i(vu, t, i);
@@ -1399,6 +1690,7 @@ void vu_i_madda(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1406,6 +1698,9 @@ template <uint32_t di>
 void vu_i_maddai(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_add_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(vu->i.f)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) + vu_vf_i(vu, s, i) * vu->i.f;
@@ -1415,6 +1710,7 @@ void vu_i_maddai(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1423,6 +1719,9 @@ void vu_i_maddaq(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
     float q = vu_get_q(vu).f;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_add_ps(_mm_loadu_ps(vu->acc.f), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(q)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu->acc.f[i] + vu_vf_i(vu, s, i) * q;
@@ -1432,6 +1731,7 @@ void vu_i_maddaq(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1442,6 +1742,9 @@ void vu_i_maddax(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_x(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_add_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) + vu_vf_i(vu, s, i) * bc;
@@ -1451,6 +1754,7 @@ void vu_i_maddax(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1461,6 +1765,9 @@ void vu_i_madday(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_y(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_add_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) + vu_vf_i(vu, s, i) * bc;
@@ -1470,6 +1777,7 @@ void vu_i_madday(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1480,6 +1788,9 @@ void vu_i_maddaz(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_z(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_add_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) + vu_vf_i(vu, s, i) * bc;
@@ -1489,6 +1800,7 @@ void vu_i_maddaz(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1499,6 +1811,9 @@ void vu_i_maddaw(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_w(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_add_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) + vu_vf_i(vu, s, i) * bc;
@@ -1508,6 +1823,7 @@ void vu_i_maddaw(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1517,6 +1833,9 @@ void vu_i_msub(struct vu_state* vu, const struct vu_instruction* ins) {
     int t = VU_UD_T;
     int d = VU_UD_D;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), vu_vf4(vu, t)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) - vu_vf_i(vu, s, i) * vu_vf_i(vu, t, i);
@@ -1526,6 +1845,7 @@ void vu_i_msub(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1534,6 +1854,9 @@ void vu_i_msubi(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
     int d = VU_UD_D;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(vu->i.f)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) - vu_vf_i(vu, s, i) * vu->i.f;
@@ -1543,6 +1866,7 @@ void vu_i_msubi(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1552,6 +1876,9 @@ void vu_i_msubq(struct vu_state* vu, const struct vu_instruction* ins) {
     int d = VU_UD_D;
     float q = vu_get_q(vu).f;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(q)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) - (vu_vf_i(vu, s, i) * q);
@@ -1561,6 +1888,7 @@ void vu_i_msubq(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1572,6 +1900,9 @@ void vu_i_msubx(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_x(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) - vu_vf_i(vu, s, i) * bc;
@@ -1581,6 +1912,7 @@ void vu_i_msubx(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1592,6 +1924,9 @@ void vu_i_msuby(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_y(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) - vu_vf_i(vu, s, i) * bc;
@@ -1601,6 +1936,7 @@ void vu_i_msuby(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1612,6 +1948,9 @@ void vu_i_msubz(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_z(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) - vu_vf_i(vu, s, i) * bc;
@@ -1621,6 +1960,7 @@ void vu_i_msubz(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1632,6 +1972,9 @@ void vu_i_msubw(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_w(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_vf4 <di>(vu, d, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) - vu_vf_i(vu, s, i) * bc;
@@ -1641,6 +1984,7 @@ void vu_i_msubw(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1649,6 +1993,9 @@ void vu_i_msuba(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
     int t = VU_UD_T;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), vu_vf4(vu, t)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) - vu_vf_i(vu, s, i) * vu_vf_i(vu, t, i);
@@ -1658,6 +2005,7 @@ void vu_i_msuba(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1665,6 +2013,9 @@ template <uint32_t di>
 void vu_i_msubai(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(vu->i.f)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) - vu_vf_i(vu, s, i) * vu->i.f;
@@ -1674,6 +2025,7 @@ void vu_i_msubai(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1682,6 +2034,9 @@ void vu_i_msubaq(struct vu_state* vu, const struct vu_instruction* ins) {
     int s = VU_UD_S;
     float q = vu_get_q(vu).f;
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_sub_ps(_mm_loadu_ps(vu->acc.f), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(q)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu->acc.f[i] - vu_vf_i(vu, s, i) * q;
@@ -1691,6 +2046,7 @@ void vu_i_msubaq(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1701,6 +2057,9 @@ void vu_i_msubax(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_x(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) - vu_vf_i(vu, s, i) * bc;
@@ -1710,6 +2069,7 @@ void vu_i_msubax(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1720,6 +2080,9 @@ void vu_i_msubay(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_y(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) - vu_vf_i(vu, s, i) * bc;
@@ -1729,6 +2092,7 @@ void vu_i_msubay(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1739,6 +2103,9 @@ void vu_i_msubaz(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_z(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) - vu_vf_i(vu, s, i) * bc;
@@ -1748,6 +2115,7 @@ void vu_i_msubaz(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -1758,6 +2126,9 @@ void vu_i_msubaw(struct vu_state* vu, const struct vu_instruction* ins) {
 
     float bc = vu_vf_w(vu, t);
 
+#ifdef _EE_USE_INTRINSICS
+    vu_set_acc4 <di>(vu, vu_update_flags4 <di>(vu, _mm_sub_ps(vu_acc4(vu), _mm_mul_ps(vu_vf4(vu, s), _mm_set1_ps(bc)))));
+#else
     template_seq<4>([&](auto i) {
         if constexpr (di & (VU_D_X >> i)) {
             float result = vu_acc_i(vu, i) - vu_vf_i(vu, s, i) * bc;
@@ -1767,6 +2138,7 @@ void vu_i_msubaw(struct vu_state* vu, const struct vu_instruction* ins) {
             vu_clear_flags(vu, i);
         }
     });
+#endif
 
     vu_update_status(vu);
 }
@@ -3472,16 +3844,92 @@ vu_block* vu_find_block(struct vu_state* vu, uint32_t tpc) {
     return block;
 }
 
-static int c = 0;
+// Keeps an invalidated block around in case the same code gets
+// uploaded to the same address again (e.g. games swapping between a
+// few VU1 microprograms every frame)
+static inline void vu_retire_block(struct vu_state* vu, vu_block& block) {
+    std::vector <std::list <vu_block>::iterator>& history = vu->block_history_tpc[block.tpc];
+
+    if (history.size() == VU_BLOCK_HISTORY) {
+        vu->block_history.erase(history.front());
+
+        history.erase(history.begin());
+    } else if (vu->block_history.size() == VU_BLOCK_HISTORY_MAX) {
+        std::list <vu_block>::iterator oldest = vu->block_history.begin();
+        std::vector <std::list <vu_block>::iterator>& entries = vu->block_history_tpc[oldest->tpc];
+
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i] == oldest) {
+                entries.erase(entries.begin() + i);
+
+                break;
+            }
+        }
+
+        vu->block_history.erase(oldest);
+    }
+
+    history.push_back(vu->block_history.insert(vu->block_history.end(), std::move(block)));
+
+    block.cycles = 0;
+    block.entries.clear();
+    block.code.clear();
+}
+
+// Looks for a retired block decoded from the code currently at tpc
+static inline bool vu_restore_block(struct vu_state* vu, vu_block* block, uint32_t tpc) {
+    std::vector <std::list <vu_block>::iterator>& history = vu->block_history_tpc[tpc];
+
+    for (size_t i = 0; i < history.size(); i++) {
+        const std::vector <uint64_t>& code = history[i]->code;
+
+        bool match = true;
+
+        for (size_t j = 0; j < code.size(); j++) {
+            if (vu->micro_mem[(tpc + j) & 0x7ff] != code[j]) {
+                match = false;
+
+                break;
+            }
+        }
+
+        if (!match)
+            continue;
+
+        *block = std::move(*history[i]);
+
+        vu->block_history.erase(history[i]);
+
+        history.erase(history.begin() + i);
+
+        return true;
+    }
+
+    return false;
+}
+
+static inline void vu_clear_block_history(struct vu_state* vu) {
+    vu->block_history.clear();
+    vu->block_history_tpc.clear();
+    vu->block_history_tpc.resize(vu->micro_mem_size+1);
+}
 
 vu_block* vu_cache_block(struct vu_state* vu, uint32_t tpc, int max_cycles) {
     vu_block* block = &vu->block_cache[tpc];
 
     vu->block_cache_size++;
 
+    if (vu_restore_block(vu, block, tpc)) {
+        vu->last_block_lookup_tpc = block->tpc;
+        vu->last_block_ptr = block;
+
+        return block;
+    }
+
     block->tpc = tpc;
     block->cycles = 0;
     block->entries.clear();
+    block->code.clear();
 
     // printf("vu: caching block at %04x\n", tpc);
 
@@ -3507,10 +3955,21 @@ vu_block* vu_cache_block(struct vu_state* vu, uint32_t tpc, int max_cycles) {
 
             entry.lower = vu->lower;
             entry.branch = vu->lower.branch;
-            entry.hazard0 = vu->upper.dst.reg == vu->lower.src[0].reg;
-            entry.hazard1 = vu->upper.dst.reg == vu->lower.src[1].reg;
-            entry.hazard2 = vu->upper.dst.reg == vu->lower.dst.reg;
             entry.hazard3 = vu->lower.dst.reg == VU_REG_Q;
+
+            int hazard0 = vu->upper.dst.reg == vu->lower.src[0].reg;
+            int hazard1 = vu->upper.dst.reg == vu->lower.src[1].reg;
+            int hazard2 = vu->upper.dst.reg == vu->lower.dst.reg;
+
+            if (!vu->upper.dst.reg) {
+                entry.order = VU_ORDER_UPPER_FIRST;
+            } else if (hazard0 || hazard1 || vu->lower.func == vu_i_waitq) {
+                entry.order = VU_ORDER_LOWER_FIRST;
+            } else if (hazard2) {
+                entry.order = VU_ORDER_UPPER_PRIORITY;
+            } else {
+                entry.order = VU_ORDER_UPPER_FIRST;
+            }
         }
 
         // If this entry is a branch or has the E bit set, we end the block here
@@ -3521,6 +3980,7 @@ vu_block* vu_cache_block(struct vu_state* vu, uint32_t tpc, int max_cycles) {
         block->cycles++;
 
         block->entries.push_back(entry);
+        block->code.push_back(liw);
     }
 
     // vu_dis_state ds;
@@ -3564,38 +4024,39 @@ bool vu_execute_block_entry(struct vu_state* vu, const vu_block_entry& entry) {
     } else {
         if (entry.hazard3 && vu->q_delay) vu->q_delay = 0;
 
-        bool waitq = entry.lower.func == vu_i_waitq;
+        switch (entry.order) {
+            case VU_ORDER_UPPER_FIRST: {
+                entry.upper.func(vu, &entry.upper);
+                entry.lower.func(vu, &entry.lower);
+            } break;
 
-        if (!entry.upper.dst.reg) {
-            entry.upper.func(vu, &entry.upper);
-            entry.lower.func(vu, &entry.lower);
-        } else if (entry.hazard0 || entry.hazard1 || waitq) {
-            // Upper instruction writes to a register that the lower
-            // instruction reads from. In this case the lower instruction
-            // gets the previous value of the register, executing the lower
-            // instruction first does the trick.
+            case VU_ORDER_LOWER_FIRST: {
+                // Upper instruction writes to a register that the lower
+                // instruction reads from. In this case the lower instruction
+                // gets the previous value of the register, executing the lower
+                // instruction first does the trick.
 
-            // We also execute WAITQ first, since it will stall the pipeline
-            // if the upper instruction reads Q
+                // We also execute WAITQ first, since it will stall the pipeline
+                // if the upper instruction reads Q
 
-            entry.lower.func(vu, &entry.lower);
-            entry.upper.func(vu, &entry.upper);
-        } else if (entry.hazard2) {
-            // Upper and lower instructions write to the same register.
-            // In this case the upper instruction takes priority, so we
-            // restore the value of the register after executing the lower
-            // instruction.
+                entry.lower.func(vu, &entry.lower);
+                entry.upper.func(vu, &entry.upper);
+            } break;
 
-            entry.upper.func(vu, &entry.upper);
+            case VU_ORDER_UPPER_PRIORITY: {
+                // Upper and lower instructions write to the same register.
+                // In this case the upper instruction takes priority, so we
+                // restore the value of the register after executing the lower
+                // instruction.
 
-            struct vu_reg128 tmp = vu->vf[entry.upper.dst.reg];
+                entry.upper.func(vu, &entry.upper);
 
-            entry.lower.func(vu, &entry.lower);
+                struct vu_reg128 tmp = vu->vf[entry.upper.dst.reg];
 
-            vu->vf[entry.upper.dst.reg] = tmp;
-        } else {
-            entry.upper.func(vu, &entry.upper);
-            entry.lower.func(vu, &entry.lower);
+                entry.lower.func(vu, &entry.lower);
+
+                vu->vf[entry.upper.dst.reg] = tmp;
+            } break;
         }
     }
 
@@ -3792,6 +4253,8 @@ void ps2_vu_reset(struct vu_state* vu) {
     vu->block_cache.clear();
     vu->block_cache.resize(vu->micro_mem_size+1);
 
+    vu_clear_block_history(vu);
+
     vu->vf[0].w = 1.0;
 }
 
@@ -3836,6 +4299,8 @@ void vu_clear_block_cache(struct vu_state* vu) {
     vu->block_cache.clear();
     vu->block_cache.resize(vu->micro_mem_size+1);
 
+    vu_clear_block_history(vu);
+
     vu->last_block_lookup_tpc = ~0u;
     vu->last_block_ptr = nullptr;
 }
@@ -3856,8 +4321,7 @@ void vu_invalidate_range(struct vu_state* vu, uint32_t addr, uint32_t size) {
                 continue;
             }
 
-            block.cycles = 0;
-            block.entries.clear();
+            vu_retire_block(vu, block);
         }
 
         vu->block_cache_size = 0;
@@ -3895,8 +4359,7 @@ void vu_invalidate_range(struct vu_state* vu, uint32_t addr, uint32_t size) {
             continue;
         }
 
-        block.cycles = 0;
-        block.entries.clear();
+        vu_retire_block(vu, block);
         invalidated++;
     }
 
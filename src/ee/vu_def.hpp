@@ -1,18 +1,38 @@
 #pragma once
 
 #include <cstdint>
+#include <list>
 #include <unordered_map>
 #include <vector>
 
 #include "vu.h"
 
+// Retired blocks kept around per TPC and in total, so programs that get
+// uploaded again don't have to be decoded again. Past either limit the
+// least recently retired block goes first
+#define VU_BLOCK_HISTORY 4
+#define VU_BLOCK_HISTORY_MAX 1024
+
+// How the upper and lower instructions of an entry are executed, this
+// only depends on the registers they use so it's resolved when the
+// block is cached
+enum : int {
+    // Upper first, then lower
+    VU_ORDER_UPPER_FIRST,
+
+    // Upper writes a register lower reads from (lower must see the
+    // previous value), or lower is WAITQ
+    VU_ORDER_LOWER_FIRST,
+
+    // Both write the same register, the upper result wins
+    VU_ORDER_UPPER_PRIORITY
+};
+
 struct vu_block_entry {
     struct vu_instruction upper, lower;
     int e_bit;
     int i_bit;
-    int hazard0;
-    int hazard1;
-    int hazard2;
+    int order;
     int hazard3;
     int branch;
 };
@@ -20,6 +40,9 @@ struct vu_block_entry {
 struct vu_block {
     std::vector <vu_block_entry> entries;
 
+    // Raw LIWs the block was decoded from
+    std::vector <uint64_t> code;
+
     uint32_t tpc;
     int cycles = 0;
 };
@@ -32,6 +55,11 @@ struct vu_state {
     std::vector <vu_block> block_cache;
     int block_cache_size;
 
+    // Blocks invalidated by micro memory writes, least recently retired
+    // first, and the ones retired from each TPC
+    std::list <vu_block> block_history;
+    std::vector <std::vector <std::list <vu_block>::iterator>> block_history_tpc;
+
     // Single-entry block cache for fast lookup (avoid hash computation)
     uint32_t last_block_lookup_tpc;
     struct vu_block* last_block_ptr;
@@ -181,6 +181,14 @@ renderer_image hardware_get_frame(void* udata) {
     return image;
 }
 
+// Frames stay on the GPU, see renderer_get_buffer
+const uint32_t* hardware_get_buffer(void* udata, int* w, int* h) {
+    *w = 0;
+    *h = 0;
+
+    return nullptr;
+}
+
 extern "C" void hardware_transfer(void* udata, int path, const void* data, size_t size) {
     hardware_state* ctx = static_cast<hardware_state*>(udata);
 
@@ -113,6 +113,7 @@ void hardware_reset(void* udata);
 void hardware_destroy(void* udata);
 void hardware_set_config(void* udata, void* config);
 renderer_image hardware_get_frame(void* udata);
+const uint32_t* hardware_get_buffer(void* udata, int* w, int* h);
 
 extern "C" {
 void hardware_transfer(void* udata, int path, const void* data, size_t size);
@@ -27,6 +27,13 @@ renderer_image null_get_frame(void* udata) {
     return image;
 }
 
+const uint32_t* null_get_buffer(void* udata, int* w, int* h) {
+    *w = 0;
+    *h = 0;
+
+    return nullptr;
+}
+
 void null_set_config(void* udata, void* config) {
     // Nothing
 }
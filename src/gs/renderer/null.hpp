@@ -13,6 +13,7 @@ void null_reset(void* udata);
 void null_destroy(void* udata);
 void null_set_config(void* udata, void* config);
 renderer_image null_get_frame(void* udata);
+const uint32_t* null_get_buffer(void* udata, int* w, int* h);
 
 extern "C" {
 void null_transfer(void* udata, int path, const void* data, size_t size);
@@ -2,6 +2,7 @@
 
 #include "null.hpp"
 #include "hardware.hpp"
+#include "software_thread.hpp"
 
 renderer_state* renderer_create(void) {
     return new renderer_state;
@@ -17,19 +18,20 @@ bool renderer_init(renderer_state* renderer, const renderer_create_info& info) {
             renderer->reset = null_reset;
             renderer->destroy = null_destroy;
             renderer->get_frame = null_get_frame;
+            renderer->get_buffer = null_get_buffer;
             renderer->set_config = null_set_config;
             renderer->transfer = null_transfer;
         } break;
 
         case RENDERER_BACKEND_SOFTWARE: {
-            // To-do: Software renderer
-            renderer->create = null_create;
-            renderer->init = null_init;
-            renderer->reset = null_reset;
-            renderer->destroy = null_destroy;
-            renderer->get_frame = null_get_frame;
-            renderer->set_config = null_set_config;
-            renderer->transfer = null_transfer;
+            renderer->create = software_thread_create;
+            renderer->init = software_thread_init;
+            renderer->reset = software_thread_reset;
+            renderer->destroy = software_thread_destroy;
+            renderer->get_frame = software_thread_get_frame;
+            renderer->get_buffer = software_thread_get_buffer;
+            renderer->set_config = software_thread_set_config;
+            renderer->transfer = software_thread_transfer;
         } break;
 
         case RENDERER_BACKEND_HARDWARE: {
@@ -38,6 +40,7 @@ bool renderer_init(renderer_state* renderer, const renderer_create_info& info) {
             renderer->reset = hardware_reset;
             renderer->destroy = hardware_destroy;
             renderer->get_frame = hardware_get_frame;
+            renderer->get_buffer = hardware_get_buffer;
             renderer->set_config = hardware_set_config;
             renderer->transfer = hardware_transfer;
         } break;
@@ -77,6 +80,13 @@ renderer_image renderer_get_frame(renderer_state* renderer) {
     return renderer->get_frame(renderer->udata);
 }
 
+// Frame in host memory as RGBA8, only the software renderer has one.
+// This works without a Vulkan device, so it's how headless users get
+// pixels out. Returns NULL if the backend renders on the GPU
+const uint32_t* renderer_get_buffer(renderer_state* renderer, int* w, int* h) {
+    return renderer->get_buffer(renderer->udata, w, h);
+}
+
 void renderer_set_config(renderer_state* renderer, void* config) {
     renderer->set_config(renderer->udata, config);
 }
\ No newline at end of file
@@ -51,6 +51,7 @@ struct renderer_stats {
 
     Frontend API
       - render_front_get_frame()
+      - render_front_get_buffer(), CPU renderers only
 */
 
 struct renderer_create_info {
@@ -87,6 +88,7 @@ struct renderer_state {
     void (*reset)(void* udata);
     void (*destroy)(void* udata);
     renderer_image (*get_frame)(void* udata);
+    const uint32_t* (*get_buffer)(void* udata, int* w, int* h);
     void (*transfer)(void* udata, int path, const void* data, size_t size);
     void (*set_config)(void* udata, void* config);
 };
@@ -98,4 +100,5 @@ void renderer_reset(renderer_state* renderer);
 void renderer_destroy(renderer_state* renderer);
 void renderer_set_config(renderer_state* renderer, void* config);
 
-renderer_image renderer_get_frame(renderer_state* renderer);
\ No newline at end of file
+renderer_image renderer_get_frame(renderer_state* renderer);
+const uint32_t* renderer_get_buffer(renderer_state* renderer, int* w, int* h);
\ No newline at end of file
@@ -2,110 +2,43 @@
 #include <cstring>
 #include <cstdio>
 #include <cmath>
+#include <algorithm>
 
-#include "gs/gs.h"
-#include "software_thread.hpp"
-
-// INCBIN stuff
-#define INCBIN_PREFIX g_
-#define INCBIN_STYLE INCBIN_STYLE_SNAKE
-
-#include "incbin.h"
+// The rasterizer's SIMD paths only need the compiler to target SSE4.1
+// (AVX2 for 8-wide coverage), independent of the EE intrinsics
+#ifdef __SSE4_1__
+#include <smmintrin.h>
+#endif
 
-#ifdef __APPLE__
-#define SHADER_FORMAT SDL_GPU_SHADERFORMAT_MSL
-#define SHADER_ENTRYPOINT "main0"
-INCBIN(vertex_shader, "../shaders/vertex.msl");
-INCBIN(fragment_shader, "../shaders/fragment.msl");
-INCBIN_EXTERN(vertex_shader);
-INCBIN_EXTERN(fragment_shader);
-#else
-#define SHADER_FORMAT SDL_GPU_SHADERFORMAT_SPIRV
-#define SHADER_ENTRYPOINT "main"
-INCBIN(vertex_shader, "../shaders/vertex.spv");
-INCBIN(fragment_shader, "../shaders/fragment.spv");
-INCBIN_EXTERN(vertex_shader);
-INCBIN_EXTERN(fragment_shader);
+#ifdef __AVX2__
+#include <immintrin.h>
 #endif
 
-#include <SDL3/SDL.h>
+#include "gs/gs.h"
+#include "software_thread.hpp"
+
+#define CLAMP(v, l, u) (((v) > (u)) ? (u) : (((v) < (l)) ? (l) : (v)))
 
-int psmct32_block[] = {
+static const int psmct32_block[] = {
     0 , 1 , 4 , 5 , 16, 17, 20, 21,
     2 , 3 , 6 , 7 , 18, 19, 22, 23,
     8 , 9 , 12, 13, 24, 25, 28, 29,
     10, 11, 14, 15, 26, 27, 30, 31
 };
 
-int psmct32_column[] = {
+static const int psmct32_column[] = {
     0 , 1 , 4 , 5 , 8 , 9 , 12, 13,
     2 , 3 , 6 , 7 , 10, 11, 14, 15
 };
 
-static inline int psmct32_addr(int base, int width, int x, int y) {
-    // base expressed in blocks
-    // 1 page = 64x32 = 8 KiB = 2048 words
-    // 1 block = 8x8 = 256 B = 64 words
-    // 1 column = 8x2 = 64 B = 16 words
-
-    int page = (x >> 6) + ((y >> 5) * width);
-    int blkx = (x >> 3) & 7;
-    int blky = (y >> 3) & 3;
-    int blk = blkx + (blky * 8);
-    int col = (y >> 1) & 3;
-    int idx = (x & 7) + ((y & 1) * 8);
-
-    // Unswizzle block
-    blk = psmct32_block[blk];
-
-    // Unswizzle column
-    idx = psmct32_column[idx];
-
-    // printf("(%x, %d, %d, %d) -> p=%d b=%d c=%d addr=%08x\n",
-    //     base, width, x, y,
-    //     page, blk, cl,
-    //     (page * 2048) + (base * 64) + (blk * 64) + cl
-    // );
-
-    return (page * 2048) + ((base + blk) * 64) + (col * 16) + idx;
-}
-
-int psmz32_block[] = {
+static const int psmz32_block[] = {
     24, 25, 28, 29, 8 , 9 , 12, 13,
     26, 27, 30, 31, 10, 11, 14, 15,
     16, 17, 20, 21, 0 , 1 , 4 , 5 ,
     18, 19, 22, 23, 2 , 3 , 6 , 7
 };
 
-static inline int psmz32_addr(int base, int width, int x, int y) {
-    // base expressed in blocks
-    // 1 page = 64x32 = 8 KiB = 2048 words
-    // 1 block = 8x8 = 256 B = 64 words
-    // 1 column = 8x2 = 64 B = 16 words
-
-    int page = (x >> 6) + ((y >> 5) * width);
-    int blkx = (x >> 3) & 7;
-    int blky = (y >> 3) & 3;
-    int blk = blkx + (blky * 8);
-    int col = (y >> 1) & 3;
-    int idx = (x & 7) + ((y & 1) * 8);
-
-    // Unswizzle block
-    blk = psmz32_block[blk];
-
-    // Unswizzle column
-    idx = psmct32_column[idx];
-
-    // printf("(%x, %d, %d, %d) -> p=%d b=%d c=%d addr=%08x\n",
-    //     base, width, x, y,
-    //     page, blk, cl,
-    //     (page * 2048) + (base * 64) + (blk * 64) + cl
-    // );
-
-    return (page * 2048) + ((base + blk) * 64) + (col * 16) + idx;
-}
-
-int psmct16_block[] = {
+static const int psmct16_block[] = {
     0 , 2 , 8 , 10,
     1 , 3 , 9 , 11,
     4 , 6 , 12, 14,
@@ -116,7 +49,7 @@ int psmct16_block[] = {
     21, 23, 29, 31
 };
 
-int psmz16_block[] = {
+static const int psmz16_block[] = {
     24, 26, 16, 18,
     25, 27, 17, 19,
     28, 30, 20, 22,
@@ -127,81 +60,7 @@ int psmz16_block[] = {
     13, 15, 5 , 7
 };
 
-int psmct16_column[] = {
-    0 , 1 , 4 , 5 , 8 , 9 , 12, 13,
-    0 , 1 , 4 , 5 , 8 , 9 , 12, 13,
-    2 , 3 , 6 , 7 , 10, 11, 14, 15,
-    2 , 3 , 6 , 7 , 10, 11, 14, 15
-};
-
-int psmct16_shift[] = {
-    0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 ,
-    1 , 1 , 1 , 1 , 1 , 1 , 1 , 1 ,
-    0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 ,
-    1 , 1 , 1 , 1 , 1 , 1 , 1 , 1 
-};
-
-static inline int psmct16_addr(int base, int width, int x, int y) {
-    // page            block          column
-    // 64 x 64 pixels  16 x 8 pixels  16 x 2 pixels
-    // base expressed in blocks
-    // 1 page = 64x32 = 8 KiB = 2048 words
-    // 1 block = 8x8 = 256 B = 64 words
-    // 1 column = 8x2 = 64 B = 16 words
-
-    int page = (x >> 6) + ((y >> 6) * width);
-    int blkx = (x >> 4) & 3;
-    int blky = (y >> 3) & 7;
-    int blk = blkx + (blky * 4);
-    int col = (y >> 1) & 3;
-    int idx = (x & 15) + ((y & 1) * 16);
-
-    // Unswizzle block
-    blk = psmct16_block[blk];
-
-    // Unswizzle column
-    idx = psmct16_column[idx];
-
-    // printf("(%x, %d, %d, %d) -> p=%d b=%d c=%d addr=%08x\n",
-    //     base, width, x, y,
-    //     page, blk, cl,
-    //     (page * 2048) + (base * 64) + (blk * 64) + cl
-    // );
-
-    return (page * 2048) + ((base + blk) * 64) + (col * 16) + idx;
-}
-
-static inline int psmz16_addr(int base, int width, int x, int y) {
-    // page            block          column
-    // 64 x 64 pixels  16 x 8 pixels  16 x 2 pixels
-    // base expressed in blocks
-    // 1 page = 64x32 = 8 KiB = 2048 words
-    // 1 block = 8x8 = 256 B = 64 words
-    // 1 column = 8x2 = 64 B = 16 words
-
-    int page = (x >> 6) + ((y >> 6) * width);
-    int blkx = (x >> 4) & 3;
-    int blky = (y >> 3) & 7;
-    int blk = blkx + (blky * 4);
-    int col = (y >> 1) & 3;
-    int idx = (x & 15) + ((y & 1) * 16);
-
-    // Unswizzle block
-    blk = psmz16_block[blk];
-
-    // Unswizzle column
-    idx = psmct16_column[idx];
-
-    // printf("(%x, %d, %d, %d) -> p=%d b=%d c=%d addr=%08x\n",
-    //     base, width, x, y,
-    //     page, blk, cl,
-    //     (page * 2048) + (base * 64) + (blk * 64) + cl
-    // );
-
-    return (page * 2048) + ((base + blk) * 64) + (col * 16) + idx;
-}
-
-int psmct16s_block[] = {
+static const int psmct16s_block[] = {
     0 , 2 , 16, 18,
     1 , 3 , 17, 19,
     8 , 10, 24, 26,
@@ -212,7 +71,7 @@ int psmct16s_block[] = {
     13, 15, 29, 31
 };
 
-int psmz16s_block[] = {
+static const int psmz16s_block[] = {
     24, 26, 8 , 10,
     25, 27, 9 , 11,
     16, 18, 0 , 2 ,
@@ -223,67 +82,21 @@ int psmz16s_block[] = {
     21, 23, 5 , 7
 };
 
-static inline int psmct16s_addr(int base, int width, int x, int y) {
-    // page            block          column
-    // 64 x 64 pixels  16 x 8 pixels  16 x 2 pixels
-    // base expressed in blocks
-    // 1 page = 64x32 = 8 KiB = 2048 words
-    // 1 block = 8x8 = 256 B = 64 words
-    // 1 column = 8x2 = 64 B = 16 words
-
-    int page = (x >> 6) + ((y >> 6) * width);
-    int blkx = (x >> 4) & 3;
-    int blky = (y >> 3) & 7;
-    int blk = blkx + (blky * 4);
-    int col = (y >> 1) & 3;
-    int idx = (x & 15) + ((y & 1) * 16);
-
-    // Unswizzle block
-    blk = psmct16s_block[blk];
-
-    // Unswizzle column
-    idx = psmct16_column[idx];
-
-    // printf("(%x, %d, %d, %d) -> p=%d b=%d c=%d addr=%08x\n",
-    //     base, width, x, y,
-    //     page, blk, cl,
-    //     (page * 2048) + (base * 64) + (blk * 64) + cl
-    // );
-
-    return (page * 2048) + ((base + blk) * 64) + (col * 16) + idx;
-}
-
-static inline int psmz16s_addr(int base, int width, int x, int y) {
-    // page            block          column
-    // 64 x 64 pixels  16 x 8 pixels  16 x 2 pixels
-    // base expressed in blocks
-    // 1 page = 64x32 = 8 KiB = 2048 words
-    // 1 block = 8x8 = 256 B = 64 words
-    // 1 column = 8x2 = 64 B = 16 words
-
-    int page = (x >> 6) + ((y >> 6) * width);
-    int blkx = (x >> 4) & 3;
-    int blky = (y >> 3) & 7;
-    int blk = blkx + (blky * 4);
-    int col = (y >> 1) & 3;
-    int idx = (x & 15) + ((y & 1) * 16);
-
-    // Unswizzle block
-    blk = psmct16s_block[blk];
-
-    // Unswizzle column
-    idx = psmct16_column[idx];
-
-    // printf("(%x, %d, %d, %d) -> p=%d b=%d c=%d addr=%08x\n",
-    //     base, width, x, y,
-    //     page, blk, cl,
-    //     (page * 2048) + (base * 64) + (blk * 64) + cl
-    // );
+static const int psmct16_column[] = {
+    0 , 1 , 4 , 5 , 8 , 9 , 12, 13,
+    0 , 1 , 4 , 5 , 8 , 9 , 12, 13,
+    2 , 3 , 6 , 7 , 10, 11, 14, 15,
+    2 , 3 , 6 , 7 , 10, 11, 14, 15
+};
 
-    return (page * 2048) + ((base + blk) * 64) + (col * 16) + idx;
-}
+static const int psmct16_shift[] = {
+    0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 ,
+    1 , 1 , 1 , 1 , 1 , 1 , 1 , 1 ,
+    0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 ,
+    1 , 1 , 1 , 1 , 1 , 1 , 1 , 1
+};
 
-int psmt8_column_02[] = {
+static const int psmt8_column_02[] = {
     0 , 1 , 4 , 5 , 8 , 9 , 12, 13,
     0 , 1 , 4 , 5 , 8 , 9 , 12, 13,
     2 , 3 , 6 , 7 , 10, 11, 14, 15,
@@ -294,7 +107,7 @@ int psmt8_column_02[] = {
     10, 11, 14, 15, 2 , 3 , 6 , 7
 };
 
-int psmt8_column_13[] = {
+static const int psmt8_column_13[] = {
     8 , 9 , 12, 13, 0 , 1 , 4 , 5 ,
     8 , 9 , 12, 13, 0 , 1 , 4 , 5 ,
     10, 11, 14, 15, 2 , 3 , 6 , 7 ,
@@ -305,7 +118,7 @@ int psmt8_column_13[] = {
     2 , 3 , 6 , 7 , 10, 11, 14, 15
 };
 
-int psmt8_shift[] = {
+static const int psmt8_shift[] = {
     0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 ,
     2 , 2 , 2 , 2 , 2 , 2 , 2 , 2 ,
     0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 ,
@@ -316,48 +129,14 @@ int psmt8_shift[] = {
     3 , 3 , 3 , 3 , 3 , 3 , 3 , 3
 };
 
-static inline int psmt8_addr(int base, int width, int x, int y) {
-    // page            block          column
-    // 128 x 64 pixels 16 x 16 pixels 16 x 4 pixels
-    // base expressed in blocks
-    // 1 page = 128x64 = 8 KiB = 2048 words
-    // 1 block = 16x16 = 256 B = 64 words
-    // 1 column = 16x4 = 64 B = 16 words
-    // 1 page = 128/4x64 = 32x64 words
-    // 1 block = 16/4x16 = 4x16 words
-    // 1 column = 16/4x4 = 4x4 words
-
-    int page = (x >> 7) + ((y >> 6) * (width >> 1));
-    int blkx = (x >> 4) & 7;
-    int blky = (y >> 4) & 3;
-    int blk = blkx + (blky * 8);
-    int col = (y >> 2) & 3;
-    int idx = (x & 15) + ((y & 3) * 16);
-    // int shift = (x & 3) * 16;
-
-    // Unswizzle block
-    blk = psmct32_block[blk];
-
-    // Unswizzle column
-    idx = (col & 1) ? psmt8_column_13[idx] : psmt8_column_02[idx];
-
-    // printf("(%x, %d, %d, %d) -> p=%d b=%d c=%d addr=%08x\n",
-    //     base, width, x, y,
-    //     page, blk, cl,
-    //     (page * 2048) + (base * 64) + (blk * 64) + cl
-    // );
-
-    return (page * 2048) + ((base + blk) * 64) + (col * 16) + idx;
-}
-
-int psmt4_block[] = {
+static const int psmt4_block[] = {
     0 , 2 , 8 , 10, 1 , 3 , 9 , 11,
     4 , 6 , 12, 14, 5 , 7 , 13, 15,
     16, 18, 24, 26, 17, 19, 25, 27,
     20, 22, 28, 30, 21, 23, 29, 31
 };
 
-int psmt4_column_02[] = {
+static const int psmt4_column_02[] = {
     0 , 1 , 4 , 5 , 8 , 9 , 12, 13,
     0 , 1 , 4 , 5 , 8 , 9 , 12, 13,
     0 , 1 , 4 , 5 , 8 , 9 , 12, 13,
@@ -376,7 +155,7 @@ int psmt4_column_02[] = {
     10, 11, 14, 15, 2 , 3 , 6 , 7
 };
 
-int psmt4_column_13[] = {
+static const int psmt4_column_13[] = {
     8 , 9 , 12, 13, 0 , 1 , 4 , 5 ,
     8 , 9 , 12, 13, 0 , 1 , 4 , 5 ,
     8 , 9 , 12, 13, 0 , 1 , 4 , 5 ,
@@ -395,7 +174,7 @@ int psmt4_column_13[] = {
     2 , 3 , 6 , 7 , 10, 11, 14, 15
 };
 
-int psmt4_shift[] = {
+static const int psmt4_shift[] = {
     0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 ,
     8 , 8 , 8 , 8 , 8 , 8 , 8 , 8 ,
     16, 16, 16, 16, 16, 16, 16, 16,
@@ -414,32 +193,6 @@ int psmt4_shift[] = {
     28, 28, 28, 28, 28, 28, 28, 28
 };
 
-static inline int psmt4_addr(int base, int width, int x, int y) {
-    // page             block          column
-    // 128 x 128 pixels 32 x 16 pixels 32 x 4 pixels
-    int page = (x >> 7) + ((y >> 7) * (width >> 1));
-    int blkx = (x >> 5) & 3;
-    int blky = (y >> 4) & 7;
-    int blk = blkx + (blky * 4);
-    int col = (y >> 2) & 3;
-    int idx = (x & 31) + ((y & 3) * 32);
-    // int shift = (x & 3) * 16;
-
-    // Unswizzle block
-    blk = psmt4_block[blk];
-
-    // Unswizzle column
-    idx = (col & 1) ? psmt4_column_13[idx] : psmt4_column_02[idx];
-
-    // printf("(%x, %d, %d, %d) -> p=%d b=%d c=%d addr=%08x\n",
-    //     base, width, x, y,
-    //     page, blk, cl,
-    //     (page * 2048) + (base * 64) + (blk * 64) + cl
-    // );
-
-    return (page * 2048) + ((base + blk) * 64) + (col * 16) + idx;
-}
-
 static const int psmt8_clut_block[] = {
     0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
     0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
@@ -475,2981 +228,3083 @@ static const int psmt8_clut_block[] = {
     0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
 };
 
-void render_point(struct ps2_gs* gs, void* udata);
-void render_line(struct ps2_gs* gs, void* udata);
-void render_triangle(struct ps2_gs* gs, void* udata);
-void render_sprite(struct ps2_gs* gs, void* udata);
-void transfer_start(struct ps2_gs* gs, void* udata);
-void transfer_write(struct ps2_gs* gs, void* udata);
-void transfer_read(struct ps2_gs* gs, void* udata);
-
-void software_thread_render_thread(software_thread_state* ctx) {
-    while (!ctx->end_signal) {
-        while (true) {
-            ctx->queue_mtx.lock();
+// Base addresses are expressed in blocks (64 words) and widths in
+// units of 64 pixels, all of these return a word address
+// 1 page = 8 KiB = 2048 words
+// 1 block = 256 B = 64 words
+// 1 column = 64 B = 16 words
+//
+// These are only used to build the swizzle tables below
+static uint32_t psmct32_addr(uint32_t base, uint32_t width, uint32_t x, uint32_t y) {
+    // page 64x32, block 8x8, column 8x2
+    uint32_t page = (x >> 6) + ((y >> 5) * width);
+    uint32_t blk = psmct32_block[((x >> 3) & 7) + (((y >> 3) & 3) * 8)];
+    uint32_t col = (y >> 1) & 3;
+    uint32_t idx = psmct32_column[(x & 7) + ((y & 1) * 8)];
+
+    return ((page * 2048) + ((base + blk) * 64) + (col * 16) + idx) & 0xfffff;
+}
+
+static uint32_t psmz32_addr(uint32_t base, uint32_t width, uint32_t x, uint32_t y) {
+    uint32_t page = (x >> 6) + ((y >> 5) * width);
+    uint32_t blk = psmz32_block[((x >> 3) & 7) + (((y >> 3) & 3) * 8)];
+    uint32_t col = (y >> 1) & 3;
+    uint32_t idx = psmct32_column[(x & 7) + ((y & 1) * 8)];
+
+    return ((page * 2048) + ((base + blk) * 64) + (col * 16) + idx) & 0xfffff;
+}
+
+static uint32_t psm16_addr(const int* block, uint32_t base, uint32_t width, uint32_t x, uint32_t y) {
+    // page 64x64, block 16x8, column 16x2
+    uint32_t page = (x >> 6) + ((y >> 6) * width);
+    uint32_t blk = block[((x >> 4) & 3) + (((y >> 3) & 7) * 4)];
+    uint32_t col = (y >> 1) & 3;
+    uint32_t idx = psmct16_column[(x & 15) + ((y & 1) * 16)];
+
+    return ((page * 2048) + ((base + blk) * 64) + (col * 16) + idx) & 0xfffff;
+}
+
+static uint32_t psmt8_addr(uint32_t base, uint32_t width, uint32_t x, uint32_t y) {
+    // page 128x64, block 16x16, column 16x4
+    uint32_t page = (x >> 7) + ((y >> 6) * (width >> 1));
+    uint32_t blk = psmct32_block[((x >> 4) & 7) + (((y >> 4) & 3) * 8)];
+    uint32_t col = (y >> 2) & 3;
+    uint32_t i = (x & 15) + ((y & 3) * 16);
+    uint32_t idx = (col & 1) ? psmt8_column_13[i] : psmt8_column_02[i];
+
+    return ((page * 2048) + ((base + blk) * 64) + (col * 16) + idx) & 0xfffff;
+}
+
+static uint32_t psmt4_addr(uint32_t base, uint32_t width, uint32_t x, uint32_t y) {
+    // page 128x128, block 32x16, column 32x4
+    uint32_t page = (x >> 7) + ((y >> 7) * (width >> 1));
+    uint32_t blk = psmt4_block[((x >> 5) & 3) + (((y >> 4) & 7) * 4)];
+    uint32_t col = (y >> 2) & 3;
+    uint32_t i = (x & 31) + ((y & 3) * 32);
+    uint32_t idx = (col & 1) ? psmt4_column_13[i] : psmt4_column_02[i];
+
+    return ((page * 2048) + ((base + blk) * 64) + (col * 16) + idx) & 0xfffff;
+}
+
+// Intra-page offsets for every format, in units of the pixel size
+// (words, halfwords, bytes or nibbles). The address of a pixel is then
+// just the page's base plus a table lookup
+struct software_swizzle {
+    uint16_t ct32[32][64];
+    uint16_t z32[32][64];
+    uint16_t ct16[64][64];
+    uint16_t ct16s[64][64];
+    uint16_t z16[64][64];
+    uint16_t z16s[64][64];
+    uint16_t t8[64][128];
+    uint16_t t4[128][128];
+
+    software_swizzle() {
+        for (int y = 0; y < 32; y++) {
+            for (int x = 0; x < 64; x++) {
+                ct32[y][x] = psmct32_addr(0, 1, x, y);
+                z32[y][x] = psmz32_addr(0, 1, x, y);
+            }
+        }
 
-            if (ctx->render_queue.empty()) {
-                ctx->queue_mtx.unlock();
+        for (int y = 0; y < 64; y++) {
+            for (int x = 0; x < 64; x++) {
+                int shift = psmct16_shift[(x & 15) + ((y & 1) * 16)];
 
-                break;
+                ct16[y][x] = (psm16_addr(psmct16_block, 0, 1, x, y) * 2) + shift;
+                ct16s[y][x] = (psm16_addr(psmct16s_block, 0, 1, x, y) * 2) + shift;
+                z16[y][x] = (psm16_addr(psmz16_block, 0, 1, x, y) * 2) + shift;
+                z16s[y][x] = (psm16_addr(psmz16s_block, 0, 1, x, y) * 2) + shift;
             }
+        }
 
-            // Explicitly copy data from the queue
-            render_data rdata = render_data(ctx->render_queue.front());
+        for (int y = 0; y < 64; y++)
+            for (int x = 0; x < 128; x++)
+                t8[y][x] = (psmt8_addr(0, 2, x, y) * 4) + psmt8_shift[(x & 15) + ((y & 3) * 16)];
 
-            // Assign context pointer to the copied context
-            rdata.gs.ctx = &rdata.gs.context[(rdata.gs.attr & GS_CTXT) ? 1 : 0];
+        for (int y = 0; y < 128; y++)
+            for (int x = 0; x < 128; x++)
+                t4[y][x] = (psmt4_addr(0, 2, x, y) * 8) + (psmt4_shift[(x & 31) + ((y & 3) * 32)] >> 2);
+    }
+};
 
-            ctx->render_queue.pop();
-            ctx->queue_mtx.unlock();
+static const software_swizzle swizzle;
 
-            ctx->render_mtx.lock();
+// Address of the page containing (x, y) in words. Indexed formats have
+// 128 pixel wide pages, so their buffer width counts pairs of pages
+static inline uint32_t software_page_addr(uint32_t bp, uint32_t bw, uint32_t x, uint32_t y, int pws, int phs) {
+    return (bp * 64) + (((x >> pws) + ((y >> phs) * bw)) * 2048);
+}
 
-            switch (rdata.prim) {
-                case 0: render_point(&rdata.gs, nullptr); break;
-                case 1: render_line(&rdata.gs, nullptr); break;
-                case 2: render_triangle(&rdata.gs, nullptr); break;
-                case 3: render_sprite(&rdata.gs, nullptr); break;
-            }
+static inline uint32_t software_addr32(const uint16_t (*table)[64], uint32_t bp, uint32_t bw, uint32_t x, uint32_t y) {
+    return (software_page_addr(bp, bw, x, y, 6, 5) + table[y & 31][x & 63]) & 0xfffff;
+}
 
-            ctx->render_mtx.unlock();
-        }
+static inline uint16_t* software_ptr16(uint32_t* vram, const uint16_t (*table)[64], uint32_t bp, uint32_t bw, uint32_t x, uint32_t y) {
+    uint32_t addr = ((software_page_addr(bp, bw, x, y, 6, 6) * 2) + table[y & 63][x & 63]) & 0x1fffff;
 
-        // std::this_thread::yield();
-    }
+    return (uint16_t*)vram + addr;
 }
 
-void software_thread_destroy(void* udata) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+static inline uint8_t* software_ptr8(uint32_t* vram, uint32_t bp, uint32_t bw, uint32_t x, uint32_t y) {
+    uint32_t addr = ((software_page_addr(bp, bw >> 1, x, y, 7, 6) * 4) + swizzle.t8[y & 63][x & 127]) & 0x3fffff;
 
-    // Send end signal to rendering thread
-    ctx->end_signal = true;
+    return (uint8_t*)vram + addr;
+}
 
-    // Clear rendering queue
-    ctx->queue_mtx.lock();
+static inline uint32_t software_addr4(uint32_t bp, uint32_t bw, uint32_t x, uint32_t y) {
+    return ((software_page_addr(bp, bw >> 1, x, y, 7, 7) * 8) + swizzle.t4[y & 127][x & 127]) & 0x7fffff;
+}
 
-    while (!ctx->render_queue.empty())
-        ctx->render_queue.pop();
+// Raw VRAM accesses, indexed formats return/take the index
+static inline uint32_t software_read(uint32_t* vram, uint32_t bp, uint32_t bw, uint32_t psm, uint32_t x, uint32_t y) {
+    switch (psm) {
+        case GS_PSMCT32: return vram[software_addr32(swizzle.ct32, bp, bw, x, y)];
+        case GS_PSMCT24: return vram[software_addr32(swizzle.ct32, bp, bw, x, y)] & 0xffffff;
+        case GS_PSMCT16: return *software_ptr16(vram, swizzle.ct16, bp, bw, x, y);
+        case GS_PSMCT16S: return *software_ptr16(vram, swizzle.ct16s, bp, bw, x, y);
+        case GS_PSMZ32: return vram[software_addr32(swizzle.z32, bp, bw, x, y)];
+        case GS_PSMZ24: return vram[software_addr32(swizzle.z32, bp, bw, x, y)] & 0xffffff;
+        case GS_PSMZ16: return *software_ptr16(vram, swizzle.z16, bp, bw, x, y);
+        case GS_PSMZ16S: return *software_ptr16(vram, swizzle.z16s, bp, bw, x, y);
+        case GS_PSMT8: return *software_ptr8(vram, bp, bw, x, y);
+        case GS_PSMT8H: return vram[software_addr32(swizzle.ct32, bp, bw, x, y)] >> 24;
+        case GS_PSMT4: {
+            uint32_t addr = software_addr4(bp, bw, x, y);
 
-    ctx->queue_mtx.unlock();
+            return (vram[addr >> 3] >> ((addr & 7) * 4)) & 0xf;
+        }
+        case GS_PSMT4HL: return (vram[software_addr32(swizzle.ct32, bp, bw, x, y)] >> 24) & 0xf;
+        case GS_PSMT4HH: return vram[software_addr32(swizzle.ct32, bp, bw, x, y)] >> 28;
+    }
 
-    if (ctx->buf)
-        free(ctx->buf);
+    return 0;
+}
 
-    // release buffers
-    SDL_ReleaseGPUBuffer(ctx->device, ctx->vertex_buffer);
-    SDL_ReleaseGPUBuffer(ctx->device, ctx->index_buffer);
-    SDL_ReleaseGPUSampler(ctx->device, ctx->sampler[0]);
-    SDL_ReleaseGPUSampler(ctx->device, ctx->sampler[1]);
+static inline void software_write(uint32_t* vram, uint32_t bp, uint32_t bw, uint32_t psm, uint32_t x, uint32_t y, uint32_t data) {
+    switch (psm) {
+        case GS_PSMCT32: vram[software_addr32(swizzle.ct32, bp, bw, x, y)] = data; break;
+        case GS_PSMCT24: {
+            uint32_t addr = software_addr32(swizzle.ct32, bp, bw, x, y);
 
-    if (ctx->texture) SDL_ReleaseGPUTexture(ctx->device, ctx->texture);
-    
-    // release the pipeline
-    SDL_ReleaseGPUGraphicsPipeline(ctx->device, ctx->pipeline);
+            vram[addr] = (vram[addr] & 0xff000000) | (data & 0xffffff);
+        } break;
+        case GS_PSMCT16: *software_ptr16(vram, swizzle.ct16, bp, bw, x, y) = data; break;
+        case GS_PSMCT16S: *software_ptr16(vram, swizzle.ct16s, bp, bw, x, y) = data; break;
+        case GS_PSMZ32: vram[software_addr32(swizzle.z32, bp, bw, x, y)] = data; break;
+        case GS_PSMZ24: {
+            uint32_t addr = software_addr32(swizzle.z32, bp, bw, x, y);
 
-    // Should call destructors for our mutex, thread and queue
-    delete ctx;
-}
+            vram[addr] = (vram[addr] & 0xff000000) | (data & 0xffffff);
+        } break;
+        case GS_PSMZ16: *software_ptr16(vram, swizzle.z16, bp, bw, x, y) = data; break;
+        case GS_PSMZ16S: *software_ptr16(vram, swizzle.z16s, bp, bw, x, y) = data; break;
+        case GS_PSMT8: *software_ptr8(vram, bp, bw, x, y) = data; break;
+        case GS_PSMT8H: {
+            uint32_t addr = software_addr32(swizzle.ct32, bp, bw, x, y);
 
-void software_thread_set_size(void* udata, int width, int height) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+            vram[addr] = (vram[addr] & 0x00ffffff) | (data << 24);
+        } break;
+        case GS_PSMT4: {
+            uint32_t addr = software_addr4(bp, bw, x, y);
+            uint32_t shift = (addr & 7) * 4;
 
-    int en1 = ctx->gs->pmode & 1;
-    int en2 = (ctx->gs->pmode >> 1) & 1;
+            vram[addr >> 3] = (vram[addr >> 3] & ~(0xfu << shift)) | ((data & 0xf) << shift);
+        } break;
+        case GS_PSMT4HL: {
+            uint32_t addr = software_addr32(swizzle.ct32, bp, bw, x, y);
 
-    uint64_t display = 0, dispfb = 0;
+            vram[addr] = (vram[addr] & 0xf0ffffff) | ((data & 0xf) << 24);
+        } break;
+        case GS_PSMT4HH: {
+            uint32_t addr = software_addr32(swizzle.ct32, bp, bw, x, y);
 
-    if (en1 && en2) {
-        display = ctx->gs->display1 > ctx->gs->display2 ? ctx->gs->display1 : ctx->gs->display2;
-        dispfb = ctx->gs->dispfb1 > ctx->gs->dispfb2 ? ctx->gs->dispfb1 : ctx->gs->dispfb2;
-    } else if (en1) {
-        display = ctx->gs->display1;
-        dispfb = ctx->gs->dispfb1;
-    } else if (en2) {
-        display = ctx->gs->display2;
-        dispfb = ctx->gs->dispfb2;
+            vram[addr] = (vram[addr] & 0x0fffffff) | ((data & 0xf) << 28);
+        } break;
     }
+}
 
-    uint32_t tex_fmt = (dispfb >> 15) & 0x1f;
+// Formats whose blocks can be moved around as a whole, the rest share
+// words with other buffers
+static inline bool software_get_block_size(uint32_t psm, uint32_t* w, uint32_t* h) {
+    switch (psm) {
+        case GS_PSMCT32:
+        case GS_PSMZ32: *w = 8; *h = 8; return true;
+        case GS_PSMCT16:
+        case GS_PSMCT16S:
+        case GS_PSMZ16:
+        case GS_PSMZ16S: *w = 16; *h = 8; return true;
+        case GS_PSMT8: *w = 16; *h = 16; return true;
+        case GS_PSMT4: *w = 32; *h = 16; return true;
+    }
 
-    int magh = ((display >> 23) & 0xf) + 1;
-    int magv = ((display >> 27) & 3) + 1;
+    return false;
+}
 
-    if (((display >> 32) & 0xfff) == 0) {
-        ctx->tex_w = 0;
-        ctx->tex_h = 0;
-        
-        return;
+// Word address of the block containing (x, y), the top-left pixel of a
+// block is always at offset 0
+static inline uint32_t software_block_addr(uint32_t bp, uint32_t bw, uint32_t psm, uint32_t x, uint32_t y) {
+    switch (psm) {
+        case GS_PSMCT32: return software_addr32(swizzle.ct32, bp, bw, x, y) & ~63u;
+        case GS_PSMZ32: return software_addr32(swizzle.z32, bp, bw, x, y) & ~63u;
+        case GS_PSMCT16: return (((software_page_addr(bp, bw, x, y, 6, 6) * 2) + swizzle.ct16[y & 63][x & 63]) >> 1) & 0xfffc0;
+        case GS_PSMCT16S: return (((software_page_addr(bp, bw, x, y, 6, 6) * 2) + swizzle.ct16s[y & 63][x & 63]) >> 1) & 0xfffc0;
+        case GS_PSMZ16: return (((software_page_addr(bp, bw, x, y, 6, 6) * 2) + swizzle.z16[y & 63][x & 63]) >> 1) & 0xfffc0;
+        case GS_PSMZ16S: return (((software_page_addr(bp, bw, x, y, 6, 6) * 2) + swizzle.z16s[y & 63][x & 63]) >> 1) & 0xfffc0;
+        case GS_PSMT8: return (((software_page_addr(bp, bw >> 1, x, y, 7, 6) * 4) + swizzle.t8[y & 63][x & 127]) >> 2) & 0xfffc0;
+        case GS_PSMT4: return (software_addr4(bp, bw, x, y) >> 3) & 0xfffc0;
     }
 
-    if (((display >> 44) & 0x7ff) == 0) {
-        ctx->tex_w = 0;
-        ctx->tex_h = 0;
-        
-        return;
-    }
+    return 0;
+}
 
-    uint32_t tex_w = (((display >> 32) & 0xfff) / magh) + 1;
-    uint32_t tex_h = (((display >> 44) & 0x7ff) / magv) + 1;
+static inline int software_psm_bpp(uint32_t psm) {
+    switch (psm) {
+        case GS_PSMCT24:
+        case GS_PSMZ24: return 24;
+        case GS_PSMCT16:
+        case GS_PSMCT16S:
+        case GS_PSMZ16:
+        case GS_PSMZ16S: return 16;
+        case GS_PSMT8:
+        case GS_PSMT8H: return 8;
+        case GS_PSMT4:
+        case GS_PSMT4HL:
+        case GS_PSMT4HH: return 4;
+    }
 
-    // SMODE2 INT=1 FFMD=1
-    // if ((ctx->gs->smode2 & 3) == 3) {
-    //     tex_h /= 2;
-    // }
+    return 32;
+}
 
-    // Weird dobiestation hack, should fix Silent Hill 2, Choro Q HG, etc.
-    if (tex_h >= (tex_w * 1.3))
-        tex_h = tex_h / 2;
+static inline int software_psm_is_16(uint32_t psm) {
+    return (psm & 0xf) == 0x2 || (psm & 0xf) == 0xa;
+}
 
-    // printf("gsr: Setting framebuffer size to %dx%d fmt=%02x magh=%d magv=%d en=(%d,%d) dwh=(%d,%d) dxy=(%d,%d)\n", tex_w, tex_h, tex_fmt, magh, magv, en1, en2,
-    //     (int)((display >> 32) & 0xfff) + 1,
-    //     (int)((display >> 44) & 0x7ff) + 1,
-    //     (int)(display & 0xfff),
-    //     (int)((display >> 12) & 0xfff)
-    // );
+// Conservative VRAM range covered by a w*h area at (0, 0)
+static inline software_range software_get_range(uint32_t bp, uint32_t bw, uint32_t psm, uint32_t w, uint32_t h) {
+    uint32_t pw = 64, ph = 32;
 
-    // Do nothing if the size hasn't changed
-    if (tex_w == ctx->tex_w && tex_h == ctx->tex_h && tex_fmt == ctx->disp_fmt) {
-        return;
+    switch (psm) {
+        case GS_PSMCT16:
+        case GS_PSMCT16S:
+        case GS_PSMZ16:
+        case GS_PSMZ16S: ph = 64; break;
+        case GS_PSMT8: pw = 128; ph = 64; break;
+        case GS_PSMT4: pw = 128; ph = 128; break;
     }
 
-    ctx->tex_w = tex_w;
-    ctx->tex_h = tex_h;
-    ctx->disp_fmt = tex_fmt;
+    uint32_t row = std::max(pw == 128 ? bw >> 1 : bw, 1u);
+    uint32_t cols = std::max((std::max(w, 1u) + pw - 1) / pw, row);
+    uint32_t rows = (std::max(h, 1u) + ph - 1) / ph;
 
-    if (ctx->buf) free(ctx->buf);
+    software_range range;
 
-    ctx->buf = (uint32_t*)malloc((ctx->tex_w * sizeof(uint32_t)) * ctx->tex_h);
+    range.bp = bp;
+    range.bw = bw;
+    range.psm = psm;
+    range.begin = bp * 64;
+    range.end = std::min(range.begin + (rows * cols * 2048), 0x100000u);
 
-    SDL_GPUTextureFormat fmt;
+    return range;
+}
 
-    switch (ctx->disp_fmt) {
-        case GS_PSMCT32:
-        case GS_PSMCT24: {
-            fmt = SDL_GPU_TEXTUREFORMAT_B8G8R8A8_UNORM;
-        } break;
+static inline bool software_overlaps(const software_range& a, const software_range& b) {
+    return a.begin < b.end && b.begin < a.end;
+}
 
-        case GS_PSMCT16:
-        case GS_PSMCT16S: {
-            fmt = SDL_GPU_TEXTUREFORMAT_B5G5R5A1_UNORM;
-        } break;
+static inline bool software_overlaps_any(const std::vector <software_range>& list, const software_range& r) {
+    for (const software_range& e : list)
+        if (software_overlaps(e, r))
+            return true;
 
-        default: {
-            // printf("gsr: Unknown framebuffer format %02x\n", ctx->disp_fmt);
-        } break;
-    }
+    return false;
+}
 
-    if (ctx->texture) {
-        SDL_ReleaseGPUTexture(ctx->device, ctx->texture);
-    }
+static inline void software_add_range(std::vector <software_range>& list, const software_range& r) {
+    for (software_range& e : list) {
+        if (e.bp == r.bp && e.bw == r.bw && e.psm == r.psm) {
+            e.end = std::max(e.end, r.end);
 
-    // Create a texture to send in our frame data
-    SDL_GPUTextureCreateInfo tci = {
-        .type = SDL_GPU_TEXTURETYPE_2D,
-        .format = fmt,
-        .usage = SDL_GPU_TEXTUREUSAGE_SAMPLER,
-        .width = tex_w,
-        .height = tex_h,
-        .layer_count_or_depth = 1,
-        .num_levels = 1,
-        .sample_count = SDL_GPU_SAMPLECOUNT_1,
-    };
+            return;
+        }
+    }
 
-    ctx->texture = SDL_CreateGPUTexture(ctx->device, &tci);
+    list.push_back(r);
 }
 
-void software_thread_set_scale(void* udata, float scale) {
-    software_thread_state* ctx = (software_thread_state*)udata;
-
-    ctx->scale = scale;
+// Register unpacking
+static inline void software_unpack_tex0(struct gs_context* c, uint64_t data) {
+    c->tex0 = data;
+    c->tbp0 = data & 0x3fff;
+    c->tbw = (data >> 14) & 0x3f;
+    c->tbpsm = (data >> 20) & 0x3f;
+    c->usize = 1 << std::min((uint32_t)((data >> 26) & 0xf), 10u);
+    c->vsize = 1 << std::min((uint32_t)((data >> 30) & 0xf), 10u);
+    c->tcc = (data >> 34) & 1;
+    c->tfx = (data >> 35) & 3;
+    c->cbp = (data >> 37) & 0x3fff;
+    c->cbpsm = (data >> 51) & 0xf;
+    c->csm = (data >> 55) & 1;
+    c->csa = (data >> 56) & 0x1f;
+    c->cld = (data >> 61) & 7;
 }
 
-void software_thread_set_aspect_mode(void* udata, int aspect_mode) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+static inline void software_unpack_tex2(struct gs_context* c, uint64_t data) {
+    // TEX2 only updates the palette related fields
+    uint64_t mask = (0x3full << 20) | (0x7ffffffull << 37);
+
+    software_unpack_tex0(c, (c->tex0 & ~mask) | (data & mask));
 
-    ctx->aspect_mode = aspect_mode;
+    c->tex2 = data;
 }
 
-void software_thread_set_integer_scaling(void* udata, bool integer_scaling) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+static inline void software_unpack_tex1(struct gs_context* c, uint64_t data) {
+    c->tex1 = data;
+    c->lcm = data & 1;
+    c->mxl = (data >> 2) & 7;
+    c->mmag = (data >> 5) & 1;
+    c->mmin = (data >> 6) & 7;
+    c->mtba = (data >> 9) & 1;
+    c->l = (data >> 19) & 3;
+    c->k = (data >> 32) & 0xfff;
+}
 
-    ctx->integer_scaling = integer_scaling;
+static inline void software_unpack_clamp(struct gs_context* c, uint64_t data) {
+    c->clamp = data;
+    c->wms = data & 3;
+    c->wmt = (data >> 2) & 3;
+    c->minu = (data >> 4) & 0x3ff;
+    c->maxu = (data >> 14) & 0x3ff;
+    c->minv = (data >> 24) & 0x3ff;
+    c->maxv = (data >> 34) & 0x3ff;
 }
 
-void software_thread_set_bilinear(void* udata, bool bilinear) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+static inline void software_unpack_test(struct gs_context* c, uint64_t data) {
+    c->test = data;
+    c->ate = data & 1;
+    c->atst = (data >> 1) & 7;
+    c->aref = (data >> 4) & 0xff;
+    c->afail = (data >> 12) & 3;
+    c->date = (data >> 14) & 1;
+    c->datm = (data >> 15) & 1;
+    c->zte = (data >> 16) & 1;
+    c->ztst = (data >> 17) & 3;
+}
 
-    ctx->bilinear = bilinear;
+static inline void software_unpack_alpha(struct gs_context* c, uint64_t data) {
+    c->alpha = data;
+    c->a = data & 3;
+    c->b = (data >> 2) & 3;
+    c->c = (data >> 4) & 3;
+    c->d = (data >> 6) & 3;
+    c->fix = (data >> 32) & 0xff;
 }
 
-void software_thread_get_viewport_size(void* udata, int* w, int* h) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+static inline void software_unpack_frame(struct gs_context* c, uint64_t data) {
+    c->frame = data;
+    c->fbp = (data & 0x1ff) << 11;
+    c->fbw = ((data >> 16) & 0x3f) << 6;
+    c->fbpsm = (data >> 24) & 0x3f;
+    c->fbmsk = data >> 32;
+}
 
-    *w = ctx->tex_w;
-    *h = ctx->tex_h;
+static inline void software_unpack_zbuf(struct gs_context* c, uint64_t data) {
+    c->zbuf = data;
+    c->zbp = (data & 0x1ff) << 11;
+    c->zbpsm = ((data >> 24) & 0xf) | 0x30;
+    c->zbmsk = (data >> 32) & 1;
 }
 
-void software_thread_get_display_size(void* udata, int* w, int* h) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+static inline void software_unpack_scissor(struct gs_context* c, uint64_t data) {
+    c->scissor = data;
+    c->scax0 = data & 0x7ff;
+    c->scax1 = (data >> 16) & 0x7ff;
+    c->scay0 = (data >> 32) & 0x7ff;
+    c->scay1 = (data >> 48) & 0x7ff;
+}
 
-    *w = ctx->disp_w;
-    *h = ctx->disp_h;
+static inline void software_unpack_xyoffset(struct gs_context* c, uint64_t data) {
+    c->xyoffset = data;
+    c->ofx = data & 0xffff;
+    c->ofy = (data >> 32) & 0xffff;
 }
 
-void software_thread_get_display_format(void* udata, int* fmt) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+static inline void software_unpack_dimx(software_state* ctx) {
+    for (int i = 0; i < 16; i++)
+        ctx->dither[i >> 2][i & 3] = ((int32_t)(((ctx->dimx >> (i * 4)) & 7) << 29)) >> 29;
+}
 
-    *fmt = ctx->disp_fmt;
-}
+// Batching
+static void software_run_tiles(software_state* ctx);
 
-void software_thread_set_window_rect(void* udata, int x, int y, int w, int h) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+static void software_worker(software_state* ctx) {
+    uint64_t generation = 0;
 
-    ctx->window_x = x;
-    ctx->window_y = y;
-    ctx->window_w = w;
-    ctx->window_h = h;
-}
+    while (true) {
+        {
+            std::unique_lock <std::mutex> lock(ctx->pool_mtx);
 
-void* software_thread_get_buffer_data(void* udata, int* w, int* h, int* bpp) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+            ctx->pool_cv.wait(lock, [&] {
+                return ctx->pool_exit || ctx->pool_generation != generation;
+            });
 
-    if (!ctx->tex_w)
-        return nullptr;
+            if (ctx->pool_exit)
+                return;
 
-    if (!ctx->buf)
-        return nullptr;
+            generation = ctx->pool_generation;
+        }
 
-    *w = ctx->tex_w;
-    *h = ctx->tex_h;
+        software_run_tiles(ctx);
 
-    switch (ctx->disp_fmt) {
-        case GS_PSMCT32:
-        case GS_PSMCT24: {
-            *bpp = 4;
-        } break;
-        case GS_PSMCT16:
-        case GS_PSMCT16S: {
-            *bpp = 2;
-        } break;
-    }
+        std::lock_guard <std::mutex> lock(ctx->pool_mtx);
 
-    return ctx->buf;
+        if (!--ctx->pool_busy)
+            ctx->pool_done_cv.notify_one();
+    }
 }
 
-void software_thread_get_interlace_mode(void* udata, int* interlace) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+static void software_draw_prim(software_state* ctx, const software_prim& prim, int x0, int y0, int x1, int y1);
 
-    *interlace = ctx->gs->smode2 & 3;
-}
+static void software_run_tiles(software_state* ctx) {
+    uint32_t count = ctx->active_tiles.size();
+
+    while (true) {
+        uint32_t i = ctx->next_tile.fetch_add(1, std::memory_order_relaxed);
+
+        if (i >= count)
+            return;
 
-const char* software_thread_get_name(void* udata) {
-    return "Software (Threaded)";
+        uint32_t tile = ctx->active_tiles[i];
+        int tx = (tile % SOFTWARE_TILES_X) << SOFTWARE_TILE_SHIFT;
+        int ty = (tile / SOFTWARE_TILES_X) << SOFTWARE_TILE_SHIFT;
+
+        for (uint32_t p : ctx->bins[tile]) {
+            const software_prim& prim = ctx->prims[p];
+
+            int x0 = std::max(prim.x0, tx);
+            int y0 = std::max(prim.y0, ty);
+            int x1 = std::min(prim.x1, tx + SOFTWARE_TILE_SIZE - 1);
+            int y1 = std::min(prim.y1, ty + SOFTWARE_TILE_SIZE - 1);
+
+            software_draw_prim(ctx, prim, x0, y0, x1, y1);
+        }
+    }
 }
 
-#define CLAMP(v, l, u) (((v) > (u)) ? (u) : (((v) < (l)) ? (l) : (v)))
+static void software_flush(software_state* ctx) {
+    if (ctx->prims.size()) {
+        ctx->next_tile = 0;
 
-static inline uint32_t gs_apply_function(struct ps2_gs* gs, uint32_t t, uint32_t f) {
-    int pr, pg, pb, pa;
-    int tr = t & 0xff;
-    int tg = (t >> 8) & 0xff;
-    int tb = (t >> 16) & 0xff;
-    int ta = (t >> 24) & 0xff;
-    int fr = f & 0xff;
-    int fg = (f >> 8) & 0xff;
-    int fb = (f >> 16) & 0xff;
-    int fa = (f >> 24) & 0xff;
-
-    switch (gs->ctx->tfx) {
-        case GS_MODULATE: {
-            pr = CLAMP((tr * fr) >> 7, 0, 255);
-            pg = CLAMP((tg * fg) >> 7, 0, 255);
-            pb = CLAMP((tb * fb) >> 7, 0, 255);
+        // Not worth waking up the pool for a couple tiles
+        if (ctx->workers.empty() || ctx->active_tiles.size() < 4) {
+            software_run_tiles(ctx);
+        } else {
+            {
+                std::lock_guard <std::mutex> lock(ctx->pool_mtx);
 
-            if (gs->ctx->tcc) {
-                pa = CLAMP((ta * fa) >> 7, 0, 255);
-            } else {
-                pa = fa;
+                ctx->pool_busy = ctx->workers.size();
+                ctx->pool_generation++;
             }
-        } break;
-        case GS_DECAL: {
-            pr = tr;
-            pg = tg;
-            pb = tb;
 
-            if (gs->ctx->tcc) {
-                pa = ta;
-            } else {
-                pa = fa;
-            }
-        } break;
-        case GS_HIGHLIGHT: {
-            pr = CLAMP(((tr * fr) >> 7) + fa, 0, 255);
-            pg = CLAMP(((tg * fg) >> 7) + fa, 0, 255);
-            pb = CLAMP(((tb * fb) >> 7) + fa, 0, 255);
+            ctx->pool_cv.notify_all();
 
-            if (gs->ctx->tcc) {
-                pa = CLAMP(fa + ta, 0, 255);
-            } else {
-                pa = fa;
-            }
-        } break;
-        case GS_HIGHLIGHT2: {
-            pr = CLAMP(((tr * fr) >> 7) + fa, 0, 255);
-            pg = CLAMP(((tg * fg) >> 7) + fa, 0, 255);
-            pb = CLAMP(((tb * fb) >> 7) + fa, 0, 255);
+            software_run_tiles(ctx);
 
-            if (gs->ctx->tcc) {
-                pa = ta;
-            } else {
-                pa = fa;
-            }
-        } break;
+            std::unique_lock <std::mutex> lock(ctx->pool_mtx);
+
+            ctx->pool_done_cv.wait(lock, [&] { return !ctx->pool_busy; });
+        }
     }
 
-    return (pr & 0xff) | ((pg & 0xff) << 8) | ((pb & 0xff) << 16) | ((pa & 0xff) << 24);
+    for (uint32_t tile : ctx->active_tiles)
+        ctx->bins[tile].clear();
+
+    ctx->active_tiles.clear();
+    ctx->prims.clear();
+    ctx->triangles.clear();
+    ctx->states.clear();
+    ctx->cluts.clear();
+    ctx->reads.clear();
+    ctx->writes.clear();
+
+    ctx->state_dirty = true;
+    ctx->clut_dirty = true;
+    ctx->batch++;
 }
 
-static inline int gs_clamp_u(struct ps2_gs* gs, int u) {
-    switch (gs->ctx->wms) {
-        case 0: {
-            u %= gs->ctx->usize;
-        } break;
+// CLUT cache
+static inline void software_load_clut_entry(software_state* ctx, struct gs_context* c, int entry, uint32_t x, uint32_t y) {
+    uint32_t* vram = ctx->gs->vram;
 
-        case 1: {
-            u = (u < 0) ? 0 : ((u > (int)gs->ctx->usize) ? gs->ctx->usize : u);
-        } break;
+    if (c->cbpsm == GS_PSMCT32 || c->cbpsm == GS_PSMCT24) {
+        uint32_t data = software_read(vram, c->cbp, 1, GS_PSMCT32, x, y);
+        int i = ((c->csa & 0xf) * 16 + entry) & 0xff;
 
-        case 2: {
-            u = (u < (int)gs->ctx->minu) ? gs->ctx->minu : ((u > (int)gs->ctx->maxu) ? gs->ctx->maxu : u);
-        } break;
+        ctx->clut[i] = data & 0xffff;
+        ctx->clut[i + 256] = data >> 16;
+    } else {
+        uint32_t data = software_read(vram, c->cbp, 1, c->cbpsm, x, y);
 
-        case 3: {
-            int umsk = gs->ctx->minu;
-            int ufix = gs->ctx->maxu;
+        ctx->clut[(c->csa * 16 + entry) & 0x1ff] = data;
+    }
+}
 
-            u = (u & umsk) | ufix;
-        } break;
+static void software_load_clut(software_state* ctx, struct gs_context* c) {
+    switch (c->cld) {
+        case 0: return;
+        case 1: break;
+        case 2: ctx->cbp0 = c->cbp; break;
+        case 3: ctx->cbp1 = c->cbp; break;
+        case 4: if (c->cbp == ctx->cbp0) return; ctx->cbp0 = c->cbp; break;
+        case 5: if (c->cbp == ctx->cbp1) return; ctx->cbp1 = c->cbp; break;
+        default: return;
     }
 
-    return u;
-}
+    int entries;
 
-static inline int gs_clamp_v(struct ps2_gs* gs, int v) {
-    switch (gs->ctx->wmt) {
-        case 0: {
-            v %= gs->ctx->vsize;
-        } break;
+    switch (c->tbpsm) {
+        case GS_PSMT8:
+        case GS_PSMT8H: entries = 256; break;
+        case GS_PSMT4:
+        case GS_PSMT4HL:
+        case GS_PSMT4HH: entries = 16; break;
+        default: return;
+    }
 
-        case 1: {
-            v = (v < 0) ? 0 : ((v > (int)gs->ctx->vsize) ? gs->ctx->vsize : v);
-        } break;
+    // Palettes may be rendered to, make sure pending draws land first
+    software_range range = software_get_range(c->cbp, 1, c->cbpsm, 64, 16);
 
-        case 2: {
-            v = (v < (int)gs->ctx->minv) ? gs->ctx->minv : ((v > (int)gs->ctx->maxv) ? gs->ctx->maxv : v);
-        } break;
+    if (c->csm)
+        range = software_get_range(c->cbp, ctx->cbw, GS_PSMCT16, ctx->cou + entries, ctx->cov + 1);
 
-        case 3: {
-            int vmsk = gs->ctx->minv;
-            int vfix = gs->ctx->maxv;
+    if (software_overlaps_any(ctx->writes, range))
+        software_flush(ctx);
 
-            v = (v & vmsk) | vfix;
-        } break;
+    for (int i = 0; i < entries; i++) {
+        if (c->csm) {
+            // CSM2, 16-bit entries laid out linearly
+            uint32_t data = software_read(ctx->gs->vram, c->cbp, ctx->cbw, GS_PSMCT16, ctx->cou + i, ctx->cov);
+
+            ctx->clut[(c->csa * 16 + i) & 0x1ff] = data;
+        } else if (entries == 256) {
+            int p = psmt8_clut_block[i];
+
+            software_load_clut_entry(ctx, c, i, p & 0xf, p >> 4);
+        } else {
+            software_load_clut_entry(ctx, c, i, i & 7, i >> 3);
+        }
     }
 
-    return v;
+    ctx->clut_dirty = true;
 }
 
-enum : int {
-    TR_FAIL,
-    TR_PASS,
-    TR_FB_ONLY,
-    TR_ZB_ONLY,
-    TR_RGB_ONLY
-};
+// Draw state
+static inline void software_mark_dirty(software_state* ctx, const software_range& r);
+static void software_lookup_texture(software_state* ctx, software_draw_state* s);
 
-static inline uint32_t gs_read_fb(struct ps2_gs* gs, int x, int y) {
-    switch (gs->ctx->fbpsm) {
-        case GS_PSMCT32: {
-            uint32_t addr = psmct32_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
+static void software_push_state(software_state* ctx) {
+    uint64_t attr = (ctx->prmodecont & 1) ? ctx->prim : ctx->prmode;
 
-            return gs->vram[addr & 0xfffff];
-        }
-        case GS_PSMCT24: {
-            uint32_t addr = psmct32_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
+    software_draw_state s;
 
-            return (gs->vram[addr & 0xfffff] & 0xffffff) | 0x80000000;
-        }
-        case GS_PSMCT16: {
-            uint32_t addr = psmct16_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+    // Records are compared bytewise, padding included
+    memset(&s, 0, sizeof(s));
+    memcpy(&s.ctx, &ctx->context[(attr >> 9) & 1], sizeof(s.ctx));
 
-            int idx = (x & 15) + ((y & 1) * 16);
+    s.iip = (attr >> 3) & 1;
+    s.tme = (attr >> 4) & 1;
+    s.fge = (attr >> 5) & 1;
+    s.abe = (attr >> 6) & 1;
+    s.fst = (attr >> 8) & 1;
+    s.aem = (ctx->texa >> 15) & 1;
+    s.ta0 = ctx->texa & 0xff;
+    s.ta1 = (ctx->texa >> 32) & 0xff;
+    s.fogcol = ctx->fogcol & 0xffffff;
+    s.dthe = ctx->dthe & 1;
+    s.colclamp = ctx->colclamp & 1;
+    s.pabe = ctx->pabe & 1;
 
-            return vram[psmct16_shift[idx] & 0xfffff];
-        } break;
-        case GS_PSMCT16S: {
-            uint32_t addr = psmct16s_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+    memcpy(s.dither, ctx->dither, sizeof(s.dither));
 
-            int idx = (x & 15) + ((y & 1) * 16);
+    struct gs_context* c = &s.ctx;
 
-            return vram[psmct16_shift[idx] & 0xfffff];
-        } break;
-        case GS_PSMZ32: {
-            uint32_t addr = psmz32_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
+    bool uses_clut = s.tme && software_psm_bpp(c->tbpsm) <= 8;
 
-            return gs->vram[addr & 0xfffff];
-        }
-        case GS_PSMZ24: {
-            uint32_t addr = psmz32_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
+    // Most register writes between primitives just restore the same
+    // values, keep using the previous record if nothing changed
+    if (!ctx->states.empty() && !(uses_clut && ctx->clut_dirty)) {
+        s.clut = ctx->states.back().clut;
+        s.texture = ctx->states.back().texture;
+        s.quad = ctx->states.back().quad;
 
-            return (gs->vram[addr & 0xfffff] & 0xffffff) | 0x80000000;
+        if (!memcmp(&s, &ctx->states.back(), sizeof(s))) {
+            ctx->state_dirty = false;
+
+            return;
         }
-        case GS_PSMZ16: {
-            uint32_t addr = psmz16_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+    }
 
-            int idx = (x & 15) + ((y & 1) * 16);
+    s.clut = 0;
+    s.texture = nullptr;
 
-            return vram[psmct16_shift[idx] & 0xfffff];
-        } break;
-        case GS_PSMZ16S: {
-            uint32_t addr = psmz16s_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+    uint32_t w = c->scax1 + 1;
+    uint32_t h = c->scay1 + 1;
 
-            int idx = (x & 15) + ((y & 1) * 16);
+    software_range fb = software_get_range(c->fbp >> 6, c->fbw >> 6, c->fbpsm, w, h);
+    software_range zb = software_get_range(c->zbp >> 6, c->fbw >> 6, c->zbpsm, w, h);
+    software_range tex = software_get_range(c->tbp0, c->tbw, c->tbpsm, c->usize, c->vsize);
 
-            return vram[psmct16_shift[idx] & 0xfffff];
-        } break;
-        default: {
-            // printf("Unsupported PSMT %02x for fb read\n", gs->ctx->fbpsm);
-            // exit(1);
-        } break;
-    }
+    bool fb_used = c->fbmsk != 0xffffffff;
+    bool zb_used = c->zte && (c->ztst != 1 || !c->zbmsk);
 
-    return 0;
-}
+    // Sampling from the render target of the same draw can't be split
+    // across tiles, draw those right away
+    ctx->immediate = s.tme && ((fb_used && software_overlaps(tex, fb)) || (zb_used && software_overlaps(tex, zb)));
 
-static inline uint32_t gs_read_dispfb(struct ps2_gs* gs, int x, int y, int dfb) {
-    uint32_t dfbp = dfb ? gs->dfbp2 : gs->dfbp1;
-    uint32_t dfbw = dfb ? gs->dfbw2 : gs->dfbw1;
-    uint32_t dfbpsm = dfb ? gs->dfbpsm2 : gs->dfbpsm1;
+    s.quad = !ctx->immediate && !(fb_used && zb_used && software_overlaps(fb, zb));
 
-    switch (dfbpsm) {
-        case GS_PSMCT32: {
-            uint32_t addr = psmct32_addr(dfbp, dfbw, x, y);
+    bool hazard = ctx->immediate;
 
-            return gs->vram[addr & 0xfffff];
-        }
-        case GS_PSMCT24: {
-            uint32_t addr = psmct32_addr(dfbp, dfbw, x, y);
+    if (s.tme && software_overlaps_any(ctx->writes, tex))
+        hazard = true;
 
-            return gs->vram[addr & 0xfffff] & 0xffffff;
-        }
-        case GS_PSMCT16: {
-            uint32_t addr = psmct16_addr(dfbp, dfbw, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+    const software_range* targets[2] = {
+        fb_used ? &fb : nullptr,
+        zb_used ? &zb : nullptr
+    };
 
-            int idx = (x & 15) + ((y & 1) * 16);
+    for (const software_range* t : targets) {
+        if (!t)
+            continue;
 
-            return vram[psmct16_shift[idx] & 0xfffff];
-        } break;
-        case GS_PSMCT16S: {
-            uint32_t addr = psmct16s_addr(dfbp, dfbw, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+        const software_range& r = *t;
 
-            int idx = (x & 15) + ((y & 1) * 16);
+        if (software_overlaps_any(ctx->reads, r))
+            hazard = true;
 
-            return vram[psmct16_shift[idx] & 0xfffff];
-        } break;
-        default: {
-            fprintf(stderr, "Unsupported PSMT %02x for dispfb read\n", dfbpsm);
-
-            exit(1);
-        } break;
+        // Aliasing a target with a different layout would break the
+        // tile to pixel mapping
+        for (const software_range& e : ctx->writes)
+            if (software_overlaps(e, r) && (e.bp != r.bp || e.bw != r.bw || e.psm != r.psm))
+                hazard = true;
     }
 
-    return 0;
-}
+    if (hazard && ctx->prims.size())
+        software_flush(ctx);
 
-static inline uint32_t gs_read_zb(struct ps2_gs* gs, int x, int y) {
-    switch (gs->ctx->zbpsm) {
-        case GS_PSMCT32: {
-            uint32_t addr = psmct32_addr(gs->ctx->zbp >> 6, gs->ctx->fbw >> 6, x, y);
+    // Draws that sample their own target can't use a decoded copy
+    if (s.tme && !ctx->immediate)
+        software_lookup_texture(ctx, &s);
 
-            return gs->vram[addr & 0xfffff];
-        }
-        case GS_PSMCT24: {
-            uint32_t addr = psmct32_addr(gs->ctx->zbp >> 6, gs->ctx->fbw >> 6, x, y);
+    // Only snapshot the CLUT when a draw can actually see it
+    if (uses_clut) {
+        if (ctx->clut_dirty || ctx->cluts.empty()) {
+            ctx->cluts.insert(ctx->cluts.end(), ctx->clut, ctx->clut + 512);
 
-            return gs->vram[addr & 0xfffff] & 0xffffff;
+            ctx->clut_dirty = false;
         }
-        case GS_PSMCT16: {
-            uint32_t addr = psmct16_addr(gs->ctx->zbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
 
-            int idx = (x & 15) + ((y & 1) * 16);
+        s.clut = ctx->cluts.size() - 512;
+    }
 
-            return vram[psmct16_shift[idx]];
-        } break;
-        case GS_PSMCT16S: {
-            uint32_t addr = psmct16s_addr(gs->ctx->zbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+    if (s.tme) software_add_range(ctx->reads, tex);
 
-            int idx = (x & 15) + ((y & 1) * 16);
+    if (fb_used) {
+        software_add_range(ctx->writes, fb);
+        software_mark_dirty(ctx, fb);
+    }
 
-            return vram[psmct16_shift[idx]];
-        } break;
-        case GS_PSMZ32: {
-            uint32_t addr = psmz32_addr(gs->ctx->zbp >> 6, gs->ctx->fbw >> 6, x, y);
+    if (zb_used) {
+        software_add_range(ctx->writes, zb);
+        software_mark_dirty(ctx, zb);
+    }
 
-            return gs->vram[addr & 0xfffff];
-        }
+    ctx->states.push_back(s);
+
+    ctx->state_dirty = false;
+}
+
+// Pixel pipeline
+static inline uint32_t software_to_rgba32(const software_draw_state& s, uint32_t c, uint32_t psm) {
+    switch (psm) {
+        case GS_PSMCT24:
         case GS_PSMZ24: {
-            uint32_t addr = psmz32_addr(gs->ctx->zbp >> 6, gs->ctx->fbw >> 6, x, y);
+            uint32_t a = (s.aem && !(c & 0xffffff)) ? 0 : s.ta0;
 
-            return gs->vram[addr & 0xfffff] & 0xffffff;
+            return (c & 0xffffff) | (a << 24);
         }
-        case GS_PSMZ16: {
-            uint32_t addr = psmz16_addr(gs->ctx->zbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
-
-            int idx = (x & 15) + ((y & 1) * 16);
 
-            return vram[psmct16_shift[idx]];
-        } break;
+        case GS_PSMCT16:
+        case GS_PSMCT16S:
+        case GS_PSMZ16:
         case GS_PSMZ16S: {
-            uint32_t addr = psmz16s_addr(gs->ctx->zbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+            uint32_t a;
 
-            int idx = (x & 15) + ((y & 1) * 16);
+            if (c & 0x8000) {
+                a = s.ta1;
+            } else {
+                a = (s.aem && !(c & 0x7fff)) ? 0 : s.ta0;
+            }
 
-            return vram[psmct16_shift[idx]];
-        } break;
-        default: {
-            // printf("Unsupported PSMT %02x for zb read\n", gs->ctx->zbpsm);
-            // exit(1);
-        } break;
+            return ((c & 0x001f) << 3) |
+                   ((c & 0x03e0) << 6) |
+                   ((c & 0x7c00) << 9) |
+                   (a << 24);
+        }
     }
 
-    return 0;
+    return c;
 }
 
-static inline uint32_t gs_read_cb_csm2(struct ps2_gs* gs, int i) {
-    int x = i + gs->cou;
+static inline uint32_t software_read_clut(const uint16_t* clut, const software_draw_state& s, uint32_t index) {
+    if (s.ctx.cbpsm == GS_PSMCT32 || s.ctx.cbpsm == GS_PSMCT24) {
+        uint32_t i = (s.ctx.tbpsm == GS_PSMT8 || s.ctx.tbpsm == GS_PSMT8H) ? index : (((s.ctx.csa & 0xf) * 16) + index);
 
-    uint32_t addr = psmct16_addr(gs->ctx->cbp, gs->cbw, x, gs->cov);
-    uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+        i &= 0xff;
 
-    int idx = (x & 15) + ((gs->cov & 1) * 16);
+        return software_to_rgba32(s, clut[i] | (clut[i + 256] << 16), s.ctx.cbpsm);
+    }
 
-    return vram[psmct16_shift[idx] & 0xfffff];
+    uint32_t i = (s.ctx.tbpsm == GS_PSMT8 || s.ctx.tbpsm == GS_PSMT8H) ? index : ((s.ctx.csa * 16) + index);
 
-    // switch (gs->ctx->tbpsm) {
-    //     case GS_PSMT8H:
-    //     case GS_PSMT8: {
-    //         uint32_t addr = psmct16_addr(gs->ctx->cbp, gs->cbw, x, gs->cov);
-    //         uint16_t* vram = (uint16_t*)(&gs->vram[addr]);
+    return software_to_rgba32(s, clut[i & 0x1ff], GS_PSMCT16);
+}
 
-    //         int idx = (x & 15) + ((gs->cov & 1) * 16);
+static inline int software_wrap(int c, int size, int mode, int min, int max) {
+    switch (mode) {
+        case 0: return c & (size - 1);
+        case 1: return CLAMP(c, 0, size - 1);
+        case 2: return CLAMP(c, min, max);
+        case 3: return (c & min) | max;
+    }
+
+    return c;
+}
+
+static inline uint32_t software_decode_texel(software_state* ctx, const software_draw_state& s, const uint16_t* clut, int u, int v) {
+    const struct gs_context& c = s.ctx;
 
-    //         return gs->vram[psmct16_shift[idx]];
-    //     } break;
+    uint32_t t = software_read(ctx->gs->vram, c.tbp0, c.tbw, c.tbpsm, u, v);
 
-    //     case GS_PSMT4HL:
-    //     case GS_PSMT4HH:
-    //     case GS_PSMT4: {
-    //         uint32_t addr = psmct16_addr(gs->ctx->cbp, gs->ctx->tbw, i, 0);
-    //         uint16_t* vram = (uint16_t*)(&gs->vram[addr]);
+    if (software_psm_bpp(c.tbpsm) <= 8)
+        return software_read_clut(clut, s, t);
 
-    //         return gs->vram[psmct16_shift[i & 15]];
-    //     } break;
-    // }
+    return software_to_rgba32(s, t, c.tbpsm);
 }
 
-static inline uint32_t gs_read_cb(struct ps2_gs* gs, int i) {
-    // Note: CSM2 should be the same?
-    // not sure if the different arrangement actually
-    // changes how address calculation is performed
-    // maybe it only applies to the CLUT cache
-    // - Edit: CSM2 uses the TEXCLUT reg, and it's
-    // basically just like a normal buffer
+static inline uint32_t software_fetch_texel(software_state* ctx, const software_draw_state& s, int u, int v) {
+    const struct gs_context& c = s.ctx;
 
-    // Note: CLUT buffers are always 64 pixels wide
+    u = software_wrap(u, c.usize, c.wms, c.minu, c.maxu);
+    v = software_wrap(v, c.vsize, c.wmt, c.minv, c.maxv);
 
-    if (gs->ctx->csm == 1)
-        return gs_read_cb_csm2(gs, i);
+    // Region modes can reach outside of the cached area
+    if (s.texture && (uint32_t)u < c.usize && (uint32_t)v < c.vsize)
+        return s.texture[u + (v * c.usize)];
 
-    switch (gs->ctx->tbpsm) {
-        case GS_PSMT8H:
-        case GS_PSMT8: {
-            int p = psmt8_clut_block[i];
-            int x = p & 0xf;
-            int y = p >> 4;
-
-            switch (gs->ctx->cbpsm) {
-                case GS_PSMCT32: {
-                    return gs->vram[psmct32_addr(gs->ctx->cbp, 1, x, y) & 0xfffff];
-                } break;
-
-                case GS_PSMCT16:
-                case GS_PSMCT16S: {
-                    uint32_t addr = psmct16_addr(gs->ctx->cbp, 2, x, y);
-                    uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
-
-                    int idx = (x & 15) + ((y & 1) * 16);
-
-                    return vram[psmct16_shift[idx] & 0xfffff];
-                } break;
-                default: {
-                    // printf("Unsupported PSMT %02x for 8-bit cb read\n", gs->ctx->cbpsm);
-                    // exit(1);
-                } break;
-            }
-        } break;
+    return software_decode_texel(ctx, s, ctx->cluts.data() + s.clut, u, v);
+}
 
-        case GS_PSMT4HH:
-        case GS_PSMT4HL:
-        case GS_PSMT4: {
-            int x = i & 0x7;
-            int y = i >> 3;
-
-            switch (gs->ctx->cbpsm) {
-                case GS_PSMCT32: {
-                    // return gs->clut_cache[gs->ctx->csa + x + (y * 8)];
-                    return gs->vram[psmct32_addr(gs->ctx->cbp, 1, x, y) & 0xfffff];
-                } break;
-
-                case GS_PSMCT16:
-                case GS_PSMCT16S: {
-                    uint32_t addr = psmct16_addr(gs->ctx->cbp, 2, x, y);
-                    uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
-
-                    int idx = (x & 15) + ((y & 1) * 16);
-
-                    return vram[psmct16_shift[idx] & 0xfffff];
-                } break;
-                default: {
-                    // printf("Unsupported PSMT %02x for 4-bit cb read\n", gs->ctx->cbpsm);
-                    // exit(1);
-                } break;
-            }
-        } break;
-    }
+// Texture cache
+static inline void software_mark_dirty(software_state* ctx, const software_range& r) {
+    if (r.end <= r.begin)
+        return;
 
-    return 0;
+    for (uint32_t page = r.begin >> 11; page <= ((r.end - 1) >> 11); page++)
+        ctx->dirty_pages[page >> 6] |= 1ull << (page & 63);
+
+    ctx->dirty = true;
 }
 
-static inline uint32_t gs_to_rgba32(struct ps2_gs* gs, uint32_t c, int fmt) {
-    switch (fmt) {
-        case GS_PSMCT32:
-        case GS_PSMZ32: {
-            return c;
-        }
+static void software_invalidate_textures(software_state* ctx) {
+    if (!ctx->dirty)
+        return;
 
-        case GS_PSMCT24:
-        case GS_PSMZ24: {
-            uint32_t a = 0;
+    for (software_texture& t : ctx->textures) {
+        if (!t.valid)
+            continue;
 
-            if (gs->aem) {
-                if (c & 0xffffff) {
-                    a = gs->ta0;
-                } else {
-                    a = 0;
-                }
-            } else {
-                a = gs->ta0;
-            }
+        for (uint32_t page = t.page_begin; page <= t.page_end; page++) {
+            if (ctx->dirty_pages[page >> 6] & (1ull << (page & 63))) {
+                t.valid = false;
 
-            return c | (a << 24);
+                break;
+            }
         }
+    }
 
-        case GS_PSMCT16:
-        case GS_PSMCT16S:
-        case GS_PSMZ16:
-        case GS_PSMZ16S: {
-            int ia = c & 0x8000;
-            uint32_t oa = 0;
+    memset(ctx->dirty_pages, 0, sizeof(ctx->dirty_pages));
 
-            if (ia) {
-                oa = gs->ta1;
-            } else {
-                if (gs->aem) {
-                    if (c & 0x7fff) {
-                        oa = gs->ta0;
-                    } else {
-                        oa = 0;
-                    }
-                } else {
-                    oa = gs->ta0;
-                }
-            }
+    ctx->dirty = false;
+}
 
-            return ((c & 0x001f) << 3) |
-                   ((c & 0x03e0) << 6) |
-                   ((c & 0x7c00) << 9) |
-                   (oa << 24);
-        } break;
+static void software_lookup_texture(software_state* ctx, software_draw_state* s) {
+    const struct gs_context& c = s->ctx;
 
-        case GS_PSMT8:
-        case GS_PSMT8H:
-        case GS_PSMT4:
-        case GS_PSMT4HL:
-        case GS_PSMT4HH: {
-            return gs_to_rgba32(gs, c, gs->ctx->cbpsm);
-        } break;
-        default: {
-            // printf("Unsupported PSMT %02x for to_rgba32\n", fmt);
-            // exit(1);
-        } break;
+    s->texture = nullptr;
+
+    if ((c.usize * c.vsize) > SOFTWARE_TEXTURE_MAX_TEXELS)
+        return;
+
+    software_invalidate_textures(ctx);
+
+    // Indexed textures are keyed by their decoded palette, this also
+    // takes care of CSA, CBPSM and TEXA
+    uint32_t palette[256] = {};
+    int entries = 0;
+
+    switch (software_psm_bpp(c.tbpsm)) {
+        case 8: entries = 256; break;
+        case 4: entries = 16; break;
     }
 
-    return 0;
-}
+    for (int i = 0; i < entries; i++)
+        palette[i] = software_read_clut(ctx->clut, *s, i);
 
-static inline uint32_t gs_from_rgba32(struct ps2_gs* gs, uint32_t c, int fmt, int x = 0, int y = 0, int dither = 0) {
-    switch (fmt) {
-        case GS_PSMCT32:
-        case GS_PSMZ32: {
-            return c;
-        }
+    bool uses_texa = !entries && c.tbpsm != GS_PSMCT32;
 
-        case GS_PSMCT24:
-        case GS_PSMZ24: {
-            // To-do: Use TEXA
-            return c & 0xffffff;
+    software_texture* victim = nullptr;
+
+    for (software_texture& t : ctx->textures) {
+        if (t.valid && t.tbp0 == c.tbp0 && t.tbw == c.tbw && t.psm == c.tbpsm &&
+            t.usize == c.usize && t.vsize == c.vsize &&
+            (!uses_texa || (t.aem == s->aem && t.ta0 == s->ta0 && t.ta1 == s->ta1)) &&
+            !memcmp(t.palette, palette, entries * sizeof(uint32_t))) {
+            t.batch = ctx->batch;
+            t.last_used = ++ctx->texture_clock;
+
+            s->texture = t.data.data();
+
+            return;
         }
 
-        case GS_PSMCT16:
-        case GS_PSMCT16S: {
-            if (dither) {
-                int dv = gs->dither[y & 3][x & 3];
+        // Textures referenced by the current batch must stay put
+        if (t.batch == ctx->batch)
+            continue;
 
-                int r = c & 0xff;
-                int g = (c >> 8) & 0xff;
-                int b = (c >> 16) & 0xff;
+        if (!victim || (victim->valid && (!t.valid || t.last_used < victim->last_used)))
+            victim = &t;
+    }
 
-                r += dv;
-                g += dv;
-                b += dv;
+    if (!victim)
+        return;
 
-                r = CLAMP(r, 0, 255);
-                g = CLAMP(g, 0, 255);
-                b = CLAMP(b, 0, 255);
+    software_range range = software_get_range(c.tbp0, c.tbw, c.tbpsm, c.usize, c.vsize);
 
-                r = (r >> 3) & 0x1f;
-                g = (g >> 3) & 0x1f;
-                b = (b >> 3) & 0x1f;
+    victim->valid = true;
+    victim->tbp0 = c.tbp0;
+    victim->tbw = c.tbw;
+    victim->psm = c.tbpsm;
+    victim->usize = c.usize;
+    victim->vsize = c.vsize;
+    victim->aem = s->aem;
+    victim->ta0 = s->ta0;
+    victim->ta1 = s->ta1;
+    victim->page_begin = range.begin >> 11;
+    victim->page_end = (std::max(range.end, range.begin + 1) - 1) >> 11;
+    victim->batch = ctx->batch;
+    victim->last_used = ++ctx->texture_clock;
 
-                return r | (g << 5) | (b << 10) | ((c & 0x80000000) ? 0x8000 : 0);
-            }
+    memcpy(victim->palette, palette, sizeof(palette));
 
-            // To-do: Use TEXA
-            return ((c & 0x0000f8) >> 3) |
-                   ((c & 0x00f800) >> 6) |
-                   ((c & 0xf80000) >> 9) |
-                   ((c & 0x80000000) ? 0x8000 : 0);
-        } break;
-        case GS_PSMZ16:
-        case GS_PSMZ16S: {
-            return c & 0xffff;
-        } break;
-        case GS_PSMT8:
-        case GS_PSMT8H:
-        case GS_PSMT4:
-        case GS_PSMT4HL:
-        case GS_PSMT4HH: {
-            return gs_from_rgba32(gs, c, gs->ctx->cbpsm);
-        } break;
-        default: {
-            // printf("Unsupported PSMT %02x for from_rgba32\n", fmt);
-            // exit(1);
-        } break;
+    victim->data.resize(c.usize * c.vsize);
+
+    uint32_t* dst = victim->data.data();
+
+    for (uint32_t v = 0; v < c.vsize; v++)
+        for (uint32_t u = 0; u < c.usize; u++)
+            *dst++ = software_decode_texel(ctx, *s, ctx->clut, u, v);
+
+    s->texture = victim->data.data();
+}
+
+static inline uint32_t software_lerp_rgba(uint32_t a, uint32_t b, int f) {
+    uint32_t r = 0;
+
+    for (int i = 0; i < 32; i += 8) {
+        int ca = (a >> i) & 0xff;
+        int cb = (b >> i) & 0xff;
+
+        r |= (uint32_t)((ca + (((cb - ca) * f) >> 4)) & 0xff) << i;
     }
 
-    return 0;
+    return r;
 }
 
-static inline uint32_t gs_read_tb_impl(struct ps2_gs* gs, int u, int v) {
-    u = gs_clamp_u(gs, u);
-    v = gs_clamp_v(gs, v);
+// u and v are 12.4 texel coordinates
+static inline uint32_t software_sample(software_state* ctx, const software_draw_state& s, int u, int v, float q) {
+    const struct gs_context& c = s.ctx;
 
-    switch (gs->ctx->tbpsm) {
-        case GS_PSMCT32:
-            return gs->vram[psmct32_addr(gs->ctx->tbp0, gs->ctx->tbw, u, v) & 0xfffff];
-        case GS_PSMCT24:
-            return gs->vram[psmct32_addr(gs->ctx->tbp0, gs->ctx->tbw, u, v) & 0xfffff] & 0xffffff;
-        case GS_PSMCT16: {
-            uint32_t addr = psmct16_addr(gs->ctx->tbp0, gs->ctx->tbw, u, v);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+    // Only the base level is sampled, LOD just picks the filter and
+    // doesn't need computing if both filters are the same
+    int linear = c.mmag;
+    int min = c.mmin == 1 || c.mmin >= 4;
 
-            int idx = (u & 15) + ((v & 1) * 16);
+    if ((c.lcm || !s.fst) && linear != min) {
+        int k = ((int32_t)(c.k << 20)) >> 20;
+        float lod = c.lcm ? (k / 16.0f) : ((-log2f(fabsf(q)) * (1 << c.l)) + (k / 16.0f));
 
-            return vram[psmct16_shift[idx]];
-        } break;
-        case GS_PSMCT16S: {
-            uint32_t addr = psmct16s_addr(gs->ctx->tbp0, gs->ctx->tbw, u, v);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+        if (lod > 0.0f)
+            linear = min;
+    }
 
-            int idx = (u & 15) + ((v & 1) * 16);
+    if (!linear)
+        return software_fetch_texel(ctx, s, u >> 4, v >> 4);
 
-            return vram[psmct16_shift[idx]];
-        } break;
-        case GS_PSMT8: {
-            uint32_t addr = psmt8_addr(gs->ctx->tbp0, gs->ctx->tbw, u, v);
-            uint8_t* vram = (uint8_t*)(&gs->vram[addr & 0xfffff]);
+    u -= 8;
+    v -= 8;
 
-            int idx = (u & 15) + ((v & 3) * 16);
+    int iu = u >> 4;
+    int iv = v >> 4;
+    int fu = u & 0xf;
+    int fv = v & 0xf;
 
-            return gs_read_cb(gs, vram[psmt8_shift[idx]]);
-        } break;
-        case GS_PSMT8H: {
-            uint32_t data = gs->vram[psmct32_addr(gs->ctx->tbp0, gs->ctx->tbw, u, v) & 0xfffff];
+    uint32_t s0 = software_fetch_texel(ctx, s, iu, iv);
+    uint32_t s1 = software_fetch_texel(ctx, s, iu + 1, iv);
+    uint32_t s2 = software_fetch_texel(ctx, s, iu, iv + 1);
+    uint32_t s3 = software_fetch_texel(ctx, s, iu + 1, iv + 1);
 
-            return gs_read_cb(gs, data >> 24);
-        } break;
-        case GS_PSMT4: {
-            uint32_t addr = psmt4_addr(gs->ctx->tbp0, gs->ctx->tbw, u, v);
+    return software_lerp_rgba(
+        software_lerp_rgba(s0, s1, fu),
+        software_lerp_rgba(s2, s3, fu),
+        fv
+    );
+}
 
-            int idx = (u & 31) + ((v & 3) * 32);
-            int shift = psmt4_shift[idx];
+static inline void software_apply_function(const software_draw_state& s, uint32_t t, int* c) {
+    int tc[4] = {
+        (int)(t & 0xff),
+        (int)((t >> 8) & 0xff),
+        (int)((t >> 16) & 0xff),
+        (int)(t >> 24)
+    };
 
-            uint32_t mask = 0xful << shift;
+    switch (s.ctx.tfx) {
+        case GS_MODULATE: {
+            for (int i = 0; i < 3; i++)
+                c[i] = std::min((tc[i] * c[i]) >> 7, 255);
 
-            return gs_read_cb(gs, (gs->vram[addr & 0xfffff] & mask) >> shift);
+            if (s.ctx.tcc)
+                c[3] = std::min((tc[3] * c[3]) >> 7, 255);
         } break;
-        case GS_PSMT4HL: {
-            uint32_t data = gs->vram[psmct32_addr(gs->ctx->tbp0, gs->ctx->tbw, u, v) & 0xfffff];
 
-            return gs_read_cb(gs, (data >> 24) & 0xf);
-        } break;
-        case GS_PSMT4HH: {
-            uint32_t data = gs->vram[psmct32_addr(gs->ctx->tbp0, gs->ctx->tbw, u, v) & 0xfffff];
+        case GS_DECAL: {
+            for (int i = 0; i < 3; i++)
+                c[i] = tc[i];
 
-            return gs_read_cb(gs, data >> 28);
+            if (s.ctx.tcc)
+                c[3] = tc[3];
         } break;
-        case GS_PSMZ32: {
-            uint32_t addr = psmz32_addr(gs->ctx->tbp0, gs->ctx->tbw, u, v);
 
-            return gs->vram[addr & 0xfffff];
-        } break;
-        case GS_PSMZ24: {
-            uint32_t addr = psmz32_addr(gs->ctx->tbp0, gs->ctx->tbw, u, v);
+        case GS_HIGHLIGHT:
+        case GS_HIGHLIGHT2: {
+            for (int i = 0; i < 3; i++)
+                c[i] = std::min(((tc[i] * c[i]) >> 7) + c[3], 255);
 
-            return gs->vram[addr & 0xfffff] & 0xffffff;
+            if (s.ctx.tcc)
+                c[3] = (s.ctx.tfx == GS_HIGHLIGHT) ? std::min(tc[3] + c[3], 255) : tc[3];
         } break;
-        case GS_PSMZ16: {
-            uint32_t addr = psmz16_addr(gs->ctx->tbp0, gs->ctx->tbw, u, v);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+    }
+}
 
-            int idx = (u & 15) + ((v & 1) * 16);
+static inline uint32_t software_read_fb(software_state* ctx, const software_draw_state& s, int x, int y) {
+    uint32_t d = software_read(ctx->gs->vram, s.ctx.fbp >> 6, s.ctx.fbw >> 6, s.ctx.fbpsm, x, y);
 
-            return vram[psmct16_shift[idx] & 0xfffff];
-        } break;
+    switch (s.ctx.fbpsm) {
+        case GS_PSMCT24:
+        case GS_PSMZ24: return d | 0x80000000;
+        case GS_PSMCT16:
+        case GS_PSMCT16S:
+        case GS_PSMZ16:
         case GS_PSMZ16S: {
-            uint32_t addr = psmz16s_addr(gs->ctx->tbp0, gs->ctx->tbw, u, v);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+            return ((d & 0x001f) << 3) |
+                   ((d & 0x03e0) << 6) |
+                   ((d & 0x7c00) << 9) |
+                   ((d & 0x8000) ? 0x80000000 : 0);
+        }
+    }
 
-            int idx = (u & 15) + ((v & 1) * 16);
+    return d;
+}
 
-            return vram[psmct16_shift[idx] & 0xfffff];
-        } break;
-        default: {
-            // printf("Unsupported PSMT %02x for tb read\n", gs->ctx->tbpsm);
-            // exit(1);
-        } break;
+static inline uint32_t software_clamp_z(uint32_t z, uint32_t zbpsm) {
+    switch (zbpsm) {
+        case GS_PSMZ24: return std::min(z, 0xffffffu);
+        case GS_PSMZ16:
+        case GS_PSMZ16S: return std::min(z, 0xffffu);
     }
 
-    return 0;
+    return z;
 }
 
-static inline uint32_t gs_read_tb(struct ps2_gs* gs, int u, int v) {
-    if (gs->ctx->mmag) {
-        float a = ((u - 8) & 0xf) * 0.0625;
-        float b = ((v - 8) & 0xf) * 0.0625;
-
-        int iu0 = (u - 8) >> 4;
-        int iv0 = (v - 8) >> 4;
-        int iu1 = iu0 + 1;
-        int iv1 = iv0 + 1;
-
-        uint32_t s0 = gs_read_tb_impl(gs, iu0, iv0);
-        uint32_t s1 = gs_read_tb_impl(gs, iu1, iv0);
-        uint32_t s2 = gs_read_tb_impl(gs, iu0, iv1);
-        uint32_t s3 = gs_read_tb_impl(gs, iu1, iv1);
-
-        s0 = gs_to_rgba32(gs, s0, gs->ctx->tbpsm);
-        s1 = gs_to_rgba32(gs, s1, gs->ctx->tbpsm);
-        s2 = gs_to_rgba32(gs, s2, gs->ctx->tbpsm);
-        s3 = gs_to_rgba32(gs, s3, gs->ctx->tbpsm);
-
-        int r0 = s0 & 0xff;
-        int g0 = (s0 >> 8) & 0xff;
-        int b0 = (s0 >> 16) & 0xff;
-        int a0 = (s0 >> 24) & 0xff;
-        int r1 = s1 & 0xff;
-        int g1 = (s1 >> 8) & 0xff;
-        int b1 = (s1 >> 16) & 0xff;
-        int a1 = (s1 >> 24) & 0xff;
-        int r2 = s2 & 0xff;
-        int g2 = (s2 >> 8) & 0xff;
-        int b2 = (s2 >> 16) & 0xff;
-        int a2 = (s2 >> 24) & 0xff;
-        int r3 = s3 & 0xff;
-        int g3 = (s3 >> 8) & 0xff;
-        int b3 = (s3 >> 16) & 0xff;
-        int a3 = (s3 >> 24) & 0xff;
-
-        uint32_t rr = ((1.0-a) * (1.0-b) * r0) + (a * (1.0-b) * r1) + ((1.0-a) * b * r2) + (a * b * r3);
-        uint32_t gg = ((1.0-a) * (1.0-b) * g0) + (a * (1.0-b) * g1) + ((1.0-a) * b * g2) + (a * b * g3);
-        uint32_t bb = ((1.0-a) * (1.0-b) * b0) + (a * (1.0-b) * b1) + ((1.0-a) * b * b2) + (a * b * b3);
-        uint32_t aa = ((1.0-a) * (1.0-b) * a0) + (a * (1.0-b) * a1) + ((1.0-a) * b * a2) + (a * b * a3);
-
-        rr = CLAMP(rr, 0, 255);
-        gg = CLAMP(gg, 0, 255);
-        bb = CLAMP(bb, 0, 255);
-        aa = CLAMP(aa, 0, 255);
+static inline void software_draw_pixel(software_state* ctx, const software_draw_state& s, int x, int y, uint32_t z, int* c) {
+    const struct gs_context& g = s.ctx;
+    uint32_t* vram = ctx->gs->vram;
 
-        return gs_from_rgba32(gs, rr | (gg << 8) | (bb << 16) | (aa << 24), gs->ctx->tbpsm);
-    }
+    bool write_fb = true;
+    bool write_zb = !g.zbmsk && g.zte;
+    uint32_t fbmsk = g.fbmsk;
 
-    return gs_read_tb_impl(gs, u >> 4, v >> 4);
-}
+    // Alpha test
+    if (g.ate) {
+        int a = c[3];
+        int aref = g.aref;
+        bool pass = true;
+
+        switch (g.atst) {
+            case 0: pass = false; break;
+            case 2: pass = a < aref; break;
+            case 3: pass = a <= aref; break;
+            case 4: pass = a == aref; break;
+            case 5: pass = a >= aref; break;
+            case 6: pass = a > aref; break;
+            case 7: pass = a != aref; break;
+        }
 
-static inline void gs_write_fb(struct ps2_gs* gs, int x, int y, uint32_t c) {
-    uint32_t f = gs_from_rgba32(gs, c, gs->ctx->fbpsm, x, y, gs->dthe);
+        if (!pass) {
+            switch (g.afail) {
+                case 0: return;
+                case 1: write_zb = false; break;
+                case 2: write_fb = false; break;
+                case 3: write_zb = false; fbmsk |= 0xff000000; break;
+            }
+        }
+    }
 
-    // To-do: Implement FBMSK
-    switch (gs->ctx->fbpsm) {
-        case GS_PSMCT32: {
-            uint32_t addr = psmct32_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
+    // Destination alpha test, 24-bit formats fail every pixel
+    if (g.date) {
+        if ((g.fbpsm & 0xf) == GS_PSMCT24)
+            return;
 
-            gs->vram[addr & 0xfffff] = f;
-            // gs->vram[(gs->ctx->fbp + x + (y * gs->ctx->fbw)) & 0xfffff] = f;
-        } break;
+        uint32_t d = software_read(vram, g.fbp >> 6, g.fbw >> 6, g.fbpsm, x, y);
+        uint32_t da = software_psm_is_16(g.fbpsm) ? (d >> 15) & 1 : d >> 31;
 
-        case GS_PSMCT24: {
-            uint32_t addr = psmct32_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint32_t v = gs->vram[addr];
+        if (da != g.datm)
+            return;
+    }
 
-            gs->vram[addr] = (v & 0xff000000) | (f & 0xffffff);
-            // gs->vram[(gs->ctx->fbp + x + (y * gs->ctx->fbw)) & 0xfffff] = f;
-        } break;
-        case GS_PSMCT16: {
-            uint32_t addr = psmct16_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr]);
+    // Depth test
+    if (g.zte) {
+        z = software_clamp_z(z, g.zbpsm);
 
-            int idx = (x & 15) + ((y & 1) * 16);
+        uint32_t zb = software_read(vram, g.zbp >> 6, g.fbw >> 6, g.zbpsm, x, y);
 
-            vram[psmct16_shift[idx]] = f;
-        } break;
-        case GS_PSMCT16S: {
-            uint32_t addr = psmct16s_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr]);
+        switch (g.ztst) {
+            case 0: return;
+            case 2: if (z < zb) return; break;
+            case 3: if (z <= zb) return; break;
+        }
+    }
 
-            int idx = (x & 15) + ((y & 1) * 16);
+    if (write_zb)
+        software_write(vram, g.zbp >> 6, g.fbw >> 6, g.zbpsm, x, y, z);
 
-            vram[psmct16_shift[idx]] = f;
-        } break;
-        case GS_PSMZ32: {
-            uint32_t addr = psmz32_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
+    if (!write_fb || fbmsk == 0xffffffff)
+        return;
 
-            gs->vram[addr & 0xfffff] = f;
-            // gs->vram[(gs->ctx->fbp + x + (y * gs->ctx->fbw)) & 0xfffff] = f;
-        } break;
+    int r = c[0], gg = c[1], b = c[2], a = c[3];
 
-        case GS_PSMZ24: {
-            uint32_t addr = psmz32_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint32_t v = gs->vram[addr];
+    // Alpha blending
+    uint32_t d = 0;
+    bool need_d = (s.abe && !(s.pabe && !(a & 0x80))) || fbmsk;
 
-            gs->vram[addr] = (v & 0xff000000) | (f & 0xffffff);
-            // gs->vram[(gs->ctx->fbp + x + (y * gs->ctx->fbw)) & 0xfffff] = f;
-        } break;
-        case GS_PSMZ16: {
-            uint32_t addr = psmz16_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr]);
+    if (need_d)
+        d = software_read_fb(ctx, s, x, y);
 
-            int idx = (x & 15) + ((y & 1) * 16);
+    if (s.abe && !(s.pabe && !(a & 0x80))) {
+        int cd[3] = { (int)(d & 0xff), (int)((d >> 8) & 0xff), (int)((d >> 16) & 0xff) };
+        int cs[3] = { r, gg, b };
+        int cv = (g.c == 0) ? a : ((g.c == 1) ? (int)(d >> 24) : (int)g.fix);
+        int out[3];
 
-            vram[psmct16_shift[idx]] = f;
-        } break;
-        case GS_PSMZ16S: {
-            uint32_t addr = psmz16s_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr]);
+        for (int i = 0; i < 3; i++) {
+            int av = (g.a == 0) ? cs[i] : ((g.a == 1) ? cd[i] : 0);
+            int bv = (g.b == 0) ? cs[i] : ((g.b == 1) ? cd[i] : 0);
+            int dv = (g.d == 0) ? cs[i] : ((g.d == 1) ? cd[i] : 0);
 
-            int idx = (x & 15) + ((y & 1) * 16);
+            out[i] = (((av - bv) * cv) >> 7) + dv;
+        }
 
-            vram[psmct16_shift[idx]] = f;
-        } break;
-        default: {
-            // printf("Unsupported PSMT %02x for fb write\n", gs->ctx->fbpsm);
-            // exit(1);
-        } break;
+        r = out[0];
+        gg = out[1];
+        b = out[2];
     }
-}
 
-static inline void gs_write_fb_no_alpha(struct ps2_gs* gs, int x, int y, uint32_t c) {
-    uint32_t f = gs_from_rgba32(gs, c, gs->ctx->fbpsm);
+    if (s.dthe && software_psm_is_16(g.fbpsm)) {
+        int dv = s.dither[y & 3][x & 3];
 
-    // To-do: Implement FBMSK
-    switch (gs->ctx->fbpsm) {
-        case GS_PSMCT32: {
-            uint32_t addr = psmct32_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint32_t p = gs->vram[addr & 0xfffff];
+        r += dv;
+        gg += dv;
+        b += dv;
+    }
 
-            gs->vram[addr & 0xfffff] = (f & 0xffffff) | (p & 0xff000000);
-        } break;
+    if (s.colclamp) {
+        r = CLAMP(r, 0, 255);
+        gg = CLAMP(gg, 0, 255);
+        b = CLAMP(b, 0, 255);
+    } else {
+        r &= 0xff;
+        gg &= 0xff;
+        b &= 0xff;
+    }
 
-        case GS_PSMCT24: {
-            uint32_t addr = psmct32_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint32_t p = gs->vram[addr];
+    // FBA
+    if (g.fba & 1)
+        a |= 0x80;
 
-            gs->vram[addr] = (f & 0xffffff) | (p & 0xff000000);
-        } break;
-        case GS_PSMCT16: {
-            uint32_t addr = psmct16_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr]);
-            uint16_t p = gs->vram[addr];
+    uint32_t f = r | (gg << 8) | (b << 16) | ((a & 0xff) << 24);
 
-            int idx = (x & 15) + ((y & 1) * 16);
+    if (fbmsk)
+        f = (f & ~fbmsk) | (d & fbmsk);
 
-            vram[psmct16_shift[idx]] = (f & 0x7fff) | (p & 0x8000);
-        } break;
-        case GS_PSMCT16S: {
-            uint32_t addr = psmct16s_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr]);
-            uint16_t p = gs->vram[addr];
+    if (software_psm_is_16(g.fbpsm)) {
+        f = ((f >> 3) & 0x001f) |
+            ((f >> 6) & 0x03e0) |
+            ((f >> 9) & 0x7c00) |
+            ((f >> 16) & 0x8000);
+    }
 
-            int idx = (x & 15) + ((y & 1) * 16);
+    software_write(vram, g.fbp >> 6, g.fbw >> 6, g.fbpsm, x, y, f);
+}
 
-            vram[psmct16_shift[idx]] = (f & 0x7fff) | (p & 0x8000);
-        } break;
-        case GS_PSMZ32: {
-            uint32_t addr = psmz32_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint32_t p = gs->vram[addr & 0xfffff];
+static inline void software_shade(software_state* ctx, const software_draw_state& s, int x, int y, uint32_t z, int* c, int u, int v, float q, int fog) {
+    if (s.tme) {
+        uint32_t t = software_sample(ctx, s, u, v, q);
 
-            gs->vram[addr & 0xfffff] = (f & 0xffffff) | (p & 0xff000000);
-        } break;
+        software_apply_function(s, t, c);
+    }
 
-        case GS_PSMZ24: {
-            uint32_t addr = psmz32_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint32_t p = gs->vram[addr];
+    if (s.fge) {
+        int fc[3] = {
+            (int)(s.fogcol & 0xff),
+            (int)((s.fogcol >> 8) & 0xff),
+            (int)((s.fogcol >> 16) & 0xff)
+        };
 
-            gs->vram[addr] = (f & 0xffffff) | (p & 0xff000000);
-        } break;
-        case GS_PSMZ16: {
-            uint32_t addr = psmz16_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr]);
-            uint16_t p = gs->vram[addr];
+        for (int i = 0; i < 3; i++)
+            c[i] = ((fog * c[i]) >> 8) + (((255 - fog) * fc[i]) >> 8);
+    }
 
-            int idx = (x & 15) + ((y & 1) * 16);
+    software_draw_pixel(ctx, s, x, y, z, c);
+}
 
-            vram[psmct16_shift[idx]] = (f & 0x7fff) | (p & 0x8000);
-        } break;
-        case GS_PSMZ16S: {
-            uint32_t addr = psmz16s_addr(gs->ctx->fbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr]);
-            uint16_t p = gs->vram[addr];
+// Shading inputs for a 4x2 block of pixels, lanes 0-3 are the first row
+struct software_quad {
+    int32_t r[8], g[8], b[8], a[8];
+    uint32_t z[8];
+    int32_t u[8], v[8];
+    float q[8];
+    int32_t fog[8];
+};
 
-            int idx = (x & 15) + ((y & 1) * 16);
+#ifdef __SSE4_1__
+// Unsigned a > b
+static inline __m128i software_cmpgt_epu32(__m128i a, __m128i b) {
+    const __m128i bias = _mm_set1_epi32(0x80000000);
 
-            vram[psmct16_shift[idx]] = (f & 0x7fff) | (p & 0x8000);
-        } break;
-        default: {
-            // printf("Unsupported PSMT %02x for fb write\n", gs->ctx->fbpsm);
-            // exit(1);
-        } break;
-    }
+    return _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
 }
 
-static inline void gs_write_zb(struct ps2_gs* gs, int x, int y, uint32_t z) {
-    if (gs->ctx->zbmsk || !gs->ctx->zte)
-        return;
+static inline int software_movemask(__m128i m) {
+    return _mm_movemask_ps(_mm_castsi128_ps(m));
+}
 
-    switch (gs->ctx->zbpsm) {
-        case 0x01: z = std::min(z, 0xffffffu); break;
-        case 0x02: z = std::min(z, 0xffffu); break;
-        case 0x0A: z = std::min(z, 0xffffu); break;
-        case 0x31: z = std::min(z, 0xffffffu); break;
-        case 0x32: z = std::min(z, 0xffffu); break;
-        case 0x3A: z = std::min(z, 0xffffu); break;
-    }
+// Expands a 4-bit lane mask to a vector mask
+static inline __m128i software_lanes(int mask) {
+    const __m128i bits = _mm_setr_epi32(1, 2, 4, 8);
 
-    switch (gs->ctx->zbpsm) {
-        case GS_PSMCT32:
-        case GS_PSMCT24: {
-            gs->vram[psmct32_addr(gs->ctx->zbp >> 6, gs->ctx->fbw >> 6, x, y) & 0xfffff] = z;
-        } break;
-        case GS_PSMCT16: {
-            uint32_t addr = psmct16_addr(gs->ctx->zbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+    return _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(mask), bits), bits);
+}
 
-            int idx = (x & 15) + ((y & 1) * 16);
+// VRAM addresses of the 4 pixels of a row, in units of the format's
+// pixel size. Every access a row makes to a buffer shares them
+struct software_row4 {
+    uint32_t bp, bw, psm;
+    int x, y;
 
-            vram[psmct16_shift[idx]] = z;
-        } break;
-        case GS_PSMCT16S: {
-            uint32_t addr = psmct16s_addr(gs->ctx->zbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+    // Rows of indexed formats or rows that cross a page go through
+    // software_read/software_write one pixel at a time
+    bool fast;
 
-            int idx = (x & 15) + ((y & 1) * 16);
+    __m128i addr;
+};
 
-            vram[psmct16_shift[idx]] = z;
-        } break;
-        case GS_PSMZ32:
-        case GS_PSMZ24: {
-            gs->vram[psmz32_addr(gs->ctx->zbp >> 6, gs->ctx->fbw >> 6, x, y) & 0xfffff] = z;
-        } break;
-        case GS_PSMZ16: {
-            uint32_t addr = psmz16_addr(gs->ctx->zbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+static inline software_row4 software_row4_init(uint32_t bp, uint32_t bw, uint32_t psm, int x, int y) {
+    software_row4 r = { bp, bw, psm, x, y, false, _mm_setzero_si128() };
 
-            int idx = (x & 15) + ((y & 1) * 16);
+    if ((x & 63) > 60)
+        return r;
 
-            vram[psmct16_shift[idx]] = z;
-        } break;
-        case GS_PSMZ16S: {
-            uint32_t addr = psmz16s_addr(gs->ctx->zbp >> 6, gs->ctx->fbw >> 6, x, y);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+    const uint16_t* table;
+    uint32_t page, mask;
 
-            int idx = (x & 15) + ((y & 1) * 16);
+    switch (psm) {
+        case GS_PSMCT32:
+        case GS_PSMCT24: table = swizzle.ct32[y & 31]; break;
+        case GS_PSMZ32:
+        case GS_PSMZ24: table = swizzle.z32[y & 31]; break;
+        case GS_PSMCT16: table = swizzle.ct16[y & 63]; break;
+        case GS_PSMCT16S: table = swizzle.ct16s[y & 63]; break;
+        case GS_PSMZ16: table = swizzle.z16[y & 63]; break;
+        case GS_PSMZ16S: table = swizzle.z16s[y & 63]; break;
 
-            vram[psmct16_shift[idx]] = z;
-        } break;
-        default: {
-            // printf("Unsupported PSMT %02x for zb write\n", gs->ctx->zbpsm);
-            // exit(1);
-        } break;
+        default: return r;
     }
-}
 
-static inline int gs_test_scissor(struct ps2_gs* gs, int x, int y) {
-    if (x < (int)gs->ctx->scax0 || y < (int)gs->ctx->scay0 ||
-        x > (int)gs->ctx->scax1 || y > (int)gs->ctx->scay1) {
-        return TR_FAIL;
+    if (software_psm_is_16(psm)) {
+        page = software_page_addr(bp, bw, x, y, 6, 6) * 2;
+        mask = 0x1fffff;
+    } else {
+        page = software_page_addr(bp, bw, x, y, 6, 5);
+        mask = 0xfffff;
     }
 
-    return TR_PASS;
+    // The row's swizzle offsets are next to each other in the table
+    __m128i off = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)(table + (x & 63))));
+
+    r.addr = _mm_and_si128(_mm_add_epi32(_mm_set1_epi32(page), off), _mm_set1_epi32(mask));
+    r.fast = true;
+
+    return r;
 }
 
-static inline int gs_test_pixel(struct ps2_gs* gs, int x, int y, uint32_t z, uint8_t a) {
-    int tr = TR_PASS;
+// Every address is within VRAM, so lanes outside of mask are read too
+// unless the row is slow
+static inline __m128i software_read4(uint32_t* vram, const software_row4& r, int mask) {
+    if (!r.fast) {
+        alignas(16) uint32_t d[4] = {};
 
-    // Alpha test
-    if (gs->ctx->ate) {
-        switch (gs->ctx->atst) {
-            case 0: tr = TR_FAIL; break;
-            case 2: tr = a < gs->ctx->aref; break;
-            case 3: tr = a <= gs->ctx->aref; break;
-            case 4: tr = a == gs->ctx->aref; break;
-            case 5: tr = a >= gs->ctx->aref; break;
-            case 6: tr = a > gs->ctx->aref; break;
-            case 7: tr = a != gs->ctx->aref; break;
-        }
+        for (int i = 0; i < 4; i++)
+            if (mask & (1 << i))
+                d[i] = software_read(vram, r.bp, r.bw, r.psm, r.x + i, r.y);
 
-        if (tr == TR_FAIL) {
-            switch (gs->ctx->afail) {
-                case 0: return TR_FAIL;
-                case 1: tr = TR_FB_ONLY; break;
-                case 2: tr = TR_ZB_ONLY; break;
-                case 3: tr = TR_RGB_ONLY; break;
-            }
-        }
+        return _mm_load_si128((const __m128i*)d);
     }
 
-    // Destination alpha test
-    if (gs->ctx->date) {
-        // Thanks to @refraction
-        // Quote: "When the format is 24bit (Z or C), DATE ceases to function.
-        //        It was believed that in 24bit mode all pixels pass because alpha
-        //        doesn't exist however after testing this on a PS2 it turns out
-        //        nothing passes, it ignores the draw."
-        if ((gs->ctx->fbpsm & 0xf) == GS_PSMCT24) return TR_FAIL;
-
-        uint32_t s = gs_read_fb(gs, x, y);
-
-        switch (gs->ctx->fbpsm) {
-            case GS_PSMCT16:
-            case GS_PSMCT16S:
-                if (((s >> 15) & 1) != gs->ctx->datm) return TR_FAIL;
-            break;
-            case GS_PSMCT32:
-                if (((s >> 31) & 1) != gs->ctx->datm) return TR_FAIL;
-            break;
-            default: {
-                fprintf(stderr, "Unsupported PSMT %02x for destination alpha test\n", gs->ctx->fbpsm);
-                exit(1);
-            } break;
-        }
+    if (software_psm_is_16(r.psm)) {
+        const uint16_t* p = (const uint16_t*)vram;
+
+        return _mm_setr_epi32(
+            p[_mm_extract_epi32(r.addr, 0)],
+            p[_mm_extract_epi32(r.addr, 1)],
+            p[_mm_extract_epi32(r.addr, 2)],
+            p[_mm_extract_epi32(r.addr, 3)]
+        );
     }
 
-    // Depth test
-    if (gs->ctx->zte) {
-        uint32_t zb = gs_read_zb(gs, x, y);
-
-        switch (gs->ctx->zbpsm) {
-            case 0x01: z = std::min(z, 0xffffffu); break;
-            case 0x02: z = std::min(z, 0xffffu); break;
-            case 0x0A: z = std::min(z, 0xffffu); break;
-            case 0x31: z = std::min(z, 0xffffffu); break;
-            case 0x32: z = std::min(z, 0xffffu); break;
-            case 0x3A: z = std::min(z, 0xffffu); break;
-        }
+#ifdef __AVX2__
+    __m128i d = _mm_i32gather_epi32((const int*)vram, r.addr, 4);
+#else
+    __m128i d = _mm_setr_epi32(
+        vram[_mm_extract_epi32(r.addr, 0)],
+        vram[_mm_extract_epi32(r.addr, 1)],
+        vram[_mm_extract_epi32(r.addr, 2)],
+        vram[_mm_extract_epi32(r.addr, 3)]
+    );
+#endif
 
-        switch (gs->ctx->ztst) {
-            case 0: return TR_FAIL;
-            case 2: {
-                if (z < zb) return TR_FAIL;
-            } break;
-            case 3: {
-                if (z <= zb) return TR_FAIL;
-            } break;
-        }
-    }
+    if (r.psm == GS_PSMCT24 || r.psm == GS_PSMZ24)
+        d = _mm_and_si128(d, _mm_set1_epi32(0xffffff));
 
-    return tr;
+    return d;
 }
 
-static inline uint32_t gs_alpha_blend(struct ps2_gs* gs, int x, int y, uint32_t s) {
-    uint32_t d = gs_read_fb(gs, x, y);
+static inline void software_write4(uint32_t* vram, const software_row4& r, __m128i data, int mask) {
+    alignas(16) uint32_t d[4];
+    alignas(16) uint32_t a[4];
 
-    switch (gs->ctx->fbpsm) {
-        case GS_PSMCT32: break;
-        case GS_PSMCT24: d |= 0x80000000; break;
-        case GS_PSMCT16:
-        case GS_PSMCT16S: {
-            int a = d & 0x8000;
+    _mm_store_si128((__m128i*)d, data);
+
+    if (!r.fast) {
+        for (int i = 0; i < 4; i++)
+            if (mask & (1 << i))
+                software_write(vram, r.bp, r.bw, r.psm, r.x + i, r.y, d[i]);
+
+        return;
+    }
 
-            d = ((d & 0x001f) << 3) |
-                ((d & 0x03e0) << 6) |
-                ((d & 0x7c00) << 9);
+    _mm_store_si128((__m128i*)a, r.addr);
+
+    switch (r.psm) {
+        case GS_PSMCT32:
+        case GS_PSMZ32: {
+            for (int i = 0; i < 4; i++)
+                if (mask & (1 << i))
+                    vram[a[i]] = d[i];
+        } break;
 
-            d |= a ? 0x80000000 : 0;
+        case GS_PSMCT24:
+        case GS_PSMZ24: {
+            for (int i = 0; i < 4; i++)
+                if (mask & (1 << i))
+                    vram[a[i]] = (vram[a[i]] & 0xff000000) | (d[i] & 0xffffff);
         } break;
+
         default: {
-            fprintf(stderr, "Unsupported PSMT %02x for alpha blend\n", gs->ctx->fbpsm);
+            uint16_t* p = (uint16_t*)vram;
 
-            exit(1);
+            for (int i = 0; i < 4; i++)
+                if (mask & (1 << i))
+                    p[a[i]] = d[i];
         } break;
     }
+}
 
-    uint32_t av = (gs->ctx->a == 0) ? s : ((gs->ctx->a == 1) ? d : 0);
-    uint32_t bv = (gs->ctx->b == 0) ? s : ((gs->ctx->b == 1) ? d : 0);
-    uint32_t cv = (gs->ctx->c == 0) ? (s >> 24) : ((gs->ctx->c == 1) ? (d >> 24) : gs->ctx->fix);
-    uint32_t dv = (gs->ctx->d == 0) ? s : ((gs->ctx->d == 1) ? d : 0);
-    
-    // cv = CLAMP(cv, 0, 127);
+// software_wrap on 4 lanes
+static inline __m128i software_wrap4(__m128i c, int size, int mode, int min, int max) {
+    switch (mode) {
+        case 0: return _mm_and_si128(c, _mm_set1_epi32(size - 1));
+        case 1: return _mm_min_epi32(_mm_max_epi32(c, _mm_setzero_si128()), _mm_set1_epi32(size - 1));
+        case 2: {
+            // Same order as CLAMP, in case MINU > MAXU
+            __m128i hi = _mm_set1_epi32(max);
 
-    // if (!gs->tme)
-    //     printf("Cd=%08x Cs=%08x a=%08x (%d) b=%08x (%d) c=%08x (%d) d=%08x (%d)\n", d, s,
-    //     av, gs->ctx->a,
-    //     bv, gs->ctx->b,
-    //     cv, gs->ctx->c,
-    //     dv, gs->ctx->d
-    // );
+            return _mm_blendv_epi8(_mm_max_epi32(c, _mm_set1_epi32(min)), hi, _mm_cmpgt_epi32(c, hi));
+        }
+        case 3: return _mm_or_si128(_mm_and_si128(c, _mm_set1_epi32(min)), _mm_set1_epi32(max));
+    }
 
-    int ar = (av >> 0 ) & 0xff;
-    int ag = (av >> 8 ) & 0xff;
-    int ab = (av >> 16) & 0xff;
-    // uint32_t aa = (av >> 24) & 0xff;
-    int br = (bv >> 0 ) & 0xff;
-    int bg = (bv >> 8 ) & 0xff;
-    int bb = (bv >> 16) & 0xff;
-    // uint32_t ba = (bv >> 24) & 0xff;
-    int dr = (dv >> 0 ) & 0xff;
-    int dg = (dv >> 8 ) & 0xff;
-    int db = (dv >> 16) & 0xff;
-    // uint32_t da = (dv >> 24) & 0xff;
+    return c;
+}
 
-    int rr = ar - br;
-    int rg = ag - bg;
-    int rb = ab - bb;
+// software_fetch_texel on the lanes in mask. Texels within the decoded
+// texture are gathered at once, the rest are decoded one at a time
+static inline __m128i software_fetch4(software_state* ctx, const software_draw_state& s, __m128i u, __m128i v, int mask) {
+    const struct gs_context& c = s.ctx;
 
-    rr = ((rr * (int)cv) >> 7) + dr;
-    rg = ((rg * (int)cv) >> 7) + dg;
-    rb = ((rb * (int)cv) >> 7) + db;
-    // uint32_t ra = (((aa - ba) * cv) >> 7) + da;
+    u = software_wrap4(u, c.usize, c.wms, c.minu, c.maxu);
+    v = software_wrap4(v, c.vsize, c.wmt, c.minv, c.maxv);
 
-    rr = CLAMP(rr, 0, 255);
-    rg = CLAMP(rg, 0, 255);
-    rb = CLAMP(rb, 0, 255);
+    __m128i t = _mm_setzero_si128();
+    int cached = 0;
 
-    return (rr & 0xff) | ((rg & 0xff) << 8) | ((rb & 0xff) << 16) | (d & 0xff000000);
-}
+    if (s.texture) {
+        __m128i in = _mm_and_si128(
+            software_cmpgt_epu32(_mm_set1_epi32(c.usize), u),
+            software_cmpgt_epu32(_mm_set1_epi32(c.vsize), v)
+        );
 
-static inline float lerpf(int32_t x, float u1, int32_t x1, float u2, int32_t x2) {
-    float b = u1 * (x2 - x);
+        // Lanes outside of the texture fetch texel 0 instead
+        __m128i i = _mm_and_si128(_mm_add_epi32(u, _mm_mullo_epi32(v, _mm_set1_epi32(c.usize))), in);
 
-    b += u2 * (x - x1);
-
-    if (!(x2 - x1))
-        return u1;
+#ifdef __AVX2__
+        t = _mm_i32gather_epi32((const int*)s.texture, i, 4);
+#else
+        t = _mm_setr_epi32(
+            s.texture[_mm_extract_epi32(i, 0)],
+            s.texture[_mm_extract_epi32(i, 1)],
+            s.texture[_mm_extract_epi32(i, 2)],
+            s.texture[_mm_extract_epi32(i, 3)]
+        );
+#endif
 
-    return b / (x2 - x1);
-}
+        cached = software_movemask(in);
+    }
 
-static inline int32_t lerp(int32_t x, int32_t u1, int32_t x1, int32_t u2, int32_t x2) {
-    int64_t b = (int64_t)u1 * (x2 - x);
+    int slow = mask & ~cached;
 
-    b += (int64_t)u2 * (x - x1);
+    if (!slow)
+        return t;
 
-    if (!(x2 - x1))
-        return u1;
+    alignas(16) uint32_t tt[4];
+    alignas(16) int32_t uu[4];
+    alignas(16) int32_t vv[4];
 
-    return b / (x2 - x1);
-}
+    _mm_store_si128((__m128i*)tt, t);
+    _mm_store_si128((__m128i*)uu, u);
+    _mm_store_si128((__m128i*)vv, v);
 
-int32_t stepsize(int32_t u1, int32_t x1, int32_t u2, int32_t x2, int64_t mult) {
-    if (!(x2 - x1))
-        return ((u2 - u1) * mult);
+    for (int i = 0; i < 4; i++)
+        if (slow & (1 << i))
+            tt[i] = software_decode_texel(ctx, s, ctx->cluts.data() + s.clut, uu[i], vv[i]);
 
-    return ((u2 - u1) * mult)/(x2 - x1);
+    return _mm_load_si128((const __m128i*)tt);
 }
 
-static inline void gs_draw_pixel(struct ps2_gs* gs, int x, int y, uint32_t z, uint32_t c) {
-    int a = c >> 24;
+// software_lerp_rgba on 4 texels, channels are widened to 16 bits
+static inline __m128i software_lerp4(__m128i a, __m128i b, __m128i f) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ff = _mm_set1_epi16(0xff);
 
-    int tr = gs_test_pixel(gs, x, y, z, a);
+    // Every channel of a texel takes its lane's weight
+    f = _mm_or_si128(f, _mm_slli_epi32(f, 16));
 
-    if (tr == TR_FAIL)
-        return;
+    __m128i flo = _mm_unpacklo_epi32(f, f);
+    __m128i fhi = _mm_unpackhi_epi32(f, f);
 
-    if (gs->abe) c = gs_alpha_blend(gs, x, y, c);
+    __m128i alo = _mm_unpacklo_epi8(a, zero);
+    __m128i ahi = _mm_unpackhi_epi8(a, zero);
+    __m128i blo = _mm_unpacklo_epi8(b, zero);
+    __m128i bhi = _mm_unpackhi_epi8(b, zero);
 
-    switch (tr) {
-        case TR_FB_ONLY: gs_write_fb(gs, x, y, c); break;
-        case TR_ZB_ONLY: gs_write_zb(gs, x, y, z); break;
-        case TR_RGB_ONLY: gs_write_fb_no_alpha(gs, x, y, c); break;
-        case TR_PASS: {
-            gs_write_zb(gs, x, y, z);
-            gs_write_fb(gs, x, y, c);
-        } break;
-    }
+    __m128i lo = _mm_add_epi16(alo, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(blo, alo), flo), 4));
+    __m128i hi = _mm_add_epi16(ahi, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(bhi, ahi), fhi), 4));
+
+    return _mm_packus_epi16(_mm_and_si128(lo, ff), _mm_and_si128(hi, ff));
 }
 
-void software_thread_init(void* udata, struct ps2_gs* gs, SDL_Window* window, SDL_GPUDevice* device) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+// software_sample on the lanes in mask
+static inline __m128i software_sample4(software_state* ctx, const software_draw_state& s, const software_quad& p, int lane, int mask) {
+    const struct gs_context& c = s.ctx;
 
-    ctx->window = window;
-    ctx->device = device;
-    ctx->gs = gs;
-    ctx->scale = 1.5f;
+    __m128i u = _mm_loadu_si128((const __m128i*)(p.u + lane));
+    __m128i v = _mm_loadu_si128((const __m128i*)(p.v + lane));
 
-    ctx->end_signal = false;
-    ctx->render_thr = std::thread(software_thread_render_thread, ctx);
-    ctx->render_thr.detach();
+    // Only the base level is sampled, LOD just picks the filter
+    int linear = c.mmag ? 0xf : 0;
+    int min = (c.mmin == 1 || c.mmin >= 4) ? 0xf : 0;
 
-    // create the vertex shader
-    SDL_GPUShaderCreateInfo vsci = {
-        .code_size = g_vertex_shader_size,
-        .code = g_vertex_shader_data,
-        .entrypoint = SHADER_ENTRYPOINT,
-        .format = SHADER_FORMAT,
-        .stage = SDL_GPU_SHADERSTAGE_VERTEX,
-        .num_samplers = 0,
-        .num_storage_textures = 0,
-        .num_storage_buffers = 0,
-        .num_uniform_buffers = 0,
-    };
+    if ((c.lcm || !s.fst) && linear != min) {
+        int k = ((int32_t)(c.k << 20)) >> 20;
 
-    SDL_GPUShader* vertex_shader = SDL_CreateGPUShader(device, &vsci);
-
-    // create the fragment shader
-    SDL_GPUShaderCreateInfo fsci = {
-        .code_size = g_fragment_shader_size,
-        .code = g_fragment_shader_data,
-        .entrypoint = SHADER_ENTRYPOINT,
-        .format = SHADER_FORMAT,
-        .stage = SDL_GPU_SHADERSTAGE_FRAGMENT,
-        .num_samplers = 1,
-        .num_storage_textures = 0,
-        .num_storage_buffers = 0,
-        .num_uniform_buffers = 0,
-    };
+        for (int i = 0; i < 4; i++) {
+            if (!(mask & (1 << i)))
+                continue;
 
-    SDL_GPUShader* fragment_shader = SDL_CreateGPUShader(device, &fsci);
-
-    // Create vertex buffer description and attributes
-    SDL_GPUVertexBufferDescription vbd[1] = {{
-        .slot = 0,
-        .pitch = sizeof(gpu_vertex),
-        .input_rate = SDL_GPU_VERTEXINPUTRATE_VERTEX,
-        .instance_step_rate = 0,
-    }};
-
-    SDL_GPUVertexAttribute va[2] = {{
-        .location = 0,
-        .buffer_slot = 0,
-        .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2,
-        .offset = 0,
-    }, {
-        .location = 1,
-        .buffer_slot = 0,
-        .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2,
-        .offset = sizeof(float) * 2,
-    }};
-
-    SDL_GPUColorTargetDescription ctd[1] = {{
-        .format = SDL_GetGPUSwapchainTextureFormat(device, window),
-        .blend_state = {
-            .src_color_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA,
-            .dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
-            .color_blend_op = SDL_GPU_BLENDOP_ADD,
-            .src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA,
-            .dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
-            .alpha_blend_op = SDL_GPU_BLENDOP_ADD,
-            .color_write_mask = SDL_GPU_COLORCOMPONENT_A,
-            .enable_blend = false,
-            .enable_color_write_mask = false,
-        },
-    }};
-
-    // Create graphics pipeline
-    SDL_GPUGraphicsPipelineCreateInfo gpci = {
-        .vertex_shader = vertex_shader,
-        .fragment_shader = fragment_shader,
-        .vertex_input_state = {
-            .vertex_buffer_descriptions = vbd,
-            .num_vertex_buffers = 1,
-            .vertex_attributes = va,
-            .num_vertex_attributes = 2,
-        },
-        .primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST,
-        .target_info = {
-            .color_target_descriptions = ctd,
-            .num_color_targets = 1,
-        },
-    };
+            float lod = c.lcm ? (k / 16.0f) : ((-log2f(fabsf(p.q[lane + i])) * (1 << c.l)) + (k / 16.0f));
 
-    ctx->pipeline = SDL_CreateGPUGraphicsPipeline(device, &gpci);
+            if (lod > 0.0f)
+                linear = (linear & ~(1 << i)) | (min & (1 << i));
+        }
+    }
 
-    SDL_assert(ctx->pipeline);
+    linear &= mask;
 
-    // we don't need to store the shaders after creating the pipeline
-    SDL_ReleaseGPUShader(device, vertex_shader);
-    SDL_ReleaseGPUShader(device, fragment_shader);
+    int nearest = mask & ~linear;
 
-    // create the vertex and index buffers
-    SDL_GPUBufferCreateInfo vbci = {
-        .usage = SDL_GPU_BUFFERUSAGE_VERTEX,
-        .size = sizeof(gpu_vertex) * 4,
-    };
+    __m128i t = _mm_setzero_si128();
 
-    ctx->vertex_buffer = SDL_CreateGPUBuffer(device, &vbci);
+    if (nearest)
+        t = software_fetch4(ctx, s, _mm_srai_epi32(u, 4), _mm_srai_epi32(v, 4), nearest);
 
-    // We're sending two triangles to make a single quad so we need 6 indices
-    SDL_GPUBufferCreateInfo ibci = {
-        .usage = SDL_GPU_BUFFERUSAGE_INDEX,
-        .size = sizeof(Uint16) * 6,
-    };
+    if (!linear)
+        return t;
 
-    ctx->index_buffer = SDL_CreateGPUBuffer(device, &ibci);
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i fm = _mm_set1_epi32(0xf);
 
-    SDL_GPUSamplerCreateInfo nearest_sci = {
-        .min_filter = SDL_GPU_FILTER_NEAREST,
-        .mag_filter = SDL_GPU_FILTER_NEAREST,
-        .mipmap_mode = SDL_GPU_SAMPLERMIPMAPMODE_NEAREST,
-        .address_mode_u = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE,
-        .address_mode_v = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE,
-        .address_mode_w = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE,
-    };
+    u = _mm_sub_epi32(u, _mm_set1_epi32(8));
+    v = _mm_sub_epi32(v, _mm_set1_epi32(8));
 
-    SDL_GPUSamplerCreateInfo linear_sci = {
-        .min_filter = SDL_GPU_FILTER_LINEAR,
-        .mag_filter = SDL_GPU_FILTER_LINEAR,
-        .mipmap_mode = SDL_GPU_SAMPLERMIPMAPMODE_NEAREST,
-        .address_mode_u = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE,
-        .address_mode_v = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE,
-        .address_mode_w = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE,
-    };
+    __m128i iu = _mm_srai_epi32(u, 4);
+    __m128i iv = _mm_srai_epi32(v, 4);
+    __m128i fu = _mm_and_si128(u, fm);
+    __m128i fv = _mm_and_si128(v, fm);
+
+    __m128i s0 = software_fetch4(ctx, s, iu, iv, linear);
+    __m128i s1 = software_fetch4(ctx, s, _mm_add_epi32(iu, one), iv, linear);
+    __m128i s2 = software_fetch4(ctx, s, iu, _mm_add_epi32(iv, one), linear);
+    __m128i s3 = software_fetch4(ctx, s, _mm_add_epi32(iu, one), _mm_add_epi32(iv, one), linear);
+
+    __m128i l = software_lerp4(software_lerp4(s0, s1, fu), software_lerp4(s2, s3, fu), fv);
 
-    ctx->sampler[0] = SDL_CreateGPUSampler(ctx->device, &nearest_sci);
-    ctx->sampler[1] = SDL_CreateGPUSampler(ctx->device, &linear_sci);
+    return nearest ? _mm_blendv_epi8(t, l, software_lanes(linear)) : l;
 }
 
-static inline uint32_t gs_generic_read(struct ps2_gs* gs, uint32_t bp, uint32_t bw, uint32_t bpsm, uint32_t u, uint32_t v) {
-    switch (bpsm) {
-        case GS_PSMCT32:
-            return gs->vram[psmct32_addr(bp, bw, u, v) & 0xfffff];
+// Frame buffer pixels as RGBA32, see software_read_fb
+static inline __m128i software_fb_to_rgba4(__m128i d, uint32_t psm) {
+    switch (psm) {
         case GS_PSMCT24:
-            return gs->vram[psmct32_addr(bp, bw, u, v) & 0xfffff];
-        case GS_PSMCT16: {
-            uint32_t addr = psmct16_addr(bp, bw, u, v);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+        case GS_PSMZ24: return _mm_or_si128(d, _mm_set1_epi32(0x80000000));
+        case GS_PSMCT16:
+        case GS_PSMCT16S:
+        case GS_PSMZ16:
+        case GS_PSMZ16S: {
+            return _mm_or_si128(
+                _mm_or_si128(
+                    _mm_slli_epi32(_mm_and_si128(d, _mm_set1_epi32(0x001f)), 3),
+                    _mm_slli_epi32(_mm_and_si128(d, _mm_set1_epi32(0x03e0)), 6)
+                ),
+                _mm_or_si128(
+                    _mm_slli_epi32(_mm_and_si128(d, _mm_set1_epi32(0x7c00)), 9),
+                    _mm_slli_epi32(_mm_and_si128(d, _mm_set1_epi32(0x8000)), 16)
+                )
+            );
+        }
+    }
 
-            int idx = (u & 15) + ((v & 1) * 16);
+    return d;
+}
 
-            return vram[psmct16_shift[idx] & 0xfffff];
-        } break;
-        case GS_PSMCT16S: {
-            uint32_t addr = psmct16s_addr(bp, bw, u, v);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+static inline void software_apply_function4(const software_draw_state& s, __m128i t, __m128i* c) {
+    const __m128i ff = _mm_set1_epi32(0xff);
 
-            int idx = (u & 15) + ((v & 1) * 16);
+    __m128i tc[4] = {
+        _mm_and_si128(t, ff),
+        _mm_and_si128(_mm_srli_epi32(t, 8), ff),
+        _mm_and_si128(_mm_srli_epi32(t, 16), ff),
+        _mm_srli_epi32(t, 24)
+    };
 
-            return vram[psmct16_shift[idx] & 0xfffff];
+    switch (s.ctx.tfx) {
+        case GS_MODULATE: {
+            for (int i = 0; i < 3; i++)
+                c[i] = _mm_min_epi32(_mm_srai_epi32(_mm_mullo_epi32(tc[i], c[i]), 7), ff);
+
+            if (s.ctx.tcc)
+                c[3] = _mm_min_epi32(_mm_srai_epi32(_mm_mullo_epi32(tc[3], c[3]), 7), ff);
         } break;
-        case GS_PSMT8: {
-            uint32_t addr = psmt8_addr(bp, bw, u, v);
-            uint8_t* vram = (uint8_t*)(&gs->vram[addr & 0xfffff]);
 
-            int idx = (u & 15) + ((v & 3) * 16);
+        case GS_DECAL: {
+            for (int i = 0; i < 3; i++)
+                c[i] = tc[i];
 
-            return vram[psmt8_shift[idx] & 0xfffff];
+            if (s.ctx.tcc)
+                c[3] = tc[3];
         } break;
-        case GS_PSMT8H: {
-            uint32_t data = gs->vram[psmct32_addr(bp, bw, u, v) & 0xfffff];
 
-            return data >> 24;
+        case GS_HIGHLIGHT:
+        case GS_HIGHLIGHT2: {
+            for (int i = 0; i < 3; i++)
+                c[i] = _mm_min_epi32(_mm_add_epi32(_mm_srai_epi32(_mm_mullo_epi32(tc[i], c[i]), 7), c[3]), ff);
+
+            if (s.ctx.tcc)
+                c[3] = (s.ctx.tfx == GS_HIGHLIGHT) ? _mm_min_epi32(_mm_add_epi32(tc[3], c[3]), ff) : tc[3];
         } break;
-        case GS_PSMT4: {
-            uint32_t addr = psmt4_addr(bp, bw, u, v);
+    }
+}
 
-            int idx = (u & 31) + ((v & 3) * 32);
-            int shift = psmt4_shift[idx];
+// software_shade and software_draw_pixel on 4 pixels of a row at once,
+// mask selects the live pixels. Frame and Z buffer addresses are worked
+// out once for the row
+static inline void software_shade4_simd(software_state* ctx, const software_draw_state& s, int x, int y, int mask, const software_quad& p, int lane) {
+    const struct gs_context& g = s.ctx;
+    uint32_t* vram = ctx->gs->vram;
 
-            uint32_t mask = 0xful << shift;
+    const __m128i ff = _mm_set1_epi32(0xff);
 
-            return (gs->vram[addr & 0xfffff] & mask) >> shift;
-        } break;
-        case GS_PSMT4HL: {
-            uint32_t data = gs->vram[psmct32_addr(bp, bw, u, v) & 0xfffff];
+    __m128i c[4] = {
+        _mm_loadu_si128((const __m128i*)(p.r + lane)),
+        _mm_loadu_si128((const __m128i*)(p.g + lane)),
+        _mm_loadu_si128((const __m128i*)(p.b + lane)),
+        _mm_loadu_si128((const __m128i*)(p.a + lane))
+    };
 
-            return (data >> 24) & 0xf;
-        } break;
-        case GS_PSMT4HH: {
-            uint32_t data = gs->vram[psmct32_addr(bp, bw, u, v) & 0xfffff];
+    if (s.tme)
+        software_apply_function4(s, software_sample4(ctx, s, p, lane, mask), c);
 
-            return data >> 28;
-        } break;
-        case GS_PSMZ32: {
-            return gs->vram[psmz32_addr(bp, bw, u, v) & 0xfffff];
-        } break;
-        case GS_PSMZ24: {
-            return gs->vram[psmz32_addr(bp, bw, u, v) & 0xfffff] & 0xffffff;
-        } break;
-        case GS_PSMZ16: {
-            uint32_t addr = psmz16_addr(bp, bw, u, v);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+    if (s.fge) {
+        __m128i f = _mm_loadu_si128((const __m128i*)(p.fog + lane));
+        __m128i fi = _mm_sub_epi32(ff, f);
 
-            int idx = (u & 15) + ((v & 1) * 16);
+        for (int i = 0; i < 3; i++) {
+            __m128i fc = _mm_set1_epi32((s.fogcol >> (i * 8)) & 0xff);
 
-            return vram[psmct16_shift[idx] & 0xfffff];
-        } break;
-        case GS_PSMZ16S: {
-            uint32_t addr = psmz16s_addr(bp, bw, u, v);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+            c[i] = _mm_add_epi32(
+                _mm_srai_epi32(_mm_mullo_epi32(f, c[i]), 8),
+                _mm_srai_epi32(_mm_mullo_epi32(fi, fc), 8)
+            );
+        }
+    }
 
-            int idx = (u & 15) + ((v & 1) * 16);
+    // Pixels that still write Z, the frame buffer, and the ones that
+    // keep the frame buffer's alpha (AFAIL = RGB_ONLY)
+    int zmask = (!g.zbmsk && g.zte) ? 0xf : 0;
+    int fmask = 0xf;
+    int amask = 0;
 
-            return vram[psmct16_shift[idx] & 0xfffff];
-        } break;
-        default: {
-            // printf("Unsupported PSMT %02x for generic read\n", gs->ctx->tbpsm);
-            // exit(1);
-        } break;
+    // Alpha test
+    if (g.ate) {
+        __m128i a = c[3];
+        __m128i aref = _mm_set1_epi32(g.aref);
+        int pass = 0xf;
+
+        switch (g.atst) {
+            case 0: pass = 0; break;
+            case 2: pass = software_movemask(_mm_cmplt_epi32(a, aref)); break;
+            case 3: pass = ~software_movemask(_mm_cmpgt_epi32(a, aref)); break;
+            case 4: pass = software_movemask(_mm_cmpeq_epi32(a, aref)); break;
+            case 5: pass = ~software_movemask(_mm_cmplt_epi32(a, aref)); break;
+            case 6: pass = software_movemask(_mm_cmpgt_epi32(a, aref)); break;
+            case 7: pass = ~software_movemask(_mm_cmpeq_epi32(a, aref)); break;
+        }
+
+        int fail = ~pass & 0xf;
+
+        switch (g.afail) {
+            case 0: mask &= ~fail; break;
+            case 1: zmask &= ~fail; break;
+            case 2: fmask &= ~fail; break;
+            case 3: zmask &= ~fail; amask = fail; break;
+        }
     }
-}
 
-static inline void gs_generic_write(struct ps2_gs* gs, uint32_t bp, uint32_t bw, uint32_t bpsm, uint32_t u, uint32_t v, uint32_t data) {
-    switch (bpsm) {
-        case GS_PSMCT32:
-            gs->vram[psmct32_addr(bp, bw, u, v) & 0xfffff] = data;
-        break;
-        case GS_PSMCT24: {
-            uint32_t addr = psmct32_addr(bp, bw, u, v) & 0xfffff;
+    software_row4 fb = software_row4_init(g.fbp >> 6, g.fbw >> 6, g.fbpsm, x, y);
 
-            gs->vram[addr] = (gs->vram[addr] & 0xff000000) | (data & 0xffffff);
-        } break;
-        break;
-        case GS_PSMCT16: {
-            uint32_t addr = psmct16_addr(bp, bw, u, v);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+    // Destination alpha test, 24-bit formats fail every pixel
+    if (g.date) {
+        if ((g.fbpsm & 0xf) == GS_PSMCT24)
+            return;
 
-            int idx = (u & 15) + ((v & 1) * 16);
+        __m128i d = software_read4(vram, fb, mask);
+        __m128i da = software_psm_is_16(g.fbpsm) ? _mm_srli_epi32(_mm_slli_epi32(d, 16), 31) : _mm_srli_epi32(d, 31);
 
-            vram[psmct16_shift[idx] & 0xfffff] = data;
-        } break;
-        case GS_PSMCT16S: {
-            uint32_t addr = psmct16s_addr(bp, bw, u, v);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+        mask &= software_movemask(_mm_cmpeq_epi32(da, _mm_set1_epi32(g.datm)));
+    }
 
-            int idx = (u & 15) + ((v & 1) * 16);
+    __m128i z = _mm_loadu_si128((const __m128i*)(p.z + lane));
 
-            vram[psmct16_shift[idx] & 0xfffff] = data;
-        } break;
-        case GS_PSMT8: {
-            uint32_t addr = psmt8_addr(bp, bw, u, v);
-            uint8_t* vram = (uint8_t*)(&gs->vram[addr & 0xfffff]);
+    software_row4 zb = {};
 
-            int idx = (u & 15) + ((v & 3) * 16);
+    // Depth test
+    if (g.zte) {
+        zb = software_row4_init(g.zbp >> 6, g.fbw >> 6, g.zbpsm, x, y);
 
-            vram[psmt8_shift[idx] & 0xfffff] = data;
-        } break;
-        case GS_PSMT8H: {
-            uint32_t addr = psmct32_addr(bp, bw, u, v) & 0xfffff;
+        switch (g.zbpsm) {
+            case GS_PSMZ24: z = _mm_min_epu32(z, _mm_set1_epi32(0xffffff)); break;
+            case GS_PSMZ16:
+            case GS_PSMZ16S: z = _mm_min_epu32(z, _mm_set1_epi32(0xffff)); break;
+        }
 
-            gs->vram[addr] = (gs->vram[addr] & 0x00ffffff) | (data << 24);
-        } break;
-        case GS_PSMT4: {
-            uint32_t addr = psmt4_addr(bp, bw, u, v) & 0xfffff;
+        if (!g.ztst)
+            return;
 
-            int idx = (u & 31) + ((v & 3) * 32);
-            int shift = psmt4_shift[idx];
+        if (g.ztst != 1) {
+            __m128i zv = software_read4(vram, zb, mask);
 
-            uint32_t mask = 0xful << shift;
+            // GEQUAL fails if z < zb, GREATER if z <= zb
+            int fail = (g.ztst == 2) ?
+                software_movemask(software_cmpgt_epu32(zv, z)) :
+                ~software_movemask(software_cmpgt_epu32(z, zv));
 
-            gs->vram[addr] = (gs->vram[addr] & ~mask) | (data << shift);
-        } break;
-        case GS_PSMT4HL: {
-            uint32_t addr = psmct32_addr(bp, bw, u, v) & 0xfffff;
+            mask &= ~fail;
+        }
+    }
 
-            gs->vram[addr] = (gs->vram[addr] & 0xf0ffffff) | ((data & 0xf) << 24);
-        } break;
-        case GS_PSMT4HH: {
-            uint32_t addr = psmct32_addr(bp, bw, u, v) & 0xfffff;
+    zmask &= mask;
+    fmask &= mask;
 
-            gs->vram[addr] = (gs->vram[addr] & 0x0fffffff) | ((data & 0xf) << 28);
-        } break;
-        case GS_PSMZ32:
-            gs->vram[psmz32_addr(bp, bw, u, v) & 0xfffff] = data;
-        break;
-        case GS_PSMZ24: {
-            uint32_t addr = psmz32_addr(bp, bw, u, v) & 0xfffff;
+    if (zmask)
+        software_write4(vram, zb, z, zmask);
 
-            gs->vram[addr] = (gs->vram[addr] & 0xff000000) | (data & 0xffffff);
-        } break;
-        break;
-        case GS_PSMZ16: {
-            uint32_t addr = psmz16_addr(bp, bw, u, v);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+    __m128i m = _mm_or_si128(_mm_set1_epi32(g.fbmsk), _mm_and_si128(software_lanes(amask), _mm_set1_epi32(0xff000000)));
 
-            int idx = (u & 15) + ((v & 1) * 16);
+    fmask &= ~software_movemask(_mm_cmpeq_epi32(m, _mm_set1_epi32(-1)));
 
-            vram[psmct16_shift[idx] & 0xfffff] = data;
-        } break;
-        case GS_PSMZ16S: {
-            uint32_t addr = psmz16s_addr(bp, bw, u, v);
-            uint16_t* vram = (uint16_t*)(&gs->vram[addr & 0xfffff]);
+    if (!fmask)
+        return;
 
-            int idx = (u & 15) + ((v & 1) * 16);
+    // Reading pixels that don't need it is harmless, their value is
+    // never used
+    __m128i d = _mm_setzero_si128();
 
-            vram[psmct16_shift[idx] & 0xfffff] = data;
-        } break;
-        default: {
-            // printf("Unsupported PSMT %02x for write\n", gs->ctx->tbpsm);
-            // exit(1);
-        } break;
+    if (s.abe || g.fbmsk || amask)
+        d = software_fb_to_rgba4(software_read4(vram, fb, fmask), g.fbpsm);
+
+    // Alpha blending, PABE skips pixels with the MSB of alpha clear
+    if (s.abe) {
+        const __m128i msb = _mm_set1_epi32(0x80);
+
+        __m128i blend = s.pabe ? _mm_cmpeq_epi32(_mm_and_si128(c[3], msb), msb) : _mm_set1_epi32(-1);
+
+        __m128i cd[3] = {
+            _mm_and_si128(d, ff),
+            _mm_and_si128(_mm_srli_epi32(d, 8), ff),
+            _mm_and_si128(_mm_srli_epi32(d, 16), ff)
+        };
+
+        __m128i cv = (g.c == 0) ? c[3] : ((g.c == 1) ? _mm_srli_epi32(d, 24) : _mm_set1_epi32(g.fix));
+        __m128i zero = _mm_setzero_si128();
+
+        for (int i = 0; i < 3; i++) {
+            __m128i av = (g.a == 0) ? c[i] : ((g.a == 1) ? cd[i] : zero);
+            __m128i bv = (g.b == 0) ? c[i] : ((g.b == 1) ? cd[i] : zero);
+            __m128i dv = (g.d == 0) ? c[i] : ((g.d == 1) ? cd[i] : zero);
+
+            __m128i out = _mm_add_epi32(_mm_srai_epi32(_mm_mullo_epi32(_mm_sub_epi32(av, bv), cv), 7), dv);
+
+            c[i] = _mm_blendv_epi8(c[i], out, blend);
+        }
+    }
+
+    if (s.dthe && software_psm_is_16(g.fbpsm)) {
+        const int* row = s.dither[y & 3];
+
+        __m128i dv = _mm_setr_epi32(row[x & 3], row[(x + 1) & 3], row[(x + 2) & 3], row[(x + 3) & 3]);
+
+        for (int i = 0; i < 3; i++)
+            c[i] = _mm_add_epi32(c[i], dv);
     }
+
+    for (int i = 0; i < 3; i++)
+        c[i] = s.colclamp ? _mm_min_epi32(_mm_max_epi32(c[i], _mm_setzero_si128()), ff) : _mm_and_si128(c[i], ff);
+
+    // FBA
+    __m128i a = (g.fba & 1) ? _mm_or_si128(c[3], _mm_set1_epi32(0x80)) : c[3];
+
+    __m128i f = _mm_or_si128(
+        _mm_or_si128(c[0], _mm_slli_epi32(c[1], 8)),
+        _mm_or_si128(_mm_slli_epi32(c[2], 16), _mm_slli_epi32(_mm_and_si128(a, ff), 24))
+    );
+
+    f = _mm_or_si128(_mm_andnot_si128(m, f), _mm_and_si128(d, m));
+
+    if (software_psm_is_16(g.fbpsm)) {
+        f = _mm_or_si128(
+            _mm_or_si128(
+                _mm_and_si128(_mm_srli_epi32(f, 3), _mm_set1_epi32(0x001f)),
+                _mm_and_si128(_mm_srli_epi32(f, 6), _mm_set1_epi32(0x03e0))
+            ),
+            _mm_or_si128(
+                _mm_and_si128(_mm_srli_epi32(f, 9), _mm_set1_epi32(0x7c00)),
+                _mm_and_si128(_mm_srli_epi32(f, 16), _mm_set1_epi32(0x8000))
+            )
+        );
+    }
+
+    software_write4(vram, fb, f, fmask);
 }
+#endif
 
-static inline void software_thread_vram_blit(struct ps2_gs* gs, software_thread_state* ctx) {
-    // printf("dbp=%x (%x) dbw=%d (%d) dpsm=%02x dsa=(%d,%d) sbp=%x (%x) sbw=%d (%d) spsm=%02x ssa=(%d,%d) rr=(%d,%d) xdir=%d\n",
-    //     ctx->dbp, ctx->dbp,
-    //     ctx->dbw, ctx->dbw,
-    //     ctx->dpsm,
-    //     ctx->dsax,
-    //     ctx->dsay,
-    //     ctx->sbp, ctx->sbp,
-    //     ctx->sbw, ctx->sbw,
-    //     ctx->spsm,
-    //     ctx->ssax,
-    //     ctx->ssay,
-    //     ctx->rrw,
-    //     ctx->rrh,
-    //     ctx->xdir
-    // );
-
-    for (int y = 0; y < ctx->rrh; y++) {
-        for (int x = 0; x < ctx->rrw; x++) {
-            uint32_t s = gs_generic_read(gs, ctx->sbp, ctx->sbw, ctx->spsm, ctx->ssax + x, ctx->ssay + y);
-
-            gs_generic_write(gs, ctx->dbp, ctx->dbw, ctx->dpsm, ctx->dsax + x, ctx->dsay + y, s);
-        }
+// Shades the live pixels of one row of a 4x2 block, lane is the index
+// of the row's first pixel in the block
+static inline void software_shade4(software_state* ctx, const software_draw_state& s, int x, int y, int mask, const software_quad& p, int lane) {
+#ifdef __SSE4_1__
+    if (s.quad) {
+        software_shade4_simd(ctx, s, x, y, mask, p, lane);
+
+        return;
+    }
+#endif
+
+    for (int i = 0; i < 4; i++) {
+        if (!(mask & (1 << i)))
+            continue;
+
+        int n = lane + i;
+        int c[4] = { p.r[n], p.g[n], p.b[n], p.a[n] };
+
+        software_shade(ctx, s, x + i, y, p.z[n], c, p.u[n], p.v[n], p.q[n], p.fog[n]);
     }
 }
 
-void render_point(struct ps2_gs* gs, void* udata) {
-    struct gs_vertex vert = gs->vq[0];
+// Rasterizers, these only touch pixels within (x0, y0)-(x1, y1)
+static void software_draw_point(software_state* ctx, const software_prim& prim, const software_draw_state& s, int x0, int y0, int x1, int y1) {
+    const software_vertex& v = prim.v[0];
 
-    vert.x -= gs->ctx->ofx;
-    vert.y -= gs->ctx->ofy;
+    int x = (v.x + 8) >> 4;
+    int y = (v.y + 8) >> 4;
 
-    if (!gs_test_scissor(gs, vert.x >> 4, vert.y >> 4))
+    if (x < x0 || x > x1 || y < y0 || y > y1)
         return;
 
-    gs_draw_pixel(gs, vert.x >> 4, vert.y >> 4, vert.z, vert.rgbaq & 0xffffffff);
+    int c[4] = { v.r, v.g, v.b, v.a };
+    int u = v.u, t = v.v;
+
+    if (!s.fst) {
+        u = (v.s / v.q) * s.ctx.usize * 16.0f;
+        t = (v.t / v.q) * s.ctx.vsize * 16.0f;
+    }
+
+    software_shade(ctx, s, x, y, v.z, c, u, t, v.q, v.fog);
 }
 
-void render_line(struct ps2_gs* gs, void* udata) {
-    struct gs_vertex v0 = gs->vq[0];
-    struct gs_vertex v1 = gs->vq[1];
+static void software_draw_line(software_state* ctx, const software_prim& prim, const software_draw_state& s, int x0, int y0, int x1, int y1) {
+    const software_vertex& v0 = prim.v[0];
+    const software_vertex& v1 = prim.v[1];
 
-    // printf("v0=(%d,%d) v1=(%d,%d)\n", v0.x, v0.y, v1.x, v1.y);
+    int dx = v1.x - v0.x;
+    int dy = v1.y - v0.y;
+    int steps = std::max(abs(dx), abs(dy)) >> 4;
 
-    v0.x -= gs->ctx->ofx;
-    v0.y -= gs->ctx->ofy;
-    v1.x -= gs->ctx->ofx;
-    v1.y -= gs->ctx->ofy;
+    if (!steps)
+        return;
 
-    int dx = abs(v1.x - v0.x);
-    int sx = v0.x < v1.x ? 1 : -1;
-    int dy = -abs(v1.y - v0.y);
-    int sy = v0.y < v1.y ? 1 : -1;
-    int error = dx + dy;
+    for (int i = 0; i < steps; i++) {
+        double f = (double)i / steps;
 
-    while (1) {
-        if (gs_test_scissor(gs, v0.x >> 4, v0.y >> 4))
-            gs_draw_pixel(gs, v0.x >> 4, v0.y >> 4, v0.z, v1.rgbaq & 0xffffffff);
+        int x = (v0.x + (int)(dx * f) + 8) >> 4;
+        int y = (v0.y + (int)(dy * f) + 8) >> 4;
 
-        int e2 = error << 1;
-    
-        if (e2 >= dy) {
-            if (v0.x == v1.x) break;
+        if (x < x0 || x > x1 || y < y0 || y > y1)
+            continue;
 
-            error = error + dy;
-            v0.x = v0.x + sx;
+        int c[4];
+
+        if (s.iip) {
+            c[0] = v0.r + (v1.r - v0.r) * f;
+            c[1] = v0.g + (v1.g - v0.g) * f;
+            c[2] = v0.b + (v1.b - v0.b) * f;
+            c[3] = v0.a + (v1.a - v0.a) * f;
+        } else {
+            c[0] = v1.r;
+            c[1] = v1.g;
+            c[2] = v1.b;
+            c[3] = v1.a;
         }
 
-        if (e2 <= dx) {
-            if (v0.y == v1.y) break;
+        uint32_t z = v0.z + ((double)v1.z - (double)v0.z) * f;
+        int fog = v0.fog + (v1.fog - v0.fog) * f;
+        float q = v0.q + (v1.q - v0.q) * f;
+        int u, v;
+
+        if (s.fst) {
+            u = v0.u + (v1.u - v0.u) * f;
+            v = v0.v + (v1.v - v0.v) * f;
+        } else {
+            float ss = v0.s + (v1.s - v0.s) * f;
+            float tt = v0.t + (v1.t - v0.t) * f;
 
-            error = error + dx;
-            v0.y = v0.y + sy;
+            u = (ss / q) * s.ctx.usize * 16.0f;
+            v = (tt / q) * s.ctx.vsize * 16.0f;
         }
+
+        software_shade(ctx, s, x, y, z, c, u, v, q, fog);
     }
 }
 
-void gs_draw_wireframe(struct ps2_gs* gs, struct gs_vertex v0, struct gs_vertex v1) {
-    v0.x -= gs->ctx->ofx;
-    v0.y -= gs->ctx->ofy;
-    v1.x -= gs->ctx->ofx;
-    v1.y -= gs->ctx->ofy;
+static inline int64_t software_edge(const software_vertex& a, const software_vertex& b, int px, int py) {
+    return ((int64_t)(b.x - a.x) * (py - a.y)) - ((int64_t)(b.y - a.y) * (px - a.x));
+}
 
-    int dx = abs(v1.x - v0.x);
-    int sx = v0.x < v1.x ? 1 : -1;
-    int dy = -abs(v1.y - v0.y);
-    int sy = v0.y < v1.y ? 1 : -1;
-    int error = dx + dy;
+static inline bool software_is_top_left(const software_vertex& a, const software_vertex& b) {
+    return (b.y > a.y) || ((a.y == b.y) && (b.x < a.x));
+}
 
-    v0.x >>= 4;
-    v0.y >>= 4;
-    v1.x >>= 4;
-    v1.y >>= 4;
+// Converts to 16.16 fixed-point. Values outside of the 32-bit range
+// wrap, which is fine since planes are evaluated modulo 2^32
+static inline int32_t software_fixed(double v) {
+    v = CLAMP(v * 65536.0, -0x1p62, 0x1p62);
 
-    while (1) {
-        if (gs_test_scissor(gs, v0.x, v0.y))
-            gs_write_fb(gs, v0.x, v0.y, 0xff0000ff);
+    return (int32_t)(uint32_t)(int64_t)llround(v);
+}
 
-        int e2 = error << 1;
-    
-        if (e2 >= dy) {
-            if (v0.x == v1.x) break;
+static inline int64_t software_fixed_z(double v) {
+    return (int64_t)llround(CLAMP(v * 65536.0, -0x1p62, 0x1p62));
+}
 
-            error = error + dy;
-            v0.x = v0.x + sx;
-        }
+// Gradients of an attribute in pixels and its value at the top-left
+// pixel of the bounding box, g = { c, dx, dy }
+static inline void software_gradient(double a0, double a1, double a2, const double* k, double ox, double oy, double* g) {
+    g[1] = ((a1 - a0) * k[0]) + ((a2 - a0) * k[1]);
+    g[2] = ((a1 - a0) * k[2]) + ((a2 - a0) * k[3]);
+    g[0] = a0 + (g[1] * ox) + (g[2] * oy);
+}
 
-        if (e2 <= dx) {
-            if (v0.y == v1.y) break;
+// bias is added to c so evaluation can round by truncating
+static inline software_plane software_setup_plane(double a0, double a1, double a2, const double* k, double ox, double oy, double bias = 0.0) {
+    double g[3];
 
-            error = error + dx;
-            v0.y = v0.y + sy;
-        }
-    }
+    software_gradient(a0, a1, a2, k, ox, oy, g);
+
+    return { software_fixed(g[0] + bias), software_fixed(g[1]), software_fixed(g[2]) };
 }
 
-#define EDGE(a, b, c) ((b.x-a.x)*(c.y-a.y)-(b.y-a.y)*(c.x-a.x))
-#define MIN2(a, b) ((((int)a) < ((int)b)) ? ((int)a) : ((int)b))
-#define MIN3(a, b, c) (MIN2(MIN2(a, b), c))
-#define MAX2(a, b) ((((int)a) > ((int)b)) ? ((int)a) : ((int)b))
-#define MAX3(a, b, c) (MAX2(MAX2(a, b), c))
-
-#define IS_TOPLEFT(a, b) ((b.y > a.y) || ((a.y == b.y) && (b.x < a.x)))
-
-void render_triangle(struct ps2_gs* gs, void* udata) {
-    struct gs_vertex v0 = gs->vq[0];
-    struct gs_vertex v1 = gs->vq[1];
-    struct gs_vertex v2 = gs->vq[2];
-
-    int area = EDGE(v0, v1, v2);
-
-    if (area < 0) {
-        v1 = gs->vq[2];
-        v2 = gs->vq[1];
-
-        area = EDGE(v0, v1, v2);
-    }
-
-    // printf("triangle: v0=(%04x,%04x) v1=(%04x,%04x) v2=(%04x,%04x) ate=%d date=%d zte=%d ztst=%d zbpsm=%02x zbp=%x fbp=%x\n",
-    //     v0.x, v0.y,
-    //     v1.x, v1.y,
-    //     v2.x, v2.y,
-    //     gs->ctx->ate, gs->ctx->date, gs->ctx->zte, gs->ctx->ztst,
-    //     gs->ctx->zbpsm, gs->ctx->zbp, gs->ctx->fbp
-    // );
-
-    v0.x -= gs->ctx->ofx;
-    v1.x -= gs->ctx->ofx;
-    v2.x -= gs->ctx->ofx;
-    v0.y -= gs->ctx->ofy;
-    v1.y -= gs->ctx->ofy;
-    v2.y -= gs->ctx->ofy;
-
-    int32_t scax0 = gs->ctx->scax0 << 4;
-    int32_t scay0 = gs->ctx->scay0 << 4;
-    int32_t scax1 = gs->ctx->scax1 << 4;
-    int32_t scay1 = gs->ctx->scay1 << 4;
-
-    int32_t xmin = ((MAX2(MIN3(v0.x, v1.x, v2.x), scax0) + 0) >> 4) << 4;
-    int32_t ymin = ((MAX2(MIN3(v0.y, v1.y, v2.y), scay0) + 0) >> 4) << 4;
-    int32_t xmax = ((MIN2(MAX3(v0.x, v1.x, v2.x), scax1) + 16) >> 4) << 4;
-    int32_t ymax = ((MIN2(MAX3(v0.y, v1.y, v2.y), scay1) + 16) >> 4) << 4;
-
-    int a01 = (v0.y - v1.y) * 16, b01 = (v1.x - v0.x) * 16;
-    int a12 = (v1.y - v2.y) * 16, b12 = (v2.x - v1.x) * 16;
-    int a20 = (v2.y - v0.y) * 16, b20 = (v0.x - v2.x) * 16;
-
-    int fogr = gs->fogcol & 0xff;
-    int fogg = (gs->fogcol >> 8) & 0xff;
-    int fogb = (gs->fogcol >> 16) & 0xff;
-
-    struct {
-        int x, y;
-    } p;
-
-    p.x = xmin;
-    p.y = ymin;
-
-    int bias0 = IS_TOPLEFT(v1, v2) ? -1 : 0;
-    int bias1 = IS_TOPLEFT(v2, v0) ? -1 : 0;
-    int bias2 = IS_TOPLEFT(v0, v1) ? -1 : 0;
-    int w0_row = EDGE(v1, v2, p);
-    int w1_row = EDGE(v2, v0, p);
-    int w2_row = EDGE(v0, v1, p);
-
-    // printf("triangle: v0=(%d.%d,%d.%d) v1=(%d.%d,%d.%d) v2=(%d.%d,%d.%d) v3=(%d.%d,%d.%d)\n",
-    //     v0.x >> 4, (v0.x & 0xf) * 625, v0.y >> 4, (v0.y & 0xf) * 625,
-    //     v1.x >> 4, (v1.x & 0xf) * 625, v1.y >> 4, (v1.y & 0xf) * 625,
-    //     v2.x >> 4, (v2.x & 0xf) * 625, v2.y >> 4, (v2.y & 0xf) * 625,
-    //     gs->vq[3].x >> 4, (gs->vq[3].x & 0xf) * 625, gs->vq[3].y >> 4, (gs->vq[3].y & 0xf) * 625
-    // );
-
-    for (p.y = ymin; p.y < ymax; p.y += 16) {
-        // Barycentric coordinates at start of row
-        int w0 = w0_row;
-        int w1 = w1_row;
-        int w2 = w2_row;
-
-        for (p.x = xmin; p.x < xmax; p.x += 16) {
-            // If p is on or inside all edges, render pixel
-            if (((w0 + bias0) | (w1 + bias1) | (w2 + bias2)) < 0) {
-                w0 += a12;
-                w1 += a20;
-                w2 += a01;
+static inline software_plane_z software_setup_plane_z(double a0, double a1, double a2, const double* k, double ox, double oy) {
+    double g[3];
 
-                continue;
-            }
+    software_gradient(a0, a1, a2, k, ox, oy, g);
 
-            // Calculate interpolation weights
-            double iw0 = (double)w0 / (double)area;
-            double iw1 = (double)w1 / (double)area;
-            double iw2 = (double)w2 / (double)area;
+    return { software_fixed_z(g[0]), software_fixed_z(g[1]), software_fixed_z(g[2]) };
+}
 
-            uint32_t fr, fg, fb, fa;
+static inline software_plane_f software_setup_plane_f(double a0, double a1, double a2, const double* k, double ox, double oy) {
+    double g[3];
 
-            if (gs->iip) {
-                fr = roundf(v0.r * iw0 + v1.r * iw1 + v2.r * iw2);
-                fg = roundf(v0.g * iw0 + v1.g * iw1 + v2.g * iw2);
-                fb = roundf(v0.b * iw0 + v1.b * iw1 + v2.b * iw2);
-                fa = roundf(v0.a * iw0 + v1.a * iw1 + v2.a * iw2);
-            } else {
-                fr = v2.r;
-                fg = v2.g;
-                fb = v2.b;
-                fa = v2.a;
-            }
+    software_gradient(a0, a1, a2, k, ox, oy, g);
 
-            if (gs->tme) {
-                // Fixed-point 12:4
-                int u, v;
+    return { (float)g[0], (float)g[1], (float)g[2] };
+}
 
-                if (gs->fst) {
-                    u = v0.u * iw0 + v1.u * iw1 + v2.u * iw2;
-                    v = v0.v * iw0 + v1.v * iw1 + v2.v * iw2;
-                } else {
-                    float s = v0.s * iw0 + v1.s * iw1 + v2.s * iw2;
-                    float t = v0.t * iw0 + v1.t * iw1 + v2.t * iw2;
-                    float q = v0.q * iw0 + v1.q * iw1 + v2.q * iw2;
+static bool software_setup_triangle(const software_prim& prim, const software_draw_state& s, software_triangle* t) {
+    const software_vertex* v0 = &prim.v[0];
+    const software_vertex* v1 = &prim.v[1];
+    const software_vertex* v2 = &prim.v[2];
 
-                    float uf = (s / q) * gs->ctx->usize;
-                    float vf = (t / q) * gs->ctx->vsize;
+    int64_t area = software_edge(*v0, *v1, v2->x, v2->y);
 
-                    // Convert to 12:4 fixed-point
-                    u = uf * (1 << 4);
-                    v = vf * (1 << 4);
-                }
+    if (!area)
+        return false;
 
-                uint32_t f = fr | (fg << 8) | (fb << 16) | (fa << 24);
+    if (area < 0)
+        std::swap(v1, v2);
 
-                uint32_t t = gs_read_tb(gs, u, v);
-                t = gs_to_rgba32(gs, t, gs->ctx->tbpsm);
-                t = gs_apply_function(gs, t, f);
+    const software_vertex* e[3][2] = { { v1, v2 }, { v2, v0 }, { v0, v1 } };
 
-                fr = t & 0xff;
-                fg = (t >> 8) & 0xff;
-                fb = (t >> 16) & 0xff;
-                fa = t >> 24;
-            }
+    int ox = prim.x0 << 4;
+    int oy = prim.y0 << 4;
 
-            if (gs->fge) {
-                int f = roundf(v0.fog * iw0 + v1.fog * iw1 + v2.fog * iw2);
+    for (int i = 0; i < 3; i++) {
+        const software_vertex& a = *e[i][0];
+        const software_vertex& b = *e[i][1];
 
-                fr = ((f * fr) >> 8) + (((255 - f) * fogr) >> 8);
-                fg = ((f * fg) >> 8) + (((255 - f) * fogg) >> 8);
-                fb = ((f * fb) >> 8) + (((255 - f) * fogb) >> 8);
-            }
+        t->step_x[i] = (int64_t)(a.y - b.y) * 16;
+        t->step_y[i] = (int64_t)(b.x - a.x) * 16;
+        t->e0[i] = software_edge(a, b, ox, oy) + (software_is_top_left(a, b) ? 0 : -1);
+    }
+
+    // Plane equation coefficients, in pixels. The attribute value at
+    // a pixel is a0 + (a1 - a0) * l1 + (a2 - a0) * l2, where l1 and l2
+    // are linear in x and y
+    double x10 = (v1->x - v0->x) / 16.0, y10 = (v1->y - v0->y) / 16.0;
+    double x20 = (v2->x - v0->x) / 16.0, y20 = (v2->y - v0->y) / 16.0;
+    double inv = 1.0 / ((x10 * y20) - (x20 * y10));
 
-            uint32_t fz = roundf(v0.z * iw0 + v1.z * iw1 + v2.z * iw2);
-            uint32_t fc = fr | (fg << 8) | (fb << 16) | (fa << 24);
+    double k[4] = {
+        y20 * inv, -y10 * inv,
+        -x20 * inv, x10 * inv
+    };
 
-            gs_draw_pixel(gs, p.x >> 4, p.y >> 4, fz, fc);
+    double px = prim.x0 - (v0->x / 16.0);
+    double py = prim.y0 - (v0->y / 16.0);
 
-            // One step to the right
-            w0 += a12;
-            w1 += a20;
-            w2 += a01;
-        }
+    t->z = software_setup_plane_z(v0->z, v1->z, v2->z, k, px, py);
+
+    // Colors round to nearest
+    if (s.iip) {
+        t->r = software_setup_plane(v0->r, v1->r, v2->r, k, px, py, 0.5);
+        t->g = software_setup_plane(v0->g, v1->g, v2->g, k, px, py, 0.5);
+        t->b = software_setup_plane(v0->b, v1->b, v2->b, k, px, py, 0.5);
+        t->alpha = software_setup_plane(v0->a, v1->a, v2->a, k, px, py, 0.5);
+    }
 
-        // One row step
-        w0_row += b12;
-        w1_row += b20;
-        w2_row += b01;
+    if (s.fge)
+        t->fog = software_setup_plane(v0->fog, v1->fog, v2->fog, k, px, py);
+
+    if (s.tme) {
+        if (s.fst) {
+            t->u = software_setup_plane(v0->u, v1->u, v2->u, k, px, py);
+            t->v = software_setup_plane(v0->v, v1->v, v2->v, k, px, py);
+        } else {
+            t->s = software_setup_plane_f(v0->s, v1->s, v2->s, k, px, py);
+            t->t = software_setup_plane_f(v0->t, v1->t, v2->t, k, px, py);
+            t->q = software_setup_plane_f(v0->q, v1->q, v2->q, k, px, py);
+        }
     }
 
-    // gs_draw_wireframe(gs, gs->vq[0], gs->vq[1]);
-    // gs_draw_wireframe(gs, gs->vq[1], gs->vq[2]);
-    // gs_draw_wireframe(gs, gs->vq[2], gs->vq[0]);
+    return true;
 }
 
-int32_t gs_lerp(int32_t x, int32_t u1, int32_t x1, int32_t u2, int32_t x2) {
-    if (!(x2 - x1))
-        return u1;
-
-    int64_t b = (int64_t)u1 * (x2 - x);
-    b += (int64_t)u2 * (x - x1);
-    return b / (x2 - x1);
-}
-
-int32_t gs_step(int32_t u1, int32_t x1, int32_t u2, int32_t x2, int64_t mult) {
-    if (!(x2 - x1))
-        return ((u2 - u1) * mult);
-    return ((u2 - u1) * mult)/(x2 - x1);
-}
-
-float gs_lerpf(int32_t x, float u1, int32_t x1, float u2, int32_t x2) {
-    if (x2 < x1) {
-        int temp = x1;
-
-        x1 = x2;
-        x2 = temp;
-    }
-
-    float b = u1 * (x2 - x);
-    b += u2 * (x - x1);
-    if (!(x2 - x1))
-        return u1;
-    return b / (x2 - x1);
-}
-
-float gs_stepf(float u1, int32_t x1, float u2, int32_t x2, int64_t mult) {
-    if (!(x2 - x1))
-        return ((u2 - u1) * mult);
-    return ((u2 - u1) * mult)/(x2 - x1);
-}
-
-void render_sprite(struct ps2_gs* gs, void* udata) {
-    struct gs_vertex v0 = gs->vq[0];
-    struct gs_vertex v1 = gs->vq[1];
-
-    v0.x -= gs->ctx->ofx;
-    v1.x -= gs->ctx->ofx;
-    v0.y -= gs->ctx->ofy;
-    v1.y -= gs->ctx->ofy;
-
-    int32_t scax0 = gs->ctx->scax0 << 4;
-    int32_t scay0 = gs->ctx->scay0 << 4;
-    int32_t scax1 = (gs->ctx->scax1 + 1) << 4;
-    int32_t scay1 = (gs->ctx->scay1 + 1) << 4;
-
-    int32_t xmin = ((std::max(std::min(v0.x, v1.x), scax0) + 8) >> 4) << 4;
-    int32_t ymin = ((std::max(std::min(v0.y, v1.y), scay0) + 8) >> 4) << 4;
-    int32_t xmax = ((std::min(std::max(v0.x, v1.x), scax1) + 8) >> 4) << 4;
-    int32_t ymax = ((std::min(std::max(v0.y, v1.y), scay1) + 8) >> 4) << 4;
-
-    // printf("sprite: v0=(%d,%d) v1=(%d,%d) sca1=(%04x,%04x) rsca1=(%04x,%04x)\n",
-    //     v0.x >> 4, v0.y >> 4,
-    //     v1.x >> 4, v1.y >> 4,
-    //     scax1, scay1,
-    //     gs->ctx->scax1 << 4,
-    //     gs->ctx->scay1 << 4
-    // );
-
-    // if (gs->tme)
-    // printf("sprite: v0=(%04x,%04x) v1=(%04x,%04x) tbpsm=%02x tbw=%x tbp=%x fbp=%x fbpsm=%02x zbp=%x zbpsm=%02x zte=%d zmsk=%d cbp=%x cbpsm=%02x\n",
-    //     v0.x, v0.y,
-    //     v1.x, v1.y,
-    //     gs->ctx->tbpsm,
-    //     gs->ctx->tbw,
-    //     gs->ctx->tbp0,
-    //     gs->ctx->fbp >> 6,
-    //     gs->ctx->fbpsm,
-    //     gs->ctx->zbp >> 6,
-    //     gs->ctx->zbpsm,
-    //     gs->ctx->zte,
-    //     gs->ctx->zbmsk,
-    //     gs->ctx->cbp >> 6,
-    //     gs->ctx->cbpsm
-    // );
-
-    // U and S values at the start of a row
-    float row_u = gs_lerpf(xmin, v0.u, v0.x, v1.u, v1.x);
-    float row_s = gs_lerpf(xmin, v0.s, v0.x, v1.s, v1.x);
-
-    // V and T values at the start of the entire quad
-    float v = gs_lerpf(ymin, v0.v, v0.y, v1.v, v1.y);
-    float t = gs_lerpf(ymin, v0.t, v0.y, v1.t, v1.y);
-
-    // Step values for U and V
-    float u_step = gs_stepf(v0.u, v0.x, v1.u, v1.x, 16);
-    float v_step = gs_stepf(v0.v, v0.y, v1.v, v1.y, 16);
-    float s_step = gs_stepf(v0.s, v0.x, v1.s, v1.x, 16);
-    float t_step = gs_stepf(v0.t, v0.y, v1.t, v1.y, 16);
-
-    // Static values
-    const float q = v1.q;
-    const int z = v1.z;
-    int a = v1.a;
-
-    for (int y = ymin; y < ymax; y += 16) {
-        float u = row_u;
-        float s = row_s;
-
-        for (int x = xmin; x < xmax; x += 16) {
-            uint32_t c = v1.rgbaq & 0xffffffff;
-
-            if (gs->tme) {
-                if (!gs->fst) {
-                    u = ((s / q) * gs->ctx->usize) * 16.0;
-                    v = ((t / q) * gs->ctx->vsize) * 16.0;
-                }
-
-                c = gs_read_tb(gs, u, v);
-                c = gs_to_rgba32(gs, c, gs->ctx->tbpsm);
-                c = gs_apply_function(gs, c, v1.rgbaq & 0xffffffff);
+// Pixel offsets within a 4x2 block, lanes 0-3 are the first row
+static const int32_t software_quad_x[8] = { 0, 1, 2, 3, 0, 1, 2, 3 };
+static const int32_t software_quad_y[8] = { 0, 0, 0, 0, 1, 1, 1, 1 };
 
-                a = c >> 24;
-            }
+// Evaluates a fixed-point plane on the 4x2 block at (x, y), relative to
+// the bounding box, and clamps the integer part to [lo, hi]
+static inline void software_eval8(const software_plane& p, int x, int y, int lo, int hi, int32_t* out) {
+    uint32_t base = (uint32_t)p.c + ((uint32_t)p.dx * x) + ((uint32_t)p.dy * y);
 
-            gs_draw_pixel(gs, x >> 4, y >> 4, z, c);
+#if defined(__AVX2__)
+    __m256i dx = _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i*)software_quad_x), _mm256_set1_epi32(p.dx));
+    __m256i dy = _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i*)software_quad_y), _mm256_set1_epi32(p.dy));
+    __m256i v = _mm256_srai_epi32(_mm256_add_epi32(_mm256_set1_epi32(base), _mm256_add_epi32(dx, dy)), 16);
 
-            u += u_step;
-            s += s_step;
-        }
+    v = _mm256_min_epi32(_mm256_max_epi32(v, _mm256_set1_epi32(lo)), _mm256_set1_epi32(hi));
+
+    _mm256_storeu_si256((__m256i*)out, v);
+#elif defined(__SSE4_1__)
+    __m128i r0 = _mm_add_epi32(_mm_set1_epi32(base), _mm_mullo_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(p.dx)));
+    __m128i r1 = _mm_add_epi32(r0, _mm_set1_epi32(p.dy));
+
+    r0 = _mm_min_epi32(_mm_max_epi32(_mm_srai_epi32(r0, 16), _mm_set1_epi32(lo)), _mm_set1_epi32(hi));
+    r1 = _mm_min_epi32(_mm_max_epi32(_mm_srai_epi32(r1, 16), _mm_set1_epi32(lo)), _mm_set1_epi32(hi));
+
+    _mm_storeu_si128((__m128i*)out, r0);
+    _mm_storeu_si128((__m128i*)(out + 4), r1);
+#else
+    for (int i = 0; i < 8; i++) {
+        int32_t v = (int32_t)(base + ((uint32_t)p.dx * software_quad_x[i]) + ((uint32_t)p.dy * software_quad_y[i]));
 
-        v += v_step;
-        t += t_step;
+        out[i] = CLAMP(v >> 16, lo, hi);
     }
+#endif
+}
 
-    // struct gs_vertex dv0 = gs->vq[0];
-    // struct gs_vertex dv1 = gs->vq[0];
-    // struct gs_vertex dv2 = gs->vq[1];
-    // struct gs_vertex dv3 = gs->vq[1];
+static inline void software_eval8_f(const software_plane_f& p, int x, int y, float* out) {
+    float base = p.c + (p.dx * x) + (p.dy * y);
 
-    // dv1.x = gs->vq[1].x;
-    // dv1.y = gs->vq[0].y;
-    // dv3.x = gs->vq[0].x;
-    // dv3.y = gs->vq[1].y;
+#ifdef __SSE4_1__
+    __m128i i = _mm_setr_epi32(0, 1, 2, 3);
+    __m128 r0 = _mm_add_ps(_mm_set1_ps(base), _mm_mul_ps(_mm_cvtepi32_ps(i), _mm_set1_ps(p.dx)));
 
-    // gs_draw_wireframe(gs, dv0, dv1);
-    // gs_draw_wireframe(gs, dv1, dv2);
-    // gs_draw_wireframe(gs, dv2, dv3);
-    // gs_draw_wireframe(gs, dv3, dv0);
+    _mm_storeu_ps(out, r0);
+    _mm_storeu_ps(out + 4, _mm_add_ps(r0, _mm_set1_ps(p.dy)));
+#else
+    for (int i = 0; i < 8; i++)
+        out[i] = (base + (p.dx * software_quad_x[i])) + (p.dy * software_quad_y[i]);
+#endif
 }
 
-static inline int gs_pixels_to_size(int fmt, int px) {
-    switch (fmt) {
-        case GS_PSMCT32:
-        case GS_PSMCT24:
-        case GS_PSMT8H:
-        case GS_PSMT4HL:
-        case GS_PSMT4HH:
-            return px;
-        case GS_PSMCT16:
-        case GS_PSMCT16S:
-            return px >> 1;
-        case GS_PSMT8:
-            return px >> 2;
-        case GS_PSMT4:
-            return px >> 3;
+// Coverage of a 4x2 block given the edge values at its top-left pixel
+// and the offsets of every pixel from it, bit n is set if pixel n is
+// inside the triangle
+static inline int software_coverage8(const int32_t* w, const int32_t (*off)[8]) {
+#if defined(__AVX2__)
+    __m256i m = _mm256_setzero_si256();
+
+    for (int i = 0; i < 3; i++)
+        m = _mm256_or_si256(m, _mm256_add_epi32(_mm256_set1_epi32(w[i]), _mm256_loadu_si256((const __m256i*)off[i])));
+
+    return ~_mm256_movemask_ps(_mm256_castsi256_ps(m)) & 0xff;
+#elif defined(__SSE4_1__)
+    __m128i m0 = _mm_setzero_si128();
+    __m128i m1 = _mm_setzero_si128();
+
+    for (int i = 0; i < 3; i++) {
+        __m128i e = _mm_set1_epi32(w[i]);
+
+        m0 = _mm_or_si128(m0, _mm_add_epi32(e, _mm_loadu_si128((const __m128i*)off[i])));
+        m1 = _mm_or_si128(m1, _mm_add_epi32(e, _mm_loadu_si128((const __m128i*)(off[i] + 4))));
     }
-    return px;
+
+    int lo = _mm_movemask_ps(_mm_castsi128_ps(m0));
+    int hi = _mm_movemask_ps(_mm_castsi128_ps(m1));
+
+    return ~(lo | (hi << 4)) & 0xff;
+#else
+    int mask = 0;
+
+    for (int n = 0; n < 8; n++)
+        if (((w[0] + off[0][n]) | (w[1] + off[1][n]) | (w[2] + off[2][n])) >= 0)
+            mask |= 1 << n;
+
+    return mask;
+#endif
 }
 
-static inline void gs_write_psmct32(struct ps2_gs* gs, software_thread_state* ctx, uint32_t data) {
-    uint32_t addr = psmct32_addr(ctx->dbp, ctx->dbw, ctx->dx, ctx->dy);
+// Evaluates every attribute the draw uses on a 4x2 block, x and y are
+// relative to the bounding box
+static inline void software_setup_quad(const software_draw_state& s, const software_triangle& t, int x, int y, software_quad* q) {
+    if (s.iip) {
+        software_eval8(t.r, x, y, 0, 255, q->r);
+        software_eval8(t.g, x, y, 0, 255, q->g);
+        software_eval8(t.b, x, y, 0, 255, q->b);
+        software_eval8(t.alpha, x, y, 0, 255, q->a);
+    }
 
-    ctx->dx++;
+    // Z needs more than 32 bits of intermediate precision
+    uint64_t z = (uint64_t)t.z.c + ((uint64_t)t.z.dx * x) + ((uint64_t)t.z.dy * y);
 
-    gs->vram[addr & 0xfffff] = data;
+    for (int i = 0; i < 8; i++) {
+        int64_t zf = (int64_t)(z + ((uint64_t)t.z.dx * software_quad_x[i]) + ((uint64_t)t.z.dy * software_quad_y[i])) >> 16;
 
-    if (ctx->dx == (ctx->rrw + ctx->dsax)) {
-        ctx->dx = ctx->dsax;
-        ctx->dy++;
+        q->z[i] = (uint32_t)CLAMP(zf, (int64_t)0, (int64_t)0xffffffff);
     }
-}
 
-static inline void gs_write_psmt4hh(struct ps2_gs* gs, software_thread_state* ctx, uint32_t data) {
-    uint32_t addr = psmct32_addr(ctx->dbp, ctx->dbw, ctx->dx, ctx->dy);
+    if (s.fge)
+        software_eval8(t.fog, x, y, 0, 255, q->fog);
 
-    ctx->dx++;
+    if (!s.tme)
+        return;
 
-    gs->vram[addr] = (gs->vram[addr] & 0x0fffffff) | (data << 28);
+    if (s.fst) {
+        software_eval8(t.u, x, y, 0, 0x3fff, q->u);
+        software_eval8(t.v, x, y, 0, 0x3fff, q->v);
 
-    if (ctx->dx == (ctx->rrw + ctx->dsax)) {
-        ctx->dx = ctx->dsax;
-        ctx->dy++;
+        return;
     }
-}
 
-static inline void gs_write_psmt4hl(struct ps2_gs* gs, software_thread_state* ctx, uint32_t data) {
-    uint32_t addr = psmct32_addr(ctx->dbp, ctx->dbw, ctx->dx, ctx->dy);
+    float ss[8], tt[8];
 
-    ctx->dx++;
+    software_eval8_f(t.s, x, y, ss);
+    software_eval8_f(t.t, x, y, tt);
+    software_eval8_f(t.q, x, y, q->q);
 
-    gs->vram[addr] = (gs->vram[addr] & 0xf0ffffff) | (data << 24);
+#ifdef __SSE4_1__
+    __m128 us = _mm_set1_ps((float)s.ctx.usize);
+    __m128 vs = _mm_set1_ps((float)s.ctx.vsize);
+    __m128 k = _mm_set1_ps(16.0f);
 
-    if (ctx->dx == (ctx->rrw + ctx->dsax)) {
-        ctx->dx = ctx->dsax;
-        ctx->dy++;
+    for (int i = 0; i < 8; i += 4) {
+        __m128 qq = _mm_loadu_ps(q->q + i);
+
+        _mm_storeu_si128((__m128i*)(q->u + i), _mm_cvttps_epi32(_mm_mul_ps(_mm_mul_ps(_mm_div_ps(_mm_loadu_ps(ss + i), qq), us), k)));
+        _mm_storeu_si128((__m128i*)(q->v + i), _mm_cvttps_epi32(_mm_mul_ps(_mm_mul_ps(_mm_div_ps(_mm_loadu_ps(tt + i), qq), vs), k)));
+    }
+#else
+    for (int i = 0; i < 8; i++) {
+        q->u[i] = (int)((ss[i] / q->q[i]) * s.ctx.usize * 16.0f);
+        q->v[i] = (int)((tt[i] / q->q[i]) * s.ctx.vsize * 16.0f);
     }
+#endif
 }
 
-static inline void gs_write_psmt4(struct ps2_gs* gs, software_thread_state* ctx, uint32_t index) {
-    uint32_t addr = psmt4_addr(ctx->dbp, ctx->dbw, ctx->dx, ctx->dy) & 0xfffff;
-
-    int idx = (ctx->dx & 31) + ((ctx->dy & 3) * 32);
-    int shift = psmt4_shift[idx];
+static void software_draw_triangle(software_state* ctx, const software_prim& prim, const software_draw_state& s, const software_triangle& t, int x0, int y0, int x1, int y1) {
+    software_quad q;
 
-    uint32_t mask = 0xful << shift;
+    // Flat shading takes the color of the last vertex, attributes the
+    // draw doesn't use are constant too
+    for (int i = 0; i < 8; i++) {
+        q.r[i] = prim.v[2].r;
+        q.g[i] = prim.v[2].g;
+        q.b[i] = prim.v[2].b;
+        q.a[i] = prim.v[2].a;
+        q.u[i] = 0;
+        q.v[i] = 0;
+        q.q[i] = 1.0f;
+        q.fog[i] = 0;
+    }
 
-    gs->vram[addr] = (gs->vram[addr] & ~mask) | (index << shift);
+    // Edge offsets of every pixel in a 4x2 block from the top-left one
+    int32_t off[3][8];
+    int32_t step[3];
 
-    ctx->dx++;
+    for (int i = 0; i < 3; i++) {
+        for (int n = 0; n < 8; n++)
+            off[i][n] = (int32_t)((t.step_x[i] * software_quad_x[n]) + (t.step_y[i] * software_quad_y[n]));
 
-    if (ctx->dx == (ctx->rrw + ctx->dsax)) {
-        ctx->dx = ctx->dsax;
-        ctx->dy++;
+        step[i] = (int32_t)(t.step_x[i] * 4);
     }
-}
 
-static inline void gs_write_psmt8(struct ps2_gs* gs, software_thread_state* ctx, uint32_t index) {
-    uint32_t addr = psmt8_addr(ctx->dbp, ctx->dbw, ctx->dx, ctx->dy) & 0xfffff;
-    uint8_t* vram = (uint8_t*)(&gs->vram[addr]);
+    for (int y = y0; y <= y1; y += 2) {
+        int fy = y - prim.y0;
 
-    int idx = (ctx->dx & 15) + ((ctx->dy & 3) * 16);
+        // The second row may be past the clip rect
+        int rows = (y < y1) ? 0xff : 0x0f;
 
-    vram[psmt8_shift[idx]] = index;
+        // Edge values are only exact within a span, far away from an
+        // edge only the sign matters, so clamp them to fit 32 bits.
+        // Steps are at most 2^20 so a span can't overflow
+        for (int sx = x0; sx <= x1; sx += SOFTWARE_TILE_SIZE) {
+            int ex = std::min(sx + SOFTWARE_TILE_SIZE - 1, x1);
 
-    ctx->dx++;
+            int32_t w[3];
 
-    if (ctx->dx == (ctx->rrw + ctx->dsax)) {
-        ctx->dx = ctx->dsax;
-        ctx->dy++;
-    }
-}
+            for (int i = 0; i < 3; i++) {
+                int64_t e = t.e0[i] + (t.step_x[i] * (sx - prim.x0)) + (t.step_y[i] * fy);
 
-static inline void gs_write_psmt8h(struct ps2_gs* gs, software_thread_state* ctx, uint32_t data) {
-    uint32_t addr = psmct32_addr(ctx->dbp, ctx->dbw, ctx->dx, ctx->dy);
+                w[i] = (int32_t)CLAMP(e, -(1ll << 30), 1ll << 30);
+            }
 
-    ctx->dx++;
+            for (int x = sx; x <= ex; x += 4) {
+                int mask = software_coverage8(w, off) & rows;
 
-    gs->vram[addr] = (gs->vram[addr] & 0x00ffffff) | (data << 24);
+                for (int i = 0; i < 3; i++)
+                    w[i] += step[i];
 
-    if (ctx->dx == (ctx->rrw + ctx->dsax)) {
-        ctx->dx = ctx->dsax;
-        ctx->dy++;
-    }
-}
+                // Don't go past the clip rect
+                if (ex - x < 3) {
+                    int m = (1 << (ex - x + 1)) - 1;
 
-static inline void gs_store_hwreg_psmt4(struct ps2_gs* gs, software_thread_state* ctx) {
-    for (int i = 0; i < 16; i++) {
-        uint64_t index = (gs->hwreg >> (i * 4)) & 0xf;
+                    mask &= m | (m << 4);
+                }
 
-        gs_write_psmt4(gs, ctx, index);
-    }
-}
+                if (!mask)
+                    continue;
+
+                software_setup_quad(s, t, x - prim.x0, fy, &q);
 
-static inline void gs_store_hwreg_psmt4hh(struct ps2_gs* gs, software_thread_state* ctx) {
-    for (int i = 0; i < 16; i++) {
-        uint64_t index = (gs->hwreg >> (i * 4)) & 0xf;
+                if (mask & 0xf)
+                    software_shade4(ctx, s, x, y, mask & 0xf, q, 0);
 
-        gs_write_psmt4hh(gs, ctx, index);
+                if (mask >> 4)
+                    software_shade4(ctx, s, x, y + 1, mask >> 4, q, 4);
+            }
+        }
     }
 }
 
-static inline void gs_store_hwreg_psmt4hl(struct ps2_gs* gs, software_thread_state* ctx) {
-    for (int i = 0; i < 16; i++) {
-        uint64_t index = (gs->hwreg >> (i * 4)) & 0xf;
+static void software_draw_sprite(software_state* ctx, const software_prim& prim, const software_draw_state& s, int x0, int y0, int x1, int y1) {
+    const software_vertex& v0 = prim.v[0];
+    const software_vertex& v1 = prim.v[1];
 
-        gs_write_psmt4hl(gs, ctx, index);
-    }
-}
+    double dx = v1.x - v0.x;
+    double dy = v1.y - v0.y;
+
+    // Sprites take every attribute but texture coordinates from the
+    // second vertex
+    software_quad p;
 
-static inline void gs_store_hwreg_psmt8(struct ps2_gs* gs, software_thread_state* ctx) {
     for (int i = 0; i < 8; i++) {
-        uint64_t index = (gs->hwreg >> (i * 8)) & 0xff;
+        p.r[i] = v1.r;
+        p.g[i] = v1.g;
+        p.b[i] = v1.b;
+        p.a[i] = v1.a;
+        p.z[i] = v1.z;
+        p.u[i] = 0;
+        p.v[i] = 0;
+        p.q[i] = v1.q;
+        p.fog[i] = v1.fog;
+    }
+
+    // U only depends on the column and V on the row, so U is worked out
+    // once for the whole span. SCISSOR limits spans to 2048 pixels, the
+    // last row of 4 can read 3 columns past the end
+    int32_t u[2048 + 3];
+    int w = x1 - x0 + 1;
+
+    for (int x = x0; x <= x1; x++) {
+        double fx = dx ? (((x << 4) - v0.x) / dx) : 0.0;
+
+        if (!s.tme) {
+            u[x - x0] = 0;
+        } else if (s.fst) {
+            u[x - x0] = (int)(v0.u + (v1.u - v0.u) * fx);
+        } else {
+            float ss = v0.s + (v1.s - v0.s) * fx;
 
-        gs_write_psmt8(gs, ctx, index);
+            u[x - x0] = (int)((ss / v1.q) * s.ctx.usize * 16.0f);
+        }
     }
-}
 
-static inline void gs_store_hwreg_psmt8h(struct ps2_gs* gs, software_thread_state* ctx) {
-    for (int i = 0; i < 8; i++) {
-        uint64_t index = (gs->hwreg >> (i * 8)) & 0xff;
+    u[w] = u[w + 1] = u[w + 2] = 0;
 
-        gs_write_psmt8h(gs, ctx, index);
-    }
-}
+    for (int y = y0; y <= y1; y++) {
+        if (s.tme) {
+            double fy = dy ? (((y << 4) - v0.y) / dy) : 0.0;
+            int v;
 
-static inline void gs_store_hwreg_psmct32(struct ps2_gs* gs, software_thread_state* ctx) {
-    uint64_t data[2] = {
-        gs->hwreg & 0xffffffff,
-        gs->hwreg >> 32
-    };
+            if (s.fst) {
+                v = (int)(v0.v + (v1.v - v0.v) * fy);
+            } else {
+                float tt = v0.t + (v1.t - v0.t) * fy;
 
-    for (int i = 0; i < 2; i++) {
-        gs_write_psmct32(gs, ctx, data[i]);
-    }
-}
+                v = (int)((tt / v1.q) * s.ctx.vsize * 16.0f);
+            }
+
+            for (int i = 0; i < 4; i++)
+                p.v[i] = v;
+        }
 
-static inline void gs_write_psmct24(struct ps2_gs* gs, software_thread_state* ctx, uint32_t data) {
-    uint32_t addr = psmct32_addr(ctx->dbp, ctx->dbw, ctx->dx++, ctx->dy) & 0xfffff;
+        for (int x = x0; x <= x1; x += 4) {
+            // Don't go past the clip rect
+            int mask = (x1 - x < 3) ? (1 << (x1 - x + 1)) - 1 : 0xf;
 
-    gs->vram[addr] = (gs->vram[addr] & 0xff000000) | (data & 0xffffff);
+            memcpy(p.u, u + (x - x0), sizeof(int32_t) * 4);
 
-    if (ctx->dx == (ctx->rrw + ctx->dsax)) {
-        ctx->dx = ctx->dsax;
-        ctx->dy++;
+            software_shade4(ctx, s, x, y, mask, p, 0);
+        }
     }
 }
 
-static inline void gs_store_hwreg_psmct24(struct ps2_gs* gs, software_thread_state* ctx) {
-    switch (ctx->psmct24_shift++) {
-        case 0: {
-            gs_write_psmct24(gs, ctx, gs->hwreg);
-            gs_write_psmct24(gs, ctx, gs->hwreg >> 24);
-            
-            ctx->psmct24_data = gs->hwreg >> 48;
-        } break;
-
-        case 1: {
-            gs_write_psmct24(gs, ctx, ctx->psmct24_data | ((gs->hwreg & 0xff) << 16));
-            gs_write_psmct24(gs, ctx, gs->hwreg >> 8);
-            gs_write_psmct24(gs, ctx, gs->hwreg >> 32);
-
-            ctx->psmct24_data = gs->hwreg >> 56;
-        } break;
+static void software_draw_prim(software_state* ctx, const software_prim& prim, int x0, int y0, int x1, int y1) {
+    if (x0 > x1 || y0 > y1)
+        return;
 
-        case 2: {
-            gs_write_psmct24(gs, ctx, ctx->psmct24_data | ((gs->hwreg & 0xffff) << 8));
-            gs_write_psmct24(gs, ctx, gs->hwreg >> 16);
-            gs_write_psmct24(gs, ctx, gs->hwreg >> 40);
+    const software_draw_state& s = ctx->states[prim.state];
 
-            ctx->psmct24_shift = 0;
-        } break;
+    switch (prim.type) {
+        case SOFTWARE_PRIM_POINT: software_draw_point(ctx, prim, s, x0, y0, x1, y1); break;
+        case SOFTWARE_PRIM_LINE: software_draw_line(ctx, prim, s, x0, y0, x1, y1); break;
+        case SOFTWARE_PRIM_TRIANGLE: software_draw_triangle(ctx, prim, s, ctx->triangles[prim.setup], x0, y0, x1, y1); break;
+        case SOFTWARE_PRIM_SPRITE: software_draw_sprite(ctx, prim, s, x0, y0, x1, y1); break;
     }
 }
 
-static inline void gs_write_psmct16(struct ps2_gs* gs, software_thread_state* ctx, uint32_t index) {
-    uint32_t addr = psmct16_addr(ctx->dbp, ctx->dbw, ctx->dx, ctx->dy) & 0xfffff;
-    uint16_t* vram = (uint16_t*)(&gs->vram[addr]);
-
-    int idx = (ctx->dx & 15) + ((ctx->dy & 1) * 16);
+// Primitive setup
+static void software_submit(software_state* ctx, int type, int count) {
+    if (ctx->state_dirty)
+        software_push_state(ctx);
 
-    vram[psmct16_shift[idx]] = index;
+    const software_draw_state& s = ctx->states.back();
 
-    ctx->dx++;
+    software_prim prim;
 
-    if (ctx->dx == (ctx->rrw + ctx->dsax)) {
-        ctx->dx = ctx->dsax;
-        ctx->dy++;
-    }
-}
+    prim.type = type;
+    prim.state = ctx->states.size() - 1;
+    prim.setup = 0;
 
-static inline void gs_write_psmct16s(struct ps2_gs* gs, software_thread_state* ctx, uint32_t index) {
-    uint32_t addr = psmct16s_addr(ctx->dbp, ctx->dbw, ctx->dx, ctx->dy) & 0xfffff;
-    uint16_t* vram = (uint16_t*)(&gs->vram[addr]);
+    int minx = INT32_MAX, miny = INT32_MAX;
+    int maxx = INT32_MIN, maxy = INT32_MIN;
 
-    int idx = (ctx->dx & 15) + ((ctx->dy & 1) * 16);
+    for (int i = 0; i < count; i++) {
+        prim.v[i] = ctx->vq[i];
 
-    vram[psmct16_shift[idx]] = index;
+        minx = std::min(minx, prim.v[i].x);
+        miny = std::min(miny, prim.v[i].y);
+        maxx = std::max(maxx, prim.v[i].x);
+        maxy = std::max(maxy, prim.v[i].y);
+    }
 
-    ctx->dx++;
+    // Pixel centers are sampled at integer coordinates
+    switch (type) {
+        case SOFTWARE_PRIM_POINT: {
+            prim.x0 = prim.x1 = (minx + 8) >> 4;
+            prim.y0 = prim.y1 = (miny + 8) >> 4;
+        } break;
 
-    if (ctx->dx == (ctx->rrw + ctx->dsax)) {
-        ctx->dx = ctx->dsax;
-        ctx->dy++;
-    }
-}
+        case SOFTWARE_PRIM_LINE: {
+            prim.x0 = minx >> 4;
+            prim.y0 = miny >> 4;
+            prim.x1 = (maxx + 15) >> 4;
+            prim.y1 = (maxy + 15) >> 4;
+        } break;
 
-static inline void gs_store_hwreg_psmct16(struct ps2_gs* gs, software_thread_state* ctx) {
-    for (int i = 0; i < 4; i++) {
-        uint64_t p = (gs->hwreg >> (i * 16)) & 0xffff;
+        case SOFTWARE_PRIM_TRIANGLE: {
+            prim.x0 = (minx + 15) >> 4;
+            prim.y0 = (miny + 15) >> 4;
+            prim.x1 = maxx >> 4;
+            prim.y1 = maxy >> 4;
+        } break;
 
-        gs_write_psmct16(gs, ctx, p);
+        case SOFTWARE_PRIM_SPRITE: {
+            prim.x0 = (minx + 15) >> 4;
+            prim.y0 = (miny + 15) >> 4;
+            prim.x1 = ((maxx + 15) >> 4) - 1;
+            prim.y1 = ((maxy + 15) >> 4) - 1;
+        } break;
     }
-}
 
-static inline void gs_store_hwreg_psmct16s(struct ps2_gs* gs, software_thread_state* ctx) {
-    for (int i = 0; i < 4; i++) {
-        uint64_t p = (gs->hwreg >> (i * 16)) & 0xffff;
+    prim.x0 = std::max(prim.x0, (int)s.ctx.scax0);
+    prim.y0 = std::max(prim.y0, (int)s.ctx.scay0);
+    prim.x1 = std::min(prim.x1, (int)s.ctx.scax1);
+    prim.y1 = std::min(prim.y1, (int)s.ctx.scay1);
 
-        gs_write_psmct16s(gs, ctx, p);
-    }
-}
+    if (prim.x0 > prim.x1 || prim.y0 > prim.y1)
+        return;
 
-void transfer_flush_buffer(software_thread_state* ctx) {
-    // printf("gs: Flushing transfer... %d (%d)\n", ctx->transfer_buffer.size(), ctx->transfer_size);
+    if (type == SOFTWARE_PRIM_TRIANGLE) {
+        software_triangle t;
 
-    ctx->render_mtx.lock();
+        if (!software_setup_triangle(prim, s, &t))
+            return;
 
-    for (int i = 0; i < ctx->transfer_buffer.size(); i++) {
-        ctx->gs->hwreg = ctx->transfer_buffer[i];
+        if (ctx->immediate) {
+            software_draw_triangle(ctx, prim, s, t, prim.x0, prim.y0, prim.x1, prim.y1);
 
-        switch (ctx->dpsm) {
-            case GS_PSMCT32: {
-                gs_store_hwreg_psmct32(ctx->gs, ctx);
-            } break;
+            return;
+        }
 
-            case GS_PSMCT24: {
-                gs_store_hwreg_psmct24(ctx->gs, ctx);
-            } break;
+        prim.setup = ctx->triangles.size();
 
-            case GS_PSMCT16: {
-                gs_store_hwreg_psmct16(ctx->gs, ctx);
-            } break;
+        ctx->triangles.push_back(t);
+    } else if (ctx->immediate) {
+        software_draw_prim(ctx, prim, prim.x0, prim.y0, prim.x1, prim.y1);
 
-            case GS_PSMCT16S: {
-                gs_store_hwreg_psmct16s(ctx->gs, ctx);
-            } break;
+        return;
+    }
 
-            case GS_PSMT8: {
-                gs_store_hwreg_psmt8(ctx->gs, ctx);
-            } break;
+    uint32_t index = ctx->prims.size();
 
-            case GS_PSMT8H: {
-                gs_store_hwreg_psmt8h(ctx->gs, ctx);
-            } break;
+    ctx->prims.push_back(prim);
 
-            case GS_PSMT4: {
-                gs_store_hwreg_psmt4(ctx->gs, ctx);
-            } break;
+    int tx0 = prim.x0 >> SOFTWARE_TILE_SHIFT;
+    int ty0 = prim.y0 >> SOFTWARE_TILE_SHIFT;
+    int tx1 = prim.x1 >> SOFTWARE_TILE_SHIFT;
+    int ty1 = prim.y1 >> SOFTWARE_TILE_SHIFT;
 
-            case GS_PSMT4HH: {
-                gs_store_hwreg_psmt4hh(ctx->gs, ctx);
-            } break;
+    for (int ty = ty0; ty <= ty1; ty++) {
+        for (int tx = tx0; tx <= tx1; tx++) {
+            uint32_t tile = tx + (ty * SOFTWARE_TILES_X);
 
-            case GS_PSMT4HL: {
-                gs_store_hwreg_psmt4hl(ctx->gs, ctx);
-            } break;
+            if (ctx->bins[tile].empty())
+                ctx->active_tiles.push_back(tile);
 
-            default: {
-                gs_store_hwreg_psmct32(ctx->gs, ctx);
-            } break;
+            ctx->bins[tile].push_back(index);
         }
     }
 
-    ctx->render_mtx.unlock();
+    if (ctx->prims.size() >= SOFTWARE_MAX_PRIMS || ctx->states.size() >= SOFTWARE_MAX_STATES)
+        software_flush(ctx);
 }
 
-void transfer_start(struct ps2_gs* gs, void* udata) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+static void software_write_vertex(software_state* ctx, uint64_t data, int fog, int kick) {
+    uint64_t attr = (ctx->prmodecont & 1) ? ctx->prim : ctx->prmode;
+    const struct gs_context& c = ctx->context[(attr >> 9) & 1];
 
-    if (ctx->transfer_size != 0) {
-        transfer_flush_buffer(ctx);
-    }
+    software_vertex& v = ctx->vq[ctx->vqi];
 
-    ctx->dbp = (gs->bitbltbuf >> 32) & 0x3fff;
-    ctx->dbw = (gs->bitbltbuf >> 48) & 0x3f;
-    ctx->dpsm = (gs->bitbltbuf >> 56) & 0x3f;
-    ctx->sbp = (gs->bitbltbuf >> 0) & 0x3fff;
-    ctx->sbw = (gs->bitbltbuf >> 16) & 0x3f;
-    ctx->spsm = (gs->bitbltbuf >> 24) & 0x3f;
-    ctx->dsax = (gs->trxpos >> 32) & 0x7ff;
-    ctx->dsay = (gs->trxpos >> 48) & 0x7ff;
-    ctx->ssax = (gs->trxpos >> 0) & 0x7ff;
-    ctx->ssay = (gs->trxpos >> 16) & 0x7ff;
-    ctx->dir = (gs->trxpos >> 59) & 3;
-    ctx->rrw = (gs->trxreg >> 0) & 0xfff;
-    ctx->rrh = (gs->trxreg >> 32) & 0xfff;
-    ctx->xdir = gs->trxdir & 3;
-    ctx->dx = ctx->dsax;
-    ctx->dy = ctx->dsay;
-    ctx->sx = ctx->ssax;
-    ctx->sy = ctx->ssay;
-    ctx->px = 0;
+    union {
+        uint32_t u32;
+        float f;
+    } s, t, q;
 
-    unsigned int pixels = ctx->rrw * ctx->rrh;
+    s.u32 = ctx->st & 0xffffffff;
+    t.u32 = ctx->st >> 32;
+    q.u32 = ctx->rgbaq >> 32;
 
-    // size in pixels = rrw*rrh
-    // size in dwords (psmct32): pixels / 2
-    // size in dwords (psmct24): floor(pixels / 3) + 1
-    // size in dwords (psmct16/s): pixels / 4
-    // size in dwords (psmt8/h): pixels / 8
-    // size in dwords (psmt4/h/hl/hh): pixels / 16
+    v.x = (int32_t)(data & 0xffff) - (int32_t)c.ofx;
+    v.y = (int32_t)((data >> 16) & 0xffff) - (int32_t)c.ofy;
+    v.z = fog ? ((data >> 32) & 0xffffff) : (data >> 32);
+    v.fog = fog ? (data >> 56) : ((ctx->fog >> 56) & 0xff);
+    v.r = ctx->rgbaq & 0xff;
+    v.g = (ctx->rgbaq >> 8) & 0xff;
+    v.b = (ctx->rgbaq >> 16) & 0xff;
+    v.a = (ctx->rgbaq >> 24) & 0xff;
+    v.u = ctx->uv & 0x3fff;
+    v.v = (ctx->uv >> 16) & 0x3fff;
+    v.s = s.f;
+    v.t = t.f;
+    v.q = q.f;
 
-    switch (ctx->dpsm) {
-        case GS_PSMZ32:
-        case GS_PSMCT32: {
-            ctx->transfer_size = pixels >> 1;
-        } break;
-        case GS_PSMCT24: {
-            ctx->transfer_size = (pixels / 3) + 1;
-        } break;
-        case GS_PSMCT16:
-        case GS_PSMCT16S: {
-            ctx->transfer_size = pixels >> 2;
-        } break;
-        case GS_PSMT8:
-        case GS_PSMT8H: {
-            ctx->transfer_size = pixels >> 3;
+    ctx->vqi++;
+
+    switch (ctx->prim & 7) {
+        case 0: {
+            if (kick) software_submit(ctx, SOFTWARE_PRIM_POINT, 1);
+
+            ctx->vqi = 0;
         } break;
-        case GS_PSMT4:
-        case GS_PSMT4HL:
-        case GS_PSMT4HH: {
-            ctx->transfer_size = pixels >> 4;
+
+        case 1: {
+            if (ctx->vqi == 2) {
+                if (kick) software_submit(ctx, SOFTWARE_PRIM_LINE, 2);
+
+                ctx->vqi = 0;
+            }
         } break;
 
-        // Assume 32-bit (Viewtiful Joe, Viewtiful Joe 2, etc.)
-        default: {
-            ctx->transfer_size = pixels >> 1;
+        case 2: {
+            if (ctx->vqi == 2) {
+                if (kick) software_submit(ctx, SOFTWARE_PRIM_LINE, 2);
 
-            // printf("gs: Unknown transfer format %02x\n", ctx->dpsm);
+                ctx->vq[0] = ctx->vq[1];
+                ctx->vqi = 1;
+            }
+        } break;
+
+        case 3: {
+            if (ctx->vqi == 3) {
+                if (kick) software_submit(ctx, SOFTWARE_PRIM_TRIANGLE, 3);
 
-            // exit(1);
+                ctx->vqi = 0;
+            }
         } break;
-    }
 
-    ctx->transfer_buffer.clear();
-    ctx->transfer_buffer.reserve(ctx->transfer_size);
+        case 4: {
+            if (ctx->vqi == 3) {
+                if (kick) software_submit(ctx, SOFTWARE_PRIM_TRIANGLE, 3);
 
-    ctx->psmct24_data = 0;
-    ctx->psmct24_shift = 0;
+                ctx->vq[0] = ctx->vq[1];
+                ctx->vq[1] = ctx->vq[2];
+                ctx->vqi = 2;
+            }
+        } break;
 
-    // printf("dbp=%x (%x) dbw=%d (%d) dpsm=%02x dsa=(%d,%d) rr=(%d,%d) xdir=%d transfer_size=%d\n",
-    //     ctx->dbp, ctx->dbp,
-    //     ctx->dbw, ctx->dbw,
-    //     ctx->dpsm,
-    //     ctx->dsax,
-    //     ctx->dsay,
-    //     ctx->rrw,
-    //     ctx->rrh,
-    //     ctx->xdir,
-    //     ctx->transfer_size
-    // );
+        case 5: {
+            if (ctx->vqi == 3) {
+                if (kick) software_submit(ctx, SOFTWARE_PRIM_TRIANGLE, 3);
 
-    if (ctx->xdir == 2) {
-        ctx->render_mtx.lock();
+                ctx->vq[1] = ctx->vq[2];
+                ctx->vqi = 2;
+            }
+        } break;
 
-        ctx->stats.texture_blits++;
+        case 6: {
+            if (ctx->vqi == 2) {
+                if (kick) software_submit(ctx, SOFTWARE_PRIM_SPRITE, 2);
 
-        software_thread_vram_blit(gs, ctx);
+                ctx->vqi = 0;
+            }
+        } break;
 
-        ctx->render_mtx.unlock();
-    } else if (ctx->xdir == 1) {
-        printf("gs: Read transfer requested\n");
+        default: {
+            ctx->vqi = 0;
+        } break;
+    }
+}
+
+// Transfers
+static void software_local_to_local(software_state* ctx) {
+    uint32_t sbp = ctx->bitbltbuf & 0x3fff;
+    uint32_t sbw = (ctx->bitbltbuf >> 16) & 0x3f;
+    uint32_t spsm = (ctx->bitbltbuf >> 24) & 0x3f;
+    uint32_t ssax = ctx->trxpos & 0x7ff;
+    uint32_t ssay = (ctx->trxpos >> 16) & 0x7ff;
+    uint32_t* vram = ctx->gs->vram;
+    uint32_t bw, bh;
+
+    // Block aligned copies between buffers of the same format just move
+    // whole blocks around, their contents don't depend on the buffer
+    // layout
+    if (spsm == ctx->dpsm && software_get_block_size(spsm, &bw, &bh) &&
+        !((ssax | ctx->dsax | ctx->rrw) & (bw - 1)) &&
+        !((ssay | ctx->dsay | ctx->rrh) & (bh - 1)) &&
+        (ssax + ctx->rrw) <= 2048 && (ctx->dsax + ctx->rrw) <= 2048 &&
+        (ssay + ctx->rrh) <= 2048 && (ctx->dsay + ctx->rrh) <= 2048) {
+        for (uint32_t y = 0; y < ctx->rrh; y += bh) {
+            for (uint32_t x = 0; x < ctx->rrw; x += bw) {
+                uint32_t src = software_block_addr(sbp, sbw, spsm, ssax + x, ssay + y);
+                uint32_t dst = software_block_addr(ctx->dbp, ctx->dbw, spsm, ctx->dsax + x, ctx->dsay + y);
+
+                memmove(&vram[dst], &vram[src], 64 * sizeof(uint32_t));
+            }
+        }
 
-        // exit(1);
-    } else {
-        ctx->stats.texture_uploads++;
+        return;
     }
-}
 
-void transfer_write(struct ps2_gs* gs, void* udata) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+    for (uint32_t y = 0; y < ctx->rrh; y++) {
+        for (uint32_t x = 0; x < ctx->rrw; x++) {
+            uint32_t data = software_read(vram, sbp, sbw, spsm, (ssax + x) & 0x7ff, (ssay + y) & 0x7ff);
 
-    ctx->transfer_buffer.push_back(gs->hwreg);
-    ctx->transfer_size--;
-
-    if (ctx->transfer_size == 0) {
-        transfer_flush_buffer(ctx);
+            software_write(vram, ctx->dbp, ctx->dbw, ctx->dpsm, (ctx->dsax + x) & 0x7ff, (ctx->dsay + y) & 0x7ff, data);
+        }
     }
 }
 
-void transfer_read(struct ps2_gs* gs, void* udata) {
-    gs->hwreg = 0;
-}
+static void software_start_transfer(software_state* ctx) {
+    ctx->dbp = (ctx->bitbltbuf >> 32) & 0x3fff;
+    ctx->dbw = (ctx->bitbltbuf >> 48) & 0x3f;
+    ctx->dpsm = (ctx->bitbltbuf >> 56) & 0x3f;
+    ctx->dsax = (ctx->trxpos >> 32) & 0x7ff;
+    ctx->dsay = (ctx->trxpos >> 48) & 0x7ff;
+    ctx->rrw = ctx->trxreg & 0xfff;
+    ctx->rrh = (ctx->trxreg >> 32) & 0xfff;
+    ctx->dx = 0;
+    ctx->dy = 0;
+    ctx->transfer_bits = 0;
+    ctx->transfer_bit_count = 0;
+    ctx->transfer_active = false;
 
-extern "C" void software_thread_render_point(struct ps2_gs* gs, void* udata) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+    switch (ctx->trxdir & 3) {
+        case 0: {
+            // Only wait for pending draws if they touch the destination
+            software_range range = software_get_range(ctx->dbp, ctx->dbw, ctx->dpsm, ctx->dsax + ctx->rrw, ctx->dsay + ctx->rrh);
 
-    ctx->stats.points++;
-    ctx->stats.primitives++;
+            if (software_overlaps_any(ctx->reads, range) || software_overlaps_any(ctx->writes, range))
+                software_flush(ctx);
 
-    ctx->queue_mtx.lock();
-    ctx->render_queue.push(render_data());
+            software_mark_dirty(ctx, range);
 
-    render_data& rdata = ctx->render_queue.back();
+            ctx->transfer_active = ctx->rrw && ctx->rrh;
+        } break;
 
-    rdata.gs = *gs;
-    rdata.prim = 0;
-    ctx->queue_mtx.unlock();
-}
+        case 1: {
+            // Local to host readbacks aren't serviced by the core yet,
+            // just make sure VRAM is up to date
+            software_flush(ctx);
+        } break;
 
-extern "C" void software_thread_render_line(struct ps2_gs* gs, void* udata) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+        case 2: {
+            software_flush(ctx);
+            software_local_to_local(ctx);
+            software_mark_dirty(ctx, software_get_range(ctx->dbp, ctx->dbw, ctx->dpsm, ctx->dsax + ctx->rrw, ctx->dsay + ctx->rrh));
+        } break;
+    }
+}
 
-    ctx->stats.lines++;
-    ctx->stats.primitives++;
+static inline bool software_advance_transfer(software_state* ctx) {
+    if (++ctx->dx == ctx->rrw) {
+        ctx->dx = 0;
 
-    ctx->queue_mtx.lock();
-    ctx->render_queue.push(render_data());
+        if (++ctx->dy == ctx->rrh) {
+            ctx->transfer_active = false;
 
-    render_data& rdata = ctx->render_queue.back();
+            return false;
+        }
+    }
 
-    rdata.gs = *gs;
-    rdata.prim = 1;
-    ctx->queue_mtx.unlock();
+    return true;
 }
 
-extern "C" void software_thread_render_triangle(struct ps2_gs* gs, void* udata) {
-    software_thread_state* ctx = (software_thread_state*)udata;
-
-    ctx->stats.triangles++;
-    ctx->stats.primitives++;
-
-    ctx->queue_mtx.lock();
-    ctx->render_queue.push(render_data());
+static void software_write_hwreg(software_state* ctx, uint64_t data) {
+    if (!ctx->transfer_active)
+        return;
 
-    render_data& rdata = ctx->render_queue.back();
+    // 32-bit pixels map to whole words, skip the unpacker
+    if (ctx->dpsm == GS_PSMCT32 || ctx->dpsm == GS_PSMZ32) {
+        const uint16_t (*table)[64] = (ctx->dpsm == GS_PSMCT32) ? swizzle.ct32 : swizzle.z32;
 
-    rdata.gs = *gs;
-    rdata.prim = 2;
-    ctx->queue_mtx.unlock();
-}
+        for (int i = 0; i < 64; i += 32) {
+            uint32_t x = (ctx->dsax + ctx->dx) & 0x7ff;
+            uint32_t y = (ctx->dsay + ctx->dy) & 0x7ff;
 
-extern "C" void software_thread_render_sprite(struct ps2_gs* gs, void* udata) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+            ctx->gs->vram[software_addr32(table, ctx->dbp, ctx->dbw, x, y)] = data >> i;
 
-    ctx->stats.sprites++;
-    ctx->stats.primitives++;
+            if (!software_advance_transfer(ctx))
+                return;
+        }
 
-    ctx->queue_mtx.lock();
-    ctx->render_queue.push(render_data());
+        return;
+    }
 
-    render_data& rdata = ctx->render_queue.back();
+    int bpp = software_psm_bpp(ctx->dpsm);
+    uint32_t mask = (bpp == 32) ? 0xffffffff : ((1u << bpp) - 1);
 
-    rdata.gs = *gs;
-    rdata.prim = 3;
-    ctx->queue_mtx.unlock();
-}
+    // Pixels are packed little-endian, 24-bit pixels can straddle
+    // HWREG writes
+    for (int i = 0; i < 64; i += 32) {
+        ctx->transfer_bits |= ((data >> i) & 0xffffffff) << ctx->transfer_bit_count;
+        ctx->transfer_bit_count += 32;
 
-extern "C" void software_thread_transfer_start(struct ps2_gs* gs, void* udata) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+        while (ctx->transfer_bit_count >= bpp) {
+            uint32_t pixel = ctx->transfer_bits & mask;
 
-    // Block until queue is empty
-    while (true) {
-        ctx->queue_mtx.lock();
+            ctx->transfer_bits >>= bpp;
+            ctx->transfer_bit_count -= bpp;
 
-        if (ctx->render_queue.empty()) {
-            ctx->queue_mtx.unlock();
+            software_write(ctx->gs->vram, ctx->dbp, ctx->dbw, ctx->dpsm,
+                (ctx->dsax + ctx->dx) & 0x7ff,
+                (ctx->dsay + ctx->dy) & 0x7ff,
+                pixel
+            );
 
-            break;
+            if (!software_advance_transfer(ctx))
+                return;
         }
-
-        ctx->queue_mtx.unlock();
     }
-
-    transfer_start(gs, ctx);
 }
 
-extern "C" void software_thread_transfer_write(struct ps2_gs* gs, void* udata) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+static void software_write_reg(software_state* ctx, int reg, uint64_t data) {
+    switch (reg) {
+        case GS_PRIM: ctx->prim = data; ctx->vqi = 0; ctx->state_dirty = true; return;
+        case GS_RGBAQ: ctx->rgbaq = data; return;
+        case GS_ST: ctx->st = data; return;
+        case GS_UV: ctx->uv = data; return;
+        case GS_XYZF2: software_write_vertex(ctx, data, 1, 1); return;
+        case GS_XYZ2: software_write_vertex(ctx, data, 0, 1); return;
+        case GS_XYZF3: software_write_vertex(ctx, data, 1, 0); return;
+        case GS_XYZ3: software_write_vertex(ctx, data, 0, 0); return;
+        case GS_FOG: ctx->fog = data; return;
+        case GS_TEX0_1:
+        case GS_TEX0_2: {
+            struct gs_context* c = &ctx->context[reg - GS_TEX0_1];
+
+            software_unpack_tex0(c, data);
+            software_load_clut(ctx, c);
+        } break;
+        case GS_TEX2_1:
+        case GS_TEX2_2: {
+            struct gs_context* c = &ctx->context[reg - GS_TEX2_1];
+
+            software_unpack_tex2(c, data);
+            software_load_clut(ctx, c);
+        } break;
+        case GS_CLAMP_1: software_unpack_clamp(&ctx->context[0], data); break;
+        case GS_CLAMP_2: software_unpack_clamp(&ctx->context[1], data); break;
+        case GS_TEX1_1: software_unpack_tex1(&ctx->context[0], data); break;
+        case GS_TEX1_2: software_unpack_tex1(&ctx->context[1], data); break;
+        case GS_XYOFFSET_1: software_unpack_xyoffset(&ctx->context[0], data); break;
+        case GS_XYOFFSET_2: software_unpack_xyoffset(&ctx->context[1], data); break;
+        case GS_PRMODECONT: ctx->prmodecont = data; break;
+        case GS_PRMODE: ctx->prmode = data; break;
+        case GS_TEXCLUT: {
+            ctx->texclut = data;
+            ctx->cbw = data & 0x3f;
+            ctx->cou = ((data >> 6) & 0x3f) << 4;
+            ctx->cov = (data >> 12) & 0x3ff;
+        } return;
+        case GS_MIPTBP1_1: ctx->context[0].miptbp1 = data; break;
+        case GS_MIPTBP1_2: ctx->context[1].miptbp1 = data; break;
+        case GS_MIPTBP2_1: ctx->context[0].miptbp2 = data; break;
+        case GS_MIPTBP2_2: ctx->context[1].miptbp2 = data; break;
+        case GS_TEXA: ctx->texa = data; break;
+        case GS_FOGCOL: ctx->fogcol = data; break;
+        case GS_TEXFLUSH: return;
+        case GS_SCISSOR_1: software_unpack_scissor(&ctx->context[0], data); break;
+        case GS_SCISSOR_2: software_unpack_scissor(&ctx->context[1], data); break;
+        case GS_ALPHA_1: software_unpack_alpha(&ctx->context[0], data); break;
+        case GS_ALPHA_2: software_unpack_alpha(&ctx->context[1], data); break;
+        case GS_DIMX: ctx->dimx = data; software_unpack_dimx(ctx); break;
+        case GS_DTHE: ctx->dthe = data; break;
+        case GS_COLCLAMP: ctx->colclamp = data; break;
+        case GS_TEST_1: software_unpack_test(&ctx->context[0], data); break;
+        case GS_TEST_2: software_unpack_test(&ctx->context[1], data); break;
+        case GS_PABE: ctx->pabe = data; break;
+        case GS_FBA_1: ctx->context[0].fba = data; break;
+        case GS_FBA_2: ctx->context[1].fba = data; break;
+        case GS_FRAME_1: software_unpack_frame(&ctx->context[0], data); break;
+        case GS_FRAME_2: software_unpack_frame(&ctx->context[1], data); break;
+        case GS_ZBUF_1: software_unpack_zbuf(&ctx->context[0], data); break;
+        case GS_ZBUF_2: software_unpack_zbuf(&ctx->context[1], data); break;
+        case GS_BITBLTBUF: ctx->bitbltbuf = data; return;
+        case GS_TRXPOS: ctx->trxpos = data; return;
+        case GS_TRXREG: ctx->trxreg = data; return;
+        case GS_TRXDIR: ctx->trxdir = data; software_start_transfer(ctx); return;
+        case GS_HWREG: software_write_hwreg(ctx, data); return;
+        case GS_SIGNAL: ps2_gs_write_signal(ctx->gs, data); return;
+        case GS_FINISH: ps2_gs_write_finish(ctx->gs, data); return;
+        case GS_LABEL: ps2_gs_write_label(ctx->gs, data); return;
+        default: return;
+    }
+
+    ctx->state_dirty = true;
+}
+
+static void software_write_packed(software_state* ctx, int r, const uint64_t* data, uint32_t* q) {
+    switch (r) {
+        case 0x01: {
+            uint64_t v = (data[0] & 0xff) |
+                         (((data[0] >> 32) & 0xff) << 8) |
+                         ((data[1] & 0xff) << 16) |
+                         (((data[1] >> 32) & 0xff) << 24) |
+                         ((uint64_t)*q << 32);
+
+            software_write_reg(ctx, GS_RGBAQ, v);
+        } break;
+
+        case 0x02: {
+            *q = data[1] & 0xffffffff;
+
+            software_write_reg(ctx, GS_ST, data[0]);
+        } break;
+
+        case 0x03: {
+            software_write_reg(ctx, GS_UV, (data[0] & 0x3fff) | ((data[0] >> 16) & 0x3fff0000));
+        } break;
+
+        case 0x04: {
+            uint64_t v = (data[0] & 0xffff) |
+                         (((data[0] >> 32) & 0xffff) << 16) |
+                         (((data[1] >> 4) & 0xffffff) << 32) |
+                         (((data[1] >> 36) & 0xff) << 56);
+
+            software_write_reg(ctx, (data[1] & 0x800000000000ull) ? GS_XYZF3 : GS_XYZF2, v);
+        } break;
+
+        case 0x05: {
+            uint64_t v = (data[0] & 0xffff) |
+                         (((data[0] >> 32) & 0xffff) << 16) |
+                         ((data[1] & 0xffffffff) << 32);
+
+            software_write_reg(ctx, (data[1] & 0x800000000000ull) ? GS_XYZ3 : GS_XYZ2, v);
+        } break;
+
+        case 0x0a: {
+            software_write_reg(ctx, GS_FOG, ((data[1] >> 36) & 0xff) << 56);
+        } break;
+
+        // A+D
+        case 0x0e: {
+            software_write_reg(ctx, data[1] & 0xff, data[0]);
+        } break;
+
+        // NOP
+        case 0x0f: break;
 
-    transfer_write(gs, ctx);
+        default: {
+            software_write_reg(ctx, r, data[0]);
+        } break;
+    }
 }
 
-extern "C" void software_thread_transfer_read(struct ps2_gs* gs, void* udata) {
-    software_thread_state* ctx = (software_thread_state*)udata;
-
-    // Block until queue is empty
-    while (true) {
-        ctx->queue_mtx.lock();
+extern "C" void software_thread_transfer(void* udata, int path, const void* data, size_t size) {
+    software_state* ctx = static_cast<software_state*>(udata);
 
-        if (ctx->render_queue.empty()) {
-            ctx->queue_mtx.unlock();
+    const uint64_t* ptr = (const uint64_t*)data;
+    const uint64_t* end = ptr + ((size / 16) * 2);
 
-            break;
-        }
+    while (ptr < end) {
+        uint64_t tag = ptr[0];
+        uint64_t regs = ptr[1];
 
-        ctx->queue_mtx.unlock();
-    }
+        ptr += 2;
 
-    // ctx->render_mtx.lock();
+        uint32_t nloop = tag & 0x7fff;
+        int fmt = (tag >> 58) & 3;
+        int nregs = (tag >> 60) & 0xf;
+        uint32_t q = 0x3f800000;
 
-    transfer_read(gs, ctx);
+        if (!nregs)
+            nregs = 16;
 
-    // ctx->render_mtx.unlock();
-}
+        if ((tag >> 46) & 1)
+            software_write_reg(ctx, GS_PRIM, (tag >> 47) & 0x7ff);
 
-void gs_blit_dispfb_deinterlace_frame(software_thread_state* ctx, int dfb) {
-    // Get current field
-    int odd = ((ctx->gs->csr >> 13) & 1) == 0;
+        switch (fmt) {
+            case 0: {
+                for (uint32_t i = 0; i < nloop; i++) {
+                    for (int j = 0; j < nregs; j++) {
+                        if (ptr >= end)
+                            return;
 
-    switch (ctx->disp_fmt) {
-        case GS_PSMCT32:
-        case GS_PSMCT24: {
-            for (int y = 0; y < ctx->tex_h / 2; y++) {
-                for (int x = 0; x < ctx->tex_w; x++) {
-                    uint32_t* dst = ctx->buf + x + (((y * 2) + odd) * ctx->tex_w);
+                        software_write_packed(ctx, (regs >> (j * 4)) & 0xf, ptr, &q);
 
-                    *dst = gs_read_dispfb(ctx->gs, x, y, dfb);
+                        ptr += 2;
+                    }
                 }
-            }
-        } break;
-        case GS_PSMCT16:
-        case GS_PSMCT16S: {
-            for (int y = 0; y < ctx->tex_h / 2; y++) {
-                for (int x = 0; x < ctx->tex_w; x++) {
-                    uint16_t* dst = ((uint16_t*)ctx->buf) + x + (((y * 2) + odd) * ctx->tex_w);
+            } break;
 
-                    *dst = gs_read_dispfb(ctx->gs, x, y, dfb);
-                }
-            }
-        } break;
-    }
-}
+            case 1: {
+                uint32_t count = nloop * nregs;
 
-void gs_blit_dispfb_deinterlace_field(software_thread_state* ctx, int dfb) {
-    // Get current field
-    int odd = ((ctx->gs->csr >> 13) & 1) == 0;
+                for (uint32_t i = 0; i < count; i++) {
+                    if (ptr >= end)
+                        return;
 
-    switch (ctx->disp_fmt) {
-        case GS_PSMCT32:
-        case GS_PSMCT24: {
-            for (int y = 0; y < ctx->tex_h / 2; y++) {
-                for (int x = 0; x < ctx->tex_w; x++) {
-                    uint32_t* dst = ctx->buf + x + (((y * 2) + odd) * ctx->tex_w);
+                    int r = (regs >> ((i % nregs) * 4)) & 0xf;
 
-                    *dst = gs_read_dispfb(ctx->gs, x, (y * 2) + odd, dfb);
+                    if (r < 0x0e)
+                        software_write_reg(ctx, r, *ptr);
+
+                    ptr++;
                 }
-            }
-        } break;
-        case GS_PSMCT16:
-        case GS_PSMCT16S: {
-            for (int y = 0; y < ctx->tex_h / 2; y++) {
-                for (int x = 0; x < ctx->tex_w; x++) {
-                    uint16_t* dst = ((uint16_t*)ctx->buf) + x + (((y * 2) + odd) * ctx->tex_w);
 
-                    *dst = gs_read_dispfb(ctx->gs, x, (y * 2) + odd, dfb);
+                // Data is padded to a full qword
+                if (count & 1)
+                    ptr++;
+            } break;
+
+            case 2:
+            case 3: {
+                for (uint32_t i = 0; i < nloop && ptr < end; i++) {
+                    software_write_reg(ctx, GS_HWREG, ptr[0]);
+                    software_write_reg(ctx, GS_HWREG, ptr[1]);
+
+                    ptr += 2;
                 }
-            }
-        } break;
+            } break;
+        }
     }
 }
 
-void gs_blit_dispfb_no_deinterlace(software_thread_state* ctx, int dfb) {
-    switch (ctx->disp_fmt) {
-        case GS_PSMCT32:
-        case GS_PSMCT24: {
-            for (int y = 0; y < ctx->tex_h; y++) {
-                for (int x = 0; x < ctx->tex_w; x++) {
-                    uint32_t* dst = ctx->buf + x + (y * ctx->tex_w);
+// Display
+static inline uint32_t software_read_display(software_state* ctx, uint64_t dispfb, int x, int y) {
+    uint32_t fbp = (dispfb & 0x1ff) << 5;
+    uint32_t fbw = (dispfb >> 9) & 0x3f;
+    uint32_t psm = (dispfb >> 15) & 0x1f;
+    uint32_t dbx = (dispfb >> 32) & 0x7ff;
+    uint32_t dby = (dispfb >> 43) & 0x7ff;
 
-                    *dst = gs_read_dispfb(ctx->gs, x, y, dfb);
-                }
-            }
-        } break;
+    uint32_t c = software_read(ctx->gs->vram, fbp, fbw, psm, (x + dbx) & 0x7ff, (y + dby) & 0x7ff);
+
+    switch (psm) {
+        case GS_PSMCT24: return c | 0x80000000;
         case GS_PSMCT16:
         case GS_PSMCT16S: {
-            for (int y = 0; y < ctx->tex_h; y++) {
-                for (int x = 0; x < ctx->tex_w; x++) {
-                    uint16_t* dst = ((uint16_t*)ctx->buf) + x + (y * ctx->tex_w);
-
-                    *dst = gs_read_dispfb(ctx->gs, x, y, dfb);
-                }
-            }
-        } break;
+            return ((c & 0x001f) << 3) |
+                   ((c & 0x03e0) << 6) |
+                   ((c & 0x7c00) << 9) |
+                   ((c & 0x8000) ? 0x80000000 : 0);
+        }
     }
+
+    return c;
 }
 
-// This starts a copy pass and transfers our vertex/index buffers and our
-// display frame
-void software_thread_begin_render(void* udata, SDL_GPUCommandBuffer* command_buffer) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+static void software_update_display(software_state* ctx) {
+    struct gs_privileged_state state;
 
-    // Block until queue is empty
-    while (true) {
-        ctx->queue_mtx.lock();
+    gs_get_privileged_state(ctx->gs, &state);
 
-        if (ctx->render_queue.empty()) {
-            ctx->queue_mtx.unlock();
+    int en1 = state.pmode & 1;
+    int en2 = (state.pmode >> 1) & 1;
 
-            break;
-        }
+    if (!en1 && !en2) {
+        ctx->width = 0;
+        ctx->height = 0;
 
-        ctx->queue_mtx.unlock();
+        return;
     }
 
-    int en1 = ctx->gs->pmode & 1;
-    int en2 = (ctx->gs->pmode >> 1) & 1;
+    uint64_t display = en1 ? state.display1 : state.display2;
 
-    uint32_t dfbp = 0;
-    int dfb = 0;
+    int magh = ((display >> 23) & 0xf) + 1;
+    int magv = ((display >> 27) & 3) + 1;
+    int w = ((((display >> 32) & 0xfff) + 1) / magh);
+    int h = ((((display >> 44) & 0x7ff) + 1) / magv);
 
-    if (en1) {
-        dfb = 0;
-        dfbp = ctx->gs->dispfb1;
-    } else if (en2) {
-        dfb = 1;
-        dfbp = ctx->gs->dispfb2;
-    }
+    // Field mode only renders every other line
+    if ((state.smode2 & 3) == 3)
+        h >>= 1;
 
-    if (!ctx->tex_w) {
-        return;
-    }
+    w = CLAMP(w, 1, 2048);
+    h = CLAMP(h, 1, 2048);
 
-    // printf("dfbp2=%08x dfbp1=%08x dfbpsm2=%02x dfbpsm1=%02x dfb=%d fbp=%x\n", ctx->gs->dfbp2, ctx->gs->dfbp1, ctx->gs->dfbpsm2, ctx->gs->dfbpsm1, dfb, ctx->gs->ctx->fbp >> 6);
+    ctx->width = w;
+    ctx->height = h;
+    ctx->buf.resize(w * h);
 
-    if (ctx->gs->smode2 & 1) {
-        // Need to deinterlace
-        if (ctx->gs->smode2 & 2) {
-            gs_blit_dispfb_deinterlace_frame(ctx, dfb);
-        } else {
-            gs_blit_dispfb_no_deinterlace(ctx, dfb);
-        }
-    } else {
-        gs_blit_dispfb_no_deinterlace(ctx, dfb);
-    }
+    // Circuit 1 is blended on top of circuit 2 (or the background color)
+    int mmod = (state.pmode >> 5) & 1;
+    int slbg = (state.pmode >> 7) & 1;
+    int alp = (state.pmode >> 8) & 0xff;
 
-    uint32_t* ptr = ctx->buf;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            uint32_t c;
 
-    SDL_Rect size, rect;
+            if (en1 && (en2 || slbg)) {
+                uint32_t c1 = software_read_display(ctx, state.dispfb1, x, y);
+                uint32_t c2 = slbg ? (uint32_t)state.bgcolor : software_read_display(ctx, state.dispfb2, x, y);
 
-    rect.w = ctx->tex_w;
-    rect.h = ctx->tex_h;
+                int a = mmod ? alp : (c1 >> 24);
 
-    SDL_GetWindowSize(ctx->window, &size.w, &size.h);
+                a = std::min(a, 0x80);
 
-    float scale = ctx->integer_scaling ? floorf(ctx->scale) : ctx->scale;
+                c = 0;
 
-    switch (ctx->aspect_mode) {
-        case RENDERER_ASPECT_NATIVE: {
-            rect.w *= scale;
-            rect.h *= scale;
-        } break;
+                for (int i = 0; i < 24; i += 8) {
+                    int k1 = (c1 >> i) & 0xff;
+                    int k2 = (c2 >> i) & 0xff;
 
-        case RENDERER_ASPECT_4_3: {
-            rect.w *= scale;
-            rect.h = (float)rect.w * (3.0f / 4.0f);
-        } break;
+                    c |= (uint32_t)std::min(((k1 * a) + (k2 * (0x80 - a))) >> 7, 255) << i;
+                }
+            } else {
+                c = software_read_display(ctx, en1 ? state.dispfb1 : state.dispfb2, x, y);
+            }
 
-        case RENDERER_ASPECT_16_9: {
-            rect.w *= scale;
-            rect.h = (float)rect.w * (9.0f / 16.0f);
-        } break;
+            ctx->buf[x + (y * w)] = c | 0xff000000;
+        }
+    }
+}
 
-        case RENDERER_ASPECT_5_4: {
-            rect.w *= scale;
-            rect.h = (float)rect.w * (4.0f / 5.0f);
-        } break;
+void* software_thread_create() {
+    return new software_state();
+}
 
-        case RENDERER_ASPECT_STRETCH: {
-            rect.w = size.w;
-            rect.h = size.h;
-        } break;
+bool software_thread_init(void* udata, const renderer_create_info& info) {
+    software_state* ctx = static_cast<software_state*>(udata);
 
-        case RENDERER_ASPECT_AUTO:
-        case RENDERER_ASPECT_STRETCH_KEEP: {
-            rect.h = size.h;
-            rect.w = (float)rect.h * (4.0f / 3.0f);
-        } break;
-    }
+    ctx->gs = info.gs;
+    ctx->gif = info.gif;
 
-    ctx->disp_w = rect.w;
-    ctx->disp_h = rect.h;
+    unsigned int threads = std::thread::hardware_concurrency();
 
-    rect.x = (size.w / 2) - (rect.w / 2);
-    rect.y = (size.h / 2) - (rect.h / 2);
+    // The emulator thread rasterizes too
+    threads = threads > 1 ? std::min(threads - 1, 15u) : 0;
 
-    float x0 = (rect.x / ((float)size.w / 2.0f)) - 1.0f;
-    float y0 = (rect.y / ((float)size.h / 2.0f)) - 1.0f;
-    float x1 = ((rect.x + rect.w) / ((float)size.w / 2.0f)) - 1.0f;
-    float y1 = ((rect.y + rect.h) / ((float)size.h / 2.0f)) - 1.0f;
+    for (unsigned int i = 0; i < threads; i++)
+        ctx->workers.emplace_back(software_worker, ctx);
 
-    // Create a transfer buffer to upload our vertex buffer and index buffer
-    SDL_GPUTransferBufferCreateInfo btbci = {
-        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
-        .size = sizeof(gpu_vertex) * 4 + sizeof(Uint16) * 6,
-    };
+    // Batch storage is reused across flushes, grab it upfront so
+    // binning doesn't reallocate on the first frames
+    ctx->prims.reserve(SOFTWARE_MAX_PRIMS);
+    ctx->states.reserve(SOFTWARE_MAX_STATES);
+    ctx->cluts.reserve(512 * 64);
+    ctx->textures.resize(SOFTWARE_TEXTURE_CACHE_SIZE);
 
-    SDL_GPUTransferBuffer* buffer_tb = SDL_CreateGPUTransferBuffer(ctx->device, &btbci);
+    software_thread_reset(ctx);
 
-    // fill the transfer buffer
-    gpu_vertex* vertices = (gpu_vertex*)SDL_MapGPUTransferBuffer(ctx->device, buffer_tb, false);
+    // Headless, only the CPU framebuffer is available
+    if (info.device == VK_NULL_HANDLE)
+        return true;
 
-    vertices[0] = { x0, y1, 0.0, 1.0 }; // Top left
-    vertices[1] = { x1, y1, 1.0, 1.0 }; // Top right
-    vertices[2] = { x1, y0, 1.0, 0.0 }; // Bottom right
-    vertices[3] = { x0, y0, 0.0, 0.0 }; // Bottom left
+    if (!Context::init_loader(nullptr))
+        return false;
 
-    Uint16* indices = (Uint16*)&vertices[4];
+    ctx->instance = new ExternallyManagedInstance(info.instance, info.instance_create_info);
+    ctx->device = new ExternallyManagedDevice(info.device, info.device_create_info);
 
-    indices[0] = 0;
-    indices[1] = 1;
-    indices[2] = 2;
-    indices[3] = 0;
-    indices[4] = 2;
-    indices[5] = 3;
+    ctx->granite_ctx.set_instance_factory(ctx->instance);
+    ctx->granite_ctx.set_device_factory(ctx->device);
+    ctx->granite_ctx.set_num_thread_indices(1);
 
-    SDL_UnmapGPUTransferBuffer(ctx->device, buffer_tb);
+    if (!ctx->granite_ctx.init_instance(nullptr, 0)) {
+        fprintf(stderr, "renderer: Failed to initialize Granite instance\n");
 
-    // start a copy pass
-    SDL_GPUCopyPass* cp = SDL_BeginGPUCopyPass(command_buffer);
+        return false;
+    }
 
-    // Upload vertex buffer (at offset 0)
-    SDL_GPUTransferBufferLocation tbl = {
-        .transfer_buffer = buffer_tb,
-        .offset = 0,
-    };
+    if (!ctx->granite_ctx.init_device(info.physical_device, VK_NULL_HANDLE, nullptr, 0)) {
+        fprintf(stderr, "renderer: Failed to initialize Granite device\n");
 
-    SDL_GPUBufferRegion br = {
-        .buffer = ctx->vertex_buffer,
-        .offset = 0,
-        .size = sizeof(gpu_vertex) * 4,
-    };
+        return false;
+    }
 
-    SDL_UploadToGPUBuffer(cp, &tbl, &br, false);
+    ctx->granite_device.set_context(ctx->granite_ctx);
+    ctx->granite_device.init_frame_contexts(4);
 
-    tbl = {
-        .transfer_buffer = buffer_tb,
-        .offset = sizeof(gpu_vertex) * 4,
-    };
+    ctx->vulkan = true;
 
-    br = {
-        .buffer = ctx->index_buffer,
-        .offset = 0,
-        .size = sizeof(Uint16) * 6,
-    };
+    return true;
+}
 
-    // Upload index buffer (right after our vertex data)
-    SDL_UploadToGPUBuffer(cp, &tbl, &br, false);
+void software_thread_reset(void* udata) {
+    software_state* ctx = static_cast<software_state*>(udata);
 
-    int stride = 4;
+    // Drop anything that's still pending
+    ctx->prims.clear();
+    software_flush(ctx);
 
-    switch (ctx->disp_fmt) {
-        case GS_PSMCT32:
-        case GS_PSMCT24: {
-            stride = 4;
-        } break;
+    ctx->prim = 0;
+    ctx->rgbaq = 0;
+    ctx->st = 0;
+    ctx->uv = 0;
+    ctx->fog = 0;
+    ctx->prmodecont = 1;
+    ctx->prmode = 0;
+    ctx->texclut = 0;
+    ctx->texa = 0;
+    ctx->fogcol = 0;
+    ctx->dimx = 0;
+    ctx->dthe = 0;
+    ctx->colclamp = 0;
+    ctx->pabe = 0;
+    ctx->bitbltbuf = 0;
+    ctx->trxpos = 0;
+    ctx->trxreg = 0;
+    ctx->trxdir = 0;
+    ctx->cbw = 0;
+    ctx->cou = 0;
+    ctx->cov = 0;
+    ctx->cbp0 = 0;
+    ctx->cbp1 = 0;
+    ctx->vqi = 0;
+    ctx->transfer_active = false;
 
-        case GS_PSMCT16:
-        case GS_PSMCT16S: {
-            stride = 2;
-        } break;
+    memset(ctx->context, 0, sizeof(ctx->context));
+    memset(ctx->dither, 0, sizeof(ctx->dither));
+    memset(ctx->clut, 0, sizeof(ctx->clut));
 
-        // Ignore unknown formats
-        // default: {
-        //     printf("Unsupported display format %d\n", ctx->disp_fmt);
-            
-        //     exit(1);
-        // } break;
+    for (software_texture& t : ctx->textures)
+        t.valid = false;
+
+    for (int i = 0; i < 2; i++) {
+        software_unpack_tex0(&ctx->context[i], 0);
+        software_unpack_frame(&ctx->context[i], 0);
+        software_unpack_zbuf(&ctx->context[i], 0);
     }
 
-    SDL_GPUTransferBufferCreateInfo ttbci = {
-        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
-        .size = static_cast<Uint32>(ctx->tex_w) * static_cast<Uint32>(ctx->tex_h) * stride
-    };
+    ctx->width = 0;
+    ctx->height = 0;
+}
 
-    SDL_GPUTransferBuffer* texture_tb = SDL_CreateGPUTransferBuffer(ctx->device, &ttbci);
+void software_thread_destroy(void* udata) {
+    software_state* ctx = static_cast<software_state*>(udata);
 
-    // fill the transfer buffer
-    void* data = SDL_MapGPUTransferBuffer(ctx->device, texture_tb, false);
+    {
+        std::lock_guard <std::mutex> lock(ctx->pool_mtx);
 
-    SDL_memcpy(data, ptr, (ctx->tex_w * stride) * ctx->tex_h);
+        ctx->pool_exit = true;
+    }
 
-    SDL_UnmapGPUTransferBuffer(ctx->device, texture_tb);
+    ctx->pool_cv.notify_all();
 
-    SDL_GPUTextureTransferInfo tti = {
-        .transfer_buffer = texture_tb,
-        .offset = 0,
-    };
+    for (std::thread& t : ctx->workers)
+        t.join();
 
-    SDL_GPUTextureRegion tr = {
-        .texture = ctx->texture,
-        .w = static_cast<Uint32>(ctx->tex_w),
-        .h = static_cast<Uint32>(ctx->tex_h),
-        .d = 1,
-    };
+    ctx->image.reset();
 
-    SDL_UploadToGPUTexture(cp, &tti, &tr, false);
+    delete ctx->instance;
+    delete ctx->device;
 
-    // end the copy pass
-    SDL_EndGPUCopyPass(cp);
+    delete ctx;
+}
 
-    SDL_ReleaseGPUTransferBuffer(ctx->device, buffer_tb);
-    SDL_ReleaseGPUTransferBuffer(ctx->device, texture_tb);
+void software_thread_set_config(void* udata, void* config) {
+    // Nothing
 }
 
-void software_thread_render(void* udata, SDL_GPUCommandBuffer* command_buffer, SDL_GPURenderPass* render_pass) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+renderer_image software_thread_get_frame(void* udata) {
+    software_state* ctx = static_cast<software_state*>(udata);
 
-    if (!ctx->texture)
-        return;
+    renderer_image image = {};
 
-    ctx->stats.frames_rendered++;
-    ctx->last_frame_stats = ctx->stats;
-    ctx->stats.lines = 0;
-    ctx->stats.points = 0;
-    ctx->stats.triangles = 0;
-    ctx->stats.sprites = 0;
-    ctx->stats.primitives = 0;
-    ctx->stats.texture_uploads = 0;
-    ctx->stats.texture_blits = 0;
+    image.image = VK_NULL_HANDLE;
+    image.view = VK_NULL_HANDLE;
 
-    SDL_BindGPUGraphicsPipeline(render_pass, ctx->pipeline);
+    software_flush(ctx);
+    software_update_display(ctx);
 
-    // bind the vertex buffer
-    SDL_GPUBufferBinding bb[1]{};
-    bb[0].buffer = ctx->vertex_buffer;
-    bb[0].offset = 0;
+    if (!ctx->width || !ctx->vulkan)
+        return image;
 
-    SDL_BindGPUVertexBuffers(render_pass, 0, bb, 1);
+    ctx->granite_device.next_frame_context();
 
-    bb[0].buffer = ctx->index_buffer;
-    bb[0].offset = 0;
+    ImageCreateInfo image_info = ImageCreateInfo::immutable_2d_image(ctx->width, ctx->height, VK_FORMAT_R8G8B8A8_UNORM);
+    ImageInitialData initial_data = {};
 
-    SDL_BindGPUIndexBuffer(render_pass, bb, SDL_GPU_INDEXELEMENTSIZE_16BIT);
+    initial_data.data = ctx->buf.data();
 
-    SDL_GPUTextureSamplerBinding tsb = {
-        .texture = ctx->texture,
-        .sampler = ctx->bilinear ? ctx->sampler[1] : ctx->sampler[0],
-    };
+    ctx->image = ctx->granite_device.create_image(image_info, &initial_data);
 
-    SDL_BindGPUFragmentSamplers(render_pass, 0, &tsb, 1);
+    // The frontend samples this image outside of Granite, make sure
+    // the upload has landed before handing it out
+    Fence fence;
+    CommandBufferHandle cmd = ctx->granite_device.request_command_buffer();
 
-    // issue a draw call
-    SDL_DrawGPUIndexedPrimitives(render_pass, 6, 1, 0, 0, 0);
-}
+    ctx->granite_device.submit(cmd, &fence);
+
+    fence->wait();
 
-void software_thread_end_render(void* udata, SDL_GPUCommandBuffer* command_buffer) {
-    // Nothing for now
+    Image* granite_image = ctx->image.get();
+
+    image.image = granite_image->get_image();
+    image.width = granite_image->get_width();
+    image.height = granite_image->get_height();
+    image.format = granite_image->get_format();
+    image.view = granite_image->get_view().get_view().view;
+
+    return image;
 }
 
-renderer_stats* software_thread_get_debug_stats(void* udata) {
-    software_thread_state* ctx = (software_thread_state*)udata;
+const uint32_t* software_thread_get_buffer(void* udata, int* w, int* h) {
+    software_state* ctx = static_cast<software_state*>(udata);
 
-    return &ctx->last_frame_stats;
-}
\ No newline at end of file
+    *w = ctx->width;
+    *h = ctx->height;
+
+    return ctx->width ? ctx->buf.data() : nullptr;
+}
@@ -3,111 +3,288 @@
 #include <vector>
 #include <cstdio>
 #include <thread>
-#include <chrono>
 #include <atomic>
-#include <queue>
 #include <mutex>
-
-#include <SDL3/SDL.h>
+#include <condition_variable>
 
 #include "gs/gs.h"
 
 #include "renderer.hpp"
+#include "hardware.hpp"
+
+/*
+    Software renderer
+    -----------------
+
+    GIF packets are decoded on the emulator thread, primitives are set up
+    and binned into 32x32 screen tiles. Binned primitives are kept in a
+    batch that gets rasterized when something needs to observe VRAM (a
+    transfer, a frame, a CLUT load) or when a new draw state would create
+    a hazard with what's already in the batch (e.g. sampling a texture
+    that a pending primitive renders to).
+
+    Flushing a batch hands every non-empty tile to a worker pool. Tiles
+    cover disjoint pixels and primitives within a tile are drawn in
+    submission order, so the result is the same as drawing serially.
+
+    Primitives don't carry GS state, they reference a draw state record
+    in the batch. A new record is only appended when the state a draw
+    sees actually differs from the previous one, and CLUT snapshots are
+    only taken for indexed textures. Batch storage is allocated once and
+    reused across flushes, idle workers sleep on a condition variable.
+
+    The display circuits are read out into a CPU framebuffer on
+    get_frame, which is then uploaded to a Vulkan image when a device is
+    available.
+*/
 
-struct render_data {
-    int prim;
-    struct ps2_gs gs;
+#define SOFTWARE_TILE_SHIFT 5
+#define SOFTWARE_TILE_SIZE (1 << SOFTWARE_TILE_SHIFT)
+#define SOFTWARE_TILES_X (2048 >> SOFTWARE_TILE_SHIFT)
+#define SOFTWARE_TILES_Y (2048 >> SOFTWARE_TILE_SHIFT)
+#define SOFTWARE_MAX_PRIMS 0x10000
+#define SOFTWARE_MAX_STATES 0x1000
+#define SOFTWARE_TEXTURE_CACHE_SIZE 32
+#define SOFTWARE_TEXTURE_MAX_TEXELS (512 * 512)
+
+enum : int {
+    SOFTWARE_PRIM_POINT,
+    SOFTWARE_PRIM_LINE,
+    SOFTWARE_PRIM_TRIANGLE,
+    SOFTWARE_PRIM_SPRITE
 };
 
-struct gpu_vertex {
-    float x, y, u, v;
+struct software_vertex {
+    // Window coordinates (12.4, XYOFFSET applied)
+    int32_t x, y;
+    uint32_t z;
+    int32_t r, g, b, a;
+    int32_t fog;
+
+    // UV is 10.4 fixed-point
+    int32_t u, v;
+    float s, t, q;
 };
 
-struct software_thread_state {
-    std::queue <render_data> render_queue;
-    std::thread render_thr;
-    std::mutex queue_mtx;
-    std::mutex render_mtx;
-
-    std::vector <uint64_t> transfer_buffer;
-    int transfer_index = 0;
-    int transfer_size = 0;
-
-    std::atomic <bool> end_signal;
-
-    unsigned int sbp = 0, dbp = 0;
-    unsigned int sbw = 0, dbw = 0;
-    unsigned int spsm = 0, dpsm = 0;
-    unsigned int ssax = 0, ssay = 0, dsax = 0, dsay = 0;
-    unsigned int rrh = 0, rrw = 0;
-    unsigned int dir = 0, xdir = 0;
-    unsigned int sx = 0, sy = 0;
-    unsigned int dx = 0, dy = 0, px = 0;
-
-    uint32_t psmct24_data = 0;
-    uint32_t psmct24_shift = 0;
-
-    // SDL stuff
-    SDL_Window* window = nullptr;
-    SDL_GPUDevice* device = nullptr;
-    SDL_GPUBuffer* vertex_buffer = nullptr;
-    SDL_GPUBuffer* index_buffer = nullptr;
-    SDL_GPUTexture* texture = nullptr;
-    SDL_GPUSampler* sampler[2] = { nullptr };
-    SDL_GPUGraphicsPipeline* pipeline = nullptr;
-
-    // Context
-    SDL_GPUCommandBuffer* cb = nullptr;
-    SDL_GPURenderPass* rp = nullptr;
+struct software_draw_state {
+    struct gs_context ctx;
+
+    int iip;
+    int tme;
+    int fge;
+    int abe;
+    int fst;
+
+    // TEXA
+    int aem;
+    uint32_t ta0;
+    uint32_t ta1;
+
+    uint32_t fogcol;
+    int dthe;
+    int colclamp;
+    int pabe;
+    int dither[4][4];
+
+    // Decoded texture (usize * vsize RGBA8 texels) if it was cached
+    const uint32_t* texture;
+
+    // Offset of this draw's CLUT snapshot in the batch's CLUT pool,
+    // only valid for indexed textures
+    uint32_t clut;
+
+    // Triangles and sprites can run the pixel pipeline 4 pixels at a
+    // time. Not set when one pixel's writes could be seen by its
+    // neighbours' reads (Z and frame buffers overlap, or the draw
+    // samples its target)
+    int quad;
+};
+
+// a(x, y) = c + dx * x + dy * y, relative to the top-left pixel of the
+// primitive's bounding box. Colors, fog and UV are 16.16 fixed-point
+// and evaluated with wrapping arithmetic, c may be far outside the
+// triangle but every covered pixel lands back in range
+struct software_plane {
+    int32_t c, dx, dy;
+};
+
+// Z is 32.16 so no depth bits are lost
+struct software_plane_z {
+    int64_t c, dx, dy;
+};
+
+// STQ come in as floats and are divided per pixel, they stay floats
+struct software_plane_f {
+    float c, dx, dy;
+};
+
+// Per-triangle setup, computed once when the triangle is binned
+struct software_triangle {
+    // Edge functions (12.4) at the top-left pixel and their per pixel
+    // steps, e0 includes the fill rule bias
+    int64_t e0[3], step_x[3], step_y[3];
+
+    software_plane_z z;
+    software_plane r, g, b, alpha;
+    software_plane fog;
 
+    // UV for FST, STQ otherwise
+    software_plane u, v;
+    software_plane_f s, t, q;
+};
+
+struct software_prim {
+    int type;
+    uint32_t state;
+
+    // Index into the batch's triangle setups
+    uint32_t setup;
+
+    // Pixel bounding box (inclusive), clipped to the scissor
+    int x0, y0, x1, y1;
+
+    software_vertex v[3];
+};
+
+// A VRAM area (in words) touched by a batch along with the layout it
+// was accessed with
+struct software_range {
+    uint32_t begin;
+    uint32_t end;
+    uint32_t bp;
+    uint32_t bw;
+    uint32_t psm;
+};
+
+// A texture decoded to RGBA8. Entries are keyed by everything that
+// affects decoding and get invalidated when any VRAM page they were
+// decoded from is written to
+struct software_texture {
+    bool valid = false;
+    uint32_t tbp0 = 0, tbw = 0, psm = 0;
+    uint32_t usize = 0, vsize = 0;
+
+    // TEXA, only used for 24 and 16-bit formats
+    int aem = 0;
+    uint32_t ta0 = 0, ta1 = 0;
+
+    // Decoded CLUT, only used for indexed formats
+    uint32_t palette[256] = {};
+
+    uint32_t page_begin = 0, page_end = 0;
+    uint64_t last_used = 0;
+
+    // Last batch that referenced this texture
+    uint64_t batch = 0;
+
+    std::vector <uint32_t> data;
+};
+
+struct software_state {
     struct ps2_gs* gs = nullptr;
+    struct ps2_gif* gif = nullptr;
+
+    // GS drawing registers
+    uint64_t prim = 0;
+    uint64_t rgbaq = 0;
+    uint64_t st = 0;
+    uint64_t uv = 0;
+    uint64_t fog = 0;
+    uint64_t prmodecont = 0;
+    uint64_t prmode = 0;
+    uint64_t texclut = 0;
+    uint64_t texa = 0;
+    uint64_t fogcol = 0;
+    uint64_t dimx = 0;
+    uint64_t dthe = 0;
+    uint64_t colclamp = 0;
+    uint64_t pabe = 0;
+    uint64_t bitbltbuf = 0;
+    uint64_t trxpos = 0;
+    uint64_t trxreg = 0;
+    uint64_t trxdir = 0;
+    struct gs_context context[2] = {};
+
+    // TEXCLUT
+    uint32_t cbw = 0;
+    uint32_t cou = 0;
+    uint32_t cov = 0;
+
+    // DIMX
+    int dither[4][4] = {};
+
+    // Vertex queue
+    software_vertex vq[4] = {};
+    unsigned int vqi = 0;
+
+    // CLUT cache, 32-bit entries are split into the lower and
+    // upper halves
+    uint16_t clut[512] = {};
+    uint32_t cbp0 = 0;
+    uint32_t cbp1 = 0;
+    bool clut_dirty = true;
+
+    // Host to local transfer
+    bool transfer_active = false;
+    uint32_t dbp = 0, dbw = 0, dpsm = 0;
+    uint32_t dsax = 0, dsay = 0;
+    uint32_t rrw = 0, rrh = 0;
+    uint32_t dx = 0, dy = 0;
+    uint64_t transfer_bits = 0;
+    int transfer_bit_count = 0;
 
-    unsigned int window_x = 0, window_y = 0;
-    unsigned int window_w = 0, window_h = 0;
+    // Current batch
+    std::vector <software_draw_state> states;
+    std::vector <uint16_t> cluts;
+    std::vector <software_prim> prims;
+    std::vector <software_triangle> triangles;
+    std::vector <uint32_t> bins[SOFTWARE_TILES_X * SOFTWARE_TILES_Y];
+    std::vector <uint32_t> active_tiles;
+    std::vector <software_range> reads;
+    std::vector <software_range> writes;
+    bool state_dirty = true;
+    bool immediate = false;
+    uint64_t batch = 1;
 
-    int tex_w = 0;
-    int tex_h = 0;
-    int disp_w = 0;
-    int disp_h = 0;
-    int disp_fmt = 0;
-    int aspect_mode = 0; // Native
-    bool integer_scaling = false;
-    float scale = 1.5;
-    bool bilinear = true;
+    // Texture cache, dirty_pages has a bit for each 8 KiB VRAM page
+    // written since the last time the cache was checked
+    std::vector <software_texture> textures;
+    uint64_t dirty_pages[512 / 64] = {};
+    bool dirty = false;
+    uint64_t texture_clock = 0;
 
-    unsigned int frame = 0;
+    // Worker pool
+    std::vector <std::thread> workers;
+    std::mutex pool_mtx;
+    std::condition_variable pool_cv;
+    std::condition_variable pool_done_cv;
+    uint64_t pool_generation = 0;
+    unsigned int pool_busy = 0;
+    bool pool_exit = false;
+    std::atomic <uint32_t> next_tile;
 
-    uint32_t* buf = nullptr;
+    // Display
+    std::vector <uint32_t> buf;
+    int width = 0;
+    int height = 0;
 
-    renderer_stats stats = { 0 };
-    renderer_stats last_frame_stats = { 0 };
+    // Vulkan output, only used if we were given a device
+    bool vulkan = false;
+    Vulkan::Context granite_ctx;
+    Vulkan::Device granite_device;
+    Vulkan::ImageHandle image;
+    ExternallyManagedDevice* device = nullptr;
+    ExternallyManagedInstance* instance = nullptr;
 };
 
-void software_thread_init(void* udata, struct ps2_gs* gs, SDL_Window* window, SDL_GPUDevice* device);
+void* software_thread_create();
+bool software_thread_init(void* udata, const renderer_create_info& info);
+void software_thread_reset(void* udata);
 void software_thread_destroy(void* udata);
-void software_thread_set_size(void* udata, int width, int height);
-void software_thread_set_scale(void* udata, float scale);
-void software_thread_set_aspect_mode(void* udata, int aspect_mode);
-void software_thread_set_integer_scaling(void* udata, bool integer_scaling);
-void software_thread_set_bilinear(void* udata, bool bilinear);
-void software_thread_get_viewport_size(void* udata, int* w, int* h);
-void software_thread_get_display_size(void* udata, int* w, int* h);
-void software_thread_get_display_format(void* udata, int* fmt);
-void software_thread_get_interlace_mode(void* udata, int* mode);
-void software_thread_set_window_rect(void* udata, int x, int y, int w, int h);
-void* software_thread_get_buffer_data(void* udata, int* w, int* h, int* bpp);
-renderer_stats* software_thread_get_debug_stats(void* udata);
-const char* software_thread_get_name(void* udata);
-void software_thread_begin_render(void* udata, SDL_GPUCommandBuffer* command_buffer);
-void software_thread_render(void* udata, SDL_GPUCommandBuffer* command_buffer, SDL_GPURenderPass* render_pass);
-void software_thread_end_render(void* udata, SDL_GPUCommandBuffer* command_buffer);
+void software_thread_set_config(void* udata, void* config);
+renderer_image software_thread_get_frame(void* udata);
+const uint32_t* software_thread_get_buffer(void* udata, int* w, int* h);
 
 extern "C" {
-void software_thread_render_point(struct ps2_gs* gs, void* udata);
-void software_thread_render_line(struct ps2_gs* gs, void* udata);
-void software_thread_render_triangle(struct ps2_gs* gs, void* udata);
-void software_thread_render_sprite(struct ps2_gs* gs, void* udata);
-void software_thread_transfer_start(struct ps2_gs* gs, void* udata);
-void software_thread_transfer_write(struct ps2_gs* gs, void* udata);
-void software_thread_transfer_read(struct ps2_gs* gs, void* udata);
-}
\ No newline at end of file
+void software_thread_transfer(void* udata, int path, const void* data, size_t size);
+}
@@ -16,4 +16,9 @@ void iop_bus_write8(void* udata, uint32_t addr, uint32_t data);
 void iop_bus_write16(void* udata, uint32_t addr, uint32_t data);
 void iop_bus_write32(void* udata, uint32_t addr, uint32_t data);
 
+// Bulk access for host-side copies (HLE, loaders, debugger)
+void* iop_bus_get_span(void* udata, uint32_t addr, uint32_t* size, int write);
+void iop_bus_read_block(void* udata, uint32_t addr, void* buf, uint32_t size);
+void iop_bus_write_block(void* udata, uint32_t addr, const void* buf, uint32_t size);
+
 #endif
\ No newline at end of file
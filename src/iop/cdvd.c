@@ -639,16 +639,16 @@ static inline void cdvd_send_irq(struct ps2_cdvd* cdvd) {
     cdvd->i_stat |= 2;
 }
 
-void cdvd_fetch_sector(struct ps2_cdvd* cdvd) {
-    memset(cdvd->buf, 0, 2352);
+void cdvd_fetch_sector(struct ps2_cdvd* cdvd, uint8_t* buf) {
+    memset(buf, 0, 2352);
 
     switch (cdvd->read_size) {
         case CDVD_CD_SS_2048:
         case CDVD_CD_SS_2328: {
-            disc_read_sector(cdvd->disc, cdvd->buf, cdvd->read_lba++, DISC_SS_DATA);
+            disc_read_sector(cdvd->disc, buf, cdvd->read_lba++, DISC_SS_DATA);
         } break;
         case CDVD_CD_SS_2352: {
-            disc_read_sector(cdvd->disc, cdvd->buf, cdvd->read_lba++, DISC_SS_RAW);
+            disc_read_sector(cdvd->disc, buf, cdvd->read_lba++, DISC_SS_RAW);
         } break;
         case CDVD_CD_SS_2340: {
             // LBA -> MSF
@@ -661,16 +661,16 @@ void cdvd_fetch_sector(struct ps2_cdvd* cdvd) {
             uint32_t f = a - (s * 75);
 
             // Fill in header
-            cdvd->buf[0] = itob_table[m];
-            cdvd->buf[1] = itob_table[s];
-            cdvd->buf[2] = itob_table[f];
-            cdvd->buf[3] = 1;
+            buf[0] = itob_table[m];
+            buf[1] = itob_table[s];
+            buf[2] = itob_table[f];
+            buf[3] = 1;
 
             // Write raw data at offset 12
-            disc_read_sector(cdvd->disc, cdvd->buf + 12, cdvd->read_lba++, DISC_SS_DATA);
+            disc_read_sector(cdvd->disc, buf + 12, cdvd->read_lba++, DISC_SS_DATA);
         } break;
         case CDVD_DVD_SS: {
-            memset(cdvd->buf, 0, 2340);
+            memset(buf, 0, 2340);
 
             uint32_t lba, layer;
 
@@ -682,22 +682,22 @@ void cdvd_fetch_sector(struct ps2_cdvd* cdvd) {
                 lba = cdvd->read_lba + 0x30000;
             }
 
-            cdvd->buf[0] = 0x20 | layer;
-            cdvd->buf[1] = (lba >> 16) & 0xFF;
-            cdvd->buf[2] = (lba >> 8) & 0xFF;
-            cdvd->buf[3] = lba & 0xff;
+            buf[0] = 0x20 | layer;
+            buf[1] = (lba >> 16) & 0xFF;
+            buf[2] = (lba >> 8) & 0xFF;
+            buf[3] = lba & 0xff;
 
-            disc_read_sector(cdvd->disc, cdvd->buf + 12, cdvd->read_lba++, DISC_SS_DATA);
+            disc_read_sector(cdvd->disc, buf + 12, cdvd->read_lba++, DISC_SS_DATA);
 
             // for (int i = 0; i < 2064;) {
             //     for (int x = 0; x < 16; x++) {
-            //         printf("%02x ", cdvd->buf[i+x]);
+            //         printf("%02x ", buf[i+x]);
             //     }
     
             //     putchar('|');
     
             //     for (int x = 0; x < 16; x++) {
-            //         printf("%c", isprint(cdvd->buf[i+x]) ? cdvd->buf[i+x] : '.');
+            //         printf("%c", isprint(buf[i+x]) ? buf[i+x] : '.');
             //     }
     
             //     puts("|");
@@ -715,17 +715,62 @@ void cdvd_fetch_sector(struct ps2_cdvd* cdvd) {
     int do_shift = (cdvd->mecha_decode) & 2;
 
     for (int i = 0; i < cdvd->read_size; ++i) {
-        if (do_xor) cdvd->buf[i] ^= cdvd->cdkey[4];
-        if (do_shift) cdvd->buf[i] = (cdvd->buf[i] >> shift_amount) | (cdvd->buf[i] << (8 - shift_amount));
+        if (do_xor) buf[i] ^= cdvd->cdkey[4];
+        if (do_shift) buf[i] = (buf[i] >> shift_amount) | (buf[i] << (8 - shift_amount));
     }
 }
 
+static inline long cdvd_scale_timing(struct ps2_cdvd* cdvd, long cycles) {
+    if (!cdvd->fast_read_sectors || (cdvd->fast_read_speed <= 1))
+        return cycles;
+
+    cycles /= cdvd->fast_read_speed;
+
+    return cycles ? cycles : 1;
+}
+
+void cdvd_do_read_end(void* udata, int overshoot) {
+    struct ps2_cdvd* cdvd = (struct ps2_cdvd*)udata;
+
+    // In fast-read mode the last batch may still be in the buffer,
+    // don't signal completion until DMA has drained it
+    if (cdvd->fast_read_sectors && cdvd->buf_size) {
+        struct sched_event event;
+
+        event.name = "CDVD Read end";
+        event.udata = cdvd;
+        event.callback = cdvd_do_read_end;
+        event.cycles = 1000;
+
+        sched_schedule(cdvd->sched, event);
+
+        cdvd_set_status(cdvd, CDVD_STATUS_READING);
+
+        return;
+    }
+
+    cdvd->n_stat = 0x4e;
+    cdvd->n_cmd = 0;
+
+    cdvd_set_ready(cdvd);
+    cdvd_set_status(cdvd, CDVD_STATUS_PAUSED);
+
+    cdvd_send_irq(cdvd);
+
+    // I_STAT needs to be set to 3?
+    cdvd->i_stat |= 2;
+}
+
 void cdvd_do_read(void* udata, int overshoot) {
     struct ps2_cdvd* cdvd = (struct ps2_cdvd*)udata;
 
+    // In fast-read mode, wait until the previous batch has been fully
+    // consumed by DMA before fetching the next one
+    int pending = cdvd->fast_read_sectors && cdvd->buf_size;
+
     // Ugly hack!!
     // Some games will send
-    if (!(cdvd->dma->cdvd.chcr & 0x1000000)) {
+    if (!(cdvd->dma->cdvd.chcr & 0x1000000) || pending) {
         // printf("cdvd: CDVD DMA not yet ready\n");
 
         struct sched_event event;
@@ -742,12 +787,30 @@ void cdvd_do_read(void* udata, int overshoot) {
         return;
     }
 
-    // Fetch a sector
-    cdvd_fetch_sector(cdvd);
+    // Fetch a sector, or a batch of them in fast-read mode
+    uint32_t count = 1;
+
+    if (cdvd->fast_read_sectors) {
+        count = cdvd->read_count;
+
+        if (count > (uint32_t)cdvd->fast_read_sectors)
+            count = cdvd->fast_read_sectors;
+
+        if (!count)
+            count = 1;
+    }
+
+    cdvd->buf_size = 0;
+    cdvd->buf_pos = 0;
 
-    // Send sector to DMA
-    cdvd->buf_size = cdvd->read_size;
-    cdvd->read_count--;
+    for (uint32_t i = 0; i < count; i++) {
+        cdvd_fetch_sector(cdvd, cdvd->buf + cdvd->buf_size);
+
+        cdvd->buf_size += cdvd->read_size;
+    }
+
+    // Send sectors to DMA
+    cdvd->read_count -= count;
 
     // printf("cdvd: Sending a sector to DMA (left=%d)\n", cdvd->read_count);
 
@@ -759,7 +822,7 @@ void cdvd_do_read(void* udata, int overshoot) {
         event.name = "CDVD Read";
         event.udata = cdvd;
         event.callback = cdvd_do_read;
-        event.cycles = 1000;
+        event.cycles = cdvd_scale_timing(cdvd, 1000 * count);
 
         sched_schedule(cdvd->sched, event);
 
@@ -768,16 +831,7 @@ void cdvd_do_read(void* udata, int overshoot) {
         return;
     }
 
-    cdvd->n_stat = 0x4e;
-    cdvd->n_cmd = 0;
-
-    cdvd_set_ready(cdvd);
-    cdvd_set_status(cdvd, CDVD_STATUS_PAUSED);
-
-    cdvd_send_irq(cdvd);
-
-    // I_STAT needs to be set to 3?
-    cdvd->i_stat |= 2;
+    cdvd_do_read_end(cdvd, 0);
 }
 
 static inline void cdvd_n_nop(struct ps2_cdvd* cdvd) {
@@ -851,7 +905,7 @@ static inline void cdvd_n_read_cd(struct ps2_cdvd* cdvd) {
     event.name = "CDVD ReadCd";
     event.udata = cdvd;
     event.callback = cdvd_do_read;
-    event.cycles = cdvd_get_cd_read_timing(cdvd, prev_lba);
+    event.cycles = cdvd_scale_timing(cdvd, cdvd_get_cd_read_timing(cdvd, prev_lba));
 
     sched_schedule(cdvd->sched, event);
 
@@ -912,7 +966,7 @@ static inline void cdvd_n_read_dvd(struct ps2_cdvd* cdvd) {
     event.name = "CDVD ReadDvd";
     event.udata = cdvd;
     event.callback = cdvd_do_read;
-    event.cycles = cdvd_get_cd_read_timing(cdvd, prev_lba);
+    event.cycles = cdvd_scale_timing(cdvd, cdvd_get_cd_read_timing(cdvd, prev_lba));
 
     sched_schedule(cdvd->sched, event);
 
@@ -999,6 +1053,7 @@ static inline void cdvd_n_get_toc(struct ps2_cdvd* cdvd) {
     }
 
     cdvd->buf_size = 2064;
+    cdvd->buf_pos = 0;
     cdvd->n_stat = 0x40;
 
     iop_dma_handle_cdvd_transfer(cdvd->dma);
@@ -1330,6 +1385,15 @@ void ps2_cdvd_reset(struct ps2_cdvd* cdvd) {
     cdvd->config_block_index = 0;
     cdvd->s_cmd = 0;
     cdvd->buf_size = 0;
+    cdvd->buf_pos = 0;
+}
+
+void ps2_cdvd_set_fast_read(struct ps2_cdvd* cdvd, int sectors, int speed) {
+    if (sectors > CDVD_FAST_READ_SECTORS)
+        sectors = CDVD_FAST_READ_SECTORS;
+
+    cdvd->fast_read_sectors = sectors > 0 ? sectors : 0;
+    cdvd->fast_read_speed = speed > 0 ? speed : 1;
 }
 
 void ps2_cdvd_set_mechacon_model(struct ps2_cdvd* cdvd, int model) {
@@ -77,6 +77,9 @@ extern "C" {
 #define CDVD_CD_SS_2352 2352
 #define CDVD_DVD_SS 2064
 
+// Maximum number of sectors fetched per read event in fast-read mode
+#define CDVD_FAST_READ_SECTORS 16
+
 struct nvram_layout {
     uint32_t bios_version;   // bios version that this eeprom layout is for
     int32_t config0_offset;   // offset of 1st config block
@@ -125,8 +128,9 @@ struct ps2_cdvd {
     uint8_t cdkey[16];
 
     struct disc_state* disc;
-    uint8_t buf[2352];
+    uint8_t buf[2352 * CDVD_FAST_READ_SECTORS];
     int buf_size;
+    int buf_pos;
 
     // Pending read
     uint32_t read_lba;
@@ -134,6 +138,12 @@ struct ps2_cdvd {
     uint32_t read_size;
     uint8_t read_speed;
 
+    // Fast-read mode, off when fast_read_sectors is 0. Sectors are
+    // read in batches and read/seek timings are divided by
+    // fast_read_speed
+    int fast_read_sectors;
+    int fast_read_speed;
+
     uint8_t nvram[1024];
 
     struct ps2_iop_dma* dma;
@@ -162,6 +172,7 @@ void ps2_cdvd_close(struct ps2_cdvd* cdvd);
 void ps2_cdvd_power_off(struct ps2_cdvd* cdvd);
 int ps2_cdvd_load_nvram(struct ps2_cdvd* cdvd, const char* path);
 void ps2_cdvd_set_mechacon_model(struct ps2_cdvd* cdvd, int model);
+void ps2_cdvd_set_fast_read(struct ps2_cdvd* cdvd, int sectors, int speed);
 uint64_t ps2_cdvd_read8(struct ps2_cdvd* cdvd, uint32_t addr);
 void ps2_cdvd_write8(struct ps2_cdvd* cdvd, uint32_t addr, uint64_t data);
 void ps2_cdvd_reset(struct ps2_cdvd* cdvd);
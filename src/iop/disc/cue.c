@@ -336,8 +336,6 @@ size_t get_file_size(FILE* file) {
 (155 - 190) + 316500 + 390    = 
 */
 
-int prev_pregap = 0;
-
 int init_tracks(cue_file_t* file, uint64_t* lba) {
     node_t* node = list_front(file->tracks);
 
@@ -60,7 +60,7 @@ struct ps2_iop_dma* ps2_iop_dma_create(void) {
     return malloc(sizeof(struct ps2_iop_dma));
 }
 
-void ps2_iop_dma_init(struct ps2_iop_dma* dma, struct ps2_iop_intc* intc, struct ps2_sif* sif, struct ps2_cdvd* cdvd, struct ps2_dmac* ee_dma, struct ps2_sio2* sio2, struct ps2_spu2* spu, struct sched_state* sched, struct iop_bus* bus) {
+void ps2_iop_dma_init(struct ps2_iop_dma* dma, struct ps2_iop_intc* intc, struct ps2_sif* sif, struct ps2_cdvd* cdvd, struct ps2_dmac* ee_dma, struct ps2_sio2* sio2, struct ps2_spu2* spu, struct ps2_speed* speed, struct sched_state* sched, struct iop_bus* bus) {
     memset(dma, 0, sizeof(struct ps2_iop_dma));
 
     dma->intc = intc;
@@ -71,6 +71,7 @@ void ps2_iop_dma_init(struct ps2_iop_dma* dma, struct ps2_iop_intc* intc, struct
     dma->ee_dma = ee_dma;
     dma->sio2 = sio2;
     dma->spu = spu;
+    dma->speed = speed;
 
     dma->dmacinten = 0x01;
 }
@@ -160,14 +161,17 @@ void iop_dma_handle_cdvd_transfer(struct ps2_iop_dma* dma) {
 
     // uint32_t addr = dma->cdvd.madr;
 
-    int i = 0;
+    int size = dma->drive->buf_size;
 
-    while (dma->cdvd.transfer_size && dma->drive->buf_size) {
-        iop_bus_write8(dma->bus, dma->cdvd.madr++, dma->drive->buf[i++]);
+    if (size > dma->cdvd.transfer_size)
+        size = dma->cdvd.transfer_size;
 
-        dma->drive->buf_size--;
-        dma->cdvd.transfer_size--;
-    }
+    iop_bus_write_block(dma->bus, dma->cdvd.madr, dma->drive->buf + dma->drive->buf_pos, size);
+
+    dma->cdvd.madr += size;
+    dma->drive->buf_pos += size;
+    dma->drive->buf_size -= size;
+    dma->cdvd.transfer_size -= size;
 
     // printf("dma: buf_size=%d transfer_size=%d\n",
     //     dma->drive->buf_size,
@@ -378,11 +382,34 @@ void iop_dma_handle_dev9_transfer(struct ps2_iop_dma* dma) {
     // is used to transfer data to and from the Samsung NAND flash
     // storage chip.
 
-    // We'll have to account for this once we implement HDD support, for
-    // now we're defaulting to the System 147/148 behavior, since it
-    // won't be used by any retail games anyways unless the HDD is present.
+    // If the ATA interface has a DMA command in flight we're talking to
+    // the HDD, otherwise default to the System 147/148 behavior.
+    struct ps2_ata* ata = dma->speed->ata;
+    int xfer = ps2_ata_dma_pending(ata);
+
+    while (xfer && dma->dev9.transfer_size) {
+        uint32_t size;
+        uint8_t* buf = ps2_ata_dma_get_buffer(ata, &size);
+
+        if (!size)
+            break;
+
+        if (size > (uint32_t)dma->dev9.transfer_size)
+            size = dma->dev9.transfer_size;
+
+        if (xfer == ATA_XFER_DMA_IN) {
+            iop_bus_write_block(dma->bus, dma->dev9.madr, buf, size);
+        } else {
+            iop_bus_read_block(dma->bus, dma->dev9.madr, buf, size);
+        }
+
+        dma->dev9.madr += size;
+        dma->dev9.transfer_size -= size;
 
-    while (dma->dev9.transfer_size) {
+        ps2_ata_dma_advance(ata, size);
+    }
+
+    while (!xfer && dma->dev9.transfer_size) {
         uint32_t d = iop_bus_read8(dma->bus, 0x14000008);
 
         iop_bus_write8(dma->bus, dma->dev9.madr++, d);
@@ -395,6 +422,26 @@ void iop_dma_handle_dev9_transfer(struct ps2_iop_dma* dma) {
 
     dma->dev9.chcr &= ~0x1000000;
 }
+// Copy the current SIF0 packet straight into EE memory. This only
+// happens if the EE channel is waiting for data and the packet is
+// contiguous in IOP memory, returns 0 otherwise
+static inline int iop_dma_sif0_direct(struct ps2_iop_dma* dma, uint128_t tag) {
+    uint32_t size = dma->sif0.size * 4;
+
+    const void* ptr = iop_bus_get_span(dma->bus, dma->sif0.addr, &size, 0);
+
+    if (!ptr || (size != (dma->sif0.size * 4)))
+        return 0;
+
+    if (!dmac_sif0_direct(dma->ee_dma, tag, ptr, dma->sif0.size >> 2))
+        return 0;
+
+    dma->sif0.addr += size;
+    dma->sif0.size = 0;
+
+    return 1;
+}
+
 void iop_dma_handle_sif0_transfer(struct ps2_iop_dma* dma) {
     // if (!ps2_sif0_is_empty(dma->sif)) {
     //     printf("iopdma: SIF FIFO not empty\n");
@@ -421,19 +468,33 @@ void iop_dma_handle_sif0_transfer(struct ps2_iop_dma* dma) {
             q.u32[2] = iop_bus_read32(dma->bus, dma->sif0.tadr + 0);
             q.u32[3] = iop_bus_read32(dma->bus, dma->sif0.tadr + 4);
 
-            ps2_sif0_write(dma->sif, q);
+            // Hand the packet straight to the EE if it's waiting for it
+            if (!iop_dma_sif0_direct(dma, q))
+                ps2_sif0_write(dma->sif, q);
         }
 
         while (dma->sif0.size) {
-            q.u32[0] = iop_bus_read32(dma->bus, dma->sif0.addr);
-            q.u32[1] = iop_bus_read32(dma->bus, dma->sif0.addr + 4);
-            q.u32[2] = iop_bus_read32(dma->bus, dma->sif0.addr + 8);
-            q.u32[3] = iop_bus_read32(dma->bus, dma->sif0.addr + 12);
+            uint32_t len = dma->sif0.size * 4;
+
+            const void* ptr = iop_bus_get_span(dma->bus, dma->sif0.addr, &len, 0);
 
-            ps2_sif0_write(dma->sif, q);
+            if (ptr && (len >= 16)) {
+                len &= ~15;
+
+                ps2_sif0_write_block(dma->sif, ptr, len >> 4);
+            } else {
+                q.u32[0] = iop_bus_read32(dma->bus, dma->sif0.addr);
+                q.u32[1] = iop_bus_read32(dma->bus, dma->sif0.addr + 4);
+                q.u32[2] = iop_bus_read32(dma->bus, dma->sif0.addr + 8);
+                q.u32[3] = iop_bus_read32(dma->bus, dma->sif0.addr + 12);
+
+                ps2_sif0_write(dma->sif, q);
+
+                len = 16;
+            }
 
-            dma->sif0.addr += 16;
-            dma->sif0.size -= 4;
+            dma->sif0.addr += len;
+            dma->sif0.size -= len >> 2;
         }
 
         dma->sif0.tadr += (dma->sif0.extra ? 4 : 2) * 4;
@@ -450,12 +511,65 @@ void iop_dma_handle_sif0_transfer(struct ps2_iop_dma* dma) {
 
 #include "rpc.h"
 
+static inline void iop_dma_sif1_end(struct ps2_iop_dma* dma) {
+    iop_dma_set_dicr_flag(dma, IOP_DMA_SIF1);
+    iop_dma_check_irq(dma);
+
+    // ps2_sif1_reset(dma->sif);
+
+    dma->sif1.chcr &= ~0x1000000;
+    dma->sif1.transfer_pending = 0;
+}
+
+int iop_dma_sif1_direct(struct ps2_iop_dma* dma, const void* data, uint32_t qwc) {
+    if (!(dma->sif1.chcr & 0x1000000) || !ps2_sif1_is_empty(dma->sif) || !qwc)
+        return 0;
+
+    // Decrementing MADR goes through the FIFO
+    if ((dma->sif1.chcr >> 1) & 1)
+        return 0;
+
+    uint64_t tag;
+
+    memcpy(&tag, data, sizeof(uint64_t));
+
+    uint32_t addr = tag & 0x7fffff;
+    uint32_t size = (tag >> 32) & 0xffffff;
+    int irq = !!(tag & 0x40000000);
+    int eot = !!(tag & 0x80000000);
+
+    // The packet has to hold exactly one IOP tag and its data
+    if (size != ((qwc - 1) * 4))
+        return 0;
+
+    iop_bus_write_block(dma->bus, addr, (const uint8_t*)data + 16, size * 4);
+
+    // Send interrupt on tag IRQ (regardless of channel IRQ enable)
+    if ((dma->dicr2 & 0x400) && irq) {
+        ps2_iop_intc_irq(dma->intc, IOP_INTC_DMA);
+    }
+
+    // The channel is stopped once the EE is done sending, or right
+    // away on EOT
+    dma->sif1.transfer_pending = 1;
+
+    if (eot)
+        iop_dma_sif1_end(dma);
+
+    return 1;
+}
+
 void iop_dma_handle_sif1_transfer(struct ps2_iop_dma* dma) {
     int madr_increment = ((dma->sif1.chcr >> 1) & 1) ? -4 : 4;
 
     // No data in the SIF FIFO yet
-    if (ps2_sif1_is_empty(dma->sif))
+    if (ps2_sif1_is_empty(dma->sif)) {
+        // Everything the EE sent went through the direct path
+        if (dma->sif1.transfer_pending)
+            iop_dma_sif1_end(dma);
+
         return;
+    }
 
     // Data ready but channel isn't ready yet, keep waiting
     if (!(dma->sif1.chcr & 0x1000000)) {
@@ -479,10 +593,27 @@ void iop_dma_handle_sif1_transfer(struct ps2_iop_dma* dma) {
 
         // printf("iop: SIF1 tag read_index=%\n", dma->sif->sif1.read_index);
 
-        char buf[128];
+        // char buf[128];
+
+        // if (rpc_decode_packet(dma->intc->iop, buf, ...)) {
+        //     printf("%s\n", buf);
+        // }
+
+        // Copy whole qwords straight into IOP memory
+        while ((madr_increment > 0) && (size >= 4)) {
+            uint32_t len = size * 4;
+
+            void* ptr = iop_bus_get_span(dma->bus, addr, &len, 1);
+
+            if (!ptr || (len < 16))
+                break;
 
-        if (rpc_decode_packet(dma->intc->iop, buf, ((void*)dma->sif->sif1.data) + (dma->sif->sif1.read_index * 16))) {
-            // printf("%s\n", buf);
+            len &= ~15;
+
+            ps2_sif1_read_block(dma->sif, ptr, len >> 4);
+
+            addr += len;
+            size -= len >> 2;
         }
 
         while (size) {
@@ -505,12 +636,7 @@ void iop_dma_handle_sif1_transfer(struct ps2_iop_dma* dma) {
             break;
     } while (!eot);
 
-    iop_dma_set_dicr_flag(dma, IOP_DMA_SIF1);
-    iop_dma_check_irq(dma);
-
-    // ps2_sif1_reset(dma->sif);
-
-    dma->sif1.chcr &= ~0x1000000;
+    iop_dma_sif1_end(dma);
 }
 void iop_dma_handle_sio2_in_transfer(struct ps2_iop_dma* dma) {
     uint32_t size = (dma->sio2_in.bcr & 0xffff) * (dma->sio2_in.bcr >> 16);
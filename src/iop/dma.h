@@ -10,6 +10,7 @@ extern "C" {
 #include "u128.h"
 
 #include "shared/sif.h"
+#include "shared/speed.h"
 
 #include "intc.h"
 #include "cdvd.h"
@@ -82,11 +83,12 @@ struct ps2_iop_dma {
     struct ps2_dmac* ee_dma;
     struct ps2_sio2* sio2;
     struct ps2_spu2* spu;
+    struct ps2_speed* speed;
     struct sched_state* sched;
 };
 
 struct ps2_iop_dma* ps2_iop_dma_create(void);
-void ps2_iop_dma_init(struct ps2_iop_dma* dma, struct ps2_iop_intc* intc, struct ps2_sif* sif, struct ps2_cdvd* cdvd, struct ps2_dmac* ee_dma, struct ps2_sio2* sio2, struct ps2_spu2* spu, struct sched_state* sched, struct iop_bus* bus);
+void ps2_iop_dma_init(struct ps2_iop_dma* dma, struct ps2_iop_intc* intc, struct ps2_sif* sif, struct ps2_cdvd* cdvd, struct ps2_dmac* ee_dma, struct ps2_sio2* sio2, struct ps2_spu2* spu, struct ps2_speed* speed, struct sched_state* sched, struct iop_bus* bus);
 void ps2_iop_dma_destroy(struct ps2_iop_dma* dma);
 uint64_t ps2_iop_dma_read16(struct ps2_iop_dma* dma, uint32_t addr);
 void ps2_iop_dma_write16(struct ps2_iop_dma* dma, uint32_t addr, uint64_t data);
@@ -103,6 +105,7 @@ void iop_dma_handle_spu2_transfer(struct ps2_iop_dma* dma);
 void iop_dma_handle_dev9_transfer(struct ps2_iop_dma* dma);
 void iop_dma_handle_sif0_transfer(struct ps2_iop_dma* dma);
 void iop_dma_handle_sif1_transfer(struct ps2_iop_dma* dma);
+int iop_dma_sif1_direct(struct ps2_iop_dma* dma, const void* data, uint32_t qwc);
 void iop_dma_handle_sio2_in_transfer(struct ps2_iop_dma* dma);
 void iop_dma_handle_sio2_out_transfer(struct ps2_iop_dma* dma);
 void iop_dma_end_sio2_out_transfer(struct ps2_iop_dma* dma);
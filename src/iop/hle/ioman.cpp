@@ -1,6 +1,7 @@
 #include <filesystem>
 #include <cstdlib>
 #include <cstdio>
+#include <cstring>
 #include <string>
 
 #include "ioman.h"
@@ -45,6 +46,18 @@
 std::string ioman_read_string(struct iop_state* iop, uint32_t addr) {
     std::string str;
 
+    uint32_t len = 256;
+    const char* span = (const char*)iop_get_span(iop, addr, &len, 0);
+
+    // Strings are almost always in RAM, only fall back to the bus when
+    // the string isn't fully inside a span
+    if (span) {
+        const char* end = (const char*)memchr(span, 0, len);
+
+        if (end)
+            return std::string(span, end - span);
+    }
+
     for (int i = 0; i < 256; i++) {
         uint8_t d = iop_read8(iop, addr + i);
 
@@ -58,11 +71,7 @@ std::string ioman_read_string(struct iop_state* iop, uint32_t addr) {
 }
 
 void ioman_read_ptr(struct iop_state* iop, uint32_t addr, void* buf, int size) {
-    unsigned char* ptr = (unsigned char*)buf;
-
-    for (int i = 0; i < size; i++) {
-        ptr[i] = iop_read8(iop, addr + i);
-    }
+    iop_read_block(iop, addr, buf, size);
 }
 
 struct iomanx_stat {
@@ -97,12 +106,34 @@ struct ioman_dirent {
 struct ioman_hle_state {
     FILE* files[IOMAN_MAX_OPEN_FILES] = { nullptr };
     ioman_dirent directories[IOMAN_MAX_OPEN_FILES] = { nullptr };
-} state;
+};
+
+// Each IOP gets its own file table, created on first use
+static inline ioman_hle_state* ioman_get_state(struct iop_state* iop) {
+    if (!iop->ioman)
+        iop->ioman = new ioman_hle_state;
+
+    return iop->ioman;
+}
+
+extern "C" void ioman_destroy(struct ioman_hle_state* state) {
+    if (!state)
+        return;
+
+    for (int i = 0; i < IOMAN_MAX_OPEN_FILES; i++) {
+        if (state->files[i])
+            fclose(state->files[i]);
+
+        delete state->directories[i].path;
+    }
+
+    delete state;
+}
 
-static inline int ioman_allocate_file(FILE* file) {
+static inline int ioman_allocate_file(ioman_hle_state* state, FILE* file) {
     for (int i = 0; i < IOMAN_MAX_OPEN_FILES; i++) {
-        if (!state.files[i]) {
-            state.files[i] = file;
+        if (!state->files[i]) {
+            state->files[i] = file;
 
             return i;
         }
@@ -112,10 +143,10 @@ static inline int ioman_allocate_file(FILE* file) {
     return -1;
 }
 
-static inline int ioman_allocate_directory(std::filesystem::path path) {
+static inline int ioman_allocate_directory(ioman_hle_state* state, std::filesystem::path path) {
     for (int i = 0; i < IOMAN_MAX_OPEN_FILES; i++) {
-        if (!state.directories[i].path) {
-            state.directories[i].path = new std::filesystem::path(path);
+        if (!state->directories[i].path) {
+            state->directories[i].path = new std::filesystem::path(path);
 
             return i;
         }
@@ -240,7 +271,7 @@ extern "C" int ioman_open(struct iop_state* iop, int iomanx) {
 
     printf("%s: Opened \'%s\'\n", iomanx ? "iomanx" : "ioman", absolute.string().c_str());
 
-    int slot = ioman_allocate_file(file);
+    int slot = ioman_allocate_file(ioman_get_state(iop), file);
 
     // Return file handle
     iop_return(iop, 0x100 + slot);
@@ -248,6 +279,8 @@ extern "C" int ioman_open(struct iop_state* iop, int iomanx) {
     return 1;
 }
 extern "C" int ioman_close(struct iop_state* iop, int iomanx) {
+    ioman_hle_state* state = ioman_get_state(iop);
+
     uint32_t fd = iop->r[4];
 
     if (!(fd >= 0x100 && fd < 0x140))
@@ -255,16 +288,18 @@ extern "C" int ioman_close(struct iop_state* iop, int iomanx) {
 
     fd -= 0x100;
 
-    if (state.files[fd])
-        fclose(state.files[fd]);
+    if (state->files[fd])
+        fclose(state->files[fd]);
 
-    state.files[fd] = nullptr;
+    state->files[fd] = nullptr;
 
     iop_return(iop, 0);
 
     return 1;
 }
 extern "C" int ioman_read(struct iop_state* iop, int iomanx) {
+    ioman_hle_state* state = ioman_get_state(iop);
+
     uint32_t fd = iop->r[4];
 
     if (!(fd >= 0x100 && fd < 0x140))
@@ -272,27 +307,43 @@ extern "C" int ioman_read(struct iop_state* iop, int iomanx) {
 
     fd -= 0x100;
 
-    if (!state.files[fd])
+    if (!state->files[fd])
         return 0;
     
     uint32_t ptr = iop->r[5];
     uint32_t size = iop->r[6];
+    uint32_t ret = 0;
 
-    uint8_t* buf = (uint8_t*)malloc(size);
+    // Read straight into IOP memory
+    while (ret < size) {
+        uint32_t len = size - ret;
+        void* span = iop_get_span(iop, ptr + ret, &len, 1);
 
-    int ret = fread(buf, 1, size, state.files[fd]);
+        if (!span) {
+            uint8_t* buf = (uint8_t*)malloc(len);
 
-    for (int i = 0; i < size; i++) {
-        iop_write8(iop, ptr + i, buf[i]);
-    }
+            len = fread(buf, 1, len, state->files[fd]);
+
+            iop_write_block(iop, ptr + ret, buf, len);
+
+            free(buf);
+        } else {
+            len = fread(span, 1, len, state->files[fd]);
+        }
+
+        ret += len;
 
-    free(buf);
+        if (!len)
+            break;
+    }
 
     iop_return(iop, ret);
 
     return 1;
 }
 extern "C" int ioman_write(struct iop_state* iop, int iomanx) {
+    ioman_hle_state* state = ioman_get_state(iop);
+
     uint32_t fd = iop->r[4];
 
     // We only use this to HLE IOMAN stdout writes
@@ -304,7 +355,7 @@ extern "C" int ioman_write(struct iop_state* iop, int iomanx) {
     if (fd >= 0x100 && fd < 0x140) {
         fd -= 0x100;
 
-        if (!state.files[fd])
+        if (!state->files[fd])
             return 0;
 
         uint32_t ptr = iop->r[5];
@@ -312,11 +363,9 @@ extern "C" int ioman_write(struct iop_state* iop, int iomanx) {
 
         uint8_t* buf = (uint8_t*)malloc(size);
 
-        for (int i = 0; i < size; i++) {
-            buf[i] = iop_read8(iop, ptr + i);
-        }
+        iop_read_block(iop, ptr, buf, size);
 
-        int ret = fwrite(buf, 1, size, state.files[fd]);
+        int ret = fwrite(buf, 1, size, state->files[fd]);
 
         free(buf);
 
@@ -347,6 +396,8 @@ extern "C" int ioman_write(struct iop_state* iop, int iomanx) {
     return 0;
 }
 extern "C" int ioman_lseek(struct iop_state* iop, int iomanx) {
+    ioman_hle_state* state = ioman_get_state(iop);
+
     uint32_t fd = iop->r[4];
 
     if (!(fd >= 0x100 && fd < 0x140))
@@ -354,19 +405,19 @@ extern "C" int ioman_lseek(struct iop_state* iop, int iomanx) {
 
     fd -= 0x100;
 
-    if (!state.files[fd])
+    if (!state->files[fd])
         return 0;
 
     int32_t off = iop->r[5];
     uint32_t whence = iop->r[6];
 
     switch (whence) {
-        case 0: fseek(state.files[fd], off, SEEK_SET); break;
-        case 1: fseek(state.files[fd], off, SEEK_CUR); break;
-        case 2: fseek(state.files[fd], off, SEEK_END); break;
+        case 0: fseek(state->files[fd], off, SEEK_SET); break;
+        case 1: fseek(state->files[fd], off, SEEK_CUR); break;
+        case 2: fseek(state->files[fd], off, SEEK_END); break;
     }
 
-    int ret = ftell(state.files[fd]);
+    int ret = ftell(state->files[fd]);
 
     iop_return(iop, ret);
 
@@ -400,7 +451,7 @@ extern "C" int ioman_dopen(struct iop_state* iop, int iomanx) {
         return 0;
     }
 
-    int slot = ioman_allocate_directory(absolute);
+    int slot = ioman_allocate_directory(ioman_get_state(iop), absolute);
 
     if (slot == -1)
         return 0;
@@ -412,6 +463,8 @@ extern "C" int ioman_dopen(struct iop_state* iop, int iomanx) {
     return 1;
 }
 extern "C" int ioman_dclose(struct iop_state* iop, int iomanx) {
+    ioman_hle_state* state = ioman_get_state(iop);
+
     uint32_t fd = iop->r[4];
 
     if (!(fd >= 0x140 && fd < 0x180))
@@ -419,17 +472,19 @@ extern "C" int ioman_dclose(struct iop_state* iop, int iomanx) {
 
     fd -= 0x140;
 
-    if (state.directories[fd].path)
-        delete state.directories[fd].path;
+    if (state->directories[fd].path)
+        delete state->directories[fd].path;
 
-    state.directories[fd].path = nullptr;
-    state.directories[fd].index = 0;
+    state->directories[fd].path = nullptr;
+    state->directories[fd].index = 0;
 
     iop_return(iop, 0);
 
     return 1;
 }
 extern "C" int ioman_dread(struct iop_state* iop, int iomanx) {
+    ioman_hle_state* state = ioman_get_state(iop);
+
     uint32_t fd = iop->r[4];
     uint32_t ptr = iop->r[5];
 
@@ -438,10 +493,10 @@ extern "C" int ioman_dread(struct iop_state* iop, int iomanx) {
 
     fd -= 0x140;
 
-    if (!state.directories[fd].path)
+    if (!state->directories[fd].path)
         return 0;
 
-    ioman_dirent* dir = &state.directories[fd];
+    ioman_dirent* dir = &state->directories[fd];
 
     std::filesystem::directory_entry entry;
 
@@ -473,9 +528,7 @@ extern "C" int ioman_dread(struct iop_state* iop, int iomanx) {
 
     dirent.name[255] = '\0';
 
-    for (int i = 0; i < sizeof(dirent); i++) {
-        iop_write8(iop, ptr + i, ((uint8_t*)&dirent)[i]);
-    }
+    iop_write_block(iop, ptr, &dirent, sizeof(dirent));
 
     printf("%s: dread index=%d name=%s\n", iomanx ? "iomanx" : "ioman", dir->index, dirent.name);
 
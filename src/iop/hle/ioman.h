@@ -25,6 +25,7 @@
 extern "C" {
 #endif
 
+void ioman_destroy(struct ioman_hle_state* state);
 int ioman_open(struct iop_state* iop, int iomanx);
 int ioman_close(struct iop_state* iop, int iomanx);
 int ioman_read(struct iop_state* iop, int iomanx);
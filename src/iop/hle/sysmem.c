@@ -3,10 +3,8 @@
 #define SM_PUTCHAR(c) \
     iop->sm_putchar(iop->sm_putchar_udata, c);
 
-int reg_index = 0;
-
-uint32_t fetch_next_param(struct iop_state* iop) {
-    return iop->r[5 + reg_index++];
+static inline uint32_t fetch_next_param(struct iop_state* iop, int* reg_index) {
+    return iop->r[5 + (*reg_index)++];
 }
 
 int sysmem_kprintf(struct iop_state* iop) {
@@ -15,7 +13,7 @@ int sysmem_kprintf(struct iop_state* iop) {
 
     int ptr = iop->r[4];
 
-    reg_index = 5;
+    int reg_index = 5;
 
     char c = iop_read8(iop, ptr++);
 
@@ -31,13 +29,13 @@ int sysmem_kprintf(struct iop_state* iop) {
 
                 switch (c) {
                     case 'c': {
-                        char ch = fetch_next_param(iop) & 0xff;
+                        char ch = fetch_next_param(iop, &reg_index) & 0xff;
 
                         SM_PUTCHAR(ch);
                     } break;
 
                     case 's': {
-                        uint32_t str_addr = fetch_next_param(iop);
+                        uint32_t str_addr = fetch_next_param(iop, &reg_index);
                         char ch = iop_read8(iop, str_addr++);
 
                         while (ch != 0) {
@@ -62,7 +60,7 @@ int sysmem_kprintf(struct iop_state* iop) {
                     } break;
 
                     case 'd': case 'u': case 'i': case 'x': case 'X':{
-                        uint32_t val = fetch_next_param(iop);
+                        uint32_t val = fetch_next_param(iop, &reg_index);
 
                         char fmt_buf[8];
                         char* fmt = fmt_buf;
@@ -5,6 +5,7 @@
 #include "iop_dis.h"
 
 #include "iop_export.h"
+#include "hle/ioman.h"
 
 // static int p = 0;
 
@@ -75,6 +76,63 @@ void iop_write32(struct iop_state* iop, uint32_t addr, uint32_t data) {
     iop->bus.write32(iop->bus.udata, iop_translate_addr(addr), data);
 }
 
+// Get a host pointer to the IOP memory at addr, see iop_bus_get_span.
+// Spans are also split at KSEG boundaries since each segment translates
+// differently
+void* iop_get_span(struct iop_state* iop, uint32_t addr, uint32_t* size, int write) {
+    uint32_t len = 0x20000000 - (addr & 0x1fffffff);
+
+    if (*size > len)
+        *size = len;
+
+    if (!iop->bus.get_span)
+        return NULL;
+
+    return iop->bus.get_span(iop->bus.udata, iop_translate_addr(addr), size, write);
+}
+
+// Copy between the host and IOP memory, going straight to RAM where
+// possible
+void iop_read_block(struct iop_state* iop, uint32_t addr, void* buf, uint32_t size) {
+    uint8_t* dst = (uint8_t*)buf;
+
+    while (size) {
+        uint32_t len = size;
+        uint8_t* ptr = (uint8_t*)iop_get_span(iop, addr, &len, 0);
+
+        if (ptr) {
+            memcpy(dst, ptr, len);
+        } else {
+            for (uint32_t i = 0; i < len; i++)
+                dst[i] = iop_read8(iop, addr + i);
+        }
+
+        addr += len;
+        dst += len;
+        size -= len;
+    }
+}
+
+void iop_write_block(struct iop_state* iop, uint32_t addr, const void* buf, uint32_t size) {
+    const uint8_t* src = (const uint8_t*)buf;
+
+    while (size) {
+        uint32_t len = size;
+        uint8_t* ptr = (uint8_t*)iop_get_span(iop, addr, &len, 1);
+
+        if (ptr) {
+            memcpy(ptr, src, len);
+        } else {
+            for (uint32_t i = 0; i < len; i++)
+                iop_write8(iop, addr + i, src[i]);
+        }
+
+        addr += len;
+        src += len;
+        size -= len;
+    }
+}
+
 static const uint32_t g_iop_cop0_write_mask_table[] = {
     0x00000000, // cop0r0   - N/A
     0x00000000, // cop0r1   - N/A
@@ -122,13 +180,16 @@ static const uint32_t g_iop_cop0_write_mask_table[] = {
     iop->next_pc = iop->next_pc + (offset); \
     iop->next_pc = iop->next_pc - 4; \
     iop->branch = 1; \
-    iop->branch_taken = 1; }
+    iop->branch_taken = 1; \
+    if ((offset) < 0) iop_test_idle_loop(iop, iop->next_pc, iop->pc - 4); }
 
 struct iop_state* iop_create(void) {
     return (struct iop_state*)malloc(sizeof(struct iop_state));
 }
 
 void iop_destroy(struct iop_state* iop) {
+    ioman_destroy(iop->ioman);
+
     free(iop);
 }
 
@@ -141,6 +202,8 @@ void iop_init(struct iop_state* iop, struct iop_bus_s bus) {
 
     iop->cop0_r[COP0_SR] = 0x10900000;
     iop->cop0_r[COP0_PRID] = 0x0000001f;
+
+    memset(iop->breakpoints, 0xff, sizeof(iop->breakpoints));
 }
 
 void iop_init_kputchar(struct iop_state* iop, void (*kputchar)(void*, char), void* udata) {
@@ -158,6 +221,216 @@ static inline int iop_check_irq(struct iop_state* iop) {
            (iop->cop0_r[COP0_SR] & iop->cop0_r[COP0_CAUSE] & 0x00000400);
 }
 
+// Get the GPRs read and written by instructions that are allowed
+// inside an idle loop. Stores, links, traps and coprocessor accesses
+// disqualify the loop
+static inline int iop_get_idle_regs(uint32_t opcode, int* branch, uint32_t* r, uint32_t* w) {
+    uint32_t rs = 1u << ((opcode >> 21) & 0x1f);
+    uint32_t rt = 1u << ((opcode >> 16) & 0x1f);
+    uint32_t rd = 1u << ((opcode >> 11) & 0x1f);
+
+    *branch = 0;
+    *r = 0;
+    *w = 0;
+
+    switch (opcode >> 26) {
+        case 0x00: {
+            switch (opcode & 0x3f) {
+                case 0x00: case 0x02: case 0x03:
+                    *r = rt; *w = rd; break;
+                case 0x04: case 0x06: case 0x07:
+                case 0x21: case 0x23: case 0x24: case 0x25:
+                case 0x26: case 0x27: case 0x2a: case 0x2b:
+                    *r = rs | rt; *w = rd; break;
+                default:
+                    return 0;
+            }
+        } break;
+
+        // bltz/bgez, the linking variants write $ra
+        case 0x01: {
+            if (((opcode >> 16) & 0x1f) > 1)
+                return 0;
+
+            *r = rs; *branch = 1;
+        } break;
+
+        case 0x02: *branch = 1; break;
+        case 0x04: case 0x05: *r = rs | rt; *branch = 1; break;
+        case 0x06: case 0x07: *r = rs; *branch = 1; break;
+        case 0x09: case 0x0a: case 0x0b: case 0x0c: case 0x0d: case 0x0e:
+        case 0x20: case 0x21: case 0x23: case 0x24: case 0x25:
+            *r = rs; *w = rt; break;
+        case 0x0f: *w = rt; break;
+        default:
+            return 0;
+    }
+
+    *r &= ~1u;
+    *w &= ~1u;
+
+    return 1;
+}
+
+// Same analysis as the EE, a loop is idle if it has no stores and no
+// register is carried from one iteration to the next
+static inline int iop_is_idle_loop(struct iop_state* iop, uint32_t start, uint32_t branch, uint32_t* code) {
+    uint32_t n = ((branch - start) >> 2) + 2;
+
+    if (n > IOP_IDLE_MAX_INSTRUCTIONS)
+        return 0;
+
+    uint32_t r[IOP_IDLE_MAX_INSTRUCTIONS];
+    uint32_t w[IOP_IDLE_MAX_INSTRUCTIONS];
+    uint32_t written = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        int is_branch;
+        uint32_t opcode = iop_bus_read32(iop, start + (i << 2));
+
+        code[i] = opcode;
+
+        if (!iop_get_idle_regs(opcode, &is_branch, &r[i], &w[i]))
+            return 0;
+
+        if (is_branch && i != n - 2)
+            return 0;
+
+        written |= w[i];
+    }
+
+    uint32_t defined = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (r[i] & written & ~defined)
+            return 0;
+
+        defined |= w[i];
+    }
+
+    return 1;
+}
+
+static inline int iop_idle_code_matches(struct iop_state* iop, struct iop_idle_entry* entry) {
+    uint32_t n = ((entry->branch - entry->start) >> 2) + 2;
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (iop_bus_read32(iop, entry->start + (i << 2)) != entry->code[i])
+            return 0;
+    }
+
+    return 1;
+}
+
+// Loads in an idle loop must read RAM or ROM, polling an I/O register
+// could have side effects. Addresses depend on register values, so this
+// runs every time the loop is about to be skipped. Bases can be registers
+// the loop doesn't write or constants built with lui/addiu/ori inside it,
+// anything else is unknown and disqualifies the loop
+static inline int iop_idle_loads_ok(struct iop_state* iop, struct iop_idle_entry* entry) {
+    uint32_t n = ((entry->branch - entry->start) >> 2) + 2;
+    uint32_t val[32];
+    uint32_t written = 0;
+    uint32_t r, w;
+    int branch;
+
+    for (uint32_t i = 0; i < n; i++) {
+        iop_get_idle_regs(entry->code[i], &branch, &r, &w);
+
+        written |= w;
+    }
+
+    memcpy(val, iop->r, sizeof(val));
+
+    uint32_t known = ~written;
+
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t opcode = entry->code[i];
+        uint32_t op = opcode >> 26;
+        uint32_t rs = (opcode >> 21) & 0x1f;
+        uint32_t rt = (opcode >> 16) & 0x1f;
+        uint32_t imm = (uint32_t)(int16_t)(opcode & 0xffff);
+
+        iop_get_idle_regs(opcode, &branch, &r, &w);
+
+        // lb, lh, lw, lbu, lhu
+        if (op >= 0x20 && op <= 0x25) {
+            uint32_t size = 4;
+
+            if (!(known & (1u << rs)))
+                return 0;
+
+            if (!iop_get_span(iop, val[rs] + imm, &size, 0))
+                return 0;
+        }
+
+        if (!w)
+            continue;
+
+        if (op == 0x0f) {
+            val[rt] = opcode << 16;
+        } else if (op == 0x09 && (known & (1u << rs))) {
+            val[rt] = val[rs] + imm;
+        } else if (op == 0x0d && (known & (1u << rs))) {
+            val[rt] = val[rs] | (opcode & 0xffff);
+        } else {
+            known &= ~w;
+
+            continue;
+        }
+
+        known |= w;
+    }
+
+    return 1;
+}
+
+static inline void iop_test_idle_loop(struct iop_state* iop, uint32_t start, uint32_t branch) {
+    struct iop_idle_entry* entry = &iop->idle_cache[((start ^ branch) >> 2) & (IOP_IDLE_CACHE_SIZE - 1)];
+
+    // Only idle verdicts need checking, a stale non-idle one just
+    // misses a skip
+    int stale = entry->start != start || entry->branch != branch ||
+                (entry->idle && !iop_idle_code_matches(iop, entry));
+
+    if (stale) {
+        entry->start = start;
+        entry->branch = branch;
+        entry->idle = iop_is_idle_loop(iop, start, branch, entry->code);
+
+        iop->idle_loops += entry->idle;
+    }
+
+    if (!entry->idle || !iop_idle_loads_ok(iop, entry))
+        return;
+
+    iop->idle = 1;
+    iop->idle_pc = start;
+}
+
+// Returns 1 if the cycle can be skipped because we're sitting at the
+// head of an idle loop with nothing pending
+static inline int iop_test_idle(struct iop_state* iop) {
+    // The delay slot still needs to run
+    if (iop->branch)
+        return 0;
+
+    if (iop->pc != iop->idle_pc || iop_check_irq(iop)) {
+        iop->idle = 0;
+
+        return 0;
+    }
+
+    iop->idle_cycles++;
+    iop->total_cycles++;
+
+    return 1;
+}
+
+void iop_wake(struct iop_state* iop) {
+    iop->idle = 0;
+}
+
 static inline void iop_print_disassembly(struct iop_state* iop) {
     char buf[128];
     struct iop_dis_state state;
@@ -196,7 +469,46 @@ static inline void iop_exception(struct iop_state* iop, uint32_t cause) {
     iop->next_pc = iop->pc + 4;
 }
 
+static inline int iop_breakpoint_slot(struct iop_state* iop, uint32_t addr) {
+    int slot = (addr >> 2) & (IOP_BREAKPOINT_SLOTS - 1);
+
+    while (iop->breakpoints[slot] != IOP_BREAKPOINT_EMPTY) {
+        if (iop->breakpoints[slot] == addr)
+            return slot;
+
+        slot = (slot + 1) & (IOP_BREAKPOINT_SLOTS - 1);
+    }
+
+    return slot;
+}
+
+static inline int iop_test_breakpoint(struct iop_state* iop) {
+    // Stall until the frontend acknowledges the hit
+    if (iop->breakpoint_hit)
+        return 1;
+
+    if (iop->breakpoint_skip) {
+        iop->breakpoint_skip = 0;
+
+        return 0;
+    }
+
+    if (iop->breakpoints[iop_breakpoint_slot(iop, iop->pc)] != iop->pc)
+        return 0;
+
+    iop->breakpoint_hit = 1;
+    iop->breakpoint_skip = 1;
+
+    return 1;
+}
+
 void iop_cycle(struct iop_state* iop) {
+    if (iop->breakpoint_count && iop_test_breakpoint(iop))
+        return;
+
+    if (iop->idle && iop_test_idle(iop))
+        return;
+
     iop->last_cycles = 0;
 
     iop->saved_pc = iop->pc;
@@ -267,6 +579,69 @@ void iop_reset(struct iop_state* iop) {
     iop->branch = 0;
     iop->delay_slot = 0;
     iop->branch_taken = 0;
+    iop->breakpoint_hit = 0;
+    iop->breakpoint_skip = 0;
+    iop->idle = 0;
+
+    memset(iop->idle_cache, 0, sizeof(iop->idle_cache));
+}
+
+int iop_set_breakpoint(struct iop_state* iop, uint32_t addr) {
+    int slot = iop_breakpoint_slot(iop, addr);
+
+    if (iop->breakpoints[slot] == addr)
+        return 1;
+
+    // Keep at least one empty slot so lookups always terminate
+    if (iop->breakpoint_count == IOP_BREAKPOINT_SLOTS - 1)
+        return 0;
+
+    iop->breakpoints[slot] = addr;
+    iop->breakpoint_count++;
+
+    return 1;
+}
+
+void iop_remove_breakpoint(struct iop_state* iop, uint32_t addr) {
+    int slot = iop_breakpoint_slot(iop, addr);
+
+    if (iop->breakpoints[slot] != addr)
+        return;
+
+    iop->breakpoints[slot] = IOP_BREAKPOINT_EMPTY;
+    iop->breakpoint_count--;
+
+    // Only forget the pending resume if it was for this breakpoint
+    if (addr == iop->pc)
+        iop->breakpoint_skip = 0;
+
+    // Reinsert the rest of the cluster so probing doesn't stop early
+    slot = (slot + 1) & (IOP_BREAKPOINT_SLOTS - 1);
+
+    while (iop->breakpoints[slot] != IOP_BREAKPOINT_EMPTY) {
+        uint32_t entry = iop->breakpoints[slot];
+
+        iop->breakpoints[slot] = IOP_BREAKPOINT_EMPTY;
+        iop->breakpoints[iop_breakpoint_slot(iop, entry)] = entry;
+
+        slot = (slot + 1) & (IOP_BREAKPOINT_SLOTS - 1);
+    }
+}
+
+void iop_clear_breakpoints(struct iop_state* iop) {
+    memset(iop->breakpoints, 0xff, sizeof(iop->breakpoints));
+
+    iop->breakpoint_count = 0;
+    iop->breakpoint_hit = 0;
+    iop->breakpoint_skip = 0;
+}
+
+int iop_poll_breakpoint(struct iop_state* iop) {
+    int hit = iop->breakpoint_hit;
+
+    iop->breakpoint_hit = 0;
+
+    return hit;
 }
 
 void iop_set_irq_pending(struct iop_state* iop) {
@@ -329,6 +704,9 @@ static inline void iop_i_j(struct iop_state* iop) {
         return;
 
     iop->next_pc = (iop->next_pc & 0xf0000000) | (IMM26 << 2);
+
+    if (iop->next_pc < iop->pc)
+        iop_test_idle_loop(iop, iop->next_pc, iop->pc - 4);
 }
 
 static inline void iop_i_jal(struct iop_state* iop) {
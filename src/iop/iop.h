@@ -46,8 +46,29 @@ struct iop_bus_s {
     void (*write8)(void* udata, uint32_t addr, uint32_t data);
     void (*write16)(void* udata, uint32_t addr, uint32_t data);
     void (*write32)(void* udata, uint32_t addr, uint32_t data);
+
+    // Optional, used for bulk host-side copies
+    void* (*get_span)(void* udata, uint32_t addr, uint32_t* size, int write);
+};
+
+// Direct-mapped cache of analyzed backwards branches, must be a power of two
+#define IOP_IDLE_CACHE_SIZE 64
+#define IOP_IDLE_MAX_INSTRUCTIONS 16
+
+struct iop_idle_entry {
+    uint32_t start;
+    uint32_t branch;
+    int idle;
+
+    // Loop body at the time it was analyzed, idle verdicts are checked
+    // against it so code loaded over the loop later is analyzed again
+    uint32_t code[IOP_IDLE_MAX_INSTRUCTIONS];
 };
 
+// Open-addressed PC set, must be a power of two
+#define IOP_BREAKPOINT_SLOTS 256
+#define IOP_BREAKPOINT_EMPTY 0xffffffff
+
 struct iop_state {
     struct iop_bus_s bus;
 
@@ -72,9 +93,26 @@ struct iop_state {
 
     uint32_t module_list_addr;
 
+    uint32_t breakpoints[IOP_BREAKPOINT_SLOTS];
+    int breakpoint_count;
+    int breakpoint_hit;
+    int breakpoint_skip;
+
+    // Idle loop detection
+    struct iop_idle_entry idle_cache[IOP_IDLE_CACHE_SIZE];
+    uint32_t idle_pc;
+    int idle;
+
+    // Stats
+    uint64_t idle_loops;
+    uint64_t idle_cycles;
+
     /* cache module list */
     int module_count;
     struct iop_module *module_list;
+
+    // HLE ioman file table, owned by hle/ioman.cpp
+    struct ioman_hle_state* ioman;
 };
 
 /*
@@ -155,6 +193,11 @@ void iop_reset(struct iop_state* iop);
 void iop_set_irq_pending(struct iop_state* iop);
 void iop_fetch(struct iop_state* iop);
 int iop_execute(struct iop_state* iop);
+int iop_set_breakpoint(struct iop_state* iop, uint32_t addr);
+void iop_remove_breakpoint(struct iop_state* iop, uint32_t addr);
+void iop_clear_breakpoints(struct iop_state* iop);
+int iop_poll_breakpoint(struct iop_state* iop);
+void iop_wake(struct iop_state* iop);
 
 // External bus access functions
 uint32_t iop_read8(struct iop_state* iop, uint32_t addr);
@@ -163,6 +206,9 @@ uint32_t iop_read32(struct iop_state* iop, uint32_t addr);
 void iop_write8(struct iop_state* iop, uint32_t addr, uint32_t data);
 void iop_write16(struct iop_state* iop, uint32_t addr, uint32_t data);
 void iop_write32(struct iop_state* iop, uint32_t addr, uint32_t data);
+void* iop_get_span(struct iop_state* iop, uint32_t addr, uint32_t* size, int write);
+void iop_read_block(struct iop_state* iop, uint32_t addr, void* buf, uint32_t size);
+void iop_write_block(struct iop_state* iop, uint32_t addr, const void* buf, uint32_t size);
 
 /*
     00h INT     Interrupt
@@ -3,10 +3,12 @@
 #include <string.h>
 #include <stdio.h>
 
-#include "spu2.h"
+#ifdef _EE_USE_INTRINSICS
+#include <emmintrin.h>
+#include <smmintrin.h>
+#endif
 
-FILE* output = NULL;
-uint32_t chunk_size = 0;
+#include "spu2.h"
 
 static const int16_t g_spu_gauss_table[] = {
     -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001,
@@ -124,9 +126,39 @@ struct wav_chunk {
 //     sched_schedule(spu2->sched, event);
 // }
 
+static inline void spu2_flush_block_cache(struct ps2_spu2* spu2) {
+    for (int i = 0; i < SPU2_BLOCK_CACHE_SETS; i++)
+        for (int j = 0; j < SPU2_BLOCK_CACHE_WAYS; j++)
+            spu2->block_cache[i][j].nax = SPU2_BLOCK_INVALID;
+}
+
+// Drop any cached block that contains addr. Blocks normally start
+// on an 8-halfword boundary, but SSA/LSAX can point anywhere, so also
+// check the set a misaligned block containing addr would live in
+static inline void spu2_invalidate_block(struct ps2_spu2* spu2, uint32_t addr) {
+    uint32_t sets[2] = {
+        (addr >> 3) & (SPU2_BLOCK_CACHE_SETS - 1),
+        ((addr - 7) >> 3) & (SPU2_BLOCK_CACHE_SETS - 1)
+    };
+
+    for (int i = 0; i < 2; i++) {
+        if (i && (sets[1] == sets[0]))
+            break;
+
+        struct spu2_block* set = spu2->block_cache[sets[i]];
+
+        for (int j = 0; j < SPU2_BLOCK_CACHE_WAYS; j++) {
+            if (((addr - set[j].nax) & 0xfffff) < 8)
+                set[j].nax = SPU2_BLOCK_INVALID;
+        }
+    }
+}
+
 void ps2_spu2_init(struct ps2_spu2* spu2, struct ps2_iop_dma* dma, struct ps2_iop_intc* intc, struct sched_state* sched) {
     memset(spu2, 0, sizeof(struct ps2_spu2));
 
+    spu2_flush_block_cache(spu2);
+
     spu2->dma = dma;
     spu2->intc = intc;
     spu2->sched = sched;
@@ -196,6 +228,9 @@ void spu2_write_kon(struct ps2_spu2* spu2, int c, int h, uint64_t data) {
         // before playing
         v->playing = 1;
         v->counter = 0;
+
+        cr->active |= 1u << idx;
+
         v->h[0] = 0;
         v->h[1] = 0;
 
@@ -258,7 +293,11 @@ void spu2_write_koff(struct ps2_spu2* spu2, int c, int h, uint64_t data) {
 }
 
 void adma_write_data(struct ps2_spu2* spu2, int c, uint64_t data) {
-    spu2->ram[(c ? 0x2400 : 0x2000) + ((spu2->c[c].memin_write_addr++) & 0x3ff)] = data;
+    uint32_t addr = (c ? 0x2400 : 0x2000) + ((spu2->c[c].memin_write_addr++) & 0x3ff);
+
+    spu2->ram[addr] = data;
+
+    spu2_invalidate_block(spu2, addr);
 }
 
 void spu2_write_data(struct ps2_spu2* spu2, int c, uint64_t data) {
@@ -271,7 +310,9 @@ void spu2_write_data(struct ps2_spu2* spu2, int c, uint64_t data) {
 
     spu2_check_irq(spu2, spu2->c[c].tsa);
 
-    spu2->ram[spu2->c[c].tsa++] = data;
+    spu2->ram[spu2->c[c].tsa] = data;
+
+    spu2_invalidate_block(spu2, spu2->c[c].tsa++);
 
     spu2->c[c].tsa &= 0xfffff;
 }
@@ -578,8 +619,8 @@ void ps2_spu2_write16(struct ps2_spu2* spu2, uint32_t addr, uint64_t data) {
         int core = (addr >> 10) & 1;
 
         switch (addr & 0x3ff) {
-            case 0x2E0: SPU2_WRITEH(core, esa); /* To-do: Reverb spu2->c[core].eaddr = 0; */ return;
-            case 0x2E2: SPU2_WRITEL(core, esa); /* To-do: Reverb spu2->c[core].eaddr = 0; */ return;
+            case 0x2E0: SPU2_WRITEH(core, esa); spu2->c[core].reverb_x = 0; return;
+            case 0x2E2: SPU2_WRITEL(core, esa); spu2->c[core].reverb_x = 0; return;
             case 0x2E4: SPU2_WRITEH(core, fb_src_a); return;
             case 0x2E6: SPU2_WRITEL(core, fb_src_a); return;
             case 0x2E8: SPU2_WRITEH(core, fb_src_b); return;
@@ -624,8 +665,8 @@ void ps2_spu2_write16(struct ps2_spu2* spu2, uint32_t addr, uint64_t data) {
             case 0x336: SPU2_WRITEL(core, mix_dest_b0); return;
             case 0x338: SPU2_WRITEH(core, mix_dest_b1); return;
             case 0x33A: SPU2_WRITEL(core, mix_dest_b1); return;
-            case 0x33C: SPU2_WRITEH(core, eea); /* To-do: Reverb spu2->c[core].eaddr = 0; */ return;
-            case 0x33E: SPU2_WRITEL(core, eea); /* To-do: Reverb spu2->c[core].eaddr = 0; */ return;
+            case 0x33C: SPU2_WRITEH(core, eea); spu2->c[core].reverb_x = 0; return;
+            case 0x33E: SPU2_WRITEL(core, eea); spu2->c[core].reverb_x = 0; return;
             case 0x340: SPU2_WRITEH(core, endx); return;
             case 0x342: SPU2_WRITEL(core, endx); return;
             case 0x344: spu2->c[core].stat = data; return;
@@ -741,7 +782,7 @@ static const int ps_adpcm_coefs_i[5][2] = {
     { 122 , -60 },
 };
 
-void spu2_decode_adpcm_block(struct ps2_spu2* spu2, struct spu2_voice* v) {
+static inline uint16_t spu2_read_adpcm_header(struct ps2_spu2* spu2, struct spu2_voice* v) {
     uint16_t hdr = spu2->ram[v->nax];
 
     // if (v->nax == spu2->c[0].irqa || v->nax == spu2->c[1].irqa)
@@ -753,6 +794,10 @@ void spu2_decode_adpcm_block(struct ps2_spu2* spu2, struct spu2_voice* v) {
 
     // printf("spu2: start=%d loop=%d end=%d\n", v->loop_start, v->loop, v->loop_end);
 
+    return hdr;
+}
+
+static inline void spu2_decode_adpcm_samples(struct ps2_spu2* spu2, struct spu2_voice* v, uint16_t hdr) {
     int shift_factor = (hdr & 0xf);
     int coef_index = ((hdr >> 4) & 0x7);
 
@@ -789,6 +834,41 @@ void spu2_decode_adpcm_block(struct ps2_spu2* spu2, struct spu2_voice* v) {
     }
 }
 
+void spu2_decode_adpcm_block(struct ps2_spu2* spu2, struct spu2_voice* v) {
+    uint16_t hdr = spu2_read_adpcm_header(spu2, v);
+
+    struct spu2_block* set = spu2->block_cache[(v->nax >> 3) & (SPU2_BLOCK_CACHE_SETS - 1)];
+
+    for (int i = 0; i < SPU2_BLOCK_CACHE_WAYS; i++) {
+        struct spu2_block* b = &set[i];
+
+        if (b->nax != v->nax || b->h[0] != v->h[0] || b->h[1] != v->h[1])
+            continue;
+
+        memcpy(v->buf, b->buf, sizeof(v->buf));
+
+        v->h[0] = v->buf[27];
+        v->h[1] = v->buf[26];
+
+        return;
+    }
+
+    struct spu2_block entry;
+
+    entry.nax = v->nax;
+    entry.h[0] = v->h[0];
+    entry.h[1] = v->h[1];
+
+    spu2_decode_adpcm_samples(spu2, v, hdr);
+
+    memcpy(entry.buf, v->buf, sizeof(entry.buf));
+
+    // Most recently decoded block goes in way 0
+    memmove(&set[1], &set[0], sizeof(struct spu2_block) * (SPU2_BLOCK_CACHE_WAYS - 1));
+
+    set[0] = entry;
+}
+
 #define PHASE v->adsr_phase
 #define CYCLES v->adsr_cycles
 #define EXPONENTIAL v->adsr_mode
@@ -877,6 +957,14 @@ void adsr_load_release(struct ps2_spu2* spu2, struct spu2_core* c, struct spu2_v
     adsr_calculate_values(spu2, v);
 }
 
+static inline void spu2_voice_end(struct spu2_core* c, struct spu2_voice* v) {
+    v->playing = 0;
+
+    // The envelope is zero at this point, so the voice's mixer lanes
+    // are silent until it gets keyed on again
+    c->active &= ~(1u << (v - c->v));
+}
+
 void spu2_handle_adsr(struct ps2_spu2* spu2, struct spu2_core* c, struct spu2_voice* v) {
     if (CYCLES) {
         CYCLES -= 1;
@@ -921,14 +1009,16 @@ void spu2_handle_adsr(struct ps2_spu2* spu2, struct spu2_core* c, struct spu2_vo
                 // v->lsax = 0;
 
                 v->envx = 0;
-                v->playing = 0;
+
+                spu2_voice_end(c, v);
             }
         } break;
 
         case ADSR_END: {
             level = 0;
             v->envx = 0;
-            v->playing = 0;
+
+            spu2_voice_end(c, v);
         } break;
     }
 
@@ -949,45 +1039,74 @@ void spu2_handle_adsr(struct ps2_spu2* spu2, struct spu2_core* c, struct spu2_vo
 #undef CLAMP
 #undef MAX
 
-struct spu2_sample spu2_get_voice_sample(struct ps2_spu2* spu2, int cr, int vc) {
-    // if (!spu2->c[cr].v[vc].playing)
-    //     return silence;
+static inline void spu2_voice_next_block(struct ps2_spu2* spu2, struct spu2_core* c, struct spu2_voice* v, int vc, int decode) {
+    if (v->loop_start)
+        v->lsax = v->nax;
 
-    struct spu2_core* c = &spu2->c[cr];
+    v->nax += 8;
+    v->nax &= 0xfffff;
+
+    spu2_check_irq(spu2, v->nax);
+
+    if (v->loop_end) {
+        if (!v->loop) {
+            if (decode) {
+                v->envx = 0;
+
+                adsr_load_release(spu2, c, v, vc);
+            } else {
+                c->endx |= 1u << vc;
+            }
+        } else {
+            v->nax = v->lsax;
+
+            spu2_check_irq(spu2, v->nax);
+        }
+    }
+
+    // Silent voices only need the block flags to keep NAX, ENDX
+    // and IRQs going, the samples themselves are never heard
+    if (decode) {
+        spu2_decode_adpcm_block(spu2, v);
+    } else {
+        spu2_read_adpcm_header(spu2, v);
+    }
+}
+
+static inline void spu2_skip_voice_sample(struct ps2_spu2* spu2, struct spu2_core* c, int vc) {
     struct spu2_voice* v = &c->v[vc];
-    struct spu2_sample s;
 
     int sample_index = v->counter >> 12;
 
-    spu2_handle_adsr(spu2, c, v);
-
     if (sample_index > 27) {
         sample_index -= 28;
 
         v->counter &= 0xfff;
         v->counter |= sample_index << 12;
 
-        if (v->loop_start)
-            v->lsax = v->nax;
+        spu2_voice_next_block(spu2, c, v, vc, 0);
+    }
+
+    v->counter += v->pitch;
 
-        v->nax += 8;
-        v->nax &= 0xfffff;
+    v->prev_sample_index = sample_index;
+}
 
-        spu2_check_irq(spu2, v->nax);
+static inline int32_t spu2_run_voice(struct ps2_spu2* spu2, int cr, int vc) {
+    struct spu2_core* c = &spu2->c[cr];
+    struct spu2_voice* v = &c->v[vc];
 
-        if (v->loop_end) {
-            if (!v->loop) {
-                v->envx = 0;
+    int sample_index = v->counter >> 12;
 
-                adsr_load_release(spu2, c, v, vc);
-            } else {
-                v->nax = v->lsax;
+    spu2_handle_adsr(spu2, c, v);
 
-                spu2_check_irq(spu2, v->nax);
-            }
-        }
+    if (sample_index > 27) {
+        sample_index -= 28;
 
-        spu2_decode_adpcm_block(spu2, v);
+        v->counter &= 0xfff;
+        v->counter |= sample_index << 12;
+
+        spu2_voice_next_block(spu2, c, v, vc, 1);
     }
 
     if (v->prev_sample_index != sample_index) {
@@ -1019,6 +1138,7 @@ struct spu2_sample spu2_get_voice_sample(struct ps2_spu2* spu2, int cr, int vc)
 
         spu2->ram[addr] = out;
 
+        spu2_invalidate_block(spu2, addr);
         spu2_check_irq(spu2, addr);
     }
 
@@ -1029,18 +1149,288 @@ struct spu2_sample spu2_get_voice_sample(struct ps2_spu2* spu2, int cr, int vc)
 
         spu2->ram[addr] = out;
 
+        spu2_invalidate_block(spu2, addr);
         spu2_check_irq(spu2, addr);
     }
 
-    s.s16[0] = (out * v->voll) >> 15;
-    s.s16[1] = (out * v->volr) >> 15;
-    s.s16[0] = ((int32_t)s.s16[0] * v->envx) >> 15;
-    s.s16[1] = ((int32_t)s.s16[1] * v->envx) >> 15;
-
     v->counter += v->pitch;
 
     v->prev_sample_index = sample_index;
 
+    return out;
+}
+
+static inline int32_t spu2_apply_volume(int32_t out, int32_t vol, int32_t env) {
+    return (((out * vol) >> 15) * env) >> 15;
+}
+
+static inline int16_t spu2_saturate(int32_t s) {
+    return (s < INT16_MIN) ? INT16_MIN : ((s > INT16_MAX) ? INT16_MAX : s);
+}
+
+// Accumulate every voice of a core into 32-bit lanes, routed to the
+// dry (VMIXL/R) and wet (VMIXEL/ER) outputs. The caller saturates once
+// after all sources have been added
+static inline void spu2_mix_voices(struct spu2_core* c, int32_t* dry, int32_t* wet) {
+#ifdef _EE_USE_INTRINSICS
+    const __m128i bits = _mm_setr_epi32(1, 2, 4, 8);
+
+    __m128i dryl = _mm_setzero_si128();
+    __m128i dryr = _mm_setzero_si128();
+    __m128i wetl = _mm_setzero_si128();
+    __m128i wetr = _mm_setzero_si128();
+
+    for (int i = 0; i < 24; i += 4) {
+        __m128i out = _mm_loadu_si128((const __m128i*)&c->mix_out[i]);
+        __m128i voll = _mm_loadu_si128((const __m128i*)&c->mix_voll[i]);
+        __m128i volr = _mm_loadu_si128((const __m128i*)&c->mix_volr[i]);
+        __m128i env = _mm_loadu_si128((const __m128i*)&c->mix_env[i]);
+
+        __m128i sl = _mm_srai_epi32(_mm_mullo_epi32(out, voll), 15);
+        __m128i sr = _mm_srai_epi32(_mm_mullo_epi32(out, volr), 15);
+
+        sl = _mm_srai_epi32(_mm_mullo_epi32(sl, env), 15);
+        sr = _mm_srai_epi32(_mm_mullo_epi32(sr, env), 15);
+
+        // Expand the routing bits for these 4 voices into lane masks
+        __m128i ml = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(c->vmixl >> i), bits), bits);
+        __m128i mr = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(c->vmixr >> i), bits), bits);
+        __m128i mel = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(c->vmixel >> i), bits), bits);
+        __m128i mer = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(c->vmixer >> i), bits), bits);
+
+        dryl = _mm_add_epi32(dryl, _mm_and_si128(sl, ml));
+        dryr = _mm_add_epi32(dryr, _mm_and_si128(sr, mr));
+        wetl = _mm_add_epi32(wetl, _mm_and_si128(sl, mel));
+        wetr = _mm_add_epi32(wetr, _mm_and_si128(sr, mer));
+    }
+
+    // Transpose so each lane holds the sum of one output
+    __m128i t0 = _mm_add_epi32(_mm_unpacklo_epi32(dryl, dryr), _mm_unpackhi_epi32(dryl, dryr));
+    __m128i t1 = _mm_add_epi32(_mm_unpacklo_epi32(wetl, wetr), _mm_unpackhi_epi32(wetl, wetr));
+    __m128i sum = _mm_add_epi32(_mm_unpacklo_epi64(t0, t1), _mm_unpackhi_epi64(t0, t1));
+
+    dry[0] += _mm_extract_epi32(sum, 0) << 1;
+    dry[1] += _mm_extract_epi32(sum, 1) << 1;
+    wet[0] += _mm_extract_epi32(sum, 2) << 1;
+    wet[1] += _mm_extract_epi32(sum, 3) << 1;
+#else
+    int32_t dryl = 0, dryr = 0;
+    int32_t wetl = 0, wetr = 0;
+
+    for (int i = 0; i < 24; i++) {
+        int32_t sl = spu2_apply_volume(c->mix_out[i], c->mix_voll[i], c->mix_env[i]);
+        int32_t sr = spu2_apply_volume(c->mix_out[i], c->mix_volr[i], c->mix_env[i]);
+
+        if (c->vmixl & (1u << i)) dryl += sl;
+        if (c->vmixr & (1u << i)) dryr += sr;
+        if (c->vmixel & (1u << i)) wetl += sl;
+        if (c->vmixer & (1u << i)) wetr += sr;
+    }
+
+    dry[0] += dryl << 1;
+    dry[1] += dryr << 1;
+    wet[0] += wetl << 1;
+    wet[1] += wetr << 1;
+#endif
+}
+
+static inline void spu2_run_core(struct ps2_spu2* spu2, int cr, int32_t* dry, int32_t* wet) {
+    struct spu2_core* c = &spu2->c[cr];
+
+    uint32_t active = c->active | SPU2_CAPTURE_VOICES;
+
+    for (int i = 0; i < 24; i++) {
+        if (!(active & (1u << i))) {
+            spu2_skip_voice_sample(spu2, c, i);
+
+            continue;
+        }
+
+        c->mix_out[i] = spu2_run_voice(spu2, cr, i);
+        c->mix_voll[i] = c->v[i].voll;
+        c->mix_volr[i] = c->v[i].volr;
+        c->mix_env[i] = c->v[i].envx;
+    }
+
+    spu2_mix_voices(c, dry, wet);
+}
+
+// Half-band filter used to go between 48 and 24 KHz, padded to 40
+// taps so it can be evaluated 4 taps at a time
+static const int32_t spu2_reverb_fir_coefs[40] = {
+       -1,     0,     2,     0,   -10,     0,    35,     0,
+     -103,     0,   266,     0,  -616,     0,  1332,     0,
+    -2960,     0, 10246, 16384, 10246,     0, -2960,     0,
+     1332,     0,  -616,     0,   266,     0,  -103,     0,
+       35,     0,   -10,     0,     2,     0,    -1,     0
+};
+
+static inline int32_t spu2_reverb_fir(const int32_t* buf) {
+#ifdef _EE_USE_INTRINSICS
+    __m128i acc = _mm_setzero_si128();
+
+    for (int i = 0; i < 40; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i*)&buf[i]);
+        __m128i k = _mm_loadu_si128((const __m128i*)&spu2_reverb_fir_coefs[i]);
+
+        acc = _mm_add_epi32(acc, _mm_mullo_epi32(s, k));
+    }
+
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0x4e));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0xb1));
+
+    return _mm_cvtsi128_si32(acc);
+#else
+    int32_t acc = 0;
+
+    for (int i = 0; i < 40; i++)
+        acc += buf[i] * spu2_reverb_fir_coefs[i];
+
+    return acc;
+#endif
+}
+
+#define MUL(a, b) (((a) * (b)) >> 15)
+
+static inline uint32_t spu2_reverb_addr(struct spu2_core* c, uint32_t start, int32_t size, int32_t offset) {
+    int32_t idx = ((int32_t)c->reverb_x + offset) % size;
+
+    if (idx < 0)
+        idx += size;
+
+    return (start + idx) & 0xfffff;
+}
+
+static inline void spu2_reverb_write(struct ps2_spu2* spu2, uint32_t addr, int32_t data) {
+    spu2->ram[addr] = spu2_saturate(data);
+
+    spu2_invalidate_block(spu2, addr);
+}
+
+// Run one 24 KHz step of the reverb for the left or right channel,
+// in is the downsampled input. Register names follow the SPU2 docs,
+// the comments give the equivalent PS1 names
+static inline int32_t spu2_reverb_step(struct ps2_spu2* spu2, struct spu2_core* c, int right, int32_t in, uint32_t start, int32_t size) {
+    int16_t* ram = (int16_t*)spu2->ram;
+
+    int32_t apf1_size = c->fb_src_a & 0xfffff; // dAPF1
+    int32_t apf2_size = c->fb_src_b & 0xfffff; // dAPF2
+
+    int32_t same_dst_off = (right ? c->iir_dest_a1 : c->iir_dest_a0) & 0xfffff; // mSAME
+    int32_t diff_dst_off = (right ? c->iir_dest_b1 : c->iir_dest_b0) & 0xfffff; // mDIFF
+    int32_t apf1_dst_off = (right ? c->mix_dest_a1 : c->mix_dest_a0) & 0xfffff; // mAPF1
+    int32_t apf2_dst_off = (right ? c->mix_dest_b1 : c->mix_dest_b0) & 0xfffff; // mAPF2
+
+    // Same side reflection reads its own channel (dSAME), different
+    // side reflection reads the other one (dDIFF)
+    uint32_t same_src = spu2_reverb_addr(c, start, size, (right ? c->iir_src_a1 : c->iir_src_a0) & 0xfffff);
+    uint32_t same_dst = spu2_reverb_addr(c, start, size, same_dst_off);
+    uint32_t same_prv = spu2_reverb_addr(c, start, size, same_dst_off - 1);
+    uint32_t diff_src = spu2_reverb_addr(c, start, size, (right ? c->iir_src_b1 : c->iir_src_b0) & 0xfffff);
+    uint32_t diff_dst = spu2_reverb_addr(c, start, size, diff_dst_off);
+    uint32_t diff_prv = spu2_reverb_addr(c, start, size, diff_dst_off - 1);
+
+    // mCOMB1-4
+    uint32_t comb1 = spu2_reverb_addr(c, start, size, (right ? c->acc_src_a1 : c->acc_src_a0) & 0xfffff);
+    uint32_t comb2 = spu2_reverb_addr(c, start, size, (right ? c->acc_src_b1 : c->acc_src_b0) & 0xfffff);
+    uint32_t comb3 = spu2_reverb_addr(c, start, size, (right ? c->acc_src_c1 : c->acc_src_c0) & 0xfffff);
+    uint32_t comb4 = spu2_reverb_addr(c, start, size, (right ? c->acc_src_d1 : c->acc_src_d0) & 0xfffff);
+
+    uint32_t apf1_src = spu2_reverb_addr(c, start, size, apf1_dst_off - apf1_size);
+    uint32_t apf1_dst = spu2_reverb_addr(c, start, size, apf1_dst_off);
+    uint32_t apf2_src = spu2_reverb_addr(c, start, size, apf2_dst_off - apf2_size);
+    uint32_t apf2_dst = spu2_reverb_addr(c, start, size, apf2_dst_off);
+
+    int32_t iir = (int16_t)c->iir_alpha;   // vIIR
+    int32_t wall = (int16_t)c->iir_coef;   // vWALL
+    int32_t apf1_vol = (int16_t)c->fb_alpha; // vAPF1
+    int32_t apf2_vol = (int16_t)c->fb_x;     // vAPF2
+
+    in = MUL((int16_t)(right ? c->in_coef_r : c->in_coef_l), in);
+
+    int32_t same = MUL(iir, in + MUL(wall, ram[same_src]) - ram[same_prv]) + ram[same_prv];
+    int32_t diff = MUL(iir, in + MUL(wall, ram[diff_src]) - ram[diff_prv]) + ram[diff_prv];
+
+    int32_t out;
+
+    out  = MUL((int16_t)c->acc_coef_a, ram[comb1]);
+    out += MUL((int16_t)c->acc_coef_b, ram[comb2]);
+    out += MUL((int16_t)c->acc_coef_c, ram[comb3]);
+    out += MUL((int16_t)c->acc_coef_d, ram[comb4]);
+
+    int32_t apf1 = out - MUL(apf1_vol, ram[apf1_src]);
+
+    out = ram[apf1_src] + MUL(apf1_vol, apf1);
+
+    int32_t apf2 = out - MUL(apf2_vol, ram[apf2_src]);
+
+    out = ram[apf2_src] + MUL(apf2_vol, apf2);
+
+    spu2_reverb_write(spu2, same_dst, same);
+    spu2_reverb_write(spu2, diff_dst, diff);
+    spu2_reverb_write(spu2, apf1_dst, apf1);
+    spu2_reverb_write(spu2, apf2_dst, apf2);
+
+    return spu2_saturate(out);
+}
+
+// Process a batch of 48 KHz reverb input in place. Each 48 KHz tick
+// runs the reverb for one channel, so each channel effectively runs
+// at 24 KHz, then the output is zero-stuffed and filtered back up
+static void spu2_run_reverb(struct ps2_spu2* spu2, int cr, int32_t* l, int32_t* r, int count) {
+    struct spu2_core* c = &spu2->c[cr];
+
+    uint32_t start = c->esa & 0xfffff;
+    uint32_t end = (c->eea & 0xf0000) | 0xffff;
+    int32_t size = (int32_t)(end - start) + 1;
+
+    int enable = (c->attr & 0x80) && (end > start);
+
+    for (int i = 0; i < count; i++) {
+        int pos = c->reverb_pos;
+        int right = c->reverb_cycle & 1;
+        int base = (pos - 38) & 63;
+
+        c->reverb_down[0][pos] = c->reverb_down[0][pos | 64] = spu2_saturate(l[i]);
+        c->reverb_down[1][pos] = c->reverb_down[1][pos | 64] = spu2_saturate(r[i]);
+
+        int32_t out = 0;
+
+        if (enable) {
+            int32_t in = spu2_saturate(spu2_reverb_fir(&c->reverb_down[right][base]) >> 15);
+
+            out = spu2_reverb_step(spu2, c, right, in, start, size);
+        }
+
+        c->reverb_up[right][pos] = c->reverb_up[right][pos | 64] = out;
+        c->reverb_up[!right][pos] = c->reverb_up[!right][pos | 64] = 0;
+
+        // Zero-stuffing halves the level, make up for it here
+        int32_t wl = spu2_saturate(spu2_reverb_fir(&c->reverb_up[0][base]) >> 14);
+        int32_t wr = spu2_saturate(spu2_reverb_fir(&c->reverb_up[1][base]) >> 14);
+
+        l[i] = MUL((int16_t)c->evoll, wl);
+        r[i] = MUL((int16_t)c->evolr, wr);
+
+        c->reverb_pos = (pos + 1) & 63;
+        c->reverb_cycle++;
+
+        if (right && enable)
+            c->reverb_x = (c->reverb_x + 1) % size;
+    }
+}
+
+#undef MUL
+
+struct spu2_sample spu2_get_voice_sample(struct ps2_spu2* spu2, int cr, int vc) {
+    struct spu2_voice* v = &spu2->c[cr].v[vc];
+    struct spu2_sample s;
+
+    int32_t out = spu2_run_voice(spu2, cr, vc);
+
+    s.s16[0] = spu2_saturate(spu2_apply_volume(out, v->voll, v->envx));
+    s.s16[1] = spu2_saturate(spu2_apply_volume(out, v->volr, v->envx));
+
     return s;
 }
 
@@ -1090,44 +1480,69 @@ struct spu2_sample ps2_spu2_get_adma_sample(struct ps2_spu2* spu2, int c) {
     return spu2_get_adma_sample(spu2, c);
 }
 
-struct spu2_sample ps2_spu2_get_sample(struct ps2_spu2* spu2, int adma_enable) {
-    struct spu2_sample s = silence;
+void ps2_spu2_get_samples(struct ps2_spu2* spu2, struct spu2_sample* buf, int count, int adma_enable) {
+    int32_t dry[2][SPU2_MIX_BLOCK];
+    int32_t wet[2][2][SPU2_MIX_BLOCK];
+
+    while (count) {
+        int n = (count < SPU2_MIX_BLOCK) ? count : SPU2_MIX_BLOCK;
+
+        for (int i = 0; i < n; i++) {
+            // ADMA
+            struct spu2_sample c0_adma = spu2_get_adma_sample(spu2, 0);
+            struct spu2_sample c1_adma = spu2_get_adma_sample(spu2, 1);
+
+            // if (output) {
+            //     if (spu2->c[0].adma_playing) {
+            //         chunk_size += sizeof(int16_t) * 2;
+            //         fwrite(&c0_adma.s16, sizeof(int16_t), 2, output);
+            //     }
+
+            //     if (spu2->c[1].adma_playing) {
+            //         chunk_size += sizeof(int16_t) * 2;
+            //         fwrite(&c1_adma.s16, sizeof(int16_t), 2, output);
+            //     }
+            // }
+
+            int32_t d[2] = { 0, 0 };
+            int32_t w0[2] = { 0, 0 };
+            int32_t w1[2] = { 0, 0 };
+
+            if (adma_enable) {
+                d[0] += c0_adma.s16[0] + c1_adma.s16[0];
+                d[1] += c0_adma.s16[1] + c1_adma.s16[1];
+            }
 
-    s.u16[0] = 0;
-    s.u16[1] = 0;
-
-    // ADMA
-    struct spu2_sample c0_adma = spu2_get_adma_sample(spu2, 0);
-    struct spu2_sample c1_adma = spu2_get_adma_sample(spu2, 1);
-
-    // if (output) {
-    //     if (spu2->c[0].adma_playing) {
-    //         chunk_size += sizeof(int16_t) * 2;
-    //         fwrite(&c0_adma.s16, sizeof(int16_t), 2, output);
-    //     }
-
-    //     if (spu2->c[1].adma_playing) {
-    //         chunk_size += sizeof(int16_t) * 2;
-    //         fwrite(&c1_adma.s16, sizeof(int16_t), 2, output);
-    //     }
-    // }
-
-    if (adma_enable) {
-        s.s16[0] += c0_adma.s16[0];
-        s.s16[1] += c0_adma.s16[1];
-        s.s16[0] += c1_adma.s16[0];
-        s.s16[1] += c1_adma.s16[1];
-    }
+            spu2_run_core(spu2, 0, d, w0);
+            spu2_run_core(spu2, 1, d, w1);
 
-    for (int i = 0; i < 24; i++) {
-        struct spu2_sample c0 = spu2_get_voice_sample(spu2, 0, i);
-        struct spu2_sample c1 = spu2_get_voice_sample(spu2, 1, i);
+            dry[0][i] = d[0];
+            dry[1][i] = d[1];
+            wet[0][0][i] = w0[0];
+            wet[0][1][i] = w0[1];
+            wet[1][0][i] = w1[0];
+            wet[1][1][i] = w1[1];
+        }
+
+        // Reverb only depends on its own input and work area, so it
+        // can run over the whole batch after the voices
+        spu2_run_reverb(spu2, 0, wet[0][0], wet[0][1], n);
+        spu2_run_reverb(spu2, 1, wet[1][0], wet[1][1], n);
+
+        for (int i = 0; i < n; i++) {
+            buf[i].s16[0] = spu2_saturate(dry[0][i] + wet[0][0][i] + wet[1][0][i]);
+            buf[i].s16[1] = spu2_saturate(dry[1][i] + wet[0][1][i] + wet[1][1][i]);
+        }
 
-        s.s16[0] += c0.s16[0] << 1;
-        s.s16[1] += c0.s16[1] << 1;
-        s.s16[0] += c1.s16[0] << 1;
-        s.s16[1] += c1.s16[1] << 1;
+        buf += n;
+        count -= n;
     }
+}
+
+struct spu2_sample ps2_spu2_get_sample(struct ps2_spu2* spu2, int adma_enable) {
+    struct spu2_sample s = silence;
+
+    ps2_spu2_get_samples(spu2, &s, 1, adma_enable);
 
     return s;
 }
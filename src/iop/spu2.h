@@ -13,6 +13,18 @@ extern "C" {
 
 #define SPU2_RAM_SIZE 0x100000 // 2 MB
 
+// Voices 1 and 3 feed the capture buffers, so they always run
+#define SPU2_CAPTURE_VOICES ((1u << 1) | (1u << 3))
+
+// Decoded ADPCM block cache, 2-way set associative, indexed by
+// block address (256 KB)
+#define SPU2_BLOCK_CACHE_SETS 2048
+#define SPU2_BLOCK_CACHE_WAYS 2
+#define SPU2_BLOCK_INVALID 0xffffffff
+
+// Samples mixed per batch, reverb runs once per batch
+#define SPU2_MIX_BLOCK 64
+
 /* Memory ranges:
     1f900000-1f90017f CORE0 Voice settings
     1f900180-1f9001b1 CORE0 Common settings
@@ -181,12 +193,40 @@ struct spu2_core {
     // Capture buffers
     uint16_t cb_out1_addr;
     uint16_t cb_out3_addr;
+
+    // Mixer inputs in structure-of-arrays form, one lane per voice.
+    // Voices that aren't in the active mask only advance their
+    // address, their lanes stay silent
+    uint32_t active;
+    int32_t mix_out[24];
+    int32_t mix_voll[24];
+    int32_t mix_volr[24];
+    int32_t mix_env[24];
+
+    // Reverb, runs at 24 KHz alternating between left and right.
+    // The 48 KHz input and 24 KHz output are kept twice in a row so
+    // the resampling filter can always read 40 contiguous samples
+    uint32_t reverb_x;
+    uint32_t reverb_cycle;
+    int reverb_pos;
+    int32_t reverb_down[2][128];
+    int32_t reverb_up[2][128];
+};
+
+// A decoded block is only valid for the filter history it was
+// decoded with, so the history is part of the key
+struct spu2_block {
+    uint32_t nax;
+    int16_t h[2];
+    int16_t buf[28];
 };
 
 struct ps2_spu2 {
     // 2 MB
     uint16_t ram[0x100000];
 
+    struct spu2_block block_cache[SPU2_BLOCK_CACHE_SETS][SPU2_BLOCK_CACHE_WAYS];
+
     struct spu2_core c[2];
 
     // CORE1 S/PDIF settings
@@ -215,6 +255,7 @@ uint64_t ps2_spu2_read16(struct ps2_spu2* spu2, uint32_t addr);
 void ps2_spu2_write16(struct ps2_spu2* spu2, uint32_t addr, uint64_t data);
 void ps2_spu2_destroy(struct ps2_spu2* spu2);
 struct spu2_sample ps2_spu2_get_sample(struct ps2_spu2* spu, int adma_enable);
+void ps2_spu2_get_samples(struct ps2_spu2* spu2, struct spu2_sample* buf, int count, int adma_enable);
 struct spu2_sample ps2_spu2_get_voice_sample(struct ps2_spu2* spu2, int c, int v);
 struct spu2_sample ps2_spu2_get_adma_sample(struct ps2_spu2* spu2, int c);
 void spu2_start_adma(struct ps2_spu2* spu2, int c);
@@ -3,6 +3,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <limits>
+#include <mutex>
 #include "ipu.hpp"
 #include "ee/dmac.h"
 #include "ee/intc.h"
@@ -87,7 +88,21 @@ static const uint8_t default_nonintra_IQ[0x40] =
     23, 24, 25, 27, 28, 30, 31, 33,
 };
 
-ImageProcessingUnit::ImageProcessingUnit(struct ps2_intc* intc, struct ps2_dmac* dmac) : intc(intc), dmac(dmac)
+// The conversion and IDCT tables only depend on constants, so every IPU
+// instance in the process shares one copy
+unsigned int ImageProcessingUnit::crcb_map[0x100];
+double ImageProcessingUnit::IDCT_table[8][8];
+
+//I'm assuming the dithering process rounds down so I've rounded the matrix values down
+const int8_t ImageProcessingUnit::dither_mtx[4][4] =
+{
+    {-4,  0, -3,  1},
+    { 2, -2,  3, -1},
+    {-3,  1, -4,  0},
+    { 3, -1,  2, -2},
+};
+
+void ImageProcessingUnit::prepare_tables()
 {
     //Generate CrCb->RGB conversion map
     for (unsigned int i = 0; i < 0x40; i += 0x8)
@@ -103,23 +118,14 @@ ImageProcessingUnit::ImageProcessingUnit(struct ps2_intc* intc, struct ps2_dmac*
         }
     }
 
-    //I'm assuming the dithering process rounds down so I've rounded the matrix values down
-    dither_mtx[0][0] = -4;
-    dither_mtx[0][1] = 0;
-    dither_mtx[0][2] = -3;
-    dither_mtx[0][3] = 1;
-    dither_mtx[1][0] = 2;
-    dither_mtx[1][1] = -2;
-    dither_mtx[1][2] = 3;
-    dither_mtx[1][3] = -1;
-    dither_mtx[2][0] = -3;
-    dither_mtx[2][1] = 1;
-    dither_mtx[2][2] = -4;
-    dither_mtx[2][3] = 0;
-    dither_mtx[3][0] = 3;
-    dither_mtx[3][1] = -1;
-    dither_mtx[3][2] = 2;
-    dither_mtx[3][3] = -2;
+    prepare_IDCT();
+}
+
+ImageProcessingUnit::ImageProcessingUnit(struct ps2_intc* intc, struct ps2_dmac* dmac) : intc(intc), dmac(dmac)
+{
+    static std::once_flag tables_once;
+
+    std::call_once(tables_once, prepare_tables);
 }
 
 void ImageProcessingUnit::reset()
@@ -128,7 +134,6 @@ void ImageProcessingUnit::reset()
     VDEC_table = nullptr;
     in_FIFO.reset();
     out_FIFO.reset();
-    prepare_IDCT();
     memcpy(intra_IQ, default_intra_IQ, sizeof(intra_IQ));
     memcpy(nonintra_IQ, default_nonintra_IQ, sizeof(nonintra_IQ));
 
@@ -188,13 +188,13 @@ struct ImageProcessingUnit
         VLC_Table* VDEC_table;
         IPU_FIFO in_FIFO, out_FIFO;
 
-        int8_t dither_mtx[4][4];
+        static const int8_t dither_mtx[4][4];
 
         uint8_t intra_IQ[0x40], nonintra_IQ[0x40];
         uint16_t VQCLUT[16];
         uint32_t TH0, TH1;
 
-        unsigned int crcb_map[0x100];
+        static unsigned int crcb_map[0x100];
 
         static uint32_t inverse_scan_zigzag[0x40];
         static uint32_t inverse_scan_alternate[0x40];
@@ -215,7 +215,7 @@ struct ImageProcessingUnit
         SETIQ_STATE setiq_state;
         PACK_Command pack;
 
-        double IDCT_table[8][8];
+        static double IDCT_table[8][8];
 
         void finish_command();
 
@@ -224,7 +224,8 @@ struct ImageProcessingUnit
         bool process_BDEC();
         void inverse_scan(int16_t* block);
         void dequantize(int16_t* block);
-        void prepare_IDCT();
+        static void prepare_tables();
+        static void prepare_IDCT();
         void perform_IDCT(const int16_t* pUV, int16_t* pXY);
         bool BDEC_read_coeffs();
         bool BDEC_read_diff();
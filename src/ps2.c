@@ -63,6 +63,7 @@ void ps2_init(struct ps2_state* ps2) {
     ee_bus_data.write32 = ee_bus_write32;
     ee_bus_data.write64 = ee_bus_write64;
     ee_bus_data.write128 = ee_bus_write128;
+    ee_bus_data.get_span = ee_bus_get_span;
     ee_bus_data.udata = ps2->ee_bus;
 
     ee_init(ps2->ee, ps2->vu0, ps2->vu1, RAM_SIZE_32MB, ee_bus_data);
@@ -79,6 +80,7 @@ void ps2_init(struct ps2_state* ps2) {
     iop_bus_data.write8 = iop_bus_write8;
     iop_bus_data.write16 = iop_bus_write16;
     iop_bus_data.write32 = iop_bus_write32;
+    iop_bus_data.get_span = iop_bus_get_span;
     iop_bus_data.udata = ps2->iop_bus;
 
     iop_init(ps2->iop, iop_bus_data);
@@ -94,7 +96,7 @@ void ps2_init(struct ps2_state* ps2) {
     ps2_intc_init(ps2->ee_intc, ps2->ee, ps2->sched);
     ps2_ee_timers_init(ps2->ee_timers, ps2->ee_intc, ps2->sched);
     ps2_ram_init(ps2->iop_ram, RAM_SIZE_2MB);
-    ps2_iop_dma_init(ps2->iop_dma, ps2->iop_intc, ps2->sif, ps2->cdvd, ps2->ee_dma, ps2->sio2, ps2->spu2, ps2->sched, ps2->iop_bus);
+    ps2_iop_dma_init(ps2->iop_dma, ps2->iop_intc, ps2->sif, ps2->cdvd, ps2->ee_dma, ps2->sio2, ps2->spu2, ps2->speed, ps2->sched, ps2->iop_bus);
     ps2_ram_init(ps2->iop_spr, RAM_SIZE_1KB);
     ps2_iop_intc_init(ps2->iop_intc, ps2->iop);
     ps2_iop_timers_init(ps2->iop_timers, ps2->iop_intc, ps2->sched);
@@ -105,7 +107,7 @@ void ps2_init(struct ps2_state* ps2) {
     ps2_fw_init(ps2->fw, ps2->iop_intc);
     ps2_sbus_init(ps2->sbus, ps2->ee_intc, ps2->iop_intc, ps2->sched);
     ps2_dev9_init(ps2->dev9, DEV9_TYPE_EXPBAY);
-    ps2_speed_init(ps2->speed, ps2->iop_intc);
+    ps2_speed_init(ps2->speed, ps2->iop_intc, ps2->sched);
     ps2_bios_init(ps2->bios);
     ps2_bios_init(ps2->rom1);
     ps2_bios_init(ps2->rom2);
@@ -241,7 +243,7 @@ void ps2_reset(struct ps2_state* ps2) {
     ps2_vif_init(ps2->vif1, 1, ps2->vu1, ps2->gif, ps2->ee_intc, ps2->sched, ps2->ee_bus);
     ps2_intc_init(ps2->ee_intc, ps2->ee, ps2->sched);
     ps2_ee_timers_init(ps2->ee_timers, ps2->ee_intc, ps2->sched);
-    ps2_iop_dma_init(ps2->iop_dma, ps2->iop_intc, ps2->sif, ps2->cdvd, ps2->ee_dma, ps2->sio2, ps2->spu2, ps2->sched, ps2->iop_bus);
+    ps2_iop_dma_init(ps2->iop_dma, ps2->iop_intc, ps2->sif, ps2->cdvd, ps2->ee_dma, ps2->sio2, ps2->spu2, ps2->speed, ps2->sched, ps2->iop_bus);
     ps2_iop_intc_init(ps2->iop_intc, ps2->iop);
     ps2_iop_timers_init(ps2->iop_timers, ps2->iop_intc, ps2->sched);
     ps2_spu2_init(ps2->spu2, ps2->iop_dma, ps2->iop_intc, ps2->sched);
@@ -249,6 +251,7 @@ void ps2_reset(struct ps2_state* ps2) {
     ps2_fw_init(ps2->fw, ps2->iop_intc);
     ps2_sbus_init(ps2->sbus, ps2->ee_intc, ps2->iop_intc, ps2->sched);
     ps2_cdvd_reset(ps2->cdvd);
+    ps2_ata_reset(ps2->speed->ata);
 
     ps2_gif_reset(ps2->gif);
     ps2_gs_reset(ps2->gs);
@@ -284,9 +287,39 @@ void ps2_reset(struct ps2_state* ps2) {
 //         if (depth > 0) --depth;
 // }
 
+// Upper bound on how far an idle EE is fast-forwarded in one go, this
+// bounds the latency of events raised by the IOP while the EE is idle
+#define PS2_IDLE_SKIP_MAX 8192
+
+static inline int ps2_get_idle_cycles(struct ps2_state* ps2) {
+    long cycles = PS2_IDLE_SKIP_MAX;
+
+    if (ps2->sched->nevents)
+        cycles = sched_next_event(ps2->sched)->cycles / ps2->timescale;
+
+    // EE timers are only advanced after the skip, stop short of the
+    // next compare/overflow so its IRQ isn't raised late
+    uint32_t timer = ps2_ee_timers_cycles_until_check(ps2->ee_timers);
+
+    if (timer < PS2_IDLE_SKIP_MAX && (long)timer < cycles)
+        cycles = timer;
+
+    if (cycles < 0)
+        return 0;
+
+    return cycles > PS2_IDLE_SKIP_MAX ? PS2_IDLE_SKIP_MAX : (int)cycles;
+}
+
 void ps2_cycle(struct ps2_state* ps2) {
     int cycles = ee_run_block(ps2->ee, 128);
 
+    // The EE is spinning on an idle loop, skip straight to the next event
+    cycles += ee_skip_idle(ps2->ee, ps2_get_idle_cycles(ps2));
+
+    // Scheduler events can change memory the IOP might be polling,
+    // so let it re-run its idle loop once per slice
+    iop_wake(ps2->iop);
+
     ps2->ee_cycles += cycles;
 
     sched_tick(ps2->sched, ps2->timescale * cycles);
@@ -322,6 +355,8 @@ void ps2_step_ee(struct ps2_state* ps2) {
 }
 
 void ps2_step_iop(struct ps2_state* ps2) {
+    iop_wake(ps2->iop);
+
     for (int i = 0; i < 8; i++) {
         ps2_ee_timers_tick(ps2->ee_timers);
         ee_step(ps2->ee);
@@ -568,6 +603,7 @@ void ps2_set_system(struct ps2_state* ps2, int system) {
     ee_bus_data.write32 = ee_bus_write32;
     ee_bus_data.write64 = ee_bus_write64;
     ee_bus_data.write128 = ee_bus_write128;
+    ee_bus_data.get_span = ee_bus_get_span;
     ee_bus_data.udata = ps2->ee_bus;
 
     ee_set_ram_size(ps2->ee, ee_ram_size);
@@ -4,6 +4,41 @@
 
 #include "ps2_elf.h"
 
+// Read a segment straight into EE memory, zeroing the part past the
+// end of the file data
+static int ps2_elf_load_segment(struct ps2_state* ps2, FILE* file, uint32_t addr, uint32_t filesz, uint32_t memsz) {
+    uint32_t done = 0;
+
+    while (done < memsz) {
+        uint32_t len = memsz - done;
+        uint8_t* ptr = (uint8_t*)ee_bus_get_span(ps2->ee_bus, addr + done, &len, 1);
+
+        if (!ptr) {
+            printf("elf: Segment at 0x%08x is outside of RAM\n", addr + done);
+
+            return 1;
+        }
+
+        uint32_t size = 0;
+
+        if (done < filesz) {
+            size = filesz - done;
+
+            if (size > len)
+                size = len;
+
+            if (fread(ptr, 1, size, file) != size)
+                return 1;
+        }
+
+        memset(ptr + size, 0, len - size);
+
+        done += len;
+    }
+
+    return 0;
+}
+
 int ps2_elf_load(struct ps2_state* ps2, const char* path) {
     ps2_reset(ps2);
 
@@ -50,13 +85,10 @@ int ps2_elf_load(struct ps2_state* ps2, const char* path) {
             phdr.p_align
         );
 
-        // Clear p_memsz bytes of EE RAM
-        memset(ps2->ee_ram->buf + phdr.p_vaddr, 0, phdr.p_memsz);
-
         // Read segment binary
         fseek(file, phdr.p_offset, SEEK_SET);
 
-        if (!fread(ps2->ee_ram->buf + phdr.p_vaddr, 1, phdr.p_filesz, file)) {
+        if (ps2_elf_load_segment(ps2, file, phdr.p_vaddr, phdr.p_filesz, phdr.p_memsz)) {
             printf("elf: Couldn't read segment binary\n");
         }
     }
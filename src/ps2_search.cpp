@@ -0,0 +1,404 @@
+#include <type_traits>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <thread>
+#include <bit>
+
+#ifdef _EE_USE_INTRINSICS
+#include <emmintrin.h>
+#endif
+
+#include "ps2_search.h"
+
+// Bitmap words per rank entry, the rank table holds the amount of matches
+// before each block so looking up the n-th match doesn't walk the whole
+// bitmap
+#define SEARCH_RANK_WORDS 64
+
+// Don't bother spawning threads for less than this many bitmap words
+#define SEARCH_WORDS_PER_THREAD 4096
+
+struct ps2_search {
+    std::vector <uint64_t> bitmap;
+    std::vector <size_t> rank;
+    std::vector <uint8_t> snapshot;
+
+    uint32_t size = 0;
+    uint32_t stride = 0;
+    uint32_t elements = 0;
+    int type = 0;
+    size_t matches = 0;
+};
+
+static inline int search_type_size(int type) {
+    switch (type) {
+        case PS2_SEARCH_U8:
+        case PS2_SEARCH_S8:
+            return 1;
+        case PS2_SEARCH_U16:
+        case PS2_SEARCH_S16:
+            return 2;
+        case PS2_SEARCH_U32:
+        case PS2_SEARCH_S32:
+        case PS2_SEARCH_F32:
+            return 4;
+    }
+
+    return 8;
+}
+
+template <typename T, int CMP> static inline bool search_cmp(T a, T b) {
+    if constexpr (CMP == PS2_SEARCH_CMP_EQ) return a == b;
+    if constexpr (CMP == PS2_SEARCH_CMP_NE) return a != b;
+    if constexpr (CMP == PS2_SEARCH_CMP_LT) return a < b;
+    if constexpr (CMP == PS2_SEARCH_CMP_GT) return a > b;
+    if constexpr (CMP == PS2_SEARCH_CMP_LE) return a <= b;
+    if constexpr (CMP == PS2_SEARCH_CMP_GE) return a >= b;
+
+    return false;
+}
+
+template <typename T, int CMP, bool PREV>
+static inline uint64_t search_word_scalar(const uint8_t* buf, const uint8_t* prev, uint32_t stride, uint32_t first, int n, T value) {
+    uint64_t mask = 0;
+
+    for (int i = 0; i < n; i++) {
+        uint32_t offset = (first + i) * stride;
+
+        T a, b = value;
+
+        memcpy(&a, buf + offset, sizeof(T));
+
+        if constexpr (PREV)
+            memcpy(&b, prev + offset, sizeof(T));
+
+        mask |= (uint64_t)search_cmp<T, CMP>(a, b) << i;
+    }
+
+    return mask;
+}
+
+#ifdef _EE_USE_INTRINSICS
+template <typename T> static inline __m128i search_splat(T value) {
+    uint8_t buf[16];
+
+    for (int i = 0; i < 16; i += sizeof(T))
+        memcpy(buf + i, &value, sizeof(T));
+
+    return _mm_loadu_si128((const __m128i*)buf);
+}
+
+template <typename T> static inline __m128i search_cmpeq(__m128i a, __m128i b) {
+    if constexpr (sizeof(T) == 1) return _mm_cmpeq_epi8(a, b);
+    if constexpr (sizeof(T) == 2) return _mm_cmpeq_epi16(a, b);
+
+    return _mm_cmpeq_epi32(a, b);
+}
+
+template <typename T> static inline __m128i search_cmpgt(__m128i a, __m128i b) {
+    if constexpr (sizeof(T) == 1) return _mm_cmpgt_epi8(a, b);
+    if constexpr (sizeof(T) == 2) return _mm_cmpgt_epi16(a, b);
+
+    return _mm_cmpgt_epi32(a, b);
+}
+
+template <typename T, int CMP> static inline __m128i search_cmp_simd(__m128i a, __m128i b) {
+    if constexpr (std::is_floating_point_v <T>) {
+        __m128 fa = _mm_castsi128_ps(a);
+        __m128 fb = _mm_castsi128_ps(b);
+
+        if constexpr (CMP == PS2_SEARCH_CMP_EQ) return _mm_castps_si128(_mm_cmpeq_ps(fa, fb));
+        if constexpr (CMP == PS2_SEARCH_CMP_NE) return _mm_castps_si128(_mm_cmpneq_ps(fa, fb));
+        if constexpr (CMP == PS2_SEARCH_CMP_LT) return _mm_castps_si128(_mm_cmplt_ps(fa, fb));
+        if constexpr (CMP == PS2_SEARCH_CMP_GT) return _mm_castps_si128(_mm_cmpgt_ps(fa, fb));
+        if constexpr (CMP == PS2_SEARCH_CMP_LE) return _mm_castps_si128(_mm_cmple_ps(fa, fb));
+
+        return _mm_castps_si128(_mm_cmpge_ps(fa, fb));
+    } else {
+        // SSE2 only has signed compares, flip the sign bit to compare
+        // unsigned values
+        if constexpr (std::is_unsigned_v <T>) {
+            __m128i bias = search_splat<T>((T)((T)1 << (sizeof(T) * 8 - 1)));
+
+            a = _mm_xor_si128(a, bias);
+            b = _mm_xor_si128(b, bias);
+        }
+
+        __m128i ones = _mm_set1_epi32(-1);
+
+        if constexpr (CMP == PS2_SEARCH_CMP_EQ) return search_cmpeq<T>(a, b);
+        if constexpr (CMP == PS2_SEARCH_CMP_NE) return _mm_xor_si128(search_cmpeq<T>(a, b), ones);
+        if constexpr (CMP == PS2_SEARCH_CMP_LT) return search_cmpgt<T>(b, a);
+        if constexpr (CMP == PS2_SEARCH_CMP_GT) return search_cmpgt<T>(a, b);
+        if constexpr (CMP == PS2_SEARCH_CMP_LE) return _mm_xor_si128(search_cmpgt<T>(a, b), ones);
+
+        return _mm_xor_si128(search_cmpgt<T>(b, a), ones);
+    }
+}
+
+// Packs a lane mask into one bit per lane
+template <typename T> static inline uint64_t search_movemask(__m128i m) {
+    if constexpr (sizeof(T) == 1) return (uint64_t)_mm_movemask_epi8(m);
+    if constexpr (sizeof(T) == 2) return (uint64_t)(_mm_movemask_epi8(_mm_packs_epi16(m, _mm_setzero_si128())) & 0xff);
+
+    return (uint64_t)_mm_movemask_ps(_mm_castsi128_ps(m));
+}
+
+template <typename T, int CMP, bool PREV>
+static inline uint64_t search_word_simd(const uint8_t* buf, const uint8_t* prev, uint32_t first, __m128i value) {
+    constexpr int lanes = 16 / sizeof(T);
+
+    const uint8_t* p = buf + first * sizeof(T);
+    const uint8_t* q = prev + first * sizeof(T);
+
+    uint64_t mask = 0;
+
+    for (int i = 0; i < 64; i += lanes) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(p + i * sizeof(T)));
+        __m128i b = value;
+
+        if constexpr (PREV)
+            b = _mm_loadu_si128((const __m128i*)(q + i * sizeof(T)));
+
+        mask |= search_movemask<T>(search_cmp_simd<T, CMP>(a, b)) << i;
+    }
+
+    return mask;
+}
+#endif
+
+template <typename T, int CMP, bool PREV>
+static size_t search_range(struct ps2_search* search, const uint8_t* buf, uint32_t first_word, uint32_t last_word, T value, bool narrow) {
+    const uint8_t* prev = search->snapshot.data();
+
+    size_t count = 0;
+
+#ifdef _EE_USE_INTRINSICS
+    __m128i simd_value;
+
+    if constexpr (sizeof(T) <= 4)
+        simd_value = search_splat<T>(value);
+#endif
+
+    for (uint32_t w = first_word; w < last_word; w++) {
+        uint64_t live = narrow ? search->bitmap[w] : ~0ull;
+
+        // Narrowing passes skip words with no candidates left
+        if (!live)
+            continue;
+
+        uint32_t first = w * 64;
+        int n = std::min<uint32_t>(64, search->elements - first);
+
+        uint64_t mask;
+
+#ifdef _EE_USE_INTRINSICS
+        if constexpr (sizeof(T) <= 4) {
+            if (n == 64 && search->stride == sizeof(T)) {
+                mask = search_word_simd<T, CMP, PREV>(buf, prev, first, simd_value);
+            } else {
+                mask = search_word_scalar<T, CMP, PREV>(buf, prev, search->stride, first, n, value);
+            }
+        } else
+#endif
+        mask = search_word_scalar<T, CMP, PREV>(buf, prev, search->stride, first, n, value);
+
+        if (n < 64)
+            mask &= (1ull << n) - 1;
+
+        mask &= live;
+
+        search->bitmap[w] = mask;
+
+        count += std::popcount(mask);
+    }
+
+    return count;
+}
+
+template <typename T, int CMP, bool PREV>
+static size_t search_run(struct ps2_search* search, const uint8_t* buf, T value, bool narrow) {
+    uint32_t words = search->bitmap.size();
+    uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+
+    threads = std::min(threads, words / SEARCH_WORDS_PER_THREAD + 1);
+
+    if (threads == 1)
+        return search_range<T, CMP, PREV>(search, buf, 0, words, value, narrow);
+
+    // Every worker owns a disjoint range of bitmap words
+    std::vector <std::thread> workers;
+    std::vector <size_t> counts(threads);
+
+    uint32_t chunk = (words + threads - 1) / threads;
+
+    for (uint32_t i = 0; i < threads; i++) {
+        uint32_t first = std::min(words, i * chunk);
+        uint32_t last = std::min(words, first + chunk);
+
+        workers.emplace_back([=, &counts] {
+            counts[i] = search_range<T, CMP, PREV>(search, buf, first, last, value, narrow);
+        });
+    }
+
+    size_t count = 0;
+
+    for (uint32_t i = 0; i < threads; i++) {
+        workers[i].join();
+
+        count += counts[i];
+    }
+
+    return count;
+}
+
+template <typename T, bool PREV>
+static size_t search_dispatch_cmp(struct ps2_search* search, const uint8_t* buf, int cmp, T value, bool narrow) {
+    switch (cmp) {
+        case PS2_SEARCH_CMP_EQ: return search_run<T, PS2_SEARCH_CMP_EQ, PREV>(search, buf, value, narrow);
+        case PS2_SEARCH_CMP_NE: return search_run<T, PS2_SEARCH_CMP_NE, PREV>(search, buf, value, narrow);
+        case PS2_SEARCH_CMP_LT: return search_run<T, PS2_SEARCH_CMP_LT, PREV>(search, buf, value, narrow);
+        case PS2_SEARCH_CMP_GT: return search_run<T, PS2_SEARCH_CMP_GT, PREV>(search, buf, value, narrow);
+        case PS2_SEARCH_CMP_LE: return search_run<T, PS2_SEARCH_CMP_LE, PREV>(search, buf, value, narrow);
+        case PS2_SEARCH_CMP_GE: return search_run<T, PS2_SEARCH_CMP_GE, PREV>(search, buf, value, narrow);
+    }
+
+    return 0;
+}
+
+template <typename T, bool PREV>
+static size_t search_dispatch_value(struct ps2_search* search, const uint8_t* buf, int cmp, uint64_t value, bool narrow) {
+    T v;
+
+    memcpy(&v, &value, sizeof(T));
+
+    return search_dispatch_cmp<T, PREV>(search, buf, cmp, v, narrow);
+}
+
+template <bool PREV>
+static size_t search_dispatch(struct ps2_search* search, const uint8_t* buf, int cmp, uint64_t value, bool narrow) {
+    switch (search->type) {
+        case PS2_SEARCH_U8: return search_dispatch_value<uint8_t, PREV>(search, buf, cmp, value, narrow);
+        case PS2_SEARCH_U16: return search_dispatch_value<uint16_t, PREV>(search, buf, cmp, value, narrow);
+        case PS2_SEARCH_U32: return search_dispatch_value<uint32_t, PREV>(search, buf, cmp, value, narrow);
+        case PS2_SEARCH_U64: return search_dispatch_value<uint64_t, PREV>(search, buf, cmp, value, narrow);
+        case PS2_SEARCH_S8: return search_dispatch_value<int8_t, PREV>(search, buf, cmp, value, narrow);
+        case PS2_SEARCH_S16: return search_dispatch_value<int16_t, PREV>(search, buf, cmp, value, narrow);
+        case PS2_SEARCH_S32: return search_dispatch_value<int32_t, PREV>(search, buf, cmp, value, narrow);
+        case PS2_SEARCH_S64: return search_dispatch_value<int64_t, PREV>(search, buf, cmp, value, narrow);
+        case PS2_SEARCH_F32: return search_dispatch_value<float, PREV>(search, buf, cmp, value, narrow);
+        case PS2_SEARCH_F64: return search_dispatch_value<double, PREV>(search, buf, cmp, value, narrow);
+    }
+
+    return 0;
+}
+
+static size_t search_finish(struct ps2_search* search, const uint8_t* buf, size_t count) {
+    search->matches = count;
+
+    // Rebuild rank table
+    size_t blocks = (search->bitmap.size() + SEARCH_RANK_WORDS - 1) / SEARCH_RANK_WORDS;
+    size_t total = 0;
+
+    search->rank.resize(blocks + 1);
+
+    for (size_t i = 0; i < search->bitmap.size(); i++) {
+        if (!(i % SEARCH_RANK_WORDS))
+            search->rank[i / SEARCH_RANK_WORDS] = total;
+
+        total += std::popcount(search->bitmap[i]);
+    }
+
+    search->rank[blocks] = total;
+
+    // Take a snapshot for the next narrowing pass
+    search->snapshot.assign(buf, buf + search->size);
+
+    return count;
+}
+
+extern "C" struct ps2_search* ps2_search_create(void) {
+    return new ps2_search;
+}
+
+extern "C" void ps2_search_clear(struct ps2_search* search) {
+    search->bitmap.clear();
+    search->rank.clear();
+    search->snapshot.clear();
+
+    search->size = 0;
+    search->elements = 0;
+    search->matches = 0;
+}
+
+extern "C" void ps2_search_destroy(struct ps2_search* search) {
+    delete search;
+}
+
+extern "C" size_t ps2_search_scan(struct ps2_search* search, const uint8_t* buf, uint32_t size, int type, int cmp, uint64_t value, int aligned) {
+    uint32_t type_size = search_type_size(type);
+
+    search->type = type;
+    search->size = size;
+    search->stride = aligned ? type_size : 1;
+
+    if (aligned) {
+        search->elements = size / type_size;
+    } else {
+        search->elements = size >= type_size ? (size - type_size + 1) : 0;
+    }
+
+    search->bitmap.assign((search->elements + 63) / 64, 0);
+
+    return search_finish(search, buf, search_dispatch<false>(search, buf, cmp, value, false));
+}
+
+extern "C" size_t ps2_search_filter(struct ps2_search* search, const uint8_t* buf, int cmp, uint64_t value) {
+    if (!search->size)
+        return 0;
+
+    return search_finish(search, buf, search_dispatch<false>(search, buf, cmp, value, true));
+}
+
+extern "C" size_t ps2_search_filter_prev(struct ps2_search* search, const uint8_t* buf, int cmp) {
+    if (!search->size)
+        return 0;
+
+    return search_finish(search, buf, search_dispatch<true>(search, buf, cmp, 0, true));
+}
+
+extern "C" size_t ps2_search_count(struct ps2_search* search) {
+    return search->matches;
+}
+
+extern "C" int ps2_search_get(struct ps2_search* search, size_t index, uint32_t* addr, uint64_t* prev) {
+    if (index >= search->matches)
+        return 0;
+
+    // Find the last block that starts at or before the requested match
+    size_t block = std::upper_bound(search->rank.begin(), search->rank.end(), index) - search->rank.begin() - 1;
+    size_t seen = search->rank[block];
+    size_t w = block * SEARCH_RANK_WORDS;
+
+    while (seen + std::popcount(search->bitmap[w]) <= index)
+        seen += std::popcount(search->bitmap[w++]);
+
+    uint64_t word = search->bitmap[w];
+
+    // Drop the matches that come before the one we want
+    for (; seen < index; seen++)
+        word &= word - 1;
+
+    uint32_t element = w * 64 + std::countr_zero(word);
+
+    *addr = element * search->stride;
+
+    if (prev) {
+        *prev = 0;
+
+        memcpy(prev, &search->snapshot[*addr], search_type_size(search->type));
+    }
+
+    return 1;
+}
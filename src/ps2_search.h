@@ -0,0 +1,50 @@
+#ifndef PS2_SEARCH_H
+#define PS2_SEARCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define PS2_SEARCH_U8 0
+#define PS2_SEARCH_U16 1
+#define PS2_SEARCH_U32 2
+#define PS2_SEARCH_U64 3
+#define PS2_SEARCH_S8 4
+#define PS2_SEARCH_S16 5
+#define PS2_SEARCH_S32 6
+#define PS2_SEARCH_S64 7
+#define PS2_SEARCH_F32 8
+#define PS2_SEARCH_F64 9
+
+#define PS2_SEARCH_CMP_EQ 0
+#define PS2_SEARCH_CMP_NE 1
+#define PS2_SEARCH_CMP_LT 2
+#define PS2_SEARCH_CMP_GT 3
+#define PS2_SEARCH_CMP_LE 4
+#define PS2_SEARCH_CMP_GE 5
+
+// Candidates are kept as a bitmap with one bit per element (or per byte
+// for unaligned searches), narrowing passes only visit set bits. The
+// engine also keeps a snapshot of memory as of the last pass, which is
+// used as the previous value for changed/unchanged/greater/less filters.
+struct ps2_search;
+
+struct ps2_search* ps2_search_create(void);
+void ps2_search_clear(struct ps2_search* search);
+void ps2_search_destroy(struct ps2_search* search);
+
+// value holds the raw bits of the reference value in the low bytes
+size_t ps2_search_scan(struct ps2_search* search, const uint8_t* buf, uint32_t size, int type, int cmp, uint64_t value, int aligned);
+size_t ps2_search_filter(struct ps2_search* search, const uint8_t* buf, int cmp, uint64_t value);
+size_t ps2_search_filter_prev(struct ps2_search* search, const uint8_t* buf, int cmp);
+size_t ps2_search_count(struct ps2_search* search);
+int ps2_search_get(struct ps2_search* search, size_t index, uint32_t* addr, uint64_t* prev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -34,6 +34,27 @@ void queue_push(struct queue_state* queue, uint32_t value) {
     queue->buf[queue->size++] = value;
 }
 
+void queue_push_block(struct queue_state* queue, const uint32_t* data, unsigned int count) {
+    if ((queue->size + count) > queue->cap) {
+        while ((queue->size + count) > queue->cap)
+            queue->cap *= 2;
+
+        uint32_t* buf = realloc(queue->buf, queue->cap * sizeof(uint32_t));
+
+        if (!buf) {
+            printf("queue: Couldn't allocate memory\n");
+
+            exit(1);
+        }
+
+        queue->buf = buf;
+    }
+
+    memcpy(queue->buf + queue->size, data, count * sizeof(uint32_t));
+
+    queue->size += count;
+}
+
 uint32_t queue_pop(struct queue_state* queue) {
     if (queue->index == queue->size)
         return 0;
@@ -18,6 +18,7 @@ struct queue_state {
 struct queue_state* queue_create(void);
 void queue_init(struct queue_state* queue);
 void queue_push(struct queue_state* queue, uint32_t value);
+void queue_push_block(struct queue_state* queue, const uint32_t* data, unsigned int count);
 uint32_t queue_pop(struct queue_state* queue);
 uint32_t queue_peek(struct queue_state* queue);
 uint32_t queue_at(struct queue_state* queue, int idx);
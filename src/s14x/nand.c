@@ -12,19 +12,28 @@ struct s14x_nand* s14x_nand_create(void) {
 int s14x_nand_init(struct s14x_nand* nand) {
     memset(nand, 0, sizeof(struct s14x_nand));
 
-    nand->buf = malloc(S14X_NAND_PAGE_SIZE_ECC);
+    nand->buf = nand->page;
     nand->state = S14X_NAND_STATE_READ_BYTE0;
 
     return 1;
 }
 
 int s14x_nand_load(struct s14x_nand* nand, const char* path) {
-    nand->file = fopen(path, "rb");
+    if (nand->file)
+        mapped_file_close(nand->file);
+
+    nand->file = mapped_file_open(path, MAPPED_FILE_READ, 0);
 
     if (!nand->file) {
+        nand->data = NULL;
+        nand->data_size = 0;
+
         return 0;
     }
 
+    nand->data = mapped_file_data(nand->file);
+    nand->data_size = mapped_file_size(nand->file);
+
     return 1;
 }
 
@@ -57,14 +66,21 @@ void nand_handle_cmd_read(struct s14x_nand* nand) {
     nand->size = S14X_NAND_PAGE_SIZE_ECC;
     nand->index = nand->byte_offset;
 
-    if (!nand->file) {
-        memset(nand->buf, 0, S14X_NAND_PAGE_SIZE_ECC);
+    size_t offset = (size_t)nand->page_offset * S14X_NAND_PAGE_SIZE_ECC;
+
+    if (offset + S14X_NAND_PAGE_SIZE_ECC <= nand->data_size) {
+        nand->buf = nand->data + offset;
 
         return;
     }
 
-    fseek(nand->file, nand->page_offset * S14X_NAND_PAGE_SIZE_ECC, SEEK_SET);
-    fread(nand->buf, 1, S14X_NAND_PAGE_SIZE_ECC, nand->file);
+    // Pad pages past the end of the image with zeroes
+    memset(nand->page, 0, S14X_NAND_PAGE_SIZE_ECC);
+
+    if (offset < nand->data_size)
+        memcpy(nand->page, nand->data + offset, nand->data_size - offset);
+
+    nand->buf = nand->page;
 }
 
 uint64_t s14x_nand_read(struct s14x_nand* nand, uint32_t addr) {
@@ -114,7 +130,7 @@ void s14x_nand_write(struct s14x_nand* nand, uint32_t addr, uint64_t data) {
 }
 
 void s14x_nand_destroy(struct s14x_nand* nand) {
-    if (nand->buf) free(nand->buf);
+    if (nand->file) mapped_file_close(nand->file);
 
     free(nand);
 }
\ No newline at end of file
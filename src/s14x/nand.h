@@ -8,6 +8,8 @@ extern "C" {
 #include <stdint.h>
 #include <stdio.h>
 
+#include "shared/mapped_file.h"
+
 #define S14X_NAND_CMD_READ   0x30
 #define S14X_NAND_CMD_ERASE  0x60
 #define S14X_NAND_CMD_WRITE  0x80
@@ -31,10 +33,17 @@ extern "C" {
 #define S14X_NAND_REG_OUTBYTE 8
 
 struct s14x_nand {
-    FILE* file;
+    struct mapped_file* file;
+    const uint8_t* data;
+    size_t data_size;
+
     int enable;
     uint8_t cmd;
-    uint8_t* buf;
+
+    // Page being read out, points straight into the mapping unless
+    // the page is (partially) past the end of the image
+    const uint8_t* buf;
+    uint8_t page[S14X_NAND_PAGE_SIZE_ECC];
     int index;
     int size;
 
@@ -12,29 +12,30 @@ int s14x_sram_init(struct s14x_sram* sram, int* write_flag) {
     memset(sram, 0, sizeof(struct s14x_sram));
 
     sram->write_flag = write_flag;
+    sram->buf = sram->mem;
 
     return 0;
 }
 
 int s14x_sram_load(struct s14x_sram* sram, const char* path) {
-    FILE* file = fopen(path, "rb");
+    if (sram->file) {
+        mapped_file_close(sram->file);
 
-    sram->path = path;
-
-    // If the file doesn't exist then we'll create it
-    if (!file) {
-        fclose(file);
+        sram->buf = sram->mem;
+    }
 
-        file = fopen(path, "wb");
+    // If the file doesn't exist then it's created and zero-filled
+    sram->file = mapped_file_open(path, MAPPED_FILE_WRITE, S14X_SRAM_SIZE);
 
-        fwrite(sram->buf, 1, S14X_SRAM_SIZE, file);
-        fclose(file);
+    if (!sram->file) {
+        printf("s14x_sram: Couldn't map SRAM file \'%s\'\n", path);
 
         return 0;
     }
 
-    fread(sram->buf, 1, S14X_SRAM_SIZE, file);
-    fclose(file);
+    sram->buf = mapped_file_data(sram->file);
+
+    mapped_file_sync_every(sram->file, S14X_SRAM_SYNC_INTERVAL);
 
     return 1;
 }
@@ -70,12 +71,8 @@ void s14x_sram_write32(struct s14x_sram* sram, uint32_t addr, uint64_t data) {
 }
 
 void s14x_sram_destroy(struct s14x_sram* sram) {
-    if (sram->path) {
-        FILE* file = fopen(sram->path, "wb");
-
-        fwrite(sram->buf, 1, S14X_SRAM_SIZE, file);
-        fclose(file);
-    }
+    if (sram->file)
+        mapped_file_close(sram->file);
 
     free(sram);
 }
\ No newline at end of file
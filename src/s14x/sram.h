@@ -8,12 +8,21 @@ extern "C" {
 #include <stdint.h>
 #include <stdio.h>
 
+#include "shared/mapped_file.h"
+
 #define S14X_SRAM_SIZE 0x8000
 
+// Delay between background syncs of the SRAM file
+#define S14X_SRAM_SYNC_INTERVAL 1000
+
 struct s14x_sram {
-    const char* path;
+    struct mapped_file* file;
     int* write_flag;
-    uint8_t buf[S14X_SRAM_SIZE];
+
+    // Points to a shared mapping of the SRAM file once one is loaded,
+    // writes land in the file directly
+    uint8_t* buf;
+    uint8_t mem[S14X_SRAM_SIZE];
 };
 
 struct s14x_sram* s14x_sram_create(void);
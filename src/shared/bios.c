@@ -3,24 +3,12 @@
 #include <stdio.h>
 
 #include "bios.h"
+#include "rom_cache.h"
 
 struct ps2_bios* ps2_bios_create(void) {
     return malloc(sizeof(struct ps2_bios));
 }
 
-static int get_file_size(FILE* file) {
-    int prev = ftell(file);
-    int size;
-
-    fseek(file, 0, SEEK_END);
-
-    size = ftell(file);
-
-    fseek(file, 0, SEEK_SET);
-
-    return size;
-}
-
 void ps2_bios_init(struct ps2_bios* bios) {
     memset(bios, 0, sizeof(struct ps2_bios));
 
@@ -39,29 +27,40 @@ int ps2_bios_load(struct ps2_bios* bios, const char* path) {
     if (!path)
         return 1;
 
-    FILE* file = fopen(path, "rb");
+    size_t size;
+    const uint8_t* buf = rom_cache_open(path, &size);
 
-    if (!file)
-        return 1;
+    if (!buf) {
+        printf("bios: Couldn't map binary from \'%s\'\n", path);
 
-    // Free dummy data
-    free(bios->buf);
+        return 1;
+    }
 
-    // "size" is actually a mask
-    bios->size = get_file_size(file) - 1;
-    bios->buf = malloc(bios->size + 1);
+    // Free dummy data or the previous image
+    if (bios->mapped) {
+        rom_cache_close(bios->buf);
+    } else {
+        free(bios->buf);
+    }
 
-    if (!fread(bios->buf, 1, bios->size + 1, file)) {
-        printf("bios: Couldn't read binary from \'%s\'\n", path);
+    // The mapping is read-only, BIOS writes aren't mapped on
+    // either bus so nothing ever writes through buf
+    bios->buf = (uint8_t*)buf;
+    bios->mapped = 1;
 
-        return 1;
-    }
+    // "size" is actually a mask
+    bios->size = size - 1;
 
     return 0;
 }
 
 void ps2_bios_destroy(struct ps2_bios* bios) {
-    free(bios->buf);
+    if (bios->mapped) {
+        rom_cache_close(bios->buf);
+    } else {
+        free(bios->buf);
+    }
+
     free(bios);
 }
 
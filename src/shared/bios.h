@@ -10,6 +10,10 @@ extern "C" {
 struct ps2_bios {
     uint8_t* buf;
     size_t size;
+
+    // Loaded images are shared read-only mappings from the ROM cache,
+    // only the dummy image is owned by the instance
+    int mapped;
 };
 
 struct ps2_bios* ps2_bios_create(void);
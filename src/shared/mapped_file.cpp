@@ -0,0 +1,232 @@
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <chrono>
+#include <mutex>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "mapped_file.h"
+
+struct mapped_file {
+    uint8_t* buf;
+    size_t size;
+    int mode;
+
+#ifdef _WIN32
+    HANDLE file;
+#else
+    int fd;
+#endif
+
+    // Background sync
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::chrono::milliseconds interval;
+    std::thread sync_thr;
+    bool end = false;
+};
+
+#ifdef _WIN32
+static bool mapped_file_map(struct mapped_file* file, const char* path, size_t min_size) {
+    int write = file->mode == MAPPED_FILE_WRITE;
+
+    file->file = CreateFileA(
+        path,
+        write ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+        FILE_SHARE_READ,
+        NULL,
+        write ? OPEN_ALWAYS : OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        NULL
+    );
+
+    if (file->file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+
+    if (!GetFileSizeEx(file->file, &size))
+        return false;
+
+    file->size = (size_t)size.QuadPart;
+
+    // Creating a writable mapping bigger than the file grows it
+    if (write && file->size < min_size)
+        file->size = min_size;
+
+    if (!file->size)
+        return false;
+
+    HANDLE mapping = CreateFileMappingA(
+        file->file,
+        NULL,
+        write ? PAGE_READWRITE : PAGE_READONLY,
+        (DWORD)((uint64_t)file->size >> 32),
+        (DWORD)file->size,
+        NULL
+    );
+
+    if (!mapping)
+        return false;
+
+    // The view keeps the mapping object alive
+    file->buf = (uint8_t*)MapViewOfFile(mapping, write ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+
+    CloseHandle(mapping);
+
+    return file->buf != NULL;
+}
+
+static void mapped_file_unmap(struct mapped_file* file) {
+    if (file->buf)
+        UnmapViewOfFile(file->buf);
+
+    if (file->file != INVALID_HANDLE_VALUE)
+        CloseHandle(file->file);
+}
+
+static void mapped_file_flush(struct mapped_file* file) {
+    FlushViewOfFile(file->buf, 0);
+    FlushFileBuffers(file->file);
+}
+#else
+static bool mapped_file_map(struct mapped_file* file, const char* path, size_t min_size) {
+    int write = file->mode == MAPPED_FILE_WRITE;
+
+    file->fd = open(path, write ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+
+    if (file->fd == -1)
+        return false;
+
+    struct stat st;
+
+    if (fstat(file->fd, &st))
+        return false;
+
+    file->size = st.st_size;
+
+    if (write && file->size < min_size) {
+        if (ftruncate(file->fd, min_size))
+            return false;
+
+        file->size = min_size;
+    }
+
+    if (!file->size)
+        return false;
+
+    void* buf = mmap(
+        NULL,
+        file->size,
+        write ? (PROT_READ | PROT_WRITE) : PROT_READ,
+        write ? MAP_SHARED : MAP_PRIVATE,
+        file->fd,
+        0
+    );
+
+    if (buf == MAP_FAILED)
+        return false;
+
+    file->buf = (uint8_t*)buf;
+
+    return true;
+}
+
+static void mapped_file_unmap(struct mapped_file* file) {
+    if (file->buf)
+        munmap(file->buf, file->size);
+
+    if (file->fd != -1)
+        close(file->fd);
+}
+
+static void mapped_file_flush(struct mapped_file* file) {
+    msync(file->buf, file->size, MS_SYNC);
+}
+#endif
+
+extern "C" struct mapped_file* mapped_file_open(const char* path, int mode, size_t min_size) {
+    struct mapped_file* file = new mapped_file;
+
+    file->buf = nullptr;
+    file->size = 0;
+    file->mode = mode;
+
+#ifdef _WIN32
+    file->file = INVALID_HANDLE_VALUE;
+#else
+    file->fd = -1;
+#endif
+
+    if (!mapped_file_map(file, path, min_size)) {
+        mapped_file_unmap(file);
+
+        delete file;
+
+        return nullptr;
+    }
+
+    return file;
+}
+
+extern "C" uint8_t* mapped_file_data(struct mapped_file* file) {
+    return file->buf;
+}
+
+extern "C" size_t mapped_file_size(struct mapped_file* file) {
+    return file->size;
+}
+
+extern "C" void mapped_file_sync(struct mapped_file* file) {
+    if (file->mode != MAPPED_FILE_WRITE)
+        return;
+
+    mapped_file_flush(file);
+}
+
+extern "C" void mapped_file_sync_every(struct mapped_file* file, int interval) {
+    if (file->mode != MAPPED_FILE_WRITE || file->sync_thr.joinable())
+        return;
+
+    file->interval = std::chrono::milliseconds(interval);
+
+    file->sync_thr = std::thread([file]() {
+        std::unique_lock <std::mutex> lock(file->mtx);
+
+        while (!file->end) {
+            file->cv.wait_for(lock, file->interval, [file]() { return file->end; });
+
+            // Clean pages are skipped by the kernel, so this is cheap
+            // when nothing was written since the last sync
+            mapped_file_flush(file);
+        }
+    });
+}
+
+extern "C" void mapped_file_close(struct mapped_file* file) {
+    if (file->sync_thr.joinable()) {
+        {
+            std::lock_guard <std::mutex> lock(file->mtx);
+
+            file->end = true;
+        }
+
+        file->cv.notify_one();
+        file->sync_thr.join();
+    }
+
+    mapped_file_sync(file);
+    mapped_file_unmap(file);
+
+    delete file;
+}
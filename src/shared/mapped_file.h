@@ -0,0 +1,36 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define MAPPED_FILE_READ 0
+#define MAPPED_FILE_WRITE 1
+
+struct mapped_file;
+
+// Maps a whole file into memory. Read mappings are read-only, write
+// mappings are shared with the file, which is created if it doesn't
+// exist and grown to at least min_size. Returns NULL on failure
+struct mapped_file* mapped_file_open(const char* path, int mode, size_t min_size);
+uint8_t* mapped_file_data(struct mapped_file* file);
+size_t mapped_file_size(struct mapped_file* file);
+
+// Writes modified pages back to the file
+void mapped_file_sync(struct mapped_file* file);
+
+// Syncs a write mapping from a background thread every interval ms
+void mapped_file_sync_every(struct mapped_file* file, int interval);
+
+// Syncs write mappings one last time before unmapping
+void mapped_file_close(struct mapped_file* file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,89 @@
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <mutex>
+
+extern "C" {
+#include "md5.h"
+}
+
+#include "rom_cache.h"
+#include "mapped_file.h"
+
+struct rom_cache_entry {
+    uint8_t digest[16];
+    struct mapped_file* file;
+    const uint8_t* buf;
+    size_t size;
+    int refs;
+};
+
+static std::mutex rom_cache_mtx;
+static std::vector <rom_cache_entry> rom_cache_entries;
+
+extern "C" const uint8_t* rom_cache_open(const char* path, size_t* size) {
+    struct mapped_file* file = mapped_file_open(path, MAPPED_FILE_READ, 0);
+
+    if (!file)
+        return NULL;
+
+    const uint8_t* buf = mapped_file_data(file);
+    size_t map_size = mapped_file_size(file);
+
+    struct md5_context ctx;
+
+    md5_init(&ctx);
+    md5_update(&ctx, (uint8_t*)buf, map_size);
+    md5_finalize(&ctx);
+
+    std::lock_guard <std::mutex> lock(rom_cache_mtx);
+
+    for (rom_cache_entry& entry : rom_cache_entries) {
+        if (entry.size != map_size || memcmp(entry.digest, ctx.digest, 16))
+            continue;
+
+        // Already mapped, drop our mapping and share the cached one
+        mapped_file_close(file);
+
+        entry.refs++;
+
+        *size = entry.size;
+
+        return entry.buf;
+    }
+
+    rom_cache_entry entry;
+
+    memcpy(entry.digest, ctx.digest, 16);
+
+    entry.file = file;
+    entry.buf = buf;
+    entry.size = map_size;
+    entry.refs = 1;
+
+    rom_cache_entries.push_back(entry);
+
+    *size = map_size;
+
+    return buf;
+}
+
+extern "C" void rom_cache_close(const uint8_t* buf) {
+    std::lock_guard <std::mutex> lock(rom_cache_mtx);
+
+    for (size_t i = 0; i < rom_cache_entries.size(); i++) {
+        rom_cache_entry& entry = rom_cache_entries[i];
+
+        if (entry.buf != buf)
+            continue;
+
+        if (--entry.refs)
+            return;
+
+        mapped_file_close(entry.file);
+
+        rom_cache_entries.erase(rom_cache_entries.begin() + i);
+
+        return;
+    }
+}
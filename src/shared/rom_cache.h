@@ -0,0 +1,24 @@
+#ifndef ROM_CACHE_H
+#define ROM_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Maps a ROM image read-only. Images are keyed by their MD5, so every
+// instance that opens the same contents (even through a different path)
+// shares a single mapping. Returns NULL if the file couldn't be mapped
+const uint8_t* rom_cache_open(const char* path, size_t* size);
+
+// Drops a reference taken by rom_cache_open, the mapping goes away
+// along with the last one
+void rom_cache_close(const uint8_t* buf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
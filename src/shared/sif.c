@@ -13,6 +13,11 @@ void ps2_sif_init(struct ps2_sif* sif, struct ps2_iop_intc* iop_intc) {
 
     sif->ctrl = 0xf0000012;
     sif->iop_intc = iop_intc;
+
+    sif->sif0.capacity = SIF_FIFO_SIZE;
+    sif->sif0.data = malloc(sizeof(uint128_t) * SIF_FIFO_SIZE);
+    sif->sif1.capacity = SIF_FIFO_SIZE;
+    sif->sif1.data = malloc(sizeof(uint128_t) * SIF_FIFO_SIZE);
 }
 
 void ps2_sif_destroy(struct ps2_sif* sif) {
@@ -73,43 +78,110 @@ void ps2_sif_write32(struct ps2_sif* sif, uint32_t addr, uint64_t data) {
     }
 }
 
-void ps2_sif0_write(struct ps2_sif* sif, uint128_t data) {
-    // printf("writing %016lx %016lx to SIF FIFO\n", data.u64[1], data.u64[0]);
+static inline void sif_fifo_grow(struct sif_fifo* fifo, uint32_t qwc) {
+    uint32_t size = fifo->write_index - fifo->read_index;
+    uint32_t capacity = fifo->capacity;
+
+    while ((size + qwc) > capacity)
+        capacity <<= 1;
+
+    uint128_t* data = malloc(sizeof(uint128_t) * capacity);
+
+    if (!data) {
+        fprintf(stderr, "sif: Couldn't resize SIF FIFO\n");
+
+        exit(1);
+    }
+
+    // Unwrap the pending data into the start of the new buffer
+    for (uint32_t i = 0; i < size; i++)
+        data[i] = fifo->data[(fifo->read_index + i) & (fifo->capacity - 1)];
+
+    free(fifo->data);
+
+    fifo->data = data;
+    fifo->capacity = capacity;
+    fifo->read_index = 0;
+    fifo->write_index = size;
+}
 
-    if (!sif->sif0.capacity) {
-        sif->sif0.capacity = 4;
-        sif->sif0.data = malloc(sizeof(uint128_t) * 4);
-    } else if (sif->sif0.write_index == sif->sif0.capacity) {
-        sif->sif0.capacity *= 2;
+static inline void sif_fifo_write(struct sif_fifo* fifo, const void* buf, uint32_t qwc) {
+    const uint8_t* data = (const uint8_t*)buf;
 
-        uint128_t* ptr = realloc(sif->sif0.data, sizeof(uint128_t) * sif->sif0.capacity);
-        
-        if (!ptr) {
-            fprintf(stderr, "sif: Couldn't resize SIF0 buffer\n");
+    if ((fifo->write_index - fifo->read_index + qwc) > fifo->capacity)
+        sif_fifo_grow(fifo, qwc);
 
-            exit(1);
+    while (qwc) {
+        uint32_t index = fifo->write_index & (fifo->capacity - 1);
+        uint32_t len = fifo->capacity - index;
+
+        if (len > qwc)
+            len = qwc;
+
+        memcpy(fifo->data + index, data, len * sizeof(uint128_t));
+
+        fifo->write_index += len;
+        data += len * sizeof(uint128_t);
+        qwc -= len;
+    }
+}
+
+static inline void sif_fifo_read(struct sif_fifo* fifo, void* buf, uint32_t qwc) {
+    uint8_t* data = (uint8_t*)buf;
+
+    while (qwc) {
+        uint32_t size = fifo->write_index - fifo->read_index;
+
+        // If EE requests more data than the IOP produced, then return the last
+        // QW that was actually transferred.
+        // This happens during SIF initialization. The IOP triggers a SIF0 transfer
+        // that sends 8 words of data (2 QW), the first QW is an EE tag that starts
+        // a 2 QW transfer from the SIF FIFO, but the IOP only ever wrote 2 QWs.
+        if (!size) {
+            for (; qwc; qwc--, data += sizeof(uint128_t))
+                memcpy(data, &fifo->last, sizeof(uint128_t));
+
+            return;
         }
 
-        sif->sif0.data = ptr;
+        uint32_t index = fifo->read_index & (fifo->capacity - 1);
+        uint32_t len = fifo->capacity - index;
+
+        if (len > size)
+            len = size;
+
+        if (len > qwc)
+            len = qwc;
+
+        memcpy(data, fifo->data + index, len * sizeof(uint128_t));
+
+        fifo->read_index += len;
+        fifo->last = fifo->data[(fifo->read_index - 1) & (fifo->capacity - 1)];
+        data += len * sizeof(uint128_t);
+        qwc -= len;
     }
+}
+
+void ps2_sif0_write(struct ps2_sif* sif, uint128_t data) {
+    sif_fifo_write(&sif->sif0, &data, 1);
+}
 
-    sif->sif0.data[sif->sif0.write_index++] = data;
+void ps2_sif0_write_block(struct ps2_sif* sif, const void* data, uint32_t qwc) {
+    sif_fifo_write(&sif->sif0, data, qwc);
 }
 
 uint128_t ps2_sif0_read(struct ps2_sif* sif) {
-    // If EE requests more data than the IOP produced, then return the last
-    // QW that was actually transferred.
-    // This happens during SIF initialization. The IOP triggers a SIF0 transfer
-    // that sends 8 words of data (2 QW), the first QW is an EE tag that starts
-    // a 2 QW transfer from the SIF FIFO, but the IOP only ever wrote 2 QWs.
-    if (sif->sif0.read_index == sif->sif0.write_index)
-        return sif->sif0.data[sif->sif0.read_index - 1];
+    uint128_t q;
 
-    uint128_t q = sif->sif0.data[sif->sif0.read_index++];
+    sif_fifo_read(&sif->sif0, &q, 1);
 
     return q;
 }
 
+void ps2_sif0_read_block(struct ps2_sif* sif, void* data, uint32_t qwc) {
+    sif_fifo_read(&sif->sif0, data, qwc);
+}
+
 void ps2_sif0_reset(struct ps2_sif* sif) {
     sif->sif0.read_index = 0;
     sif->sif0.write_index = 0;
@@ -119,43 +191,30 @@ int ps2_sif0_is_empty(struct ps2_sif* sif) {
     return sif->sif0.read_index == sif->sif0.write_index;
 }
 
-void ps2_sif1_write(struct ps2_sif* sif, uint128_t data) {
-    // printf("writing %016lx %016lx to SIF FIFO\n", data.u64[1], data.u64[0]);
-
-    if (!sif->sif1.capacity) {
-        sif->sif1.capacity = 4;
-        sif->sif1.data = malloc(sizeof(uint128_t) * 4);
-    } else if (sif->sif1.write_index == sif->sif1.capacity) {
-        sif->sif1.capacity *= 2;
-
-        uint128_t* ptr = realloc(sif->sif1.data, sizeof(uint128_t) * sif->sif1.capacity);
-        
-        if (!ptr) {
-            fprintf(stderr, "sif: Couldn't resize SIF1 buffer\n");
-
-            exit(1);
-        }
+uint32_t ps2_sif0_size(struct ps2_sif* sif) {
+    return sif->sif0.write_index - sif->sif0.read_index;
+}
 
-        sif->sif1.data = ptr;
-    }
+void ps2_sif1_write(struct ps2_sif* sif, uint128_t data) {
+    sif_fifo_write(&sif->sif1, &data, 1);
+}
 
-    sif->sif1.data[sif->sif1.write_index++] = data;
+void ps2_sif1_write_block(struct ps2_sif* sif, const void* data, uint32_t qwc) {
+    sif_fifo_write(&sif->sif1, data, qwc);
 }
 
 uint128_t ps2_sif1_read(struct ps2_sif* sif) {
-    // If EE requests more data than the IOP produced, then return the last
-    // QW that was actually transferred.
-    // This happens during SIF initialization. The IOP triggers a SIF0 transfer
-    // that sends 8 words of data (2 QW), the first QW is an EE tag that starts
-    // a 2 QW transfer from the SIF FIFO, but the IOP only ever wrote 2 QWs.
-    if (sif->sif1.read_index == sif->sif1.write_index)
-        return sif->sif1.data[sif->sif1.read_index - 1];
+    uint128_t q;
 
-    uint128_t q = sif->sif1.data[sif->sif1.read_index++];
+    sif_fifo_read(&sif->sif1, &q, 1);
 
     return q;
 }
 
+void ps2_sif1_read_block(struct ps2_sif* sif, void* data, uint32_t qwc) {
+    sif_fifo_read(&sif->sif1, data, qwc);
+}
+
 void ps2_sif1_reset(struct ps2_sif* sif) {
     sif->sif1.read_index = 0;
     sif->sif1.write_index = 0;
@@ -163,4 +222,8 @@ void ps2_sif1_reset(struct ps2_sif* sif) {
 
 int ps2_sif1_is_empty(struct ps2_sif* sif) {
     return sif->sif1.read_index == sif->sif1.write_index;
-}
\ No newline at end of file
+}
+
+uint32_t ps2_sif1_size(struct ps2_sif* sif) {
+    return sif->sif1.write_index - sif->sif1.read_index;
+}
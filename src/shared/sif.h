@@ -13,12 +13,27 @@ extern "C" {
 #define SIF_EE_SIDE 0
 #define SIF_IOP_SIDE 1
 
+// Initial FIFO size in qwords, must be a power of 2
+#define SIF_FIFO_SIZE 0x400
+
+/*
+    SIF FIFOs are rings indexed by free-running read and write counters.
+    The real FIFOs are tiny and stall the sending DMA channel when full,
+    but our channels move whole chains at once and can't stall, so if the
+    receiving side isn't ready yet the ring is grown to fit the data.
+
+    Most of the time both channels are already running when a transfer
+    starts. The DMA code then skips the FIFO and copies each packet
+    straight from the sender's memory to the receiver's memory.
+*/
 struct sif_fifo {
-    int read_index;
-    int write_index;
-    int ready;
+    uint32_t read_index;
+    uint32_t write_index;
+    uint32_t capacity;
     uint128_t* data;
-    int capacity;
+
+    // Last qword read, returned again on underflow
+    uint128_t last;
 };
 
 struct ps2_sif {
@@ -43,13 +58,19 @@ void ps2_sif_write32(struct ps2_sif* sif, uint32_t addr, uint64_t data);
 
 // DMA stuff
 void ps2_sif0_write(struct ps2_sif* sif, uint128_t data);
+void ps2_sif0_write_block(struct ps2_sif* sif, const void* data, uint32_t qwc);
 uint128_t ps2_sif0_read(struct ps2_sif* sif);
+void ps2_sif0_read_block(struct ps2_sif* sif, void* data, uint32_t qwc);
 void ps2_sif0_reset(struct ps2_sif* sif);
 int ps2_sif0_is_empty(struct ps2_sif* sif);
+uint32_t ps2_sif0_size(struct ps2_sif* sif);
 void ps2_sif1_write(struct ps2_sif* sif, uint128_t data);
+void ps2_sif1_write_block(struct ps2_sif* sif, const void* data, uint32_t qwc);
 uint128_t ps2_sif1_read(struct ps2_sif* sif);
+void ps2_sif1_read_block(struct ps2_sif* sif, void* data, uint32_t qwc);
 void ps2_sif1_reset(struct ps2_sif* sif);
 int ps2_sif1_is_empty(struct ps2_sif* sif);
+uint32_t ps2_sif1_size(struct ps2_sif* sif);
 
 #ifdef __cplusplus
 }
@@ -8,7 +8,7 @@ struct ps2_speed* ps2_speed_create(void) {
     return malloc(sizeof(struct ps2_speed));
 }
 
-void ps2_speed_init(struct ps2_speed* speed, struct ps2_iop_intc* iop_intc) {
+void ps2_speed_init(struct ps2_speed* speed, struct ps2_iop_intc* iop_intc, struct sched_state* sched) {
     memset(speed, 0, sizeof(struct ps2_speed));
 
     speed->iop_intc = iop_intc;
@@ -17,7 +17,7 @@ void ps2_speed_init(struct ps2_speed* speed, struct ps2_iop_intc* iop_intc) {
     speed->eeprom = ps2_eeprom_create();
 
     ps2_flash_init(speed->flash);
-    ps2_ata_init(speed->ata, speed);
+    ps2_ata_init(speed->ata, speed, sched);
     ps2_eeprom_init(speed->eeprom);
 
     speed->rev8 |= 2;
@@ -153,6 +153,16 @@ int ps2_speed_load_flash(struct ps2_speed* speed, const char* path) {
     return ret;
 }
 
+int ps2_speed_load_hdd(struct ps2_speed* speed, const char* path, const char* overlay) {
+    int ret = ps2_ata_load(speed->ata, path, overlay);
+
+    if (ret) {
+        speed->rev3 |= SPD_CAPS_ATA;
+    }
+
+    return ret;
+}
+
 void ps2_speed_set_mac_address(struct ps2_speed* speed, const uint8_t* mac) {
     uint16_t data[32] = {
         0x0000, 0x0000, 0x0000, 0x0000,
@@ -3,69 +3,607 @@
 
 #include "ata.h"
 
+// Emulated drive latencies (in EE cycles)
+#define ATA_COMMAND_DELAY 10000
+#define ATA_SEEK_DELAY 100000
+#define ATA_SECTOR_DELAY 2000
+
 struct ps2_ata* ps2_ata_create(void) {
     return malloc(sizeof(struct ps2_ata));
 }
 
-void ps2_ata_init(struct ps2_ata* ata, struct ps2_speed* speed) {
+static void ata_set_signature(struct ps2_ata* ata) {
+    ata->error = 0x01; // Diagnostics passed
+    ata->nsector = 1;
+    ata->sector = 1;
+    ata->lcyl = 0;
+    ata->hcyl = 0;
+    ata->select = 0;
+    ata->status = ATA_STAT_DRDY | ATA_STAT_DSC;
+    ata->xfer = ATA_XFER_NONE;
+}
+
+void ps2_ata_init(struct ps2_ata* ata, struct ps2_speed* speed, struct sched_state* sched) {
     memset(ata, 0, sizeof(struct ps2_ata));
 
     ata->speed = speed;
-    ata->nsector = 1;
-    ata->sector = 1;
+    ata->sched = sched;
+
+    ata_set_signature(ata);
 }
 
-int ps2_ata_load(struct ps2_ata* ata, const char* path) {
-    // To-do: Load HDD image
+int ps2_ata_load(struct ps2_ata* ata, const char* path, const char* overlay) {
+    if (!path || !path[0])
+        return 0;
+
+    if (ata->image) {
+        hdd_image_close(ata->image);
+
+        ata->image = NULL;
+    }
+
+    // When an overlay is specified the image at path is used as a
+    // read-only base, and every write goes to the overlay instead
+    if (overlay && overlay[0]) {
+        FILE* file = fopen(overlay, "rb");
+
+        if (file) {
+            fclose(file);
+        } else if (!hdd_image_create(overlay, 0, path)) {
+            printf("ata: Couldn't create overlay \'%s\' for \'%s\'\n", overlay, path);
+
+            return 0;
+        }
+
+        path = overlay;
+    }
+
+    ata->image = hdd_image_open(path);
+
+    if (!ata->image) {
+        printf("ata: Couldn't open HDD image \'%s\'\n", path);
+
+        return 0;
+    }
+
+    ata->sectors = hdd_image_get_sectors(ata->image);
+
+    printf("ata: HDD image \'%s\' loaded (%llu sectors)\n", path, (unsigned long long)ata->sectors);
 
     return 1;
 }
 
+void ps2_ata_reset(struct ps2_ata* ata) {
+    if (ata->image)
+        hdd_image_wait(ata->image);
+
+    ata->control = 0;
+
+    ata_set_signature(ata);
+}
+
 void ps2_ata_destroy(struct ps2_ata* ata) {
+    if (ata->image)
+        hdd_image_close(ata->image);
+
+    free(ata->buf);
     free(ata);
 }
 
-uint64_t ps2_ata_read16(struct ps2_ata* ata, uint32_t addr) {
-    printf("ata: read16 %08x\n", addr);
+static inline void ata_send_irq(struct ps2_ata* ata) {
+    if (ata->control & ATA_CTRL_NIEN)
+        return;
+
+    ps2_speed_send_irq(ata->speed, SPD_INTR_ATA0);
+}
+
+static inline void ata_schedule(struct ps2_ata* ata, void (*callback)(void*, int), const char* name, long cycles) {
+    struct sched_event event;
+
+    event.callback = callback;
+    event.cycles = cycles;
+    event.name = name;
+    event.udata = ata;
+
+    sched_schedule(ata->sched, event);
+}
+
+static int ata_alloc_buffer(struct ps2_ata* ata, uint32_t size) {
+    if (size > ata->buf_cap) {
+        uint8_t* buf = realloc(ata->buf, size);
+
+        if (!buf)
+            return 0;
+
+        ata->buf = buf;
+        ata->buf_cap = size;
+    }
+
+    ata->buf_pos = 0;
+    ata->buf_size = size;
+
+    return 1;
+}
+
+// Raised when the drive has data ready (PIO in) or is ready to receive
+// the next block (PIO out)
+static void ata_event_drq(void* udata, int overshoot) {
+    struct ps2_ata* ata = (struct ps2_ata*)udata;
+
+    // Command was aborted by a reset
+    if (!(ata->status & ATA_STAT_BSY))
+        return;
+
+    if (hdd_image_wait(ata->image)) {
+        ata->xfer = ATA_XFER_NONE;
+        ata->status = ATA_STAT_DRDY | ATA_STAT_ERR;
+        ata->error = ATA_ERR_UNC;
+    } else {
+        ata->status = ATA_STAT_DRDY | ATA_STAT_DSC | ATA_STAT_DRQ;
+    }
+
+    ata_send_irq(ata);
+}
+
+static void ata_event_complete(void* udata, int overshoot) {
+    struct ps2_ata* ata = (struct ps2_ata*)udata;
+
+    if (!(ata->status & ATA_STAT_BSY))
+        return;
+
+    ata->xfer = ATA_XFER_NONE;
+
+    if (ata->image && hdd_image_wait(ata->image)) {
+        ata->status = ATA_STAT_DRDY | ATA_STAT_ERR;
+        ata->error = ATA_ERR_UNC;
+    } else {
+        ata->status = ATA_STAT_DRDY | ATA_STAT_DSC;
+    }
+
+    ata_send_irq(ata);
+}
+
+static void ata_finish(struct ps2_ata* ata, long delay) {
+    ata->xfer = ATA_XFER_NONE;
+    ata->status = ATA_STAT_BSY | ATA_STAT_DRDY;
+
+    ata_schedule(ata, ata_event_complete, "ATA command", delay);
+}
+
+static void ata_abort(struct ps2_ata* ata, int error) {
+    ata->xfer = ATA_XFER_NONE;
+    ata->status = ATA_STAT_DRDY | ATA_STAT_ERR;
+    ata->error = error;
+
+    ata_send_irq(ata);
+}
+
+static int ata_get_address(struct ps2_ata* ata, int ext) {
+    if (ext) {
+        ata->lba =
+            ((uint64_t)(ata->sector & 0xff)) |
+            ((uint64_t)(ata->lcyl & 0xff) << 8) |
+            ((uint64_t)(ata->hcyl & 0xff) << 16) |
+            ((uint64_t)(ata->hob_sector & 0xff) << 24) |
+            ((uint64_t)(ata->hob_lcyl & 0xff) << 32) |
+            ((uint64_t)(ata->hob_hcyl & 0xff) << 40);
+
+        ata->count = (ata->nsector & 0xff) | ((ata->hob_nsector & 0xff) << 8);
+        ata->count = ata->count ? ata->count : 65536;
+    } else {
+        ata->lba =
+            ((uint64_t)(ata->sector & 0xff)) |
+            ((uint64_t)(ata->lcyl & 0xff) << 8) |
+            ((uint64_t)(ata->hcyl & 0xff) << 16) |
+            ((uint64_t)(ata->select & 0x0f) << 24);
+
+        ata->count = ata->nsector & 0xff;
+        ata->count = ata->count ? ata->count : 256;
+    }
+
+    if (ata->lba + ata->count > ata->sectors) {
+        ata_abort(ata, ATA_ERR_IDNF);
+
+        return 0;
+    }
+
+    if (!ata_alloc_buffer(ata, ata->count * HDD_SECTOR_SIZE)) {
+        ata_abort(ata, ATA_ERR_ABRT);
+
+        return 0;
+    }
+
+    return 1;
+}
+
+static void ata_set_address(struct ps2_ata* ata, uint64_t lba, int ext) {
+    ata->sector = lba & 0xff;
+    ata->lcyl = (lba >> 8) & 0xff;
+    ata->hcyl = (lba >> 16) & 0xff;
+
+    if (ext) {
+        ata->hob_sector = (lba >> 24) & 0xff;
+        ata->hob_lcyl = (lba >> 32) & 0xff;
+        ata->hob_hcyl = (lba >> 40) & 0xff;
+    } else {
+        ata->select = (ata->select & 0xf0) | ((lba >> 24) & 0x0f);
+    }
+}
+
+static void ata_put_string(uint16_t* words, int index, int len, const char* str) {
+    // Strings are stored with the first character in the high byte
+    for (int i = 0; i < len; i++) {
+        char c0 = *str ? *str++ : ' ';
+        char c1 = *str ? *str++ : ' ';
+
+        words[index + i] = (c0 << 8) | c1;
+    }
+}
+
+static void ata_cmd_identify(struct ps2_ata* ata) {
+    uint16_t words[256];
+
+    memset(words, 0, sizeof(words));
+
+    uint64_t lba28 = ata->sectors > 0x0fffffff ? 0x0fffffff : ata->sectors;
+    uint64_t cyls = ata->sectors / (16 * 63);
+
+    words[0] = 0x0040; // Fixed disk
+    words[1] = cyls > 16383 ? 16383 : cyls;
+    words[3] = 16;
+    words[6] = 63;
+
+    ata_put_string(words, 10, 10, "IRIS00000000");
+    ata_put_string(words, 23, 4, "1.00");
+    ata_put_string(words, 27, 20, "IRIS HDD");
+
+    words[47] = 0x8001; // READ/WRITE MULTIPLE, 1 sector
+    words[49] = 0x0300; // LBA, DMA
+    words[53] = 0x0006; // Words 64-70 and 88 valid
+    words[54] = words[1];
+    words[55] = words[3];
+    words[56] = words[6];
+    words[60] = lba28 & 0xffff;
+    words[61] = lba28 >> 16;
+    words[63] = 0x0407; // MWDMA 0-2 supported, 2 selected
+    words[64] = 0x0003; // PIO 3-4
+    words[80] = 0x007e; // ATA-1 to ATA-6
+    words[82] = 0x4001; // SMART
+    words[83] = 0x7400; // 48-bit addressing, FLUSH CACHE EXT
+    words[84] = 0x4000;
+    words[85] = 0x4001;
+    words[86] = 0x3400;
+    words[87] = 0x4000;
+    words[88] = 0x203f; // UDMA 0-5 supported, 5 selected
+    words[93] = 0x4000;
+    words[100] = ata->sectors & 0xffff;
+    words[101] = (ata->sectors >> 16) & 0xffff;
+    words[102] = (ata->sectors >> 32) & 0xffff;
+    words[103] = (ata->sectors >> 48) & 0xffff;
+
+    // Integrity word
+    uint8_t sum = 0xa5;
+
+    for (int i = 0; i < 255; i++)
+        sum += (words[i] & 0xff) + (words[i] >> 8);
+
+    words[255] = ((uint8_t)-sum << 8) | 0xa5;
+
+    ata_alloc_buffer(ata, sizeof(words));
+
+    for (int i = 0; i < 256; i++) {
+        ata->buf[i * 2 + 0] = words[i] & 0xff;
+        ata->buf[i * 2 + 1] = words[i] >> 8;
+    }
+
+    ata->xfer = ATA_XFER_PIO_IN;
+    ata->status = ATA_STAT_BSY | ATA_STAT_DRDY;
+
+    ata_schedule(ata, ata_event_drq, "ATA IDENTIFY", ATA_COMMAND_DELAY);
+}
 
+static void ata_cmd_read(struct ps2_ata* ata, int ext, int dma) {
+    if (!ata_get_address(ata, ext))
+        return;
+
+    // The read runs in the background while the drive "seeks", PIO
+    // transfers pick the data up from the DRQ event, DMA transfers wait
+    // for it when the DEV9 channel is started
+    hdd_image_submit_read(ata->image, ata->lba, ata->count, ata->buf);
+
+    ata->status = ATA_STAT_BSY | ATA_STAT_DRDY;
+
+    if (dma) {
+        ata->xfer = ATA_XFER_DMA_IN;
+        ata->status |= ATA_STAT_DRQ;
+    } else {
+        ata->xfer = ATA_XFER_PIO_IN;
+
+        ata_schedule(ata, ata_event_drq, "ATA read", ATA_SEEK_DELAY);
+    }
+}
+
+static void ata_cmd_write(struct ps2_ata* ata, int ext, int dma) {
+    if (!ata_get_address(ata, ext))
+        return;
+
+    ata->xfer = dma ? ATA_XFER_DMA_OUT : ATA_XFER_PIO_OUT;
+    ata->status = ATA_STAT_DRDY | ATA_STAT_DSC | ATA_STAT_DRQ;
+
+    if (dma)
+        ata->status |= ATA_STAT_BSY;
+}
+
+static void ata_write_done(struct ps2_ata* ata) {
+    // Written data goes to the image in the background, the command
+    // completes once the write is done
+    hdd_image_submit_write(ata->image, ata->lba, ata->count, ata->buf);
+
+    ata_finish(ata, ATA_SEEK_DELAY);
+}
+
+static void ata_cmd_sce_security(struct ps2_ata* ata) {
+    switch (ata->feature & 0xff) {
+        // Get SCE ID
+        case 0xec: {
+            ata_alloc_buffer(ata, HDD_SECTOR_SIZE);
+
+            memset(ata->buf, 0, HDD_SECTOR_SIZE);
+
+            ata->xfer = ATA_XFER_PIO_IN;
+            ata->status = ATA_STAT_BSY | ATA_STAT_DRDY;
+
+            ata_schedule(ata, ata_event_drq, "ATA SCE security", ATA_COMMAND_DELAY);
+        } break;
+
+        default: {
+            ata_finish(ata, ATA_COMMAND_DELAY);
+        } break;
+    }
+}
+
+static void ata_cmd_smart(struct ps2_ata* ata) {
+    switch (ata->feature & 0xff) {
+        // RETURN STATUS, report no threshold exceeded
+        case 0xda: {
+            ata->lcyl = 0x4f;
+            ata->hcyl = 0xc2;
+        } break;
+    }
+
+    ata_finish(ata, ATA_COMMAND_DELAY);
+}
+
+static void ata_handle_command(struct ps2_ata* ata, uint8_t cmd) {
+    // printf("ata: command %02x\n", cmd);
+
+    ata->command = cmd;
+    ata->error = 0;
+
+    // Wait for any outstanding I/O before starting a new command, the
+    // transfer buffer is reused
+    hdd_image_wait(ata->image);
+
+    switch (cmd) {
+        case 0x20: case 0x21: ata_cmd_read(ata, 0, 0); return;
+        case 0x24: ata_cmd_read(ata, 1, 0); return;
+        case 0xc8: case 0xc9: ata_cmd_read(ata, 0, 1); return;
+        case 0x25: ata_cmd_read(ata, 1, 1); return;
+        case 0x30: case 0x31: ata_cmd_write(ata, 0, 0); return;
+        case 0x34: ata_cmd_write(ata, 1, 0); return;
+        case 0xca: case 0xcb: ata_cmd_write(ata, 0, 1); return;
+        case 0x35: ata_cmd_write(ata, 1, 1); return;
+        case 0xec: ata_cmd_identify(ata); return;
+        case 0x8e: ata_cmd_sce_security(ata); return;
+        case 0xb0: ata_cmd_smart(ata); return;
+
+        // FLUSH CACHE (EXT)
+        case 0xe7:
+        case 0xea: {
+            hdd_image_submit_flush(ata->image);
+
+            ata_finish(ata, ATA_COMMAND_DELAY);
+        } return;
+
+        // CHECK POWER MODE, always active
+        case 0xe5: {
+            ata->nsector = 0xff;
+
+            ata_finish(ata, ATA_COMMAND_DELAY);
+        } return;
+
+        // READ NATIVE MAX ADDRESS (EXT)
+        case 0xf8:
+        case 0x27: {
+            ata_set_address(ata, ata->sectors - 1, cmd == 0x27);
+            ata_finish(ata, ATA_COMMAND_DELAY);
+        } return;
+
+        // Commands without data, nothing to do other than completing them
+        case 0x00: // NOP
+        case 0x10: // RECALIBRATE
+        case 0x40: // READ VERIFY SECTORS
+        case 0x42: // READ VERIFY SECTORS EXT
+        case 0x70: // SEEK
+        case 0x91: // INITIALIZE DEVICE PARAMETERS
+        case 0xc6: // SET MULTIPLE MODE
+        case 0xe0: // STANDBY IMMEDIATE
+        case 0xe1: // IDLE IMMEDIATE
+        case 0xe2: // STANDBY
+        case 0xe3: // IDLE
+        case 0xe6: // SLEEP
+        case 0xef: // SET FEATURES
+            ata_finish(ata, ATA_COMMAND_DELAY);
+        return;
+    }
+
+    printf("ata: Unhandled command %02x\n", cmd);
+
+    ata_abort(ata, ATA_ERR_ABRT);
+}
+
+static uint16_t ata_read_data(struct ps2_ata* ata) {
+    if (ata->xfer != ATA_XFER_PIO_IN || !(ata->status & ATA_STAT_DRQ))
+        return 0;
+
+    uint16_t data = ata->buf[ata->buf_pos] | (ata->buf[ata->buf_pos + 1] << 8);
+
+    ata->buf_pos += 2;
+
+    if (ata->buf_pos % HDD_SECTOR_SIZE)
+        return data;
+
+    if (ata->buf_pos == ata->buf_size) {
+        // Last sector read, no interrupt is raised
+        ata->xfer = ATA_XFER_NONE;
+        ata->status = ATA_STAT_DRDY | ATA_STAT_DSC;
+    } else {
+        ata->status = ATA_STAT_BSY | ATA_STAT_DRDY;
+
+        ata_schedule(ata, ata_event_drq, "ATA read", ATA_SECTOR_DELAY);
+    }
+
+    return data;
+}
+
+static void ata_write_data(struct ps2_ata* ata, uint16_t data) {
+    if (ata->xfer != ATA_XFER_PIO_OUT || !(ata->status & ATA_STAT_DRQ))
+        return;
+
+    ata->buf[ata->buf_pos + 0] = data & 0xff;
+    ata->buf[ata->buf_pos + 1] = data >> 8;
+
+    ata->buf_pos += 2;
+
+    if (ata->buf_pos % HDD_SECTOR_SIZE)
+        return;
+
+    if (ata->buf_pos == ata->buf_size) {
+        ata_write_done(ata);
+    } else {
+        ata->status = ATA_STAT_BSY | ATA_STAT_DRDY;
+
+        ata_schedule(ata, ata_event_drq, "ATA write", ATA_SECTOR_DELAY);
+    }
+}
+
+static inline uint16_t ata_read_register(struct ps2_ata* ata, uint16_t reg, uint16_t hob) {
+    return (ata->control & ATA_CTRL_HOB) ? hob : reg;
+}
+
+static inline void ata_write_register(struct ps2_ata* ata, uint16_t* reg, uint16_t* hob, uint64_t data) {
+    *hob = *reg;
+    *reg = data & 0xff;
+
+    ata->control &= ~ATA_CTRL_HOB;
+}
+
+static inline int ata_selected(struct ps2_ata* ata) {
+    // Only a master drive is emulated
+    return ata->image && !(ata->select & 0x10);
+}
+
+uint64_t ps2_ata_read16(struct ps2_ata* ata, uint32_t addr) {
     switch (addr) {
-        case 0x0040: return ata->data;
+        case 0x0040: return ata_selected(ata) ? ata_read_data(ata) : 0;
         case 0x0042: return ata->error;
-        case 0x0044: return ata->nsector;
-        case 0x0046: return ata->sector;
-        case 0x0048: return ata->lcyl;
-        case 0x004a: return ata->hcyl;
+        case 0x0044: return ata_read_register(ata, ata->nsector, ata->hob_nsector);
+        case 0x0046: return ata_read_register(ata, ata->sector, ata->hob_sector);
+        case 0x0048: return ata_read_register(ata, ata->lcyl, ata->hob_lcyl);
+        case 0x004a: return ata_read_register(ata, ata->hcyl, ata->hob_hcyl);
         case 0x004c: return ata->select;
-        case 0x004e: return 0x48; // RDY | DRQ
-        case 0x005c: return 0x40;
+        case 0x004e: {
+            if (!ata_selected(ata))
+                return 0;
+
+            // Reading STATUS acknowledges the interrupt
+            ata->speed->intr_stat &= ~SPD_INTR_ATA0;
+
+            return ata->status;
+        }
+        case 0x005c: return ata_selected(ata) ? ata->status : 0;
     }
+
+    printf("ata: read16 %08x\n", addr);
+
+    return 0;
 }
 
 uint64_t ps2_ata_read32(struct ps2_ata* ata, uint32_t addr) {
     printf("ata: read32 %08x\n", addr);
+
+    return 0;
 }
 
 void ps2_ata_write16(struct ps2_ata* ata, uint32_t addr, uint64_t data) {
-    printf("ata: write16 %08x %08lx\n", addr, data);
-
     switch (addr) {
-        // case 0x0040: return ata->data;
-        // case 0x0042: return ata->error;
-        // case 0x0044: return ata->nsector;
-        // case 0x0046: return ata->sector;
-        case 0x0048: ata->lcyl = data; return;
-        case 0x004a: ata->hcyl = data; return;
-        case 0x004c: ata->select = data; return;
+        case 0x0040: if (ata_selected(ata)) ata_write_data(ata, data); return;
+        case 0x0042: ata_write_register(ata, &ata->feature, &ata->hob_feature, data); return;
+        case 0x0044: ata_write_register(ata, &ata->nsector, &ata->hob_nsector, data); return;
+        case 0x0046: ata_write_register(ata, &ata->sector, &ata->hob_sector, data); return;
+        case 0x0048: ata_write_register(ata, &ata->lcyl, &ata->hob_lcyl, data); return;
+        case 0x004a: ata_write_register(ata, &ata->hcyl, &ata->hob_hcyl, data); return;
+        case 0x004c: ata->select = data & 0xff; return;
         case 0x004e: {
             // COMMAND
-            ps2_speed_send_irq(ata->speed, SPD_INTR_ATA0);
+            if (!ata_selected(ata))
+                return;
 
-            return;
-        } break;
-        // case 0x005c: return ata->control;
+            ata_handle_command(ata, data & 0xff);
+        } return;
+        case 0x005c: {
+            // CONTROL, software reset on SRST going low
+            int srst = ata->control & ATA_CTRL_SRST;
+
+            ata->control = data & 0xff;
+
+            if (srst && !(data & ATA_CTRL_SRST)) {
+                if (ata->image)
+                    hdd_image_wait(ata->image);
+
+                ata_set_signature(ata);
+            }
+        } return;
     }
+
+    printf("ata: write16 %08x %08lx\n", addr, data);
 }
 
 void ps2_ata_write32(struct ps2_ata* ata, uint32_t addr, uint64_t data) {
     printf("ata: write32 %08x %08lx\n", addr, data);
-}
\ No newline at end of file
+}
+
+int ps2_ata_dma_pending(struct ps2_ata* ata) {
+    if (ata->xfer != ATA_XFER_DMA_IN && ata->xfer != ATA_XFER_DMA_OUT)
+        return 0;
+
+    return ata->xfer;
+}
+
+uint8_t* ps2_ata_dma_get_buffer(struct ps2_ata* ata, uint32_t* size) {
+    // DMA reads can start before the background read is done
+    if (ata->xfer == ATA_XFER_DMA_IN && hdd_image_wait(ata->image)) {
+        ata_abort(ata, ATA_ERR_UNC);
+
+        *size = 0;
+
+        return NULL;
+    }
+
+    *size = ata->buf_size - ata->buf_pos;
+
+    return ata->buf + ata->buf_pos;
+}
+
+void ps2_ata_dma_advance(struct ps2_ata* ata, uint32_t size) {
+    ata->buf_pos += size;
+
+    if (ata->buf_pos < ata->buf_size)
+        return;
+
+    if (ata->xfer == ATA_XFER_DMA_OUT) {
+        ata_write_done(ata);
+    } else {
+        ata_finish(ata, ATA_SECTOR_DELAY);
+    }
+}
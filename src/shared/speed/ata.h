@@ -31,8 +31,36 @@ extern "C" {
 #include <stdlib.h>
 #include <stdio.h>
 
+#include "scheduler.h"
+
+#include "hdd.h"
+
 #include "../speed.h"
 
+// Status
+#define ATA_STAT_ERR  0x01
+#define ATA_STAT_DRQ  0x08
+#define ATA_STAT_DSC  0x10
+#define ATA_STAT_DF   0x20
+#define ATA_STAT_DRDY 0x40
+#define ATA_STAT_BSY  0x80
+
+// Error
+#define ATA_ERR_ABRT 0x04
+#define ATA_ERR_IDNF 0x10
+#define ATA_ERR_UNC  0x40
+
+// Device control
+#define ATA_CTRL_NIEN 0x02
+#define ATA_CTRL_SRST 0x04
+#define ATA_CTRL_HOB  0x80
+
+#define ATA_XFER_NONE    0
+#define ATA_XFER_PIO_IN  1
+#define ATA_XFER_PIO_OUT 2
+#define ATA_XFER_DMA_IN  3
+#define ATA_XFER_DMA_OUT 4
+
 struct ps2_ata {
     uint16_t data;
     uint16_t error;
@@ -46,18 +74,44 @@ struct ps2_ata {
     uint16_t command;
     uint16_t control;
 
+    // Previous register contents, used by 48-bit commands
+    uint16_t hob_feature;
+    uint16_t hob_nsector;
+    uint16_t hob_sector;
+    uint16_t hob_lcyl;
+    uint16_t hob_hcyl;
+
+    struct hdd_image* image;
+    uint64_t sectors;
+
+    // Current transfer
+    int xfer;
+    uint8_t* buf;
+    size_t buf_cap;
+    uint32_t buf_pos;
+    uint32_t buf_size;
+    uint64_t lba;
+    uint32_t count;
+
     struct ps2_speed* speed;
+    struct sched_state* sched;
 };
 
 struct ps2_ata* ps2_ata_create(void);
-void ps2_ata_init(struct ps2_ata* ata, struct ps2_speed* speed);
-int ps2_ata_load(struct ps2_ata* ata, const char* path);
+void ps2_ata_init(struct ps2_ata* ata, struct ps2_speed* speed, struct sched_state* sched);
+int ps2_ata_load(struct ps2_ata* ata, const char* path, const char* overlay);
+void ps2_ata_reset(struct ps2_ata* ata);
 void ps2_ata_destroy(struct ps2_ata* ata);
 uint64_t ps2_ata_read16(struct ps2_ata* ata, uint32_t addr);
 uint64_t ps2_ata_read32(struct ps2_ata* ata, uint32_t addr);
 void ps2_ata_write16(struct ps2_ata* ata, uint32_t addr, uint64_t data);
 void ps2_ata_write32(struct ps2_ata* ata, uint32_t addr, uint64_t data);
 
+// DMA interface, used by the DEV9 DMA channel
+int ps2_ata_dma_pending(struct ps2_ata* ata);
+uint8_t* ps2_ata_dma_get_buffer(struct ps2_ata* ata, uint32_t* size);
+void ps2_ata_dma_advance(struct ps2_ata* ata, uint32_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,471 @@
+#include <condition_variable>
+#include <filesystem>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <thread>
+#include <deque>
+#include <mutex>
+
+#include "hdd.h"
+
+#ifdef _MSC_VER
+#define fseek64 _fseeki64
+#define ftell64 _ftelli64
+#elif defined(_WIN32)
+#define fseek64 fseeko64
+#define ftell64 ftello64
+#else
+#define fseek64 fseek
+#define ftell64 ftell
+#endif
+
+#define HDD_MAGIC "IRISHDD"
+#define HDD_VERSION 1
+#define HDD_HEADER_SIZE 0x200
+#define HDD_BASE_PATH_SIZE 0x1d8
+
+// Limit base image chains so a broken image can't recurse forever
+#define HDD_MAX_DEPTH 8
+
+struct hdd_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t block_size;
+    uint64_t sectors;
+    uint64_t map_offset;
+    uint32_t map_entries;
+    uint32_t reserved;
+    char base_path[HDD_BASE_PATH_SIZE];
+};
+
+static_assert(sizeof(hdd_header) == HDD_HEADER_SIZE);
+
+struct hdd_layer {
+    FILE* file = nullptr;
+    bool sparse = false;
+    bool writable = false;
+    uint64_t sectors = 0;
+
+    // Sparse images only
+    uint32_t block_size = 0;
+    uint64_t map_offset = 0;
+    uint64_t file_end = 0;
+    std::vector <uint32_t> map;
+
+    hdd_layer* base = nullptr;
+};
+
+enum {
+    HDD_REQ_READ,
+    HDD_REQ_WRITE,
+    HDD_REQ_FLUSH
+};
+
+struct hdd_request {
+    int type;
+    uint64_t lba;
+    uint32_t count;
+    uint8_t* buf;
+};
+
+struct hdd_image {
+    hdd_layer* layer;
+
+    std::deque <hdd_request> queue;
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::condition_variable done_cv;
+    std::thread worker;
+    bool busy = false;
+    bool end = false;
+    bool error = false;
+};
+
+static void hdd_layer_close(hdd_layer* layer) {
+    while (layer) {
+        hdd_layer* base = layer->base;
+
+        if (layer->file)
+            fclose(layer->file);
+
+        delete layer;
+
+        layer = base;
+    }
+}
+
+static hdd_layer* hdd_layer_open(const std::string& path, bool writable, int depth) {
+    if (depth == HDD_MAX_DEPTH) {
+        fprintf(stderr, "hdd: Too many base images, stopping at \'%s\'\n", path.c_str());
+
+        return nullptr;
+    }
+
+    FILE* file = writable ? fopen(path.c_str(), "r+b") : nullptr;
+
+    if (!file) {
+        writable = false;
+
+        file = fopen(path.c_str(), "rb");
+    }
+
+    if (!file)
+        return nullptr;
+
+    hdd_layer* layer = new hdd_layer;
+
+    layer->file = file;
+    layer->writable = writable;
+
+    hdd_header hdr;
+
+    memset(&hdr, 0, sizeof(hdr));
+
+    fseek64(file, 0, SEEK_END);
+
+    uint64_t size = ftell64(file);
+
+    fseek64(file, 0, SEEK_SET);
+
+    if (fread(&hdr, sizeof(hdr), 1, file) != 1 || memcmp(hdr.magic, HDD_MAGIC, 8)) {
+        // Not a sparse image, treat it as a raw dump
+        layer->sectors = size / HDD_SECTOR_SIZE;
+
+        return layer;
+    }
+
+    if (hdr.version != HDD_VERSION || !hdr.block_size || (hdr.block_size % HDD_SECTOR_SIZE)) {
+        fprintf(stderr, "hdd: Unsupported sparse image \'%s\'\n", path.c_str());
+
+        hdd_layer_close(layer);
+
+        return nullptr;
+    }
+
+    layer->sparse = true;
+    layer->sectors = hdr.sectors;
+    layer->block_size = hdr.block_size;
+    layer->map_offset = hdr.map_offset;
+    layer->file_end = size;
+    layer->map.resize(hdr.map_entries);
+
+    fseek64(file, hdr.map_offset, SEEK_SET);
+
+    if (fread(layer->map.data(), sizeof(uint32_t), hdr.map_entries, file) != hdr.map_entries) {
+        fprintf(stderr, "hdd: Couldn't read block map from \'%s\'\n", path.c_str());
+
+        hdd_layer_close(layer);
+
+        return nullptr;
+    }
+
+    hdr.base_path[HDD_BASE_PATH_SIZE - 1] = '\0';
+
+    if (hdr.base_path[0]) {
+        std::filesystem::path base_path = hdr.base_path;
+
+        if (base_path.is_relative())
+            base_path = std::filesystem::path(path).parent_path() / base_path;
+
+        // Base images are never written to
+        layer->base = hdd_layer_open(base_path.string(), false, depth + 1);
+
+        if (!layer->base) {
+            fprintf(stderr, "hdd: Couldn't open base image \'%s\'\n", base_path.string().c_str());
+
+            hdd_layer_close(layer);
+
+            return nullptr;
+        }
+    }
+
+    return layer;
+}
+
+static bool hdd_layer_read(hdd_layer* layer, uint64_t lba, uint32_t count, uint8_t* buf) {
+    // Anything past the end of the image reads as zeroes
+    if (lba >= layer->sectors) {
+        memset(buf, 0, (size_t)count * HDD_SECTOR_SIZE);
+
+        return true;
+    }
+
+    if (lba + count > layer->sectors) {
+        uint32_t valid = layer->sectors - lba;
+
+        memset(buf + (size_t)valid * HDD_SECTOR_SIZE, 0, (size_t)(count - valid) * HDD_SECTOR_SIZE);
+
+        count = valid;
+    }
+
+    if (!layer->sparse) {
+        fseek64(layer->file, lba * HDD_SECTOR_SIZE, SEEK_SET);
+
+        size_t size = (size_t)count * HDD_SECTOR_SIZE;
+        size_t read = fread(buf, 1, size, layer->file);
+
+        if (read != size)
+            memset(buf + read, 0, size - read);
+
+        return true;
+    }
+
+    uint32_t block_sectors = layer->block_size / HDD_SECTOR_SIZE;
+
+    while (count) {
+        uint64_t block = lba / block_sectors;
+        uint32_t offset = lba % block_sectors;
+        uint32_t n = std::min(count, block_sectors - offset);
+        uint32_t entry = block < layer->map.size() ? layer->map[block] : 0;
+
+        if (entry) {
+            fseek64(layer->file, (uint64_t)entry * HDD_SECTOR_SIZE + (uint64_t)offset * HDD_SECTOR_SIZE, SEEK_SET);
+
+            if (fread(buf, HDD_SECTOR_SIZE, n, layer->file) != n)
+                return false;
+        } else if (layer->base) {
+            if (!hdd_layer_read(layer->base, lba, n, buf))
+                return false;
+        } else {
+            memset(buf, 0, (size_t)n * HDD_SECTOR_SIZE);
+        }
+
+        buf += (size_t)n * HDD_SECTOR_SIZE;
+        lba += n;
+        count -= n;
+    }
+
+    return true;
+}
+
+static bool hdd_layer_write(hdd_layer* layer, uint64_t lba, uint32_t count, const uint8_t* buf) {
+    if (!layer->writable || lba + count > layer->sectors)
+        return false;
+
+    if (!layer->sparse) {
+        fseek64(layer->file, lba * HDD_SECTOR_SIZE, SEEK_SET);
+
+        return fwrite(buf, HDD_SECTOR_SIZE, count, layer->file) == count;
+    }
+
+    uint32_t block_sectors = layer->block_size / HDD_SECTOR_SIZE;
+
+    while (count) {
+        uint64_t block = lba / block_sectors;
+        uint32_t offset = lba % block_sectors;
+        uint32_t n = std::min(count, block_sectors - offset);
+        uint32_t entry = layer->map[block];
+
+        if (entry) {
+            fseek64(layer->file, (uint64_t)entry * HDD_SECTOR_SIZE + (uint64_t)offset * HDD_SECTOR_SIZE, SEEK_SET);
+
+            if (fwrite(buf, HDD_SECTOR_SIZE, n, layer->file) != n)
+                return false;
+        } else {
+            // Allocate on write. The new block is filled with the old
+            // contents (from the base image, if any) and written out
+            // before the map entry is updated, so a crash in between
+            // only leaks the block instead of corrupting the image
+            std::vector <uint8_t> data(layer->block_size);
+
+            if (layer->base) {
+                if (!hdd_layer_read(layer->base, block * block_sectors, block_sectors, data.data()))
+                    return false;
+            }
+
+            memcpy(&data[(size_t)offset * HDD_SECTOR_SIZE], buf, (size_t)n * HDD_SECTOR_SIZE);
+
+            entry = layer->file_end / HDD_SECTOR_SIZE;
+
+            fseek64(layer->file, layer->file_end, SEEK_SET);
+
+            if (fwrite(data.data(), 1, layer->block_size, layer->file) != layer->block_size)
+                return false;
+
+            fflush(layer->file);
+
+            fseek64(layer->file, layer->map_offset + block * sizeof(uint32_t), SEEK_SET);
+
+            if (fwrite(&entry, sizeof(uint32_t), 1, layer->file) != 1)
+                return false;
+
+            layer->map[block] = entry;
+            layer->file_end += layer->block_size;
+        }
+
+        buf += (size_t)n * HDD_SECTOR_SIZE;
+        lba += n;
+        count -= n;
+    }
+
+    return true;
+}
+
+static void hdd_image_worker(struct hdd_image* image) {
+    std::unique_lock <std::mutex> lock(image->mtx);
+
+    while (true) {
+        image->cv.wait(lock, [image] { return image->end || !image->queue.empty(); });
+
+        if (image->queue.empty())
+            return;
+
+        hdd_request req = image->queue.front();
+
+        image->queue.pop_front();
+        image->busy = true;
+
+        lock.unlock();
+
+        bool ok = true;
+
+        switch (req.type) {
+            case HDD_REQ_READ: ok = hdd_layer_read(image->layer, req.lba, req.count, req.buf); break;
+            case HDD_REQ_WRITE: ok = hdd_layer_write(image->layer, req.lba, req.count, req.buf); break;
+            case HDD_REQ_FLUSH: ok = fflush(image->layer->file) == 0; break;
+        }
+
+        lock.lock();
+
+        image->busy = false;
+        image->error = image->error || !ok;
+
+        if (image->queue.empty())
+            image->done_cv.notify_all();
+    }
+}
+
+static void hdd_image_submit(struct hdd_image* image, hdd_request req) {
+    {
+        std::lock_guard <std::mutex> lock(image->mtx);
+
+        image->queue.push_back(req);
+    }
+
+    image->cv.notify_one();
+}
+
+extern "C" struct hdd_image* hdd_image_open(const char* path) {
+    hdd_layer* layer = hdd_layer_open(path, true, 0);
+
+    if (!layer)
+        return NULL;
+
+    if (!layer->writable)
+        fprintf(stderr, "hdd: Image \'%s\' is read-only, writes will fail\n", path);
+
+    struct hdd_image* image = new hdd_image;
+
+    image->layer = layer;
+    image->worker = std::thread(hdd_image_worker, image);
+
+    return image;
+}
+
+extern "C" int hdd_image_create(const char* path, uint64_t sectors, const char* base_path) {
+    if (base_path && base_path[0] && !sectors) {
+        std::filesystem::path base = base_path;
+
+        if (base.is_relative())
+            base = std::filesystem::path(path).parent_path() / base;
+
+        hdd_layer* layer = hdd_layer_open(base.string(), false, 0);
+
+        if (!layer)
+            return 0;
+
+        sectors = layer->sectors;
+
+        hdd_layer_close(layer);
+    }
+
+    if (!sectors)
+        return 0;
+
+    hdd_header hdr;
+
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, HDD_MAGIC, 8);
+
+    hdr.version = HDD_VERSION;
+    hdr.block_size = HDD_BLOCK_SIZE;
+    hdr.sectors = sectors;
+    hdr.map_offset = HDD_HEADER_SIZE;
+    hdr.map_entries = (sectors * HDD_SECTOR_SIZE + HDD_BLOCK_SIZE - 1) / HDD_BLOCK_SIZE;
+
+    if (base_path) {
+        if (strlen(base_path) >= HDD_BASE_PATH_SIZE)
+            return 0;
+
+        strcpy(hdr.base_path, base_path);
+    }
+
+    FILE* file = fopen(path, "wb");
+
+    if (!file)
+        return 0;
+
+    std::vector <uint32_t> map(hdr.map_entries);
+
+    bool ok = fwrite(&hdr, sizeof(hdr), 1, file) == 1;
+
+    ok = ok && fwrite(map.data(), sizeof(uint32_t), map.size(), file) == map.size();
+
+    // Start allocating blocks on a sector boundary
+    long pad = (HDD_SECTOR_SIZE - (ftell64(file) % HDD_SECTOR_SIZE)) % HDD_SECTOR_SIZE;
+
+    for (long i = 0; ok && i < pad; i++)
+        ok = fputc(0, file) != EOF;
+
+    fclose(file);
+
+    return ok;
+}
+
+extern "C" uint64_t hdd_image_get_sectors(struct hdd_image* image) {
+    return image->layer->sectors;
+}
+
+extern "C" void hdd_image_submit_read(struct hdd_image* image, uint64_t lba, uint32_t count, uint8_t* buf) {
+    hdd_image_submit(image, { HDD_REQ_READ, lba, count, buf });
+}
+
+extern "C" void hdd_image_submit_write(struct hdd_image* image, uint64_t lba, uint32_t count, const uint8_t* buf) {
+    hdd_image_submit(image, { HDD_REQ_WRITE, lba, count, (uint8_t*)buf });
+}
+
+extern "C" void hdd_image_submit_flush(struct hdd_image* image) {
+    hdd_image_submit(image, { HDD_REQ_FLUSH, 0, 0, nullptr });
+}
+
+extern "C" int hdd_image_wait(struct hdd_image* image) {
+    std::unique_lock <std::mutex> lock(image->mtx);
+
+    image->done_cv.wait(lock, [image] { return image->queue.empty() && !image->busy; });
+
+    int error = image->error;
+
+    image->error = false;
+
+    return error;
+}
+
+extern "C" void hdd_image_close(struct hdd_image* image) {
+    {
+        std::lock_guard <std::mutex> lock(image->mtx);
+
+        image->end = true;
+    }
+
+    // The worker drains the queue before exiting
+    image->cv.notify_one();
+    image->worker.join();
+
+    hdd_layer_close(image->layer);
+
+    delete image;
+}
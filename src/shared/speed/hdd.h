@@ -0,0 +1,55 @@
+#ifndef HDD_H
+#define HDD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    HDD image backend
+    -----------------
+
+    Images can either be raw sector dumps or sparse images. Sparse
+    images only store blocks that have been written to, and can be
+    stacked on top of a read-only base image (raw or sparse) that
+    provides the contents of every block that hasn't been written yet.
+    This lets any number of instances share a single base image, each
+    with their own overlay.
+
+    Sparse image layout (little-endian):
+    0x000 - Magic ("IRISHDD\0")
+    0x008 - Version
+    0x00c - Block size (in bytes)
+    0x010 - Sector count
+    0x018 - Block map offset
+    0x020 - Block map entries
+    0x024 - Reserved
+    0x028 - Base image path (NUL terminated, relative to the image)
+    0x200 - Block map, one 32-bit entry per block with the offset of
+            the block in 512-byte units, 0 if not allocated
+
+    Requests are processed in order by a worker thread. Buffers passed
+    to a request must stay valid until hdd_image_wait returns.
+*/
+
+#include <stdint.h>
+
+#define HDD_SECTOR_SIZE 512
+#define HDD_BLOCK_SIZE 0x10000
+
+struct hdd_image;
+
+struct hdd_image* hdd_image_open(const char* path);
+int hdd_image_create(const char* path, uint64_t sectors, const char* base_path);
+uint64_t hdd_image_get_sectors(struct hdd_image* image);
+void hdd_image_submit_read(struct hdd_image* image, uint64_t lba, uint32_t count, uint8_t* buf);
+void hdd_image_submit_write(struct hdd_image* image, uint64_t lba, uint32_t count, const uint8_t* buf);
+void hdd_image_submit_flush(struct hdd_image* image);
+int hdd_image_wait(struct hdd_image* image);
+void hdd_image_close(struct hdd_image* image);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,229 @@
+// EE interpreter dispatch micro-benchmark
+//
+// Runs a synthetic stream of decoded instructions through the same loop
+// ee_run_block uses, once with the packed 16-byte ee_instruction and once
+// with the 48-byte layout it replaced. The old layout stores every field
+// pre-extracted as an int32_t, including i15 and i26, so it gets its own
+// copy of the handlers compiled against those fields. Both sets of
+// handlers are generated from the same bodies, the only differences are
+// the decoded footprint and how fields are read.
+//
+// Expect the two to be close. Instructions are fetched sequentially, so
+// the prefetcher hides most of the extra footprint and the indirect call
+// is what bounds dispatch. The packed layout pulls ahead once the decoded
+// stream has to come from DRAM.
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+#include "ee/ee_cached.cpp"
+
+// vu_cached.cpp references the GIF, none of these instructions reach it
+extern "C" void ps2_gif_fifo_write(struct ps2_gif* gif, uint128_t data, int path) {}
+
+// Decoded instruction layout before the packing
+struct ee_instruction_old {
+    uint32_t opcode;
+    int32_t rs;
+    int32_t rt;
+    int32_t rd;
+    int32_t sa;
+    int32_t i15;
+    int32_t i16;
+    int32_t i26;
+
+    int branch;
+    int cycles;
+
+    void (*func)(struct ee_state*, const ee_instruction_old&);
+};
+
+static_assert(sizeof(ee_instruction_old) == 48);
+
+// The old layout stored these instead of rebuilding them
+#undef EE_D_I15
+#undef EE_D_I26
+#define EE_D_I15 (i.i15)
+#define EE_D_I26 (i.i26)
+
+#define BENCH_HANDLER(name, body) \
+    static void bench_old_##name(struct ee_state* ee, const ee_instruction_old& i) { body; }
+
+BENCH_HANDLER(addu, EE_RD = SE6432(EE_RS + EE_RT))
+BENCH_HANDLER(or, EE_RD = EE_RS | EE_RT)
+BENCH_HANDLER(xor, EE_RD = EE_RS ^ EE_RT)
+BENCH_HANDLER(sll, EE_RD = SE6432(EE_RT32 << EE_D_SA))
+BENCH_HANDLER(slt, EE_RD = (int64_t)EE_RS < (int64_t)EE_RT)
+BENCH_HANDLER(addiu, EE_RT = SE6432(EE_RS32 + SE3216(EE_D_I16)))
+BENCH_HANDLER(ori, EE_RT = EE_RS | EE_D_I16)
+BENCH_HANDLER(lui, EE_RT = SE6432(EE_D_I16 << 16))
+BENCH_HANDLER(bne, BRANCH(EE_RS != EE_RT, EE_D_SI16))
+BENCH_HANDLER(j, ee_set_pc_delayed(ee, (ee->next_pc & 0xf0000000) | (EE_D_I26 << 2)))
+
+static ee_instruction_old bench_old_decode(uint32_t opcode) {
+    ee_instruction n = ee_decode(opcode);
+    ee_instruction_old i;
+
+    i.opcode = opcode;
+    i.rs = (opcode >> 21) & 0x1f;
+    i.rt = (opcode >> 16) & 0x1f;
+    i.rd = (opcode >> 11) & 0x1f;
+    i.sa = (opcode >> 6) & 0x1f;
+    i.i15 = (opcode >> 6) & 0x7fff;
+    i.i16 = opcode & 0xffff;
+    i.i26 = opcode & 0x3ffffff;
+    i.branch = n.branch;
+    i.cycles = n.cycles;
+
+    if (n.func == ee_i_addu) i.func = bench_old_addu;
+    else if (n.func == ee_i_or) i.func = bench_old_or;
+    else if (n.func == ee_i_xor) i.func = bench_old_xor;
+    else if (n.func == ee_i_sll) i.func = bench_old_sll;
+    else if (n.func == ee_i_slt) i.func = bench_old_slt;
+    else if (n.func == ee_i_addiu) i.func = bench_old_addiu;
+    else if (n.func == ee_i_ori) i.func = bench_old_ori;
+    else if (n.func == ee_i_lui) i.func = bench_old_lui;
+    else if (n.func == ee_i_bne) i.func = bench_old_bne;
+    else if (n.func == ee_i_j) i.func = bench_old_j;
+    else {
+        fprintf(stderr, "bench: no old handler for %08x\n", opcode);
+
+        exit(1);
+    }
+
+    return i;
+}
+
+static uint32_t bench_random_opcode(std::mt19937& rng, int kinds) {
+    uint32_t rs = rng() & 31;
+    uint32_t rt = rng() & 31;
+    uint32_t rd = (rng() % 31) + 1;
+    uint32_t imm = rng() & 0xffff;
+
+    switch (rng() % kinds) {
+        case 0: return (rs << 21) | (rt << 16) | (rd << 11) | 0x21;         // addu
+        case 1: return (rs << 21) | (rt << 16) | (rd << 11) | 0x25;         // or
+        case 2: return (rs << 21) | (rt << 16) | (rd << 11) | 0x26;         // xor
+        case 3: return (rt << 16) | (rd << 11) | ((imm & 31) << 6) | 0x00;  // sll
+        case 4: return (rs << 21) | (rt << 16) | (rd << 11) | 0x2a;         // slt
+        case 5: return (0x09 << 26) | (rs << 21) | (rd << 16) | imm;        // addiu
+        case 6: return (0x0d << 26) | (rs << 21) | (rd << 16) | imm;        // ori
+        case 7: return (0x0f << 26) | (rd << 16) | imm;                     // lui
+        case 8: return (0x05 << 26) | (rs << 21) | (rt << 16) | imm;        // bne
+    }
+
+    return (0x02 << 26) | (rng() & 0x3ffffff);                              // j
+}
+
+// Same per-instruction work as the ee_run_block loop
+template <class T>
+static double bench_run(struct ee_state* ee, const std::vector <T>& block, uint64_t total) {
+    uint64_t passes = total / block.size();
+
+    if (!passes)
+        passes = 1;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint64_t n = 0; n < passes; n++) {
+        ee->pc = 0x100000;
+        ee->next_pc = ee->pc + 4;
+
+        for (const T& i : block) {
+            ee->delay_slot = ee->branch;
+            ee->branch = 0;
+
+            ee->pc = ee->next_pc;
+            ee->next_pc += 4;
+
+            i.func(ee, i);
+
+            ee->count++;
+            ee->r[0] = { 0 };
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration <double, std::nano>(end - start).count();
+
+    return ns / (double)(passes * block.size());
+}
+
+static void bench_stream(struct ee_state* ee, const char* name, int kinds, int period, uint64_t total) {
+    std::mt19937 rng(1234);
+
+    printf("%s\n", name);
+    printf("%12s %10s %10s %10s %10s %8s\n", "instructions", "16B size", "48B size", "16B ns/op", "48B ns/op", "speedup");
+
+    // From a block that fits in L1 to a working set that spills out of L2
+    static const size_t sizes[] = { 256, 4096, 32768, 262144, 1048576 };
+
+    for (size_t size : sizes) {
+        std::vector <ee_instruction> packed(size);
+        std::vector <ee_instruction_old> old(size);
+
+        // A short repeating pattern keeps the indirect call predictable,
+        // so what's left is the cost of fetching decoded instructions
+        std::vector <uint32_t> pattern(period ? period : size);
+
+        for (uint32_t& opcode : pattern)
+            opcode = bench_random_opcode(rng, kinds);
+
+        for (size_t n = 0; n < size; n++) {
+            uint32_t opcode = pattern[n % pattern.size()];
+
+            packed[n] = ee_decode(opcode);
+            old[n] = bench_old_decode(opcode);
+        }
+
+        // Warm up caches and branch predictors before timing, then
+        // alternate runs so frequency changes hit both layouts alike
+        bench_run(ee, packed, size * 4);
+        bench_run(ee, old, size * 4);
+
+        double a = 0.0, b = 0.0;
+
+        for (int r = 0; r < 4; r++) {
+            a += bench_run(ee, packed, total / 4);
+            b += bench_run(ee, old, total / 4);
+        }
+
+        a /= 4.0;
+        b /= 4.0;
+
+        printf("%12zu %8zuKB %8zuKB %10.3f %10.3f %7.2fx\n",
+            size,
+            (size * sizeof(ee_instruction)) / 1024,
+            (size * sizeof(ee_instruction_old)) / 1024,
+            a, b, b / a
+        );
+    }
+
+    printf("\n");
+}
+
+int main(int argc, const char* argv[]) {
+    uint64_t total = 200000000;
+
+    if (argc > 1)
+        total = strtoull(argv[1], NULL, 0);
+
+    struct ee_state* ee = ee_create();
+
+    printf("sizeof(ee_instruction) = %zu, old layout = %zu\n\n", sizeof(ee_instruction), sizeof(ee_instruction_old));
+
+    // Every handler kind in random order, the indirect call mispredicts
+    // on most instructions and that dominates the time per instruction
+    bench_stream(ee, "random ALU/branch mix:", 10, 0, total);
+
+    // 64-instruction loop body, predictable once the predictor learns it
+    bench_stream(ee, "repeating 64-instruction pattern:", 10, 64, total);
+
+    delete ee;
+
+    return 0;
+}
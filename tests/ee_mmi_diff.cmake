@@ -0,0 +1,23 @@
+# Runs the scalar and SSE builds of ee_mmi_diff and compares their output
+cmake_minimum_required(VERSION 3.21)
+
+execute_process(COMMAND ${SCALAR} OUTPUT_VARIABLE SCALAR_OUTPUT RESULT_VARIABLE SCALAR_RESULT)
+execute_process(COMMAND ${SSE} OUTPUT_VARIABLE SSE_OUTPUT RESULT_VARIABLE SSE_RESULT)
+
+if (NOT SCALAR_RESULT EQUAL 0 OR NOT SSE_RESULT EQUAL 0)
+    message(FATAL_ERROR "ee_mmi_diff: test program failed (${SCALAR_RESULT}, ${SSE_RESULT})")
+endif()
+
+if (NOT SCALAR_OUTPUT STREQUAL SSE_OUTPUT)
+    string(REPLACE "\n" ";" SCALAR_LINES "${SCALAR_OUTPUT}")
+    string(REPLACE "\n" ";" SSE_LINES "${SSE_OUTPUT}")
+
+    foreach (LINE IN LISTS SCALAR_LINES)
+        if (NOT LINE IN_LIST SSE_LINES)
+            string(REGEX MATCH "^[a-z0-9]+" NAME "${LINE}")
+            message(STATUS "ee_mmi_diff: mismatch in ${NAME}")
+        endif()
+    endforeach()
+
+    message(FATAL_ERROR "ee_mmi_diff: scalar and SSE results differ")
+endif()